@@ -4,17 +4,50 @@
 // - atualizações de altura (COUNT_HEIGHT)
 // - rotações (COUNT_ROT)
 // - alocação/liberação de nós (COUNT_ALLOC / COUNT_FREE)
+// - atualizações do tamanho da subárvore (COUNT_TAMANHO; fora das somas abaixo,
+//   lido por avl_get_tamanho_and_reset)
 // A métrica final usada por main_experimento será a soma de todas as categorias.
 // Exporta funções:
 //   Arvore1* avl_criar();
 //   void avl_inserir(Arvore1*, int);
 //   int avl_remover_chave(Arvore1*, int); // remove 1 ocorrência
+//   void avl_inserir_lote(Arvore1*, const int*, int);  // ordena e insere a partir de um dedo
+//   int avl_remover_lote(Arvore1*, const int*, int);   // idem; retorna quantas removeu
+//   void avl_anexar(Arvore1*, int);    // inserção com dica: O(1) amortizado se chave >= máximo (sem AVL_TAMANHO)
+//   long avl_remover_intervalo(Arvore1*, int, int); // remove [lo, hi] (split/join); retorna ocorrências
+//   void avl_uniao(Arvore1*, Arvore1*);       // a = a ∪ b (quantidades somadas); b fica vazia
+//   void avl_intersecao(Arvore1*, Arvore1*);  // a = a ∩ b (menor quantidade); b fica vazia
+//   void avl_diferenca(Arvore1*, Arvore1*);   // a = a \ b (quantidades subtraídas); b fica vazia
+//   void avl_definir_threads(int);            // threads das operações de conjunto (padrão 1)
+//   int avl_definir_arena(int, int);          // nós numa arena (modo, NUMA; Arena_mod.c); retorna o modo efetivo
+//   void avl_arena_estado(int*, int*, long*); // modo e NUMA efetivos, bytes mapeados
 //   void avl_remover_tudo(Arvore1*);
+//   int avl_buscar(Arvore1*, int);
+//   int avl_altura(Arvore1*);                     // altura da raiz (0 = vazia)
+//   long avl_percorrer(Arvore1*, void (*)(int, int, void*), void*); // em ordem (valor, quantidade)
+//   long avl_rank(Arvore1*, int);                 // ocorrências < chave
+//   int avl_select(Arvore1*, long, int*);         // k-ésima ocorrência (k a partir de 0); 0 se k >= total
+//   long avl_contar_intervalo(Arvore1*, int, int); // ocorrências em [lo, hi]
+//   int avl_salvar(Arvore1*, const char*);          // arquivo pré-ordem sem ponteiros
+//   Arvore1* avl_carregar(const char*);             // mmap + reconstrução linear
+//   ArvoreMapeadaAVL* avl_mapear(const char*);      // mmap usado como árvore só leitura
+//   int avl_mapa_buscar(ArvoreMapeadaAVL*, int);
+//   void avl_mapa_fechar(ArvoreMapeadaAVL*);
 //   long avl_get_insercao_and_reset();
 //   long avl_get_remocao_and_reset();
+//   long avl_get_conjunto_and_reset();
+//   long avl_get_tamanho_and_reset();
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 
 typedef struct no1 {
     struct no1* pai;
@@ -23,19 +56,23 @@ typedef struct no1 {
     int altura;
     int valor;
     int quantidade;
+    int tamanho;    // ocorrências na subárvore (soma das quantidades), se AVL_TAMANHO
 } No1;
 
 typedef struct arvore1 {
     No1* raiz;
+    No1* maximo;    // nó mais à direita, usado por avl_anexar (NULL = recalcular)
 } Arvore1;
 
 
-static long AVL_COUNT_VISIT = 0;   // comparações / visitas (navegação)
-static long AVL_COUNT_MOVE  = 0;   // atribuições / mov. ponteiros (links)
-static long AVL_COUNT_HEIGHT = 0;  // atualizações de altura
-static long AVL_COUNT_ROT   = 0;   // rotações (cada rotação conta 1)
-static long AVL_COUNT_ALLOC = 0;   // alocações de nós
-static long AVL_COUNT_FREE  = 0;   // liberações de nós
+/* por thread: as tarefas paralelas de avl_uniao & cia. devolvem suas contas a quem as criou */
+static _Thread_local long AVL_COUNT_VISIT = 0;   // comparações / visitas (navegação)
+static _Thread_local long AVL_COUNT_MOVE  = 0;   // atribuições / mov. ponteiros (links)
+static _Thread_local long AVL_COUNT_HEIGHT = 0;  // atualizações de altura
+static _Thread_local long AVL_COUNT_ROT   = 0;   // rotações (cada rotação conta 1)
+static _Thread_local long AVL_COUNT_ALLOC = 0;   // alocações de nós
+static _Thread_local long AVL_COUNT_FREE  = 0;   // liberações de nós
+static _Thread_local long AVL_COUNT_TAMANHO = 0; // atualizações de tamanho da subárvore
 
 /* wrappers para obter "esforço total" e reset */
 long avl_get_insercao_and_reset() {
@@ -49,6 +86,18 @@ long avl_get_remocao_and_reset() {
     AVL_COUNT_VISIT = AVL_COUNT_MOVE = AVL_COUNT_HEIGHT = AVL_COUNT_ROT = AVL_COUNT_FREE = 0;
     return total;
 }
+/* operações de conjunto: todas as categorias */
+long avl_get_conjunto_and_reset() {
+    long total = AVL_COUNT_VISIT + AVL_COUNT_MOVE + AVL_COUNT_HEIGHT + AVL_COUNT_ROT + AVL_COUNT_ALLOC + AVL_COUNT_FREE;
+    AVL_COUNT_VISIT = AVL_COUNT_MOVE = AVL_COUNT_HEIGHT = AVL_COUNT_ROT = AVL_COUNT_ALLOC = AVL_COUNT_FREE = 0;
+    return total;
+}
+/* custo do aumento por tamanho (avl_rank & cia.), separado das outras categorias */
+long avl_get_tamanho_and_reset() {
+    long total = AVL_COUNT_TAMANHO;
+    AVL_COUNT_TAMANHO = 0;
+    return total;
+}
 
 
 static inline void COUNT_VISIT() { AVL_COUNT_VISIT++; }
@@ -57,6 +106,7 @@ static inline void COUNT_HEIGHT(){ AVL_COUNT_HEIGHT++; }
 static inline void COUNT_ROT()   { AVL_COUNT_ROT++; }
 static inline void COUNT_ALLOC() { AVL_COUNT_ALLOC++; }
 static inline void COUNT_FREEF() { AVL_COUNT_FREE++; }
+static inline void COUNT_TAMANHO() { AVL_COUNT_TAMANHO++; }
 
 int altura_no(No1* n) {
     if (!n) return 0;
@@ -65,19 +115,56 @@ int altura_no(No1* n) {
 
 int max(int a, int b) { return a > b ? a : b; }
 
+/* Aumento por tamanho da subárvore: rotações e rebalanceamentos recalculam o
+   tamanho dos nós que tocam, e toda mudança de quantidade sobe até a raiz.
+   Desligado por padrão (a subida deixa a anexação O(log n)); compile com
+   -DAVL_TAMANHO=1 para avl_rank & cia. em O(log n). Sem ele elas continuam
+   funcionando, mas somando a subárvore (O(n)). */
+#ifndef AVL_TAMANHO
+#define AVL_TAMANHO 0
+#endif
+
+static inline int tamanho_no(No1* n) { return n ? n->tamanho : 0; }
+
+static inline void avl_tam_atualizar(No1* x) {
+    if (!AVL_TAMANHO) return;
+    x->tamanho = x->quantidade + tamanho_no(x->esquerda) + tamanho_no(x->direita);
+    COUNT_TAMANHO();
+}
+
+/* recalcula de x até a raiz */
+static void avl_tam_subir(No1* x) {
+    if (!AVL_TAMANHO) return;
+    for (; x; x = x->pai) avl_tam_atualizar(x);
+}
+
+/* nós numa arena com páginas grandes / política NUMA (ver Arena_mod.c) */
+#include "Arena_mod.c"
+static Arena AVL_ARENA = ARENA_INICIAL;
+
+int avl_definir_arena(int modo, int numa) {
+    return arena_definir(&AVL_ARENA, modo, numa);
+}
+
+void avl_arena_estado(int* modo, int* numa, long* bytes) {
+    arena_estado(&AVL_ARENA, modo, numa, bytes);
+}
+
 Arvore1* avl_criar() {
     Arvore1* a = (Arvore1*) malloc(sizeof(Arvore1));
     a->raiz = NULL;
+    a->maximo = NULL;
     return a;
 }
 
 No1* novo_no_avl(int valor, No1* pai) {
-    No1* n = (No1*) malloc(sizeof(No1));
+    No1* n = (No1*) arena_alocar(&AVL_ARENA, sizeof(No1));
     n->valor = valor;
     n->pai = pai;
     n->esquerda = n->direita = NULL;
     n->quantidade = 1;
     n->altura = 1;
+    n->tamanho = 1;
     COUNT_ALLOC();
     COUNT_MOVE(); // atribuições de ponteiro iniciais
     return n;
@@ -110,6 +197,8 @@ static No1* rotacao_esq(Arvore1* a, No1* x) {
     // atualiza alturas (contabilizar)
     x->altura = 1 + max(altura_no(x->esquerda), altura_no(x->direita)); COUNT_HEIGHT();
     y->altura = 1 + max(altura_no(y->esquerda), altura_no(y->direita)); COUNT_HEIGHT();
+    avl_tam_atualizar(x);
+    avl_tam_atualizar(y);
 
     return y;
 }
@@ -138,6 +227,8 @@ static No1* rotacao_dir(Arvore1* a, No1* y) {
     // atualiza alturas
     y->altura = 1 + max(altura_no(y->esquerda), altura_no(y->direita)); COUNT_HEIGHT();
     x->altura = 1 + max(altura_no(x->esquerda), altura_no(x->direita)); COUNT_HEIGHT();
+    avl_tam_atualizar(y);
+    avl_tam_atualizar(x);
 
     return x;
 }
@@ -166,12 +257,14 @@ static No1* avl_inserir_rec(Arvore1* a, No1* node, int chave, No1* pai, int* cri
     } else {
         node->quantidade++;
         COUNT_MOVE();
+        avl_tam_atualizar(node);
         return node;
     }
 
     // atualiza altura
     node->altura = 1 + max(altura_no(node->esquerda), altura_no(node->direita));
     COUNT_HEIGHT();
+    avl_tam_atualizar(node);
 
     // balanceamento
     int fb = fator_balanceamento(node);
@@ -201,12 +294,100 @@ static No1* avl_inserir_rec(Arvore1* a, No1* node, int chave, No1* pai, int* cri
 }
 
 void avl_inserir(Arvore1* a, int chave) {
+    if (a->maximo && chave > a->maximo->valor) a->maximo = NULL;
     int criado = 0;
     a->raiz = avl_inserir_rec(a, a->raiz, chave, NULL, &criado);
     if (a->raiz) a->raiz->pai = NULL, COUNT_MOVE();
 }
 
 
+/* altura da raiz (0 = vazia; sem contagem) */
+int avl_altura(Arvore1* a) {
+    return a ? altura_no(a->raiz) : 0;
+}
+
+/* busca pública (visitas contadas) */
+int avl_buscar(Arvore1* a, int chave) {
+    No1* cur = a ? a->raiz : NULL;
+    while (cur) {
+        COUNT_VISIT();
+        if (chave == cur->valor) return 1;
+        cur = (chave < cur->valor) ? cur->esquerda : cur->direita;
+    }
+    return 0;
+}
+
+/* percurso em ordem: cb(valor, quantidade, ctx) por chave distinta */
+static long avl_percorrer_rec(No1* x, void (*cb)(int, int, void*), void* ctx) {
+    if (!x) return 0;
+    long c = avl_percorrer_rec(x->esquerda, cb, ctx);
+    cb(x->valor, x->quantidade, ctx);
+    return c + 1 + avl_percorrer_rec(x->direita, cb, ctx);
+}
+
+long avl_percorrer(Arvore1* a, void (*cb)(int, int, void*), void* ctx) {
+    if (!a) return 0;
+    return avl_percorrer_rec(a->raiz, cb, ctx);
+}
+
+/* --------------------------------------------------
+   Estatísticas de ordem (contagem por ocorrência, como avl_percorrer com as
+   quantidades): uma descida usando o tamanho das subárvores, O(log n).
+   -------------------------------------------------- */
+
+/* tamanho da subárvore; sem o aumento, soma os nós */
+static long avl_tam(No1* x) {
+    if (!x) return 0;
+    if (AVL_TAMANHO) return x->tamanho;
+    return x->quantidade + avl_tam(x->esquerda) + avl_tam(x->direita);
+}
+
+/* ocorrências < chave (ou <= chave se inclusivo) */
+static long avl_contar_abaixo(No1* x, int chave, int inclusivo) {
+    long c = 0;
+    while (x) {
+        COUNT_VISIT();
+        if (chave < x->valor) {
+            x = x->esquerda;
+        } else if (chave == x->valor) {
+            return c + avl_tam(x->esquerda) + (inclusivo ? x->quantidade : 0);
+        } else {
+            c += avl_tam(x->esquerda) + x->quantidade;
+            x = x->direita;
+        }
+    }
+    return c;
+}
+
+long avl_rank(Arvore1* a, int chave) {
+    if (!a) return 0;
+    return avl_contar_abaixo(a->raiz, chave, 0);
+}
+
+int avl_select(Arvore1* a, long k, int* chave) {
+    if (!a || k < 0) return 0;
+    No1* x = a->raiz;
+    while (x) {
+        COUNT_VISIT();
+        long e = avl_tam(x->esquerda);
+        if (k < e) {
+            x = x->esquerda;
+        } else if (k < e + x->quantidade) {
+            if (chave) *chave = x->valor;
+            return 1;
+        } else {
+            k -= e + x->quantidade;
+            x = x->direita;
+        }
+    }
+    return 0;
+}
+
+long avl_contar_intervalo(Arvore1* a, int lo, int hi) {
+    if (!a || lo > hi) return 0;
+    return avl_contar_abaixo(a->raiz, hi, 1) - avl_contar_abaixo(a->raiz, lo, 0);
+}
+
 static No1* avl_minimo(No1* node) {
     if (!node) return NULL;
     No1* cur = node;
@@ -229,6 +410,7 @@ static No1* avl_remover_rec(Arvore1* a, No1* node, int chave, int* removed) {
         *removed = 1;
         if (node->quantidade > 1) {
             node->quantidade--; COUNT_MOVE();
+            avl_tam_atualizar(node);
             return node;
         }
         // nó com um ou nenhum filho
@@ -243,14 +425,15 @@ static No1* avl_remover_rec(Arvore1* a, No1* node, int chave, int* removed) {
                 COUNT_MOVE();
                 *node = *temp;
             }
-            COUNT_FREEF(); free(temp);
+            COUNT_FREEF(); arena_liberar(&AVL_ARENA, temp);
         } else {
             // dois filhos: pegar sucessor (mínimo na direita)
             No1* temp = avl_minimo(node->direita);
             COUNT_VISIT();
             node->valor = temp->valor; COUNT_MOVE();
             node->quantidade = temp->quantidade; COUNT_MOVE();
-            // remover sucessor (uma cópia)
+            // remover o nó sucessor (todas as ocorrências já foram copiadas para node)
+            temp->quantidade = 1; COUNT_MOVE();
             node->direita = avl_remover_rec(a, node->direita, temp->valor, removed);
             if (node->direita) node->direita->pai = node, COUNT_MOVE();
         }
@@ -261,6 +444,7 @@ static No1* avl_remover_rec(Arvore1* a, No1* node, int chave, int* removed) {
     // atualizar altura
     node->altura = 1 + max(altura_no(node->esquerda), altura_no(node->direita));
     COUNT_HEIGHT();
+    avl_tam_atualizar(node);
 
     // balance
     int fb = fator_balanceamento(node);
@@ -291,11 +475,517 @@ static No1* avl_remover_rec(Arvore1* a, No1* node, int chave, int* removed) {
 
 int avl_remover_chave(Arvore1* a, int chave) {
     int removed = 0;
+    a->maximo = NULL;   /* a remoção pode copiar/liberar o nó máximo */
     a->raiz = avl_remover_rec(a, a->raiz, chave, &removed);
     if (a->raiz) a->raiz->pai = NULL, COUNT_MOVE();
     return removed;
 }
 
+/* --------------------------------------------------
+   Lotes ordenados com busca a partir de um dedo
+   O lote é ordenado e cada chave parte do nó tocado pela anterior: sobe pelos
+   pais só até a subárvore cujo intervalo contém a chave e desce dali. Inserção
+   e remoção física são feitas no nó e o rebalanceamento sobe pelos pais.
+   -------------------------------------------------- */
+
+/* o lote é ordenado com o radix sort de Ordenacao_mod.c */
+#include "Ordenacao_mod.c"
+
+/* sobe do dedo até o primeiro ancestral cuja subárvore contém a chave */
+static No1* avl_dedo_subir(No1* x, int chave) {
+    if (chave >= x->valor) {
+        while (x->pai && !(x == x->pai->esquerda && chave < x->pai->valor)) { COUNT_VISIT(); x = x->pai; }
+    } else {
+        while (x->pai && !(x == x->pai->direita && chave > x->pai->valor)) { COUNT_VISIT(); x = x->pai; }
+    }
+    return x;
+}
+
+/* desce de x; devolve o nó da chave (*achou = 1) ou o pai onde ela entraria */
+static No1* avl_descer(No1* x, int chave, int* achou) {
+    No1* pai = NULL;
+    *achou = 0;
+    while (x) {
+        COUNT_VISIT();
+        if (chave == x->valor) { *achou = 1; return x; }
+        pai = x;
+        x = (chave < x->valor) ? x->esquerda : x->direita;
+    }
+    return pai;
+}
+
+/* atualiza alturas e rotaciona de x até a raiz; quando a altura da subárvore
+   não muda, daí para cima só os tamanhos */
+static void avl_retracar(Arvore1* a, No1* x) {
+    while (x) {
+        int antes = x->altura;
+        x->altura = 1 + max(altura_no(x->esquerda), altura_no(x->direita));
+        COUNT_HEIGHT();
+        avl_tam_atualizar(x);
+        int fb = fator_balanceamento(x);
+        if (fb > 1) {
+            if (fator_balanceamento(x->esquerda) < 0) rotacao_esq(a, x->esquerda);
+            x = rotacao_dir(a, x);
+        } else if (fb < -1) {
+            if (fator_balanceamento(x->direita) > 0) rotacao_dir(a, x->direita);
+            x = rotacao_esq(a, x);
+        }
+        if (x->altura == antes) { avl_tam_subir(x->pai); break; }
+        x = x->pai;
+    }
+}
+
+/* insere a partir do dedo; devolve o nó da chave (próximo dedo) */
+static No1* avl_inserir_dedo(Arvore1* a, No1* dedo, int chave) {
+    if (!a->raiz) {
+        a->raiz = novo_no_avl(chave, NULL); COUNT_MOVE();
+        return a->raiz;
+    }
+    int achou;
+    No1* x = avl_descer(dedo ? avl_dedo_subir(dedo, chave) : a->raiz, chave, &achou);
+    if (achou) {
+        x->quantidade++; COUNT_MOVE();
+        avl_tam_subir(x);
+        return x;
+    }
+    No1* z = novo_no_avl(chave, x);
+    if (chave < x->valor) x->esquerda = z;
+    else x->direita = z;
+    COUNT_MOVE();
+    avl_retracar(a, x);
+    return z;
+}
+
+/* remove uma ocorrência a partir do dedo; devolve um nó que continua na árvore */
+static No1* avl_remover_dedo(Arvore1* a, No1* dedo, int chave, int* removido) {
+    int achou;
+    No1* z = avl_descer(dedo ? avl_dedo_subir(dedo, chave) : a->raiz, chave, &achou);
+    *removido = achou;
+    if (!achou) return z;
+    if (z->quantidade > 1) {
+        z->quantidade--; COUNT_MOVE();
+        avl_tam_subir(z);
+        return z;
+    }
+    /* dois filhos: o sucessor sobe para z e é ele que sai fisicamente */
+    No1* y = z;
+    if (z->esquerda && z->direita) {
+        y = avl_minimo(z->direita);
+        z->valor = y->valor; COUNT_MOVE();
+        z->quantidade = y->quantidade; COUNT_MOVE();
+    }
+    No1* filho = y->esquerda ? y->esquerda : y->direita;
+    No1* p = y->pai;
+    if (filho) { filho->pai = p; COUNT_MOVE(); }
+    if (!p) a->raiz = filho;
+    else if (y == p->esquerda) p->esquerda = filho;
+    else p->direita = filho;
+    COUNT_MOVE();
+    COUNT_FREEF(); arena_liberar(&AVL_ARENA, y);
+    avl_retracar(a, p);
+    return p ? p : a->raiz;
+}
+
+void avl_inserir_lote(Arvore1* a, const int* chaves, int n) {
+    if (!a || !chaves || n <= 0) return;
+    a->maximo = NULL;
+    int* v = ordenacao_radix(chaves, n, 1, NULL);
+    No1* dedo = NULL;
+    for (int i = 0; i < n; i++) dedo = avl_inserir_dedo(a, dedo, v[i]);
+    free(v);
+}
+
+int avl_remover_lote(Arvore1* a, const int* chaves, int n) {
+    if (!a || !chaves || n <= 0) return 0;
+    a->maximo = NULL;
+    int* v = ordenacao_radix(chaves, n, 1, NULL);
+    No1* dedo = NULL;
+    int removidos = 0;
+    for (int i = 0; i < n && a->raiz; i++) {
+        int r;
+        dedo = avl_remover_dedo(a, dedo, v[i], &r);
+        removidos += r;
+    }
+    free(v);
+    return removidos;
+}
+
+/* --------------------------------------------------
+   Anexação de chaves crescentes (timestamps etc.)
+   O nó máximo fica em cache: uma chave >= máximo vira filho direito dele e o
+   rebalanceamento sobe só enquanto a altura muda (O(1) amortizado numa
+   sequência crescente). Com AVL_TAMANHO os tamanhos sobem até a raiz e a
+   anexação passa a O(log n). Chave menor cai em avl_inserir.
+   -------------------------------------------------- */
+
+static No1* avl_maximo(Arvore1* a) {
+    if (!a->maximo && a->raiz) {
+        No1* x = a->raiz;
+        while (x->direita) { COUNT_VISIT(); x = x->direita; }
+        a->maximo = x;
+    }
+    return a->maximo;
+}
+
+void avl_anexar(Arvore1* a, int chave) {
+    if (!a) return;
+    No1* m = avl_maximo(a);
+    if (!m) {
+        a->raiz = novo_no_avl(chave, NULL); COUNT_MOVE();
+        a->maximo = a->raiz;
+        return;
+    }
+    COUNT_VISIT();
+    if (chave < m->valor) { avl_inserir(a, chave); return; }
+    if (chave == m->valor) { m->quantidade++; COUNT_MOVE(); avl_tam_subir(m); return; }
+    No1* z = novo_no_avl(chave, m);
+    m->direita = z; COUNT_MOVE();
+    avl_retracar(a, m);
+    a->maximo = z;
+}
+
+/* --------------------------------------------------
+   Remoção de intervalo por split/join
+   join(l, k, r): desce a espinha da subárvore mais alta até a altura da
+   outra, pendura k ali e rebalanceia para cima (O(diferença de alturas)).
+   split(t, k): separa t em (< k), nó de k e (> k), reaproveitando os nós do
+   caminho como chave dos joins (O(log n) no total).
+   avl_remover_intervalo separa [lo, hi], libera o meio inteiro e junta as
+   pontas: O(log n + k). O join rebalanceia dentro de uma Arvore1 local (as
+   rotações e avl_retracar atualizam a raiz dela), então split/join não tocam a
+   árvore do chamador e podem rodar em paralelo em subárvores disjuntas.
+   Faixas com até AVL_INTERVALO_CURTO nós saem uma a uma pelo dedo: o split/join
+   custa algumas descidas completas e perde para remoções avulsas com k pequeno.
+   -------------------------------------------------- */
+
+#define AVL_INTERVALO_CURTO 8
+
+static No1* avl_join(No1* l, No1* k, No1* r) {
+    Arvore1 sub = { NULL, NULL };
+    int hl = altura_no(l), hr = altura_no(r);
+    if (hl > hr + 1) {
+        No1* p = NULL;
+        No1* c = l;
+        while (c && altura_no(c) > hr + 1) { COUNT_VISIT(); p = c; c = c->direita; }
+        k->esquerda = c; COUNT_MOVE();
+        k->direita = r; COUNT_MOVE();
+        if (c) c->pai = k;
+        if (r) r->pai = k;
+        k->altura = 1 + max(altura_no(c), hr); COUNT_HEIGHT();
+        avl_tam_atualizar(k);
+        k->pai = p; p->direita = k; COUNT_MOVE();
+        l->pai = NULL;
+        sub.raiz = l;
+        avl_retracar(&sub, p);
+        return sub.raiz;
+    }
+    if (hr > hl + 1) {
+        No1* p = NULL;
+        No1* c = r;
+        while (c && altura_no(c) > hl + 1) { COUNT_VISIT(); p = c; c = c->esquerda; }
+        k->esquerda = l; COUNT_MOVE();
+        k->direita = c; COUNT_MOVE();
+        if (l) l->pai = k;
+        if (c) c->pai = k;
+        k->altura = 1 + max(hl, altura_no(c)); COUNT_HEIGHT();
+        avl_tam_atualizar(k);
+        k->pai = p; p->esquerda = k; COUNT_MOVE();
+        r->pai = NULL;
+        sub.raiz = r;
+        avl_retracar(&sub, p);
+        return sub.raiz;
+    }
+    k->esquerda = l; COUNT_MOVE();
+    k->direita = r; COUNT_MOVE();
+    k->pai = NULL;
+    if (l) l->pai = k;
+    if (r) r->pai = k;
+    k->altura = 1 + max(hl, hr); COUNT_HEIGHT();
+    avl_tam_atualizar(k);
+    return k;
+}
+
+static void avl_split(No1* t, int chave, No1** menor, No1** igual, No1** maior) {
+    if (!t) { *menor = *igual = *maior = NULL; return; }
+    COUNT_VISIT();
+    No1* l = t->esquerda;
+    No1* r = t->direita;
+    if (l) l->pai = NULL;
+    if (r) r->pai = NULL;
+    t->esquerda = t->direita = NULL; COUNT_MOVE();
+    if (chave == t->valor) {
+        *menor = l; *igual = t; *maior = r;
+    } else if (chave < t->valor) {
+        No1* lr;
+        avl_split(l, chave, menor, igual, &lr);
+        *maior = avl_join(lr, t, r);
+    } else {
+        No1* rl;
+        avl_split(r, chave, &rl, igual, maior);
+        *menor = avl_join(l, t, rl);
+    }
+}
+
+/* junta l e r (todas as chaves de l < r) usando o máximo de l como chave do meio */
+static No1* avl_join2(No1* l, No1* r) {
+    if (!l) return r;
+    if (!r) return l;
+    No1* m = l;
+    while (m->direita) { COUNT_VISIT(); m = m->direita; }
+    No1 *l2, *meio, *vazio;
+    avl_split(l, m->valor, &l2, &meio, &vazio);
+    return avl_join(l2, meio, r);
+}
+
+/* libera a subárvore; retorna o número de ocorrências removidas */
+static long avl_descartar(No1* x) {
+    if (!x) return 0;
+    long c = x->quantidade + avl_descartar(x->esquerda) + avl_descartar(x->direita);
+    COUNT_FREEF(); arena_liberar(&AVL_ARENA, x);
+    return c;
+}
+
+static No1* avl_sucessor(No1* x) {
+    if (x->direita) return avl_minimo(x->direita);
+    while (x->pai && x == x->pai->direita) { COUNT_VISIT(); x = x->pai; }
+    return x->pai;
+}
+
+long avl_remover_intervalo(Arvore1* a, int lo, int hi) {
+    if (!a || !a->raiz || lo > hi) return 0;
+    a->maximo = NULL;
+
+    No1* z = NULL;
+    for (No1* x = a->raiz; x; ) {
+        COUNT_VISIT();
+        if (x->valor >= lo) { z = x; x = x->esquerda; }
+        else x = x->direita;
+    }
+    No1* curtos[AVL_INTERVALO_CURTO];
+    int nc = 0;
+    while (z && z->valor <= hi && nc < AVL_INTERVALO_CURTO) {
+        curtos[nc++] = z;
+        z = avl_sucessor(z);
+    }
+    if (!z || z->valor > hi) {
+        long removidos = 0;
+        int valores[AVL_INTERVALO_CURTO];
+        for (int i = 0; i < nc; i++) {
+            removidos += curtos[i]->quantidade;
+            if (curtos[i]->quantidade > 1) {
+                curtos[i]->quantidade = 1; COUNT_MOVE();
+                avl_tam_subir(curtos[i]);
+            }
+            valores[i] = curtos[i]->valor;
+        }
+        No1* dedo = NULL;
+        int removido;
+        for (int i = 0; i < nc; i++) dedo = avl_remover_dedo(a, dedo, valores[i], &removido);
+        return removidos;
+    }
+
+    No1 *l, *m1, *resto, *meio, *m2, *r;
+    avl_split(a->raiz, lo, &l, &m1, &resto);
+    avl_split(resto, hi, &meio, &m2, &r);
+    long removidos = avl_descartar(m1) + avl_descartar(meio) + avl_descartar(m2);
+    a->raiz = avl_join2(l, r);
+    if (a->raiz) a->raiz->pai = NULL;
+    return removidos;
+}
+
+/* --------------------------------------------------
+   Operações de conjunto por split/join (união, interseção, diferença)
+   op(t1, t2): separa t2 (ou t1) pela chave da raiz de t1 (ou t2), resolve as
+   duas metades independentes e junta com a raiz no meio. Trabalho
+   O(m log(n/m + 1)), m = menor tamanho; profundidade O(log n · log m).
+   As duas metades rodam em paralelo num pool fork-join enquanto a subárvore
+   tiver altura >= AVL_GRAO_ALTURA; abaixo disso o custo de criar a tarefa
+   passa o da própria recursão.
+   -------------------------------------------------- */
+
+#define AVL_GRAO_ALTURA 14
+#define AVL_MAX_THREADS 64
+
+/* pool fork-join: pilha de tarefas + trabalhadores; quem espera um join executa
+   tarefas pendentes (inclusive a sua) em vez de bloquear */
+typedef struct TarefaAVL {
+    void (*f)(void*);
+    void* arg;
+    atomic_int feita;
+    long contas[7];               // contadores da tarefa, somados por quem a criou
+    struct TarefaAVL* prox;
+} TarefaAVL;
+
+static pthread_mutex_t AVL_POOL_TRAVA = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t AVL_POOL_SINAL = PTHREAD_COND_INITIALIZER;
+static TarefaAVL* AVL_POOL_PILHA = NULL;
+static int AVL_POOL_THREADS = 1;      // incluindo a que chama
+static int AVL_POOL_INICIADAS = 0;    // trabalhadores criados
+
+static void avl_tarefa_executar(TarefaAVL* t) {
+    long salvo[7] = { AVL_COUNT_VISIT, AVL_COUNT_MOVE, AVL_COUNT_HEIGHT, AVL_COUNT_ROT, AVL_COUNT_ALLOC, AVL_COUNT_FREE, AVL_COUNT_TAMANHO };
+    AVL_COUNT_VISIT = AVL_COUNT_MOVE = AVL_COUNT_HEIGHT = AVL_COUNT_ROT = AVL_COUNT_ALLOC = AVL_COUNT_FREE = AVL_COUNT_TAMANHO = 0;
+    t->f(t->arg);
+    t->contas[0] = AVL_COUNT_VISIT; t->contas[1] = AVL_COUNT_MOVE; t->contas[2] = AVL_COUNT_HEIGHT;
+    t->contas[3] = AVL_COUNT_ROT; t->contas[4] = AVL_COUNT_ALLOC; t->contas[5] = AVL_COUNT_FREE;
+    t->contas[6] = AVL_COUNT_TAMANHO;
+    AVL_COUNT_VISIT = salvo[0]; AVL_COUNT_MOVE = salvo[1]; AVL_COUNT_HEIGHT = salvo[2];
+    AVL_COUNT_ROT = salvo[3]; AVL_COUNT_ALLOC = salvo[4]; AVL_COUNT_FREE = salvo[5];
+    AVL_COUNT_TAMANHO = salvo[6];
+    atomic_store_explicit(&t->feita, 1, memory_order_release);
+}
+
+static TarefaAVL* avl_pool_tirar() {
+    pthread_mutex_lock(&AVL_POOL_TRAVA);
+    TarefaAVL* t = AVL_POOL_PILHA;
+    if (t) AVL_POOL_PILHA = t->prox;
+    pthread_mutex_unlock(&AVL_POOL_TRAVA);
+    return t;
+}
+
+static void* avl_pool_trabalhador(void* x) {
+    (void) x;
+    for (;;) {
+        pthread_mutex_lock(&AVL_POOL_TRAVA);
+        while (!AVL_POOL_PILHA) pthread_cond_wait(&AVL_POOL_SINAL, &AVL_POOL_TRAVA);
+        TarefaAVL* t = AVL_POOL_PILHA;
+        AVL_POOL_PILHA = t->prox;
+        pthread_mutex_unlock(&AVL_POOL_TRAVA);
+        avl_tarefa_executar(t);
+    }
+    return NULL;
+}
+
+/* trabalhadores são criados sob demanda e ficam até o fim do processo */
+void avl_definir_threads(int n) {
+    if (n < 1) n = 1;
+    if (n > AVL_MAX_THREADS) n = AVL_MAX_THREADS;
+    pthread_mutex_lock(&AVL_POOL_TRAVA);
+    while (AVL_POOL_INICIADAS < n - 1) {
+        pthread_t id;
+        if (pthread_create(&id, NULL, avl_pool_trabalhador, NULL) != 0) break;
+        pthread_detach(id);
+        AVL_POOL_INICIADAS++;
+    }
+    AVL_POOL_THREADS = AVL_POOL_INICIADAS + 1 < n ? AVL_POOL_INICIADAS + 1 : n;
+    pthread_mutex_unlock(&AVL_POOL_TRAVA);
+}
+
+/* executa f(a) e g(b); g vai para o pool se houver threads */
+static void avl_em_paralelo(void (*f)(void*), void* a, void (*g)(void*), void* b) {
+    if (AVL_POOL_THREADS < 2) { f(a); g(b); return; }
+    TarefaAVL t;
+    t.f = g;
+    t.arg = b;
+    atomic_init(&t.feita, 0);
+    pthread_mutex_lock(&AVL_POOL_TRAVA);
+    t.prox = AVL_POOL_PILHA;
+    AVL_POOL_PILHA = &t;
+    pthread_cond_signal(&AVL_POOL_SINAL);
+    pthread_mutex_unlock(&AVL_POOL_TRAVA);
+    f(a);
+    while (!atomic_load_explicit(&t.feita, memory_order_acquire)) {
+        TarefaAVL* o = avl_pool_tirar();
+        if (o) avl_tarefa_executar(o);
+        else sched_yield();
+    }
+    AVL_COUNT_VISIT += t.contas[0]; AVL_COUNT_MOVE += t.contas[1]; AVL_COUNT_HEIGHT += t.contas[2];
+    AVL_COUNT_ROT += t.contas[3]; AVL_COUNT_ALLOC += t.contas[4]; AVL_COUNT_FREE += t.contas[5];
+    AVL_COUNT_TAMANHO += t.contas[6];
+}
+
+enum { AVL_UNIAO, AVL_INTERSECAO, AVL_DIFERENCA };
+
+typedef struct {
+    int op;
+    No1* t1;
+    No1* t2;
+    No1* r;
+} ConjuntoAVL;
+
+static No1* avl_conjunto_rec(int op, No1* t1, No1* t2);
+
+static void avl_conjunto_tarefa(void* x) {
+    ConjuntoAVL* c = (ConjuntoAVL*) x;
+    c->r = avl_conjunto_rec(c->op, c->t1, c->t2);
+}
+
+/* resolve as duas metades, em paralelo se a subárvore é grande */
+static void avl_conjunto_metades(ConjuntoAVL* e, ConjuntoAVL* d, int altura) {
+    if (altura >= AVL_GRAO_ALTURA) {
+        avl_em_paralelo(avl_conjunto_tarefa, e, avl_conjunto_tarefa, d);
+    } else {
+        avl_conjunto_tarefa(e);
+        avl_conjunto_tarefa(d);
+    }
+}
+
+static void avl_soltar_filhos(No1* x, No1** l, No1** r) {
+    *l = x->esquerda;
+    *r = x->direita;
+    if (*l) (*l)->pai = NULL;
+    if (*r) (*r)->pai = NULL;
+    x->esquerda = x->direita = NULL; COUNT_MOVE();
+}
+
+static No1* avl_conjunto_rec(int op, No1* t1, No1* t2) {
+    if (!t1) {
+        if (op == AVL_UNIAO) return t2;
+        avl_descartar(t2);
+        return NULL;
+    }
+    if (!t2) {
+        if (op != AVL_INTERSECAO) return t1;
+        avl_descartar(t1);
+        return NULL;
+    }
+    COUNT_VISIT();
+    ConjuntoAVL e = { op, NULL, NULL, NULL };
+    ConjuntoAVL d = { op, NULL, NULL, NULL };
+    No1* m;
+    if (op == AVL_UNIAO) {
+        /* a raiz de t1 fica; t2 é separado pela chave dela */
+        int h = altura_no(t1);
+        avl_soltar_filhos(t1, &e.t1, &d.t1);
+        avl_split(t2, t1->valor, &e.t2, &m, &d.t2);
+        if (m) {
+            t1->quantidade += m->quantidade; COUNT_MOVE();
+            COUNT_FREEF(); arena_liberar(&AVL_ARENA, m);
+        }
+        avl_conjunto_metades(&e, &d, h);
+        return avl_join(e.r, t1, d.r);
+    }
+    /* interseção / diferença: o resultado só tem nós de t1, separado pela raiz de t2 */
+    int h = altura_no(t2);
+    int q2 = t2->quantidade;
+    avl_soltar_filhos(t2, &e.t2, &d.t2);
+    avl_split(t1, t2->valor, &e.t1, &m, &d.t1);
+    COUNT_FREEF(); arena_liberar(&AVL_ARENA, t2);
+    avl_conjunto_metades(&e, &d, h);
+    if (m) {
+        int q = (op == AVL_INTERSECAO) ? (m->quantidade < q2 ? m->quantidade : q2) : m->quantidade - q2;
+        if (q > 0) {
+            m->quantidade = q; COUNT_MOVE();
+            return avl_join(e.r, m, d.r);
+        }
+        COUNT_FREEF(); arena_liberar(&AVL_ARENA, m);
+    }
+    return avl_join2(e.r, d.r);
+}
+
+static void avl_conjunto(int op, Arvore1* a, Arvore1* b) {
+    if (!a || !b || a == b) return;
+    a->raiz = avl_conjunto_rec(op, a->raiz, b->raiz);
+    if (a->raiz) a->raiz->pai = NULL;
+    a->maximo = NULL;
+    b->raiz = NULL;
+    b->maximo = NULL;
+}
+
+void avl_uniao(Arvore1* a, Arvore1* b) { avl_conjunto(AVL_UNIAO, a, b); }
+void avl_intersecao(Arvore1* a, Arvore1* b) { avl_conjunto(AVL_INTERSECAO, a, b); }
+void avl_diferenca(Arvore1* a, Arvore1* b) { avl_conjunto(AVL_DIFERENCA, a, b); }
+
 /* Esvaziar a árvore removendo nodos um a um (usado para medir custo real de remoção) */
 void avl_remover_tudo(Arvore1* a) {
     if (!a) return;
@@ -306,7 +996,7 @@ void avl_remover_tudo(Arvore1* a) {
     No1** stack = (No1**) malloc(sizeof(No1*) * 1024);
     int top = 0;
     No1* cur = a->raiz;
-    while ((cur != NULL)) {
+    while (cur != NULL || top > 0) {
         while (cur) {
             if (top % 1024 == 0) {
                 ;
@@ -331,3 +1021,233 @@ void avl_remover_tudo(Arvore1* a) {
     }
     free(vals);
 }
+
+/* --------------------------------------------------
+   Serialização (pré-ordem, sem ponteiros) e carga via mmap
+   Arquivo: CabecalhoAVL + n registros em pré-ordem. O filho esquerdo do
+   registro i (se existe) é o registro i+1; o direito é o índice em 'direita'.
+   -------------------------------------------------- */
+
+#define AVL_MAGICA  0x314C5641u   /* "AVL1" */
+#define AVL_TEM_ESQ 1             /* bit 0 de info; altura nos bits 1.. */
+
+typedef struct {
+    uint32_t magica;
+    uint32_t tam_registro;
+    uint64_t n;
+} CabecalhoAVL;
+
+typedef struct {
+    int32_t valor;
+    int32_t quantidade;
+    int32_t direita;      // índice do filho direito (-1 = nenhum)
+    int32_t info;
+} RegistroAVL;
+
+typedef struct arvoreMapeadaAVL {
+    void* base;
+    size_t tamanho;
+    const RegistroAVL* r;
+    uint64_t n;
+} ArvoreMapeadaAVL;
+
+/* pilha de nós (ou índices) pendentes; cresce sob demanda */
+typedef struct {
+    No1** no;
+    int64_t* idx;
+    int topo, cap;
+} PilhaSerAVL;
+
+static void avl_pilha_push(PilhaSerAVL* p, No1* no, int64_t idx) {
+    if (p->topo == p->cap) {
+        p->cap = p->cap ? 2 * p->cap : 64;
+        p->no = (No1**) realloc(p->no, sizeof(No1*) * p->cap);
+        p->idx = (int64_t*) realloc(p->idx, sizeof(int64_t) * p->cap);
+    }
+    p->no[p->topo] = no;
+    p->idx[p->topo] = idx;
+    p->topo++;
+}
+
+/* 0 = ok, -1 = erro de E/S */
+int avl_salvar(Arvore1* a, const char* caminho) {
+    PilhaSerAVL p = { NULL, NULL, 0, 0 };
+    uint64_t n = 0;
+    No1* cur = a->raiz;
+    while (cur || p.topo) {
+        if (!cur) cur = p.no[--p.topo];
+        n++;
+        if (cur->direita) avl_pilha_push(&p, cur->direita, 0);
+        cur = cur->esquerda;
+    }
+
+    size_t tamanho = sizeof(CabecalhoAVL) + n * sizeof(RegistroAVL);
+    int fd = open(caminho, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t) tamanho) != 0) {
+        if (fd >= 0) close(fd);
+        free(p.no); free(p.idx);
+        return -1;
+    }
+    void* base = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        free(p.no); free(p.idx);
+        return -1;
+    }
+    CabecalhoAVL* c = (CabecalhoAVL*) base;
+    c->magica = AVL_MAGICA;
+    c->tam_registro = sizeof(RegistroAVL);
+    c->n = n;
+    RegistroAVL* r = (RegistroAVL*) (c + 1);
+
+    /* pré-ordem: ao desempilhar o filho direito, corrige o índice no pai */
+    int64_t i = 0;
+    cur = a->raiz;
+    while (cur || p.topo) {
+        if (!cur) {
+            p.topo--;
+            cur = p.no[p.topo];
+            r[p.idx[p.topo]].direita = (int32_t) i;
+        }
+        r[i].valor = cur->valor;
+        r[i].quantidade = cur->quantidade;
+        r[i].direita = -1;
+        r[i].info = (cur->altura << 1) | (cur->esquerda ? AVL_TEM_ESQ : 0);
+        if (cur->direita) avl_pilha_push(&p, cur->direita, i);
+        i++;
+        cur = cur->esquerda;
+    }
+    free(p.no); free(p.idx);
+    return munmap(base, tamanho);
+}
+
+static void* avl_abrir_mapa(const char* caminho, size_t* tamanho, uint64_t* n) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(CabecalhoAVL)) {
+        close(fd);
+        return NULL;
+    }
+    void* base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+    const CabecalhoAVL* c = (const CabecalhoAVL*) base;
+    if (c->magica != AVL_MAGICA || c->tam_registro != sizeof(RegistroAVL) ||
+        (size_t) st.st_size < sizeof(CabecalhoAVL) + c->n * sizeof(RegistroAVL)) {
+        munmap(base, (size_t) st.st_size);
+        return NULL;
+    }
+    *tamanho = (size_t) st.st_size;
+    *n = c->n;
+    return base;
+}
+
+/* o arquivo não guarda tamanhos: recalculados em pós-ordem depois da carga */
+static void avl_tam_calcular(No1* x) {
+    if (!x) return;
+    avl_tam_calcular(x->esquerda);
+    avl_tam_calcular(x->direita);
+    avl_tam_atualizar(x);
+}
+
+/* libera os nós de uma carga interrompida (sem recursão nem remoções) */
+static void avl_liberar_nos(No1* raiz) {
+    PilhaSerAVL p = { NULL, NULL, 0, 0 };
+    if (raiz) avl_pilha_push(&p, raiz, 0);
+    while (p.topo > 0) {
+        No1* x = p.no[--p.topo];
+        if (x->esquerda) avl_pilha_push(&p, x->esquerda, 0);
+        if (x->direita) avl_pilha_push(&p, x->direita, 0);
+        arena_liberar(&AVL_ARENA, x); COUNT_FREEF();
+    }
+    free(p.no); free(p.idx);
+}
+
+/* reconstrói a árvore de ponteiros numa passada linear sobre o arquivo mapeado;
+   NULL se o arquivo não é uma árvore válida */
+Arvore1* avl_carregar(const char* caminho) {
+    size_t tamanho;
+    uint64_t n;
+    void* base = avl_abrir_mapa(caminho, &tamanho, &n);
+    if (!base) return NULL;
+    madvise(base, tamanho, MADV_SEQUENTIAL);
+    const RegistroAVL* r = (const RegistroAVL*) ((const CabecalhoAVL*) base + 1);
+
+    Arvore1* a = avl_criar();
+    PilhaSerAVL p = { NULL, NULL, 0, 0 };  /* nós que ainda esperam o filho direito */
+    No1* ant = NULL;
+    int ant_tem_esq = 0, corrompido = 0;
+    for (uint64_t i = 0; i < n && !corrompido; i++) {
+        No1* x = novo_no_avl(r[i].valor, NULL);
+        x->quantidade = r[i].quantidade;
+        x->altura = r[i].info >> 1;
+        if (!ant) {
+            a->raiz = x;
+        } else if (ant_tem_esq) {
+            ant->esquerda = x;
+            x->pai = ant; COUNT_MOVE();
+        } else if (p.topo > 0) {
+            No1* pai = p.no[--p.topo];
+            pai->direita = x;
+            x->pai = pai; COUNT_MOVE();
+        } else {
+            arena_liberar(&AVL_ARENA, x); COUNT_FREEF();
+            corrompido = 1;
+            continue;
+        }
+        if (r[i].direita >= 0) avl_pilha_push(&p, x, 0);
+        ant = x;
+        ant_tem_esq = r[i].info & AVL_TEM_ESQ;
+    }
+    /* sobrou filho anunciado e não gravado: arquivo truncado */
+    if (ant_tem_esq || p.topo > 0) corrompido = 1;
+    free(p.no); free(p.idx);
+    munmap(base, tamanho);
+    if (corrompido) {
+        fprintf(stderr, "avl_carregar: arquivo corrompido (%s)\n", caminho);
+        avl_liberar_nos(a->raiz);
+        free(a);
+        return NULL;
+    }
+    if (AVL_TAMANHO) avl_tam_calcular(a->raiz);
+    return a;
+}
+
+/* usa o arquivo mapeado diretamente como árvore somente leitura */
+ArvoreMapeadaAVL* avl_mapear(const char* caminho) {
+    ArvoreMapeadaAVL* m = (ArvoreMapeadaAVL*) malloc(sizeof(ArvoreMapeadaAVL));
+    m->base = avl_abrir_mapa(caminho, &m->tamanho, &m->n);
+    if (!m->base) {
+        free(m);
+        return NULL;
+    }
+    m->r = (const RegistroAVL*) ((const CabecalhoAVL*) m->base + 1);
+    return m;
+}
+
+/* os índices do arquivo são conferidos a cada passo (o mapa não é lido
+   inteiro ao abrir): em pré-ordem os dois filhos vêm depois do pai, então
+   i cresce sempre e um arquivo corrompido não sai de [0, n) nem dá laço */
+int avl_mapa_buscar(ArvoreMapeadaAVL* m, int chave) {
+    if (!m || m->n == 0) return 0;
+    int64_t i = 0;
+    for (;;) {
+        const RegistroAVL* x = &m->r[i];
+        COUNT_VISIT();
+        if (chave == x->valor) return 1;
+        if (chave < x->valor) {
+            if (!(x->info & AVL_TEM_ESQ) || (uint64_t) (i + 1) >= m->n) return 0;
+            i++;
+        } else {
+            if (x->direita <= i || (uint64_t) x->direita >= m->n) return 0;
+            i = x->direita;
+        }
+    }
+}
+
+void avl_mapa_fechar(ArvoreMapeadaAVL* m) {
+    if (!m) return;
+    munmap(m->base, m->tamanho);
+    free(m);
+}
@@ -0,0 +1,444 @@
+// Arena de nós com páginas grandes (2 MiB) e política NUMA opcional.
+// Não é compilado à parte: AVL_mod.c, RubroNegra_mod.c e B_mod.c fazem
+// #include "Arena_mod.c" e cada um tem a sua arena (tudo aqui é static).
+//
+// Com a arena desligada (padrão) arena_alocar é malloc. Ligada, os nós saem
+// de blocos de 2 MiB obtidos com mmap e alinhados em 2 MiB, cada bloco com
+// objetos de um tamanho só e lista de livres própria. Modos:
+//   ARENA_PAGINAS: páginas normais (4 KiB); só agrupa os nós
+//   ARENA_THP:     madvise(MADV_HUGEPAGE) (páginas grandes transparentes)
+//   ARENA_HUGETLB: MAP_HUGETLB (páginas reservadas em /proc/sys/vm/nr_hugepages);
+//                  sem páginas reservadas cai para ARENA_THP
+// NUMA (mbind nos blocos novos): ARENA_NUMA_INTERCALADO espalha as páginas
+// pelos nós permitidos; ARENA_NUMA_LOCAL põe cada página no nó da thread que
+// a toca primeiro. Com um nó só (ou sem mbind) a política é ignorada.
+//
+// O cabeçalho do bloco fica no início dele: o dono de um objeto é o ponteiro
+// com os 21 bits baixos zerados. Um mapa de dois níveis das páginas de 2 MiB
+// (lido sem trava) diz se o endereço é de um bloco da arena, então
+// arena_liberar aceita também ponteiros de malloc (os nós criados antes de
+// ligar a arena, ou quando a arena não conseguiu um bloco) e chama free neles
+// sem procurar nada.
+//
+// Cada thread tem um cache de objetos livres por tamanho: alocar e liberar
+// mexem só nele. A trava da arena só é pega para encher o cache com um lote
+// (ARENA_LOTE objetos) ou devolver um lote quando ele passa de 2 lotes, e
+// quando a thread termina (destrutor de pthread_key). Objetos no cache contam
+// como vivos no bloco.
+// arena_reservar e arena_devolver são as versões sem malloc/free (NULL / 0
+// fora da arena). Um bloco sem nós vivos é devolvido ao sistema, a menos que
+// seja o bloco em uso do seu tamanho. Trocar o modo só com o módulo parado
+// (sem outras threads alocando); os nós já alocados continuam válidos, e os
+// caches das outras threads são esvaziados no próximo uso.
+
+#ifndef ARENA_MOD_C
+#define ARENA_MOD_C
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <pthread.h>
+
+#define ARENA_DESLIGADA 0
+#define ARENA_PAGINAS   1
+#define ARENA_THP       2
+#define ARENA_HUGETLB   3
+
+#define ARENA_NUMA_NENHUM      0
+#define ARENA_NUMA_INTERCALADO 1
+#define ARENA_NUMA_LOCAL       2
+
+#define ARENA_PAGINA_GRANDE (2UL << 20)
+#define ARENA_BLOCO         ARENA_PAGINA_GRANDE   // tamanho e alinhamento de cada bloco
+#define ARENA_CAB           64                    // cabeçalho no início do bloco
+#define ARENA_MAX_CLASSES   16
+#define ARENA_LOTE          64                    // objetos por troca cache <-> blocos
+
+// mapa de blocos: endereços de 48 bits = 15 bits de raiz + 12 de folha + 21 do bloco
+#define ARENA_MAPA_RAIZ  (1UL << 15)
+#define ARENA_MAPA_FOLHA (1UL << 12)
+
+// políticas de mbind (linux/mempolicy.h)
+#define ARENA_MPOL_INTERLEAVE 3
+#define ARENA_MPOL_LOCAL      4
+#define ARENA_MPOL_F_MEMS_ALLOWED (1 << 2)
+
+typedef struct BlocoArena {
+    struct BlocoArena* ant;   // lista de blocos da arena
+    struct BlocoArena* prox;
+    char* topo;        // próxima posição nunca usada
+    char* fim;
+    void* livres;      // objetos devolvidos a este bloco
+    long vivos;        // objetos fora do bloco (em uso ou em algum cache)
+    int classe;
+    int modo;
+} BlocoArena;
+
+typedef struct {
+    pthread_mutex_t trava;
+    int modo;            // pedido
+    int numa;
+    int modo_efetivo;    // depois das quedas (HUGETLB -> THP -> PAGINAS)
+    int numa_efetivo;
+    int geracao;         // muda a cada arena_definir (invalida os caches)
+    int nblocos;
+    int nclasses;
+    size_t classe_tam[ARENA_MAX_CLASSES];
+    BlocoArena* classe_atual[ARENA_MAX_CLASSES];   // bloco em uso (NULL = nenhum)
+    BlocoArena* blocos;
+    long bytes;          // mapeados
+    unsigned char* mapa[ARENA_MAPA_RAIZ];          // folhas: 1 = página de 2 MiB é um bloco
+} Arena;
+
+#define ARENA_INICIAL { .trava = PTHREAD_MUTEX_INITIALIZER }
+
+/* cache da thread (uma arena por módulo, então um cache por módulo) */
+typedef struct {
+    void* livres;
+    int n;
+} CacheClasse;
+
+typedef struct {
+    Arena* dono;
+    int geracao;
+    CacheClasse c[ARENA_MAX_CLASSES];
+} CacheArena;
+
+static _Thread_local CacheArena ARENA_CACHE_TL;
+static pthread_key_t ARENA_CHAVE;
+static pthread_once_t ARENA_UMA_VEZ = PTHREAD_ONCE_INIT;
+
+/* nós NUMA permitidos a este processo (máscara de até 64 nós); 0 se não der para saber */
+static unsigned long arena_nos_numa() {
+#ifdef SYS_get_mempolicy
+    unsigned long mascara = 0;
+    if (syscall(SYS_get_mempolicy, NULL, &mascara, 64UL, NULL, ARENA_MPOL_F_MEMS_ALLOWED) == 0)
+        return mascara;
+#endif
+    return 0;
+}
+
+static int arena_aplicar_numa(void* p, size_t tam, int numa) {
+#ifdef SYS_mbind
+    unsigned long mascara = arena_nos_numa();
+    if (numa == ARENA_NUMA_INTERCALADO && mascara)
+        return syscall(SYS_mbind, p, tam, ARENA_MPOL_INTERLEAVE, &mascara, 64UL, 0) == 0;
+    if (numa == ARENA_NUMA_LOCAL)
+        return syscall(SYS_mbind, p, tam, ARENA_MPOL_LOCAL, NULL, 0UL, 0) == 0;
+#else
+    (void) p; (void) tam; (void) numa;
+#endif
+    return 0;
+}
+
+static int arena_thp_disponivel() {
+    char linha[128] = "";
+    FILE* f = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (!f) return 0;
+    if (!fgets(linha, sizeof(linha), f)) linha[0] = 0;
+    fclose(f);
+    return strstr(linha, "[never]") == NULL && linha[0] != 0;
+}
+
+static int arena_hugetlb_disponivel() {
+#ifdef MAP_HUGETLB
+    void* p = mmap(NULL, ARENA_PAGINA_GRANDE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p == MAP_FAILED) return 0;
+    munmap(p, ARENA_PAGINA_GRANDE);
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/* bloco que contém p, ou NULL se p não é da arena (sem trava) */
+static BlocoArena* arena_bloco_de(Arena* a, const void* p) {
+    uintptr_t x = (uintptr_t) p;
+    if ((x >> 33) >= ARENA_MAPA_RAIZ) return NULL;
+    unsigned char* folha = __atomic_load_n(&a->mapa[x >> 33], __ATOMIC_ACQUIRE);
+    if (!folha || !__atomic_load_n(&folha[(x >> 21) & (ARENA_MAPA_FOLHA - 1)], __ATOMIC_ACQUIRE)) return NULL;
+    return (BlocoArena*) (x & ~(uintptr_t) (ARENA_BLOCO - 1));
+}
+
+/* marca/desmarca o bloco no mapa (com a trava); 0 se o endereço não cabe no mapa */
+static int arena_marcar(Arena* a, BlocoArena* b, unsigned char v) {
+    uintptr_t x = (uintptr_t) b;
+    if ((x >> 33) >= ARENA_MAPA_RAIZ) return 0;
+    unsigned char* folha = a->mapa[x >> 33];
+    if (!folha) {
+        folha = (unsigned char*) calloc(ARENA_MAPA_FOLHA, 1);
+        if (!folha) return 0;
+        __atomic_store_n(&a->mapa[x >> 33], folha, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&folha[(x >> 21) & (ARENA_MAPA_FOLHA - 1)], v, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/* desmapeia um bloco vazio (com a trava) */
+static void arena_soltar_bloco(Arena* a, BlocoArena* b) {
+    if (b->ant) b->ant->prox = b->prox;
+    else a->blocos = b->prox;
+    if (b->prox) b->prox->ant = b->ant;
+    if (a->classe_atual[b->classe] == b) a->classe_atual[b->classe] = NULL;
+    arena_marcar(a, b, 0);
+    a->nblocos--;
+    a->bytes -= (long) ARENA_BLOCO;
+    munmap(b, ARENA_BLOCO);
+}
+
+/* mapeia um bloco novo para a classe c (com a trava); NULL se o mmap falhar */
+static BlocoArena* arena_novo_bloco(Arena* a, int c) {
+    char* ini = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (a->modo_efetivo == ARENA_HUGETLB) {
+        ini = mmap(NULL, ARENA_BLOCO, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ini == MAP_FAILED) a->modo_efetivo = ARENA_THP;   // páginas reservadas acabaram
+    }
+#endif
+    if (ini == MAP_FAILED) {
+        /* mapeia o dobro e corta as pontas para alinhar em 2 MiB */
+        char* base = mmap(NULL, 2 * ARENA_BLOCO, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) return NULL;
+        ini = (char*) (((uintptr_t) base + ARENA_BLOCO - 1) & ~(uintptr_t) (ARENA_BLOCO - 1));
+        if (ini > base) munmap(base, (size_t) (ini - base));
+        if (ini + ARENA_BLOCO < base + 2 * ARENA_BLOCO)
+            munmap(ini + ARENA_BLOCO, (size_t) (base + 2 * ARENA_BLOCO - (ini + ARENA_BLOCO)));
+#ifdef MADV_HUGEPAGE
+        if (a->modo_efetivo == ARENA_THP && madvise(ini, ARENA_BLOCO, MADV_HUGEPAGE) != 0)
+            a->modo_efetivo = ARENA_PAGINAS;
+        /* com THP "always" o kernel usaria páginas grandes mesmo assim */
+        if (a->modo_efetivo == ARENA_PAGINAS) madvise(ini, ARENA_BLOCO, MADV_NOHUGEPAGE);
+#endif
+    }
+    if (a->numa_efetivo != ARENA_NUMA_NENHUM && !arena_aplicar_numa(ini, ARENA_BLOCO, a->numa_efetivo))
+        a->numa_efetivo = ARENA_NUMA_NENHUM;
+
+    BlocoArena* b = (BlocoArena*) ini;
+    if (!arena_marcar(a, b, 1)) {
+        munmap(ini, ARENA_BLOCO);
+        return NULL;
+    }
+    b->topo = ini + ARENA_CAB;
+    b->fim = ini + ARENA_BLOCO;
+    b->livres = NULL;
+    b->vivos = 0;
+    b->classe = c;
+    b->modo = a->modo;
+    b->ant = NULL;
+    b->prox = a->blocos;
+    if (a->blocos) a->blocos->ant = b;
+    a->blocos = b;
+    a->nblocos++;
+    a->bytes += (long) ARENA_BLOCO;
+    return b;
+}
+
+/* um objeto da classe c tirado dos blocos (com a trava); NULL sem bloco */
+static void* arena_tirar(Arena* a, int c) {
+    size_t tam = a->classe_tam[c];
+    BlocoArena* b = a->classe_atual[c];
+    if (!b || (!b->livres && b->topo + tam > b->fim)) {
+        /* outro bloco deste tamanho e modo com espaço, ou um novo */
+        for (b = a->blocos; b; b = b->prox)
+            if (b->classe == c && b->modo == a->modo && (b->livres || b->topo + tam <= b->fim)) break;
+        if (!b) b = arena_novo_bloco(a, c);
+        if (!b) return NULL;
+        a->classe_atual[c] = b;
+    }
+    void* p;
+    if (b->livres) {
+        p = b->livres;
+        b->livres = *(void**) p;
+    } else {
+        p = b->topo;
+        b->topo += tam;
+    }
+    b->vivos++;
+    return p;
+}
+
+/* devolve p ao seu bloco (com a trava) */
+static void arena_guardar(Arena* a, void* p) {
+    BlocoArena* b = (BlocoArena*) ((uintptr_t) p & ~(uintptr_t) (ARENA_BLOCO - 1));
+    *(void**) p = b->livres;
+    b->livres = p;
+    b->vivos--;
+    if (b->vivos == 0 && (a->classe_atual[b->classe] != b || b->modo != a->modo)) arena_soltar_bloco(a, b);
+}
+
+/* devolve até max objetos do cache da classe c aos blocos (com a trava) */
+static void arena_devolver_lote(Arena* a, CacheClasse* cc, int max) {
+    while (cc->livres && max-- > 0) {
+        void* p = cc->livres;
+        cc->livres = *(void**) p;
+        cc->n--;
+        arena_guardar(a, p);
+    }
+}
+
+static void arena_esvaziar_cache(CacheArena* k) {
+    Arena* a = k->dono;
+    pthread_mutex_lock(&a->trava);
+    for (int c = 0; c < ARENA_MAX_CLASSES; c++) arena_devolver_lote(a, &k->c[c], k->c[c].n);
+    pthread_mutex_unlock(&a->trava);
+}
+
+static void arena_fim_thread(void* x) {
+    arena_esvaziar_cache((CacheArena*) x);
+}
+
+static void arena_iniciar_chave() {
+    pthread_key_create(&ARENA_CHAVE, arena_fim_thread);
+}
+
+/* cache desta thread para a arena a (esvaziado se a arena mudou de modo);
+   NULL se a thread já usa o cache com outra arena do mesmo módulo */
+static CacheArena* arena_cache(Arena* a) {
+    CacheArena* k = &ARENA_CACHE_TL;
+    if (k->dono != a) {
+        if (k->dono) return NULL;
+        pthread_once(&ARENA_UMA_VEZ, arena_iniciar_chave);
+        k->dono = a;
+        k->geracao = __atomic_load_n(&a->geracao, __ATOMIC_ACQUIRE);
+        pthread_setspecific(ARENA_CHAVE, k);
+    }
+    int g = __atomic_load_n(&a->geracao, __ATOMIC_ACQUIRE);
+    if (k->geracao != g) {
+        arena_esvaziar_cache(k);
+        k->geracao = g;
+    }
+    return k;
+}
+
+/* liga/desliga a arena; retorna o modo efetivo (com as quedas) */
+static int arena_definir(Arena* a, int modo, int numa) {
+    if (modo < ARENA_DESLIGADA || modo > ARENA_HUGETLB) modo = ARENA_DESLIGADA;
+    if (numa < ARENA_NUMA_NENHUM || numa > ARENA_NUMA_LOCAL) numa = ARENA_NUMA_NENHUM;
+    int efetivo = modo;
+    if (efetivo == ARENA_HUGETLB && !arena_hugetlb_disponivel()) efetivo = ARENA_THP;
+    if (efetivo == ARENA_THP && !arena_thp_disponivel()) efetivo = ARENA_PAGINAS;
+    unsigned long nos = arena_nos_numa();
+    int numa_efetivo = modo != ARENA_DESLIGADA && (nos & (nos - 1)) ? numa : ARENA_NUMA_NENHUM;
+
+    if (ARENA_CACHE_TL.dono == a) arena_esvaziar_cache(&ARENA_CACHE_TL);
+    pthread_mutex_lock(&a->trava);
+    a->numa = numa;
+    a->modo_efetivo = efetivo;
+    a->numa_efetivo = numa_efetivo;
+    for (int c = 0; c < a->nclasses; c++) a->classe_atual[c] = NULL;
+    /* blocos vazios do modo anterior saem agora; os outros, quando esvaziarem */
+    for (BlocoArena* b = a->blocos; b; ) {
+        BlocoArena* prox = b->prox;
+        if (b->vivos == 0) arena_soltar_bloco(a, b);
+        b = prox;
+    }
+    __atomic_store_n(&a->geracao, a->geracao + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&a->modo, modo, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&a->trava);
+    if (ARENA_CACHE_TL.dono == a) ARENA_CACHE_TL.geracao = a->geracao;
+    return modo == ARENA_DESLIGADA ? ARENA_DESLIGADA : efetivo;
+}
+
+/* classe do tamanho tam (cria se preciso); -1 se acabaram as classes */
+static int arena_classe(Arena* a, size_t tam) {
+    int n = __atomic_load_n(&a->nclasses, __ATOMIC_ACQUIRE);
+    for (int c = 0; c < n; c++)
+        if (a->classe_tam[c] == tam) return c;
+    pthread_mutex_lock(&a->trava);
+    int c = 0;
+    while (c < a->nclasses && a->classe_tam[c] != tam) c++;
+    if (c == a->nclasses) {
+        if (c == ARENA_MAX_CLASSES) c = -1;
+        else {
+            a->classe_tam[c] = tam;
+            a->classe_atual[c] = NULL;
+            __atomic_store_n(&a->nclasses, c + 1, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&a->trava);
+    return c;
+}
+
+/* objeto de tam bytes de um bloco da arena; NULL se desligada ou sem bloco */
+static void* arena_reservar(Arena* a, size_t tam) {
+    if (__atomic_load_n(&a->modo, __ATOMIC_ACQUIRE) == ARENA_DESLIGADA) return NULL;
+    tam = (tam + 15) & ~(size_t) 15;
+    if (tam > ARENA_BLOCO - ARENA_CAB) return NULL;
+    int c = arena_classe(a, tam);
+    if (c < 0) return NULL;
+    CacheArena* k = arena_cache(a);
+    if (!k) {
+        pthread_mutex_lock(&a->trava);
+        void* p = arena_tirar(a, c);
+        pthread_mutex_unlock(&a->trava);
+        return p;
+    }
+    CacheClasse* cc = &k->c[c];
+    if (!cc->livres) {
+        /* enche o cache com um lote */
+        pthread_mutex_lock(&a->trava);
+        while (cc->n < ARENA_LOTE) {
+            void* p = arena_tirar(a, c);
+            if (!p) break;
+            *(void**) p = cc->livres;
+            cc->livres = p;
+            cc->n++;
+        }
+        pthread_mutex_unlock(&a->trava);
+        if (!cc->livres) return NULL;
+    }
+    void* p = cc->livres;
+    cc->livres = *(void**) p;
+    cc->n--;
+    return p;
+}
+
+static inline void* arena_alocar(Arena* a, size_t tam) {
+    void* p = arena_reservar(a, tam);
+    return p ? p : malloc(tam);
+}
+
+/* devolve p à arena; 0 se p não é da arena */
+static int arena_devolver(Arena* a, void* p) {
+    if (!p) return 0;
+    BlocoArena* b = arena_bloco_de(a, p);
+    if (!b) return 0;
+    CacheArena* k = arena_cache(a);
+    if (!k) {
+        pthread_mutex_lock(&a->trava);
+        arena_guardar(a, p);
+        pthread_mutex_unlock(&a->trava);
+        return 1;
+    }
+    CacheClasse* cc = &k->c[b->classe];
+    *(void**) p = cc->livres;
+    cc->livres = p;
+    cc->n++;
+    if (cc->n > 2 * ARENA_LOTE) {
+        pthread_mutex_lock(&a->trava);
+        arena_devolver_lote(a, cc, ARENA_LOTE);
+        pthread_mutex_unlock(&a->trava);
+    }
+    return 1;
+}
+
+static inline void arena_liberar(Arena* a, void* p) {
+    if (p && !arena_devolver(a, p)) free(p);
+}
+
+/* modo e NUMA efetivos (DESLIGADA se a arena estiver desligada) e bytes mapeados */
+static void arena_estado(Arena* a, int* modo, int* numa, long* bytes) {
+    pthread_mutex_lock(&a->trava);
+    int ligada = a->modo != ARENA_DESLIGADA;
+    if (modo) *modo = ligada ? a->modo_efetivo : ARENA_DESLIGADA;
+    if (numa) *numa = ligada ? a->numa_efetivo : ARENA_NUMA_NENHUM;
+    if (bytes) *bytes = a->bytes;
+    pthread_mutex_unlock(&a->trava);
+}
+
+#endif
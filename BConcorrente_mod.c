@@ -0,0 +1,487 @@
+// B-tree concorrente com latch por nó (latch crabbing / lock coupling)
+// Mesmo algoritmo top-down da B_mod.c (split proativo na inserção, fill proativo
+// na remoção), o que permite soltar o pai assim que o filho está "seguro":
+// - busca: latches de leitura acoplados (pega o filho, solta o pai)
+// - inserção/remoção otimista: latches de leitura até a folha, escrita só na folha;
+//   se a folha estiver cheia (inserção) ou no mínimo (remoção), refaz pessimista
+// - pessimista: latches de escrita acoplados, com split/fill antes de descer
+// O ponteiro da raiz é protegido por trava_raiz (só muda em split/merge da raiz).
+// Contadores por thread (_Thread_local): mesmas categorias da B_mod.c, cada thread
+// lê e zera apenas o próprio esforço.
+// Exporta funções:
+//   ArvoreBC* bc_criar(int);
+//   void bc_inserir(ArvoreBC*, int);
+//   int bc_buscar(ArvoreBC*, int);
+//   int bc_remover_chave(ArvoreBC*, int);
+//   void bc_remover_tudo(ArvoreBC*);
+//   void bc_destruir(ArvoreBC*);
+//   long bc_get_insercao_and_reset();
+//   long bc_get_remocao_and_reset();
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+typedef struct NoBC {
+    int *chaves;
+    struct NoBC **filhos;
+    int n;        // número de chaves atualmente
+    int folha;    // 1 se folha (imutável após a criação do nó)
+    pthread_rwlock_t trava;
+} NoBC;
+
+typedef struct ArvoreBC {
+    NoBC* raiz;
+    int t; // ordem mínima (t >= 2)
+    pthread_rwlock_t trava_raiz; // protege o ponteiro raiz
+} ArvoreBC;
+
+static _Thread_local long BC_COUNT_VISIT = 0;
+static _Thread_local long BC_COUNT_MOVE  = 0;
+static _Thread_local long BC_COUNT_SPLIT = 0;
+static _Thread_local long BC_COUNT_MERGE = 0;
+static _Thread_local long BC_COUNT_ALLOC = 0;
+static _Thread_local long BC_COUNT_FREE  = 0;
+
+long bc_get_insercao_and_reset() {
+    long v = BC_COUNT_VISIT + BC_COUNT_MOVE + BC_COUNT_SPLIT + BC_COUNT_ALLOC;
+    BC_COUNT_VISIT = BC_COUNT_MOVE = BC_COUNT_SPLIT = BC_COUNT_MERGE = BC_COUNT_ALLOC = BC_COUNT_FREE = 0;
+    return v;
+}
+long bc_get_remocao_and_reset() {
+    long v = BC_COUNT_VISIT + BC_COUNT_MOVE + BC_COUNT_MERGE + BC_COUNT_FREE;
+    BC_COUNT_VISIT = BC_COUNT_MOVE = BC_COUNT_SPLIT = BC_COUNT_MERGE = BC_COUNT_ALLOC = BC_COUNT_FREE = 0;
+    return v;
+}
+
+ArvoreBC* bc_criar(int ordem);
+void bc_inserir(ArvoreBC*, int);
+int bc_buscar(ArvoreBC*, int);
+int bc_remover_chave(ArvoreBC*, int);
+void bc_remover_tudo(ArvoreBC*);
+void bc_destruir(ArvoreBC*);
+
+#define BC_VISIT() (BC_COUNT_VISIT++)
+#define BC_MOVE()  (BC_COUNT_MOVE++)
+#define BC_SPLIT() (BC_COUNT_SPLIT++)
+#define BC_MERGE() (BC_COUNT_MERGE++)
+#define BC_ALLOC() (BC_COUNT_ALLOC++)
+#define BC_FREE()  (BC_COUNT_FREE++)
+
+#define LER(x)      pthread_rwlock_rdlock(&(x)->trava)
+#define ESCREVER(x) pthread_rwlock_wrlock(&(x)->trava)
+#define SOLTAR(x)   pthread_rwlock_unlock(&(x)->trava)
+
+static NoBC* bc_novo_no(int t, int folha) {
+    NoBC* x = (NoBC*) malloc(sizeof(NoBC));
+    x->folha = folha;
+    x->chaves = (int*) malloc(sizeof(int) * (2 * t - 1));
+    x->filhos = (NoBC**) malloc(sizeof(NoBC*) * (2 * t));
+    x->n = 0;
+    for (int i = 0; i < 2 * t; i++) x->filhos[i] = NULL;
+    pthread_rwlock_init(&x->trava, NULL);
+    BC_ALLOC(); BC_MOVE();
+    return x;
+}
+
+/* só é chamado com o nó inacessível para as outras threads */
+static void bc_liberar_no(NoBC* x) {
+    pthread_rwlock_destroy(&x->trava);
+    free(x->chaves); BC_FREE();
+    free(x->filhos); BC_FREE();
+    free(x); BC_FREE();
+}
+
+ArvoreBC* bc_criar(int ordem) {
+    if (ordem < 2) ordem = 2;
+    ArvoreBC* a = (ArvoreBC*) malloc(sizeof(ArvoreBC));
+    a->t = ordem;
+    a->raiz = bc_novo_no(ordem, 1);
+    pthread_rwlock_init(&a->trava_raiz, NULL);
+    BC_ALLOC();
+    return a;
+}
+
+/* primeira posição i com chaves[i] >= k */
+static int bc_posicao(NoBC* x, int k) {
+    int i = 0;
+    while (i < x->n && k > x->chaves[i]) {
+        BC_VISIT();
+        i++;
+    }
+    return i;
+}
+
+/* trava o nó em modo escrita se for folha (destino da modificação), leitura caso contrário */
+static void bc_travar_descida(NoBC* x) {
+    if (x->folha) ESCREVER(x);
+    else LER(x);
+}
+
+int bc_buscar(ArvoreBC* a, int k) {
+    pthread_rwlock_rdlock(&a->trava_raiz);
+    NoBC* x = a->raiz;
+    LER(x);
+    pthread_rwlock_unlock(&a->trava_raiz);
+    for (;;) {
+        BC_VISIT();
+        int i = bc_posicao(x, k);
+        if (i < x->n && x->chaves[i] == k) { SOLTAR(x); return 1; }
+        if (x->folha) { SOLTAR(x); return 0; }
+        NoBC* c = x->filhos[i];
+        LER(c);
+        SOLTAR(x);
+        x = c;
+    }
+}
+
+/* split do filho cheio x->filhos[i]; x e o filho estão travados em escrita.
+   O novo irmão só fica acessível através de x. */
+static void bc_split_child(NoBC* x, int i, int t) {
+    BC_SPLIT();
+    NoBC* y = x->filhos[i];
+    NoBC* z = bc_novo_no(t, y->folha);
+    z->n = t - 1;
+    for (int j = 0; j < t - 1; j++) {
+        z->chaves[j] = y->chaves[j + t]; BC_MOVE();
+    }
+    if (!y->folha) {
+        for (int j = 0; j < t; j++) {
+            z->filhos[j] = y->filhos[j + t]; BC_MOVE();
+            y->filhos[j + t] = NULL;
+        }
+    }
+    y->n = t - 1;
+
+    for (int j = x->n; j >= i + 1; j--) {
+        x->filhos[j + 1] = x->filhos[j]; BC_MOVE();
+    }
+    x->filhos[i + 1] = z; BC_MOVE();
+    for (int j = x->n - 1; j >= i; j--) {
+        x->chaves[j + 1] = x->chaves[j]; BC_MOVE();
+    }
+    x->chaves[i] = y->chaves[t - 1]; BC_MOVE();
+    x->n = x->n + 1; BC_MOVE();
+}
+
+static void bc_inserir_na_folha(NoBC* x, int k) {
+    int i = x->n - 1;
+    while (i >= 0 && x->chaves[i] > k) {
+        x->chaves[i + 1] = x->chaves[i]; BC_MOVE();
+        i--;
+        BC_VISIT();
+    }
+    x->chaves[i + 1] = k; BC_MOVE();
+    x->n = x->n + 1; BC_MOVE();
+}
+
+/* índice do filho para inserção (empates vão para a direita, como na B_mod.c) */
+static int bc_filho_insercao(NoBC* x, int k) {
+    int i = x->n - 1;
+    while (i >= 0 && x->chaves[i] > k) {
+        i--;
+        BC_VISIT();
+    }
+    return i + 1;
+}
+
+/* latches de leitura até a folha; falha (0) se a folha estiver cheia */
+static int bc_inserir_otimista(ArvoreBC* a, int k) {
+    pthread_rwlock_rdlock(&a->trava_raiz);
+    NoBC* x = a->raiz;
+    bc_travar_descida(x);
+    pthread_rwlock_unlock(&a->trava_raiz);
+    while (!x->folha) {
+        BC_VISIT();
+        NoBC* c = x->filhos[bc_filho_insercao(x, k)];
+        bc_travar_descida(c);
+        SOLTAR(x);
+        x = c;
+    }
+    if (x->n == 2 * a->t - 1) { SOLTAR(x); return 0; }
+    BC_VISIT();
+    bc_inserir_na_folha(x, k);
+    SOLTAR(x);
+    return 1;
+}
+
+/* latches de escrita acoplados; todo nó visitado é dividido antes se estiver cheio */
+static void bc_inserir_pessimista(ArvoreBC* a, int k) {
+    int t = a->t;
+    pthread_rwlock_wrlock(&a->trava_raiz);
+    NoBC* x = a->raiz;
+    ESCREVER(x);
+    if (x->n == 2 * t - 1) {
+        /* nova raiz s: ninguém chega a ela enquanto seguramos trava_raiz,
+           então a descida continua direto na metade certa, sem travar s */
+        NoBC* s = bc_novo_no(t, 0); BC_MOVE();
+        s->filhos[0] = x; BC_MOVE();
+        bc_split_child(s, 0, t);
+        a->raiz = s; BC_MOVE();
+        if (s->chaves[0] < k) {
+            NoBC* z = s->filhos[1];
+            ESCREVER(z);
+            SOLTAR(x);
+            x = z;
+        }
+    }
+    pthread_rwlock_unlock(&a->trava_raiz);
+
+    while (!x->folha) {
+        BC_VISIT();
+        int i = bc_filho_insercao(x, k);
+        NoBC* c = x->filhos[i];
+        ESCREVER(c);
+        if (c->n == 2 * t - 1) {
+            bc_split_child(x, i, t);
+            if (x->chaves[i] < k) {
+                NoBC* z = x->filhos[i + 1];
+                ESCREVER(z);
+                SOLTAR(c);
+                c = z;
+            }
+        }
+        SOLTAR(x);
+        x = c;
+    }
+    BC_VISIT();
+    bc_inserir_na_folha(x, k);
+    SOLTAR(x);
+}
+
+void bc_inserir(ArvoreBC* a, int k) {
+    if (!bc_inserir_otimista(a, k)) bc_inserir_pessimista(a, k);
+}
+
+/* merge: alvo (x->filhos[sep]) absorve o separador x->chaves[sep] e o irmão da
+   direita absorvido, que é liberado; ambos travados em escrita */
+static void bc_merge(NoBC* x, int sep, NoBC* alvo, NoBC* absorvido) {
+    alvo->chaves[alvo->n] = x->chaves[sep]; BC_MOVE();
+    for (int i = 0; i < absorvido->n; ++i) {
+        alvo->chaves[alvo->n + 1 + i] = absorvido->chaves[i]; BC_MOVE(); BC_MERGE();
+    }
+    if (!alvo->folha) {
+        for (int i = 0; i <= absorvido->n; ++i) {
+            alvo->filhos[alvo->n + 1 + i] = absorvido->filhos[i]; BC_MOVE(); BC_MERGE();
+        }
+    }
+    alvo->n += absorvido->n + 1; BC_MOVE();
+    for (int i = sep + 1; i < x->n; ++i) {
+        x->chaves[i - 1] = x->chaves[i]; BC_MOVE();
+        x->filhos[i] = x->filhos[i + 1]; BC_MOVE();
+    }
+    x->filhos[x->n] = NULL; BC_MOVE();
+    x->n--; BC_MOVE();
+    SOLTAR(absorvido);
+    bc_liberar_no(absorvido);
+}
+
+/* Garante que x->filhos[idx] (c, travado) tenha pelo menos t chaves: empresta de um
+   irmão ou faz merge. x está travado em escrita, então nenhuma outra thread pode
+   chegar aos irmãos; a ordem de travamento entre irmãos não importa.
+   Retorna o nó (travado) onde a descida continua. */
+static NoBC* bc_fill(NoBC* x, int idx, int t, NoBC* c) {
+    NoBC* esq = (idx > 0) ? x->filhos[idx - 1] : NULL;
+    NoBC* dir = (idx < x->n) ? x->filhos[idx + 1] : NULL;
+
+    if (esq) {
+        ESCREVER(esq);
+        if (esq->n >= t) {
+            for (int i = c->n - 1; i >= 0; --i) {
+                c->chaves[i + 1] = c->chaves[i]; BC_MOVE();
+            }
+            if (!c->folha) {
+                for (int i = c->n; i >= 0; --i) {
+                    c->filhos[i + 1] = c->filhos[i]; BC_MOVE();
+                }
+                c->filhos[0] = esq->filhos[esq->n]; BC_MOVE();
+                esq->filhos[esq->n] = NULL;
+            }
+            c->chaves[0] = x->chaves[idx - 1]; BC_MOVE();
+            x->chaves[idx - 1] = esq->chaves[esq->n - 1]; BC_MOVE();
+            c->n += 1; BC_MOVE();
+            esq->n -= 1; BC_MOVE();
+            SOLTAR(esq);
+            return c;
+        }
+    }
+
+    if (dir) {
+        ESCREVER(dir);
+        if (dir->n >= t) {
+            if (esq) SOLTAR(esq);
+            c->chaves[c->n] = x->chaves[idx]; BC_MOVE();
+            if (!c->folha) { c->filhos[c->n + 1] = dir->filhos[0]; BC_MOVE(); }
+            x->chaves[idx] = dir->chaves[0]; BC_MOVE();
+            for (int i = 0; i < dir->n - 1; ++i) {
+                dir->chaves[i] = dir->chaves[i + 1]; BC_MOVE();
+            }
+            if (!dir->folha) {
+                for (int i = 0; i < dir->n; ++i) {
+                    dir->filhos[i] = dir->filhos[i + 1]; BC_MOVE();
+                }
+                dir->filhos[dir->n] = NULL;
+            }
+            c->n += 1; BC_MOVE();
+            dir->n -= 1; BC_MOVE();
+            SOLTAR(dir);
+            return c;
+        }
+    }
+
+    /* nenhum irmão pode emprestar: merge com o da direita, ou c entra no da esquerda */
+    if (dir) {
+        if (esq) SOLTAR(esq);
+        bc_merge(x, idx, c, dir);
+        return c;
+    }
+    bc_merge(x, idx - 1, esq, c);
+    return esq;
+}
+
+static void bc_remover_da_folha(NoBC* x, int idx) {
+    for (int i = idx + 1; i < x->n; ++i) {
+        x->chaves[i - 1] = x->chaves[i]; BC_MOVE();
+    }
+    x->n--; BC_MOVE();
+}
+
+/* remove e devolve o máximo (ou mínimo) da subárvore c, travada e com >= t chaves;
+   solta todos os latches da descida */
+static int bc_remover_extremo(NoBC* c, int maximo, int t) {
+    for (;;) {
+        BC_VISIT();
+        if (c->folha) {
+            int idx = maximo ? c->n - 1 : 0;
+            int k = c->chaves[idx];
+            bc_remover_da_folha(c, idx);
+            SOLTAR(c);
+            return k;
+        }
+        int idx = maximo ? c->n : 0;
+        NoBC* f = c->filhos[idx];
+        ESCREVER(f);
+        if (f->n < t) f = bc_fill(c, idx, t, f);
+        SOLTAR(c);
+        c = f;
+    }
+}
+
+/* folha em latch de escrita; -1 = precisa do caminho pessimista */
+static int bc_remover_otimista(ArvoreBC* a, int k) {
+    pthread_rwlock_rdlock(&a->trava_raiz);
+    NoBC* x = a->raiz;
+    bc_travar_descida(x);
+    pthread_rwlock_unlock(&a->trava_raiz);
+    int eh_raiz = 1; /* enquanto seguramos o latch, a raiz-folha não pode ser trocada */
+    while (!x->folha) {
+        BC_VISIT();
+        int i = bc_posicao(x, k);
+        if (i < x->n && x->chaves[i] == k) { SOLTAR(x); return -1; }
+        NoBC* c = x->filhos[i];
+        bc_travar_descida(c);
+        SOLTAR(x);
+        x = c;
+        eh_raiz = 0;
+    }
+    BC_VISIT();
+    int i = bc_posicao(x, k);
+    if (i >= x->n || x->chaves[i] != k) { SOLTAR(x); return 0; }
+    if (!eh_raiz && x->n < a->t) { SOLTAR(x); return -1; }
+    bc_remover_da_folha(x, i);
+    SOLTAR(x);
+    return 1;
+}
+
+static int bc_remover_pessimista(ArvoreBC* a, int k) {
+    int t = a->t;
+    int removido = 0;
+    pthread_rwlock_wrlock(&a->trava_raiz);
+    int raiz_travada = 1;
+    NoBC* x = a->raiz;
+    ESCREVER(x);
+
+    for (;;) {
+        /* a raiz só muda se ficar vazia após um merge: solta trava_raiz quando x for seguro */
+        if (raiz_travada && (x->folha || x->n >= 2)) {
+            pthread_rwlock_unlock(&a->trava_raiz);
+            raiz_travada = 0;
+        }
+        BC_VISIT();
+        int idx = bc_posicao(x, k);
+        NoBC* c;
+
+        if (idx < x->n && x->chaves[idx] == k) {
+            if (x->folha) {
+                bc_remover_da_folha(x, idx);
+                removido = 1;
+                break;
+            }
+            c = x->filhos[idx];
+            ESCREVER(c);
+            if (c->n >= t) {
+                x->chaves[idx] = bc_remover_extremo(c, 1, t); BC_MOVE();
+                removido = 1;
+                break;
+            }
+            NoBC* d = x->filhos[idx + 1];
+            ESCREVER(d);
+            if (d->n >= t) {
+                SOLTAR(c);
+                x->chaves[idx] = bc_remover_extremo(d, 0, t); BC_MOVE();
+                removido = 1;
+                break;
+            }
+            /* ambos com t-1: k desce para c junto com o conteúdo de d */
+            bc_merge(x, idx, c, d);
+        } else {
+            if (x->folha) break;
+            c = x->filhos[idx];
+            ESCREVER(c);
+            if (c->n < t) c = bc_fill(x, idx, t, c);
+        }
+
+        if (x->n == 0) {
+            /* merge esvaziou a raiz: o filho resultante vira a nova raiz */
+            a->raiz = c; BC_MOVE();
+            SOLTAR(x);
+            bc_liberar_no(x);
+        } else {
+            SOLTAR(x);
+        }
+        x = c;
+    }
+
+    SOLTAR(x);
+    if (raiz_travada) pthread_rwlock_unlock(&a->trava_raiz);
+    return removido;
+}
+
+int bc_remover_chave(ArvoreBC* a, int k) {
+    if (!a) return 0;
+    int r = bc_remover_otimista(a, k);
+    if (r < 0) r = bc_remover_pessimista(a, k);
+    return r;
+}
+
+/* remover tudo (liberação recursiva; sem outras threads ativas) */
+static void bc_liberar(NoBC* no) {
+    if (!no) return;
+    if (!no->folha) {
+        for (int i = 0; i <= no->n; ++i) bc_liberar(no->filhos[i]);
+    }
+    bc_liberar_no(no);
+}
+
+void bc_remover_tudo(ArvoreBC* a) {
+    if (!a) return;
+    bc_liberar(a->raiz);
+    a->raiz = bc_novo_no(a->t, 1); BC_ALLOC();
+}
+
+void bc_destruir(ArvoreBC* a) {
+    if (!a) return;
+    bc_liberar(a->raiz);
+    pthread_rwlock_destroy(&a->trava_raiz);
+    free(a);
+}
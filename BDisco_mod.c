@@ -0,0 +1,661 @@
+// B-tree em disco (páginas de 4 KiB) com buffer pool e substituição clock
+// - cada nó ocupa exatamente uma página do arquivo; filhos são ids de página
+// - t é calculado para o nó caber na página: 16t + 4 <= 4096 -> t = 255
+// - página 0 guarda os metadados (raiz, número de páginas, lista de livres);
+//   reabrir o arquivo recupera a árvore sem reconstrução
+// - páginas são lidas/escritas com pread/pwrite por um pool de quadros
+//   alinhados; a vítima é escolhida pelo algoritmo clock (bit de referência),
+//   quadros fixados (em uso pela operação) não são despejados
+// - mesmo algoritmo top-down da B_mod.c (split/fill antes de descer)
+// Contadores: VISIT, MOVE, SPLIT, MERGE, ALLOC, FREE (como na B_mod.c)
+// e, à parte, LEITURA/ESCRITA de páginas no arquivo.
+// Exporta funções:
+//   ArvoreBD* bd_abrir(const char*, int);         // arquivo, quadros do pool; NULL se o arquivo não é vazio nem uma árvore
+//   ArvoreBD* bd_abrir_ordem(const char*, int, int); // idem, com t menor que o da página
+//   void bd_fechar(ArvoreBD*);                    // grava páginas sujas e metadados
+//   void bd_sincronizar(ArvoreBD*);
+//   void bd_inserir(ArvoreBD*, int);
+//   int bd_buscar(ArvoreBD*, int);
+//   int bd_remover_chave(ArvoreBD*, int);
+//   void bd_remover_tudo(ArvoreBD*);
+//   int bd_ordem(ArvoreBD*);
+//   long bd_get_leituras();   long bd_get_escritas();
+//   long bd_get_insercao_and_reset();
+//   long bd_get_remocao_and_reset();
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define BD_PAGINA      4096
+#define BD_MAGICA      0x42445431u   /* "BDT1" */
+#define BD_NENHUMA     0xFFFFFFFFu
+#define BD_MIN_QUADROS 8             /* operações fixam no máximo 4 páginas */
+
+typedef struct PaginaBD {
+    int32_t n;        // número de chaves (-1 = página livre)
+    int32_t folha;    // 1 se folha
+    int32_t dados[];  // chaves[2t-1] seguidas de filhos[2t] (ids de página)
+} PaginaBD;
+
+/* maior t com 2 + (2t-1) + 2t inteiros de 32 bits numa página */
+#define BD_ORDEM_PAGINA ((BD_PAGINA - (int) sizeof(PaginaBD) + (int) sizeof(int32_t)) / (4 * (int) sizeof(int32_t)))
+
+typedef struct MetaBD {
+    uint32_t magica;
+    int32_t t;
+    uint32_t raiz;
+    uint32_t npaginas;
+    uint32_t livre;   // primeira página livre (BD_NENHUMA = nenhuma)
+} MetaBD;
+
+typedef struct QuadroBD {
+    uint32_t pagina;  // BD_NENHUMA = vazio
+    int pinos;
+    int sujo;
+    int ref;          // bit de referência do clock
+} QuadroBD;
+
+typedef struct ArvoreBD {
+    int fd;
+    int t;
+    MetaBD meta;
+    QuadroBD* quadros;
+    unsigned char* memoria;   // nq * BD_PAGINA, alinhada em página
+    int nq;
+    int ponteiro;             // ponteiro do clock
+    int* mapa;                // página -> quadro (-1 = fora do pool)
+    uint32_t cap_mapa;
+} ArvoreBD;
+
+/* nó fixado no pool */
+typedef struct NoBD {
+    uint32_t id;
+    PaginaBD* p;
+    int32_t* chaves;
+    uint32_t* filhos;
+} NoBD;
+
+static long BD_COUNT_VISIT   = 0;
+static long BD_COUNT_MOVE    = 0;
+static long BD_COUNT_SPLIT   = 0;
+static long BD_COUNT_MERGE   = 0;
+static long BD_COUNT_ALLOC   = 0;
+static long BD_COUNT_FREE    = 0;
+static long BD_COUNT_LEITURA = 0;
+static long BD_COUNT_ESCRITA = 0;
+
+long bd_get_leituras() {
+    return BD_COUNT_LEITURA;
+}
+long bd_get_escritas() {
+    return BD_COUNT_ESCRITA;
+}
+long bd_get_insercao_and_reset() {
+    long v = BD_COUNT_VISIT + BD_COUNT_MOVE + BD_COUNT_SPLIT + BD_COUNT_ALLOC;
+    BD_COUNT_VISIT = BD_COUNT_MOVE = BD_COUNT_SPLIT = BD_COUNT_MERGE = BD_COUNT_ALLOC = BD_COUNT_FREE = 0;
+    BD_COUNT_LEITURA = BD_COUNT_ESCRITA = 0;
+    return v;
+}
+long bd_get_remocao_and_reset() {
+    long v = BD_COUNT_VISIT + BD_COUNT_MOVE + BD_COUNT_MERGE + BD_COUNT_FREE;
+    BD_COUNT_VISIT = BD_COUNT_MOVE = BD_COUNT_SPLIT = BD_COUNT_MERGE = BD_COUNT_ALLOC = BD_COUNT_FREE = 0;
+    BD_COUNT_LEITURA = BD_COUNT_ESCRITA = 0;
+    return v;
+}
+
+ArvoreBD* bd_abrir(const char* caminho, int quadros);
+ArvoreBD* bd_abrir_ordem(const char* caminho, int quadros, int ordem);
+void bd_fechar(ArvoreBD*);
+void bd_sincronizar(ArvoreBD*);
+void bd_inserir(ArvoreBD*, int);
+int bd_buscar(ArvoreBD*, int);
+int bd_remover_chave(ArvoreBD*, int);
+void bd_remover_tudo(ArvoreBD*);
+int bd_ordem(ArvoreBD*);
+
+#define BD_VISIT() (BD_COUNT_VISIT++)
+#define BD_MOVE()  (BD_COUNT_MOVE++)
+#define BD_SPLIT() (BD_COUNT_SPLIT++)
+#define BD_MERGE() (BD_COUNT_MERGE++)
+#define BD_ALLOC() (BD_COUNT_ALLOC++)
+#define BD_FREE()  (BD_COUNT_FREE++)
+
+/* --------------------------------------------------
+   Arquivo e buffer pool
+   -------------------------------------------------- */
+
+static unsigned char* bd_quadro_mem(ArvoreBD* a, int q) {
+    return a->memoria + (size_t) q * BD_PAGINA;
+}
+
+static void bd_ler_pagina(ArvoreBD* a, uint32_t id, void* buf) {
+    ssize_t r = pread(a->fd, buf, BD_PAGINA, (off_t) id * BD_PAGINA);
+    if (r < BD_PAGINA) memset((unsigned char*) buf + (r > 0 ? r : 0), 0, BD_PAGINA - (r > 0 ? r : 0));
+    BD_COUNT_LEITURA++;
+}
+
+static void bd_escrever_pagina(ArvoreBD* a, uint32_t id, const void* buf) {
+    if (pwrite(a->fd, buf, BD_PAGINA, (off_t) id * BD_PAGINA) != BD_PAGINA) {
+        perror("bd: pwrite");
+        exit(1);
+    }
+    BD_COUNT_ESCRITA++;
+}
+
+static void bd_garantir_mapa(ArvoreBD* a, uint32_t npaginas) {
+    if (npaginas <= a->cap_mapa) return;
+    uint32_t cap = a->cap_mapa ? a->cap_mapa : 1024;
+    while (cap < npaginas) cap *= 2;
+    a->mapa = (int*) realloc(a->mapa, sizeof(int) * cap);
+    for (uint32_t i = a->cap_mapa; i < cap; i++) a->mapa[i] = -1;
+    a->cap_mapa = cap;
+}
+
+/* clock: passa pelos quadros limpando o bit de referência até achar um livre */
+static int bd_vitima(ArvoreBD* a) {
+    for (int voltas = 0; voltas < 2 * a->nq + 1; voltas++) {
+        int q = a->ponteiro;
+        a->ponteiro = (a->ponteiro + 1) % a->nq;
+        QuadroBD* f = &a->quadros[q];
+        if (f->pinos > 0) continue;
+        if (f->ref) {
+            f->ref = 0;
+            continue;
+        }
+        if (f->pagina != BD_NENHUMA) {
+            if (f->sujo) bd_escrever_pagina(a, f->pagina, bd_quadro_mem(a, q));
+            a->mapa[f->pagina] = -1;
+        }
+        f->pagina = BD_NENHUMA;
+        f->sujo = 0;
+        return q;
+    }
+    fprintf(stderr, "bd: todos os quadros do pool estão fixados\n");
+    exit(1);
+}
+
+static NoBD bd_no_do_quadro(ArvoreBD* a, uint32_t id, int q) {
+    NoBD x;
+    x.id = id;
+    x.p = (PaginaBD*) bd_quadro_mem(a, q);
+    x.chaves = x.p->dados;
+    x.filhos = (uint32_t*) (x.p->dados + 2 * a->t - 1);
+    return x;
+}
+
+/* fixa a página id no pool (lê do arquivo se não estiver residente) */
+static NoBD bd_fixar(ArvoreBD* a, uint32_t id) {
+    int q = a->mapa[id];
+    if (q < 0) {
+        q = bd_vitima(a);
+        bd_ler_pagina(a, id, bd_quadro_mem(a, q));
+        a->quadros[q].pagina = id;
+        a->mapa[id] = q;
+    }
+    a->quadros[q].pinos++;
+    a->quadros[q].ref = 1;
+    return bd_no_do_quadro(a, id, q);
+}
+
+static void bd_soltar(ArvoreBD* a, NoBD* x) {
+    a->quadros[a->mapa[x->id]].pinos--;
+}
+
+static void bd_sujar(ArvoreBD* a, NoBD* x) {
+    a->quadros[a->mapa[x->id]].sujo = 1;
+}
+
+/* nova página (da lista de livres ou no fim do arquivo), já fixada e suja */
+static NoBD bd_novo_no(ArvoreBD* a, int folha) {
+    uint32_t id;
+    int q;
+    if (a->meta.livre != BD_NENHUMA) {
+        id = a->meta.livre;
+        NoBD x = bd_fixar(a, id);
+        a->meta.livre = (uint32_t) x.p->dados[0];
+        q = a->mapa[id];
+    } else {
+        id = a->meta.npaginas++;
+        bd_garantir_mapa(a, a->meta.npaginas);
+        q = bd_vitima(a);
+        a->quadros[q].pagina = id;
+        a->quadros[q].pinos = 1;
+        a->quadros[q].ref = 1;
+        a->mapa[id] = q;
+    }
+    a->quadros[q].sujo = 1;
+    NoBD x = bd_no_do_quadro(a, id, q);
+    memset(x.p, 0, BD_PAGINA);
+    x.p->folha = folha;
+    BD_ALLOC(); BD_MOVE();
+    return x;
+}
+
+/* devolve a página à lista de livres e solta o pino */
+static void bd_liberar_no(ArvoreBD* a, NoBD* x) {
+    x->p->n = -1;
+    x->p->dados[0] = (int32_t) a->meta.livre;
+    a->meta.livre = x->id;
+    bd_sujar(a, x);
+    bd_soltar(a, x);
+    BD_FREE();
+}
+
+static void bd_gravar_meta(ArvoreBD* a) {
+    unsigned char* buf = (unsigned char*) calloc(1, BD_PAGINA);
+    memcpy(buf, &a->meta, sizeof(MetaBD));
+    bd_escrever_pagina(a, 0, buf);
+    free(buf);
+}
+
+void bd_sincronizar(ArvoreBD* a) {
+    for (int q = 0; q < a->nq; q++) {
+        QuadroBD* f = &a->quadros[q];
+        if (f->pagina != BD_NENHUMA && f->sujo) {
+            bd_escrever_pagina(a, f->pagina, bd_quadro_mem(a, q));
+            f->sujo = 0;
+        }
+    }
+    bd_gravar_meta(a);
+    fsync(a->fd);
+}
+
+static void bd_nova_arvore(ArvoreBD* a) {
+    a->meta.magica = BD_MAGICA;
+    a->meta.t = a->t;
+    a->meta.npaginas = 1;
+    a->meta.livre = BD_NENHUMA;
+    bd_garantir_mapa(a, 1);
+    NoBD r = bd_novo_no(a, 1);
+    a->meta.raiz = r.id;
+    bd_soltar(a, &r);
+}
+
+ArvoreBD* bd_abrir_ordem(const char* caminho, int quadros, int ordem) {
+    int fd = open(caminho, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        perror("bd: open");
+        return NULL;
+    }
+    /* só um arquivo vazio (recém-criado) vira árvore nova; outro conteúdo
+       qualquer não é apagado */
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror("bd: fstat");
+        close(fd);
+        return NULL;
+    }
+    if (quadros < BD_MIN_QUADROS) quadros = BD_MIN_QUADROS;
+    if (ordem < 2 || ordem > BD_ORDEM_PAGINA) ordem = BD_ORDEM_PAGINA;
+
+    ArvoreBD* a = (ArvoreBD*) calloc(1, sizeof(ArvoreBD));
+    a->fd = fd;
+    a->nq = quadros;
+    a->quadros = (QuadroBD*) calloc(quadros, sizeof(QuadroBD));
+    for (int q = 0; q < quadros; q++) a->quadros[q].pagina = BD_NENHUMA;
+    void* mem = NULL;
+    if (posix_memalign(&mem, BD_PAGINA, (size_t) quadros * BD_PAGINA) != 0) {
+        perror("bd: posix_memalign");
+        exit(1);
+    }
+    a->memoria = (unsigned char*) mem;
+
+    if (st.st_size == 0) {
+        a->t = ordem;
+        bd_nova_arvore(a);
+        return a;
+    }
+    /* arquivo existente: os metadados da página 0 mandam (inclusive t) */
+    unsigned char* buf = (unsigned char*) malloc(BD_PAGINA);
+    bd_ler_pagina(a, 0, buf);
+    memcpy(&a->meta, buf, sizeof(MetaBD));
+    free(buf);
+    if (a->meta.magica != BD_MAGICA || a->meta.t < 2 || a->meta.t > BD_ORDEM_PAGINA ||
+        a->meta.npaginas < 1) {
+        fprintf(stderr, "bd: %s não é uma B-tree em disco válida\n", caminho);
+        close(fd);
+        free(a->memoria);
+        free(a->quadros);
+        free(a);
+        return NULL;
+    }
+    a->t = a->meta.t;
+    bd_garantir_mapa(a, a->meta.npaginas);
+    return a;
+}
+
+ArvoreBD* bd_abrir(const char* caminho, int quadros) {
+    return bd_abrir_ordem(caminho, quadros, BD_ORDEM_PAGINA);
+}
+
+void bd_fechar(ArvoreBD* a) {
+    if (!a) return;
+    bd_sincronizar(a);
+    close(a->fd);
+    free(a->memoria);
+    free(a->quadros);
+    free(a->mapa);
+    free(a);
+}
+
+int bd_ordem(ArvoreBD* a) {
+    return a->t;
+}
+
+/* --------------------------------------------------
+   Busca
+   -------------------------------------------------- */
+
+int bd_buscar(ArvoreBD* a, int k) {
+    uint32_t id = a->meta.raiz;
+    for (;;) {
+        NoBD x = bd_fixar(a, id);
+        int i = 0;
+        while (i < x.p->n && k > x.chaves[i]) {
+            BD_VISIT();
+            i++;
+        }
+        int achou = (i < x.p->n && k == x.chaves[i]);
+        int folha = x.p->folha;
+        id = folha ? BD_NENHUMA : x.filhos[i];
+        bd_soltar(a, &x);
+        if (achou) return 1;
+        if (folha) return 0;
+    }
+}
+
+/* --------------------------------------------------
+   Inserção
+   -------------------------------------------------- */
+
+/* split do filho cheio y = x->filhos[i] (x e y fixados; x não está cheio) */
+static void bd_split_child(ArvoreBD* a, NoBD* x, int i, NoBD* y) {
+    BD_SPLIT();
+    int t = a->t;
+    NoBD z = bd_novo_no(a, y->p->folha);
+    z.p->n = t - 1;
+    for (int j = 0; j < t - 1; j++) {
+        z.chaves[j] = y->chaves[j + t]; BD_MOVE();
+    }
+    if (!y->p->folha) {
+        for (int j = 0; j < t; j++) {
+            z.filhos[j] = y->filhos[j + t]; BD_MOVE();
+        }
+    }
+    y->p->n = t - 1;
+
+    for (int j = x->p->n; j >= i + 1; j--) {
+        x->filhos[j + 1] = x->filhos[j]; BD_MOVE();
+    }
+    x->filhos[i + 1] = z.id; BD_MOVE();
+    for (int j = x->p->n - 1; j >= i; j--) {
+        x->chaves[j + 1] = x->chaves[j]; BD_MOVE();
+    }
+    x->chaves[i] = y->chaves[t - 1]; BD_MOVE();
+    x->p->n = x->p->n + 1; BD_MOVE();
+
+    bd_sujar(a, x);
+    bd_sujar(a, y);
+    bd_soltar(a, &z);
+}
+
+/* x fixado e não cheio; solta x no fim */
+static void bd_insert_nonfull(ArvoreBD* a, NoBD x, int k) {
+    int t = a->t;
+    for (;;) {
+        BD_VISIT();
+        int i = x.p->n - 1;
+        if (x.p->folha) {
+            while (i >= 0 && x.chaves[i] > k) {
+                x.chaves[i + 1] = x.chaves[i]; BD_MOVE();
+                i--;
+                BD_VISIT();
+            }
+            x.chaves[i + 1] = k; BD_MOVE();
+            x.p->n = x.p->n + 1; BD_MOVE();
+            bd_sujar(a, &x);
+            bd_soltar(a, &x);
+            return;
+        }
+        while (i >= 0 && x.chaves[i] > k) {
+            i--;
+            BD_VISIT();
+        }
+        i++;
+        NoBD c = bd_fixar(a, x.filhos[i]);
+        if (c.p->n == 2 * t - 1) {
+            bd_split_child(a, &x, i, &c);
+            if (x.chaves[i] < k) {
+                bd_soltar(a, &c);
+                c = bd_fixar(a, x.filhos[i + 1]);
+            }
+        }
+        bd_soltar(a, &x);
+        x = c;
+    }
+}
+
+void bd_inserir(ArvoreBD* a, int k) {
+    BD_VISIT();
+    NoBD r = bd_fixar(a, a->meta.raiz);
+    if (r.p->n == 2 * a->t - 1) {
+        NoBD s = bd_novo_no(a, 0); BD_MOVE();
+        a->meta.raiz = s.id; BD_MOVE();
+        s.filhos[0] = r.id; BD_MOVE();
+        bd_split_child(a, &s, 0, &r);
+        bd_soltar(a, &r);
+        r = s;
+    }
+    bd_insert_nonfull(a, r, k);
+}
+
+/* --------------------------------------------------
+   Remoção
+   -------------------------------------------------- */
+
+/* maior chave da subárvore c (c fixado; continua fixado) */
+static int bd_get_pred(ArvoreBD* a, NoBD* c) {
+    if (c->p->folha) return c->chaves[c->p->n - 1];
+    uint32_t id = c->filhos[c->p->n];
+    for (;;) {
+        BD_VISIT();
+        NoBD x = bd_fixar(a, id);
+        int folha = x.p->folha;
+        int k = folha ? x.chaves[x.p->n - 1] : 0;
+        id = folha ? 0 : x.filhos[x.p->n];
+        bd_soltar(a, &x);
+        if (folha) return k;
+    }
+}
+
+/* menor chave da subárvore c */
+static int bd_get_succ(ArvoreBD* a, NoBD* c) {
+    if (c->p->folha) return c->chaves[0];
+    uint32_t id = c->filhos[0];
+    for (;;) {
+        BD_VISIT();
+        NoBD x = bd_fixar(a, id);
+        int folha = x.p->folha;
+        int k = folha ? x.chaves[0] : 0;
+        id = folha ? 0 : x.filhos[0];
+        bd_soltar(a, &x);
+        if (folha) return k;
+    }
+}
+
+/* funde s = x->filhos[idx+1] em c = x->filhos[idx]; s é liberado */
+static void bd_merge(ArvoreBD* a, NoBD* x, int idx, NoBD* c, NoBD* s) {
+    int t = a->t;
+    c->chaves[t - 1] = x->chaves[idx]; BD_MOVE();
+    for (int i = 0; i < s->p->n; ++i) {
+        c->chaves[i + t] = s->chaves[i]; BD_MOVE(); BD_MERGE();
+    }
+    if (!c->p->folha) {
+        for (int i = 0; i <= s->p->n; ++i) {
+            c->filhos[i + t] = s->filhos[i]; BD_MOVE(); BD_MERGE();
+        }
+    }
+    for (int i = idx + 1; i < x->p->n; ++i) {
+        x->chaves[i - 1] = x->chaves[i]; BD_MOVE();
+        x->filhos[i] = x->filhos[i + 1]; BD_MOVE();
+    }
+    c->p->n += s->p->n + 1; BD_MOVE();
+    x->p->n--; BD_MOVE();
+    bd_sujar(a, x);
+    bd_sujar(a, c);
+    bd_liberar_no(a, s);
+}
+
+/* garante que o filho c = x->filhos[idx] tenha >= t chaves.
+   Devolve o índice do filho a descer; *c passa a ser esse filho (fixado). */
+static int bd_fill(ArvoreBD* a, NoBD* x, int idx, NoBD* c) {
+    int t = a->t;
+    NoBD esq, dir;
+    int tem_esq = 0;
+
+    if (idx != 0) {
+        esq = bd_fixar(a, x->filhos[idx - 1]);
+        tem_esq = 1;
+        if (esq.p->n >= t) {
+            for (int i = c->p->n - 1; i >= 0; --i) {
+                c->chaves[i + 1] = c->chaves[i]; BD_MOVE();
+            }
+            if (!c->p->folha) {
+                for (int i = c->p->n; i >= 0; --i) {
+                    c->filhos[i + 1] = c->filhos[i]; BD_MOVE();
+                }
+            }
+            c->chaves[0] = x->chaves[idx - 1]; BD_MOVE();
+            if (!c->p->folha) c->filhos[0] = esq.filhos[esq.p->n], BD_MOVE();
+            x->chaves[idx - 1] = esq.chaves[esq.p->n - 1]; BD_MOVE();
+            c->p->n += 1; BD_MOVE();
+            esq.p->n -= 1; BD_MOVE();
+            bd_sujar(a, x); bd_sujar(a, c); bd_sujar(a, &esq);
+            bd_soltar(a, &esq);
+            return idx;
+        }
+    }
+    if (idx != x->p->n) {
+        dir = bd_fixar(a, x->filhos[idx + 1]);
+        if (dir.p->n >= t) {
+            c->chaves[c->p->n] = x->chaves[idx]; BD_MOVE();
+            if (!c->p->folha) c->filhos[c->p->n + 1] = dir.filhos[0], BD_MOVE();
+            x->chaves[idx] = dir.chaves[0]; BD_MOVE();
+            for (int i = 0; i < dir.p->n - 1; ++i) {
+                dir.chaves[i] = dir.chaves[i + 1]; BD_MOVE();
+            }
+            if (!dir.p->folha) {
+                for (int i = 0; i < dir.p->n; ++i) {
+                    dir.filhos[i] = dir.filhos[i + 1]; BD_MOVE();
+                }
+            }
+            c->p->n += 1; BD_MOVE();
+            dir.p->n -= 1; BD_MOVE();
+            bd_sujar(a, x); bd_sujar(a, c); bd_sujar(a, &dir);
+            bd_soltar(a, &dir);
+            if (tem_esq) bd_soltar(a, &esq);
+            return idx;
+        }
+        bd_merge(a, x, idx, c, &dir);
+        if (tem_esq) bd_soltar(a, &esq);
+        return idx;
+    }
+    bd_merge(a, x, idx - 1, &esq, c);
+    *c = esq;
+    return idx - 1;
+}
+
+/* x fixado; solta x no fim */
+static void bd_remove_from_node(ArvoreBD* a, NoBD x, int k) {
+    int t = a->t;
+    for (;;) {
+        int idx = 0;
+        while (idx < x.p->n && x.chaves[idx] < k) {
+            idx++;
+            BD_VISIT();
+        }
+
+        if (idx < x.p->n && x.chaves[idx] == k) {
+            if (x.p->folha) {
+                for (int i = idx + 1; i < x.p->n; ++i) {
+                    x.chaves[i - 1] = x.chaves[i]; BD_MOVE();
+                }
+                x.p->n--; BD_MOVE();
+                bd_sujar(a, &x);
+                bd_soltar(a, &x);
+                return;
+            }
+            NoBD c = bd_fixar(a, x.filhos[idx]);
+            if (c.p->n >= t) {
+                int pred = bd_get_pred(a, &c); BD_VISIT();
+                x.chaves[idx] = pred; BD_MOVE();
+                bd_sujar(a, &x);
+                bd_soltar(a, &x);
+                x = c;
+                k = pred;
+                continue;
+            }
+            NoBD d = bd_fixar(a, x.filhos[idx + 1]);
+            if (d.p->n >= t) {
+                int succ = bd_get_succ(a, &d); BD_VISIT();
+                x.chaves[idx] = succ; BD_MOVE();
+                bd_sujar(a, &x);
+                bd_soltar(a, &x);
+                bd_soltar(a, &c);
+                x = d;
+                k = succ;
+                continue;
+            }
+            bd_merge(a, &x, idx, &c, &d);
+            bd_soltar(a, &x);
+            x = c;
+        } else {
+            if (x.p->folha) {
+                bd_soltar(a, &x);
+                return;
+            }
+            NoBD c = bd_fixar(a, x.filhos[idx]);
+            if (c.p->n < t) bd_fill(a, &x, idx, &c);
+            bd_soltar(a, &x);
+            x = c;
+        }
+    }
+}
+
+int bd_remover_chave(ArvoreBD* a, int k) {
+    if (!a) return 0;
+    if (!bd_buscar(a, k)) return 0;
+
+    bd_remove_from_node(a, bd_fixar(a, a->meta.raiz), k);
+
+    NoBD r = bd_fixar(a, a->meta.raiz);
+    if (r.p->n == 0 && !r.p->folha) {
+        a->meta.raiz = r.filhos[0]; BD_MOVE();
+        bd_liberar_no(a, &r);
+    } else {
+        bd_soltar(a, &r);
+    }
+    BD_VISIT();
+    return 1;
+}
+
+/* esvazia a árvore: descarta o pool e trunca o arquivo */
+void bd_remover_tudo(ArvoreBD* a) {
+    if (!a) return;
+    for (uint32_t id = 1; id < a->meta.npaginas; id++) BD_FREE();
+    for (int q = 0; q < a->nq; q++) {
+        if (a->quadros[q].pagina != BD_NENHUMA) a->mapa[a->quadros[q].pagina] = -1;
+        a->quadros[q].pagina = BD_NENHUMA;
+        a->quadros[q].sujo = 0;
+        a->quadros[q].pinos = 0;
+        a->quadros[q].ref = 0;
+    }
+    if (ftruncate(a->fd, 0) != 0) perror("bd: ftruncate");
+    bd_nova_arvore(a);
+    BD_ALLOC();
+}
@@ -0,0 +1,414 @@
+// B^epsilon-tree (B-tree com buffers de mensagens nos nós internos)
+// Inserção e remoção não descem até a folha: viram mensagens (INS/DEL) no buffer
+// da raiz. Quando um buffer enche, as mensagens do filho mais carregado descem
+// de uma vez (flush); nas folhas as mensagens são aplicadas.
+// - folhas guardam as chaves (até 2t-1); internos guardam pivôs (cópias) e buffer
+// - o buffer de cada interno é um pool de cap mensagens com uma fila por filho,
+//   então rotear e descer um lote custa proporcional ao lote
+// - busca confere os buffers do caminho (mensagem mais nova vence)
+// - remoção confere antes se a chave está visível (be_buscar, buffers inclusos):
+//   devolve 0 sem mensagem se não está, 1 e enfileira DEL se está; folhas podem
+//   ficar vazias, não há merge
+// - semântica de conjunto: INS de chave existente não duplica
+// Contadores: mesmas categorias da B_mod.c + FLUSH (lotes descidos)
+// Exporta funções:
+//   ArvoreBE* be_criar(int);                 // buffer padrão (BE_FATOR_BUFFER * 2t)
+//   ArvoreBE* be_criar_buffer(int, int);     // ordem, capacidade do buffer
+//   void be_inserir(ArvoreBE*, int);
+//   int be_buscar(ArvoreBE*, int);
+//   int be_remover_chave(ArvoreBE*, int);
+//   void be_remover_tudo(ArvoreBE*);
+//   long be_get_insercao_and_reset();
+//   long be_get_remocao_and_reset();
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BE_FATOR_BUFFER 4   /* mensagens por filho no buffer padrão */
+
+enum { BE_INS, BE_DEL };
+
+typedef struct MsgBE {
+    int chave;
+    int tipo;
+    int prox;             // próxima da mesma fila (ou da lista livre); -1 = fim
+} MsgBE;
+
+typedef struct NoBE {
+    int *chaves;          // chaves (folha) ou pivôs (interno)
+    struct NoBE **filhos;
+    MsgBE *buffer;        // pool de mensagens (só internos)
+    int *cab, *cauda, *qtd; // fila de mensagens de cada filho, em ordem de chegada
+    int livre;            // primeira posição livre do pool
+    int n;                // número de chaves/pivôs
+    int nbuf;             // mensagens no buffer
+    int folha;            // 1 se folha
+} NoBE;
+
+typedef struct ArvoreBE {
+    NoBE* raiz;
+    int t;        // ordem mínima (t)
+    int cap_buffer;
+} ArvoreBE;
+
+static long BE_COUNT_VISIT = 0;
+static long BE_COUNT_MOVE  = 0;
+static long BE_COUNT_SPLIT = 0;
+static long BE_COUNT_MERGE = 0;
+static long BE_COUNT_ALLOC = 0;
+static long BE_COUNT_FREE  = 0;
+static long BE_COUNT_FLUSH = 0;
+
+long be_get_insercao_and_reset() {
+    long v = BE_COUNT_VISIT + BE_COUNT_MOVE + BE_COUNT_SPLIT + BE_COUNT_ALLOC + BE_COUNT_FLUSH;
+    BE_COUNT_VISIT = BE_COUNT_MOVE = BE_COUNT_SPLIT = BE_COUNT_MERGE = BE_COUNT_ALLOC = BE_COUNT_FREE = BE_COUNT_FLUSH = 0;
+    return v;
+}
+long be_get_remocao_and_reset() {
+    long v = BE_COUNT_VISIT + BE_COUNT_MOVE + BE_COUNT_MERGE + BE_COUNT_FREE + BE_COUNT_FLUSH;
+    BE_COUNT_VISIT = BE_COUNT_MOVE = BE_COUNT_SPLIT = BE_COUNT_MERGE = BE_COUNT_ALLOC = BE_COUNT_FREE = BE_COUNT_FLUSH = 0;
+    return v;
+}
+
+ArvoreBE* be_criar(int ordem);
+ArvoreBE* be_criar_buffer(int ordem, int cap_buffer);
+void be_inserir(ArvoreBE*, int);
+int be_buscar(ArvoreBE*, int);
+int be_remover_chave(ArvoreBE*, int);
+void be_remover_tudo(ArvoreBE*);
+
+#define BE_VISIT() (BE_COUNT_VISIT++)
+#define BE_MOVE()  (BE_COUNT_MOVE++)
+#define BE_SPLIT() (BE_COUNT_SPLIT++)
+#define BE_ALLOC() (BE_COUNT_ALLOC++)
+#define BE_FREE()  (BE_COUNT_FREE++)
+#define BE_FLUSH() (BE_COUNT_FLUSH++)
+
+static NoBE* be_novo_no(ArvoreBE* a, int folha) {
+    int t = a->t;
+    NoBE* x = (NoBE*) malloc(sizeof(NoBE));
+    x->folha = folha;
+    x->chaves = (int*) malloc(sizeof(int) * (2 * t - 1));
+    x->filhos = NULL;
+    x->buffer = NULL;
+    x->cab = x->cauda = x->qtd = NULL;
+    x->livre = -1;
+    x->n = 0;
+    x->nbuf = 0;
+    if (!folha) {
+        x->filhos = (NoBE**) calloc(2 * t, sizeof(NoBE*));
+        x->buffer = (MsgBE*) malloc(sizeof(MsgBE) * a->cap_buffer);
+        for (int i = 0; i < a->cap_buffer; i++) x->buffer[i].prox = i + 1;
+        x->buffer[a->cap_buffer - 1].prox = -1;
+        x->livre = 0;
+        x->cab = (int*) malloc(sizeof(int) * 3 * 2 * t);
+        x->cauda = x->cab + 2 * t;
+        x->qtd = x->cab + 4 * t;
+        for (int i = 0; i < 2 * t; i++) {
+            x->cab[i] = x->cauda[i] = -1;
+            x->qtd[i] = 0;
+        }
+    }
+    BE_ALLOC(); BE_MOVE();
+    return x;
+}
+
+static void be_liberar_no(NoBE* x) {
+    free(x->chaves); BE_FREE();
+    if (!x->folha) {
+        free(x->filhos); BE_FREE();
+        free(x->buffer); BE_FREE();
+        free(x->cab); BE_FREE();
+    }
+    free(x); BE_FREE();
+}
+
+ArvoreBE* be_criar_buffer(int ordem, int cap_buffer) {
+    if (ordem < 2) ordem = 2;
+    if (cap_buffer < 2) cap_buffer = 2;
+    ArvoreBE* a = (ArvoreBE*) malloc(sizeof(ArvoreBE));
+    a->t = ordem;
+    a->cap_buffer = cap_buffer;
+    a->raiz = be_novo_no(a, 1);
+    BE_ALLOC();
+    return a;
+}
+
+ArvoreBE* be_criar(int ordem) {
+    if (ordem < 2) ordem = 2;
+    return be_criar_buffer(ordem, BE_FATOR_BUFFER * 2 * ordem);
+}
+
+/* filho de x que cobre k: número de pivôs <= k (busca binária) */
+static int be_filho(NoBE* x, int k) {
+    int lo = 0, hi = x->n;
+    while (lo < hi) {
+        int m = (lo + hi) / 2;
+        BE_VISIT();
+        if (x->chaves[m] <= k) lo = m + 1;
+        else hi = m;
+    }
+    return lo;
+}
+
+/* posição de k na folha (primeira chave >= k) */
+static int be_pos_folha(NoBE* x, int k) {
+    int lo = 0, hi = x->n;
+    while (lo < hi) {
+        int m = (lo + hi) / 2;
+        BE_VISIT();
+        if (x->chaves[m] < k) lo = m + 1;
+        else hi = m;
+    }
+    return lo;
+}
+
+static int be_cheio(ArvoreBE* a, NoBE* x) {
+    return x->n == 2 * a->t - 1;
+}
+
+/* ----- filas do buffer ----- */
+
+/* liga a posição s no fim da fila do filho i */
+static void be_enfileirar(NoBE* x, int i, int s) {
+    x->buffer[s].prox = -1;
+    if (x->cauda[i] < 0) x->cab[i] = s;
+    else x->buffer[x->cauda[i]].prox = s;
+    x->cauda[i] = s;
+    x->qtd[i]++;
+}
+
+/* nova mensagem no buffer de x (há espaço), na fila do filho que cobre k */
+static void be_anexar(NoBE* x, int k, int tipo) {
+    int s = x->livre;
+    x->livre = x->buffer[s].prox;
+    x->buffer[s].chave = k;
+    x->buffer[s].tipo = tipo; BE_MOVE();
+    be_enfileirar(x, be_filho(x, k), s);
+    x->nbuf++;
+}
+
+/* devolve a posição s ao pool */
+static void be_devolver(NoBE* x, int s) {
+    x->buffer[s].prox = x->livre;
+    x->livre = s;
+    x->nbuf--;
+}
+
+/* esvazia a fila i e devolve sua cabeça */
+static int be_desligar(NoBE* x, int i) {
+    int s = x->cab[i];
+    x->cab[i] = x->cauda[i] = -1;
+    x->qtd[i] = 0;
+    return s;
+}
+
+/* aplica uma mensagem na folha; devolve 0 se é INS de chave nova e a folha está cheia */
+static int be_aplicar_folha(ArvoreBE* a, NoBE* x, int k, int tipo) {
+    int i = be_pos_folha(x, k);
+    int existe = (i < x->n && x->chaves[i] == k);
+    if (tipo == BE_INS) {
+        if (existe) return 1;
+        if (be_cheio(a, x)) return 0;
+        for (int j = x->n; j > i; j--) {
+            x->chaves[j] = x->chaves[j - 1]; BE_MOVE();
+        }
+        x->chaves[i] = k; BE_MOVE();
+        x->n++; BE_MOVE();
+    } else if (existe) {
+        for (int j = i + 1; j < x->n; j++) {
+            x->chaves[j - 1] = x->chaves[j]; BE_MOVE();
+        }
+        x->n--; BE_MOVE();
+    }
+    return 1;
+}
+
+/* split do filho cheio x->filhos[i] (x não está cheio).
+   Folha: metade de cima vai para z e z->chaves[0] é copiado como pivô.
+   Interno: pivô do meio sobe e as filas dos filhos de z mudam de pool.
+   Em x, a fila do filho i é repartida pelo novo pivô. */
+static void be_split_child(ArvoreBE* a, NoBE* x, int i) {
+    BE_SPLIT();
+    int t = a->t;
+    NoBE* y = x->filhos[i];
+    NoBE* z = be_novo_no(a, y->folha);
+    int pivo;
+
+    if (y->folha) {
+        int fica = y->n / 2;
+        z->n = y->n - fica;
+        for (int j = 0; j < z->n; j++) {
+            z->chaves[j] = y->chaves[fica + j]; BE_MOVE();
+        }
+        y->n = fica;
+        pivo = z->chaves[0];
+    } else {
+        z->n = t - 1;
+        for (int j = 0; j < t - 1; j++) {
+            z->chaves[j] = y->chaves[j + t]; BE_MOVE();
+        }
+        for (int j = 0; j < t; j++) {
+            z->filhos[j] = y->filhos[j + t]; BE_MOVE();
+            y->filhos[j + t] = NULL;
+        }
+        y->n = t - 1;
+        pivo = y->chaves[t - 1];
+        for (int j = 0; j < t; j++) {
+            for (int s = be_desligar(y, j + t); s >= 0; ) {
+                int prox = y->buffer[s].prox;
+                be_anexar(z, y->buffer[s].chave, y->buffer[s].tipo);
+                be_devolver(y, s);
+                s = prox;
+            }
+        }
+    }
+
+    for (int j = x->n; j >= i + 1; j--) {
+        x->filhos[j + 1] = x->filhos[j];
+        x->cab[j + 1] = x->cab[j];
+        x->cauda[j + 1] = x->cauda[j];
+        x->qtd[j + 1] = x->qtd[j]; BE_MOVE();
+    }
+    x->filhos[i + 1] = z; BE_MOVE();
+    for (int j = x->n - 1; j >= i; j--) {
+        x->chaves[j + 1] = x->chaves[j]; BE_MOVE();
+    }
+    x->chaves[i] = pivo; BE_MOVE();
+    x->n++; BE_MOVE();
+
+    x->cab[i + 1] = x->cauda[i + 1] = -1;
+    x->qtd[i + 1] = 0;
+    for (int s = be_desligar(x, i); s >= 0; ) {
+        int prox = x->buffer[s].prox;
+        BE_VISIT();
+        be_enfileirar(x, x->buffer[s].chave >= pivo ? i + 1 : i, s);
+        s = prox;
+    }
+}
+
+/* Desce do buffer de x (interno, não cheio) a fila do filho com mais mensagens.
+   Folhas que enchem são divididas; filhos internos com buffer cheio descem antes
+   (em cascata). Move pelo menos uma mensagem. */
+static void be_flush(ArvoreBE* a, NoBE* x) {
+    BE_FLUSH();
+    int c = 0;
+    for (int j = 1; j <= x->n; j++) {
+        BE_VISIT();
+        if (x->qtd[j] > x->qtd[c]) c = j;
+    }
+
+    /* o filho c pode se dividir no caminho: o lote cobre [c, ultimo] */
+    int ultimo = c, bloqueado = 0;
+    for (int s = be_desligar(x, c); s >= 0; ) {
+        int prox = x->buffer[s].prox;
+        int k = x->buffer[s].chave, tipo = x->buffer[s].tipo;
+        int i = c;
+        while (i < ultimo && k >= x->chaves[i]) {
+            i++; BE_VISIT();
+        }
+        NoBE* f = x->filhos[i];
+        if (!bloqueado) {
+            if (f->folha) {
+                if (!be_aplicar_folha(a, f, k, tipo)) {
+                    if (be_cheio(a, x)) {
+                        bloqueado = 1;
+                    } else {
+                        be_split_child(a, x, i); ultimo++;
+                        BE_VISIT();
+                        if (k >= x->chaves[i]) i++;
+                        be_aplicar_folha(a, x->filhos[i], k, tipo);
+                    }
+                }
+            } else if (f->nbuf == a->cap_buffer) {
+                if (!be_cheio(a, f)) {
+                    be_flush(a, f);
+                } else if (!be_cheio(a, x)) {
+                    be_split_child(a, x, i); ultimo++;
+                    BE_VISIT();
+                    if (k >= x->chaves[i]) i++;
+                    f = x->filhos[i];
+                    if (f->nbuf == a->cap_buffer) be_flush(a, f);
+                } else {
+                    bloqueado = 1;
+                }
+                if (!bloqueado) be_anexar(f, k, tipo);
+            } else {
+                be_anexar(f, k, tipo);
+            }
+        }
+        if (bloqueado) be_enfileirar(x, i, s); /* x e o filho cheios: espera o próximo flush */
+        else be_devolver(x, s);
+        s = prox;
+    }
+}
+
+/* nova raiz acima da atual, dividindo-a */
+static NoBE* be_crescer(ArvoreBE* a) {
+    NoBE* s = be_novo_no(a, 0);
+    s->filhos[0] = a->raiz; BE_MOVE();
+    a->raiz = s; BE_MOVE();
+    be_split_child(a, s, 0);
+    return s;
+}
+
+static void be_mensagem(ArvoreBE* a, int k, int tipo) {
+    BE_VISIT();
+    NoBE* r = a->raiz;
+    if (r->folha) {
+        if (be_aplicar_folha(a, r, k, tipo)) return;
+        r = be_crescer(a);
+        be_aplicar_folha(a, r->filhos[be_filho(r, k)], k, tipo);
+        return;
+    }
+    /* buffer cheio: desce um lote (ou cresce a árvore, se a raiz também está cheia) */
+    while (r->nbuf == a->cap_buffer) {
+        if (be_cheio(a, r)) r = be_crescer(a);
+        else be_flush(a, r);
+    }
+    be_anexar(r, k, tipo);
+}
+
+void be_inserir(ArvoreBE* a, int k) {
+    be_mensagem(a, k, BE_INS);
+}
+
+/* o retorno pede uma descida até a chave (como nas outras árvores): a
+   remoção paga a busca, mas uma chave ausente não gera mensagem */
+int be_remover_chave(ArvoreBE* a, int k) {
+    if (!a || !be_buscar(a, k)) return 0;
+    be_mensagem(a, k, BE_DEL);
+    return 1;
+}
+
+/* busca: a mensagem mais nova do caminho (de cima para baixo, fim da fila) decide */
+int be_buscar(ArvoreBE* a, int k) {
+    NoBE* x = a->raiz;
+    while (!x->folha) {
+        int i = be_filho(x, k);
+        int tipo = -1;
+        for (int s = x->cab[i]; s >= 0; s = x->buffer[s].prox) {
+            BE_VISIT();
+            if (x->buffer[s].chave == k) tipo = x->buffer[s].tipo;
+        }
+        if (tipo >= 0) return tipo == BE_INS;
+        x = x->filhos[i];
+    }
+    int i = be_pos_folha(x, k);
+    return i < x->n && x->chaves[i] == k;
+}
+
+static void be_liberar(NoBE* no) {
+    if (!no) return;
+    if (!no->folha) {
+        for (int i = 0; i <= no->n; ++i) be_liberar(no->filhos[i]);
+    }
+    be_liberar_no(no);
+}
+
+void be_remover_tudo(ArvoreBE* a) {
+    if (!a) return;
+    be_liberar(a->raiz);
+    a->raiz = be_novo_no(a, 1); BE_ALLOC();
+}
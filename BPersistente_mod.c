@@ -0,0 +1,464 @@
+// B-tree persistente (copy-on-write) com snapshots O(1)
+// - mesmo algoritmo top-down da B_mod.c (split antes de descer, fill antes de descer)
+// - cada nó tem um contador de referências (pais + raízes que apontam para ele);
+//   o escritor só altera nó com refs == 1; se o nó é compartilhado, copia-o antes
+//   (copia apenas os nós que a operação toca: caminho + irmãos de split/fill)
+// - bp_snapshot() pega uma referência para a raiz atual: a versão fica imutável
+//   enquanto o snapshot existir e pode ser lida por outra thread sem trava
+// - bp_snap_liberar() solta a referência; nós que chegam a refs == 0 são liberados
+//   (soltando por sua vez os filhos)
+// Escritas e bp_snapshot são serializadas por um mutex (um escritor por vez).
+// Contadores (por thread): VISIT, MOVE, SPLIT, MERGE, ALLOC, FREE e COPY
+// (chaves/ponteiros copiados ao duplicar nós compartilhados).
+// Exporta funções:
+//   ArvoreBP* bp_criar(int);
+//   void bp_inserir(ArvoreBP*, int);
+//   int bp_remover_chave(ArvoreBP*, int);
+//   int bp_buscar(ArvoreBP*, int);
+//   void bp_destruir(ArvoreBP*);
+//   SnapshotBP* bp_snapshot(ArvoreBP*);
+//   int bp_snap_buscar(SnapshotBP*, int);
+//   long bp_snap_percorrer(SnapshotBP*, void (*)(int, void*), void*);
+//   void bp_snap_liberar(SnapshotBP*);
+//   long bp_get_copia();
+//   long bp_get_insercao_and_reset();
+//   long bp_get_remocao_and_reset();
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+typedef struct NoBP {
+    int *chaves;
+    struct NoBP **filhos;
+    int n;        // número de chaves atualmente
+    int folha;    // 1 se folha
+    atomic_int refs;
+} NoBP;
+
+typedef struct ArvoreBP {
+    NoBP* raiz;
+    int t; // ordem mínima (t)
+    pthread_mutex_t escritor;
+} ArvoreBP;
+
+typedef struct SnapshotBP {
+    NoBP* raiz;
+} SnapshotBP;
+
+static _Thread_local long BP_COUNT_VISIT = 0;
+static _Thread_local long BP_COUNT_MOVE  = 0;
+static _Thread_local long BP_COUNT_SPLIT = 0;
+static _Thread_local long BP_COUNT_MERGE = 0;
+static _Thread_local long BP_COUNT_ALLOC = 0;
+static _Thread_local long BP_COUNT_FREE  = 0;
+static _Thread_local long BP_COUNT_COPY  = 0;
+
+long bp_get_copia() {
+    return BP_COUNT_COPY;
+}
+long bp_get_insercao_and_reset() {
+    long v = BP_COUNT_VISIT + BP_COUNT_MOVE + BP_COUNT_SPLIT + BP_COUNT_ALLOC + BP_COUNT_COPY;
+    BP_COUNT_VISIT = BP_COUNT_MOVE = BP_COUNT_SPLIT = BP_COUNT_MERGE = BP_COUNT_ALLOC = BP_COUNT_FREE = BP_COUNT_COPY = 0;
+    return v;
+}
+long bp_get_remocao_and_reset() {
+    long v = BP_COUNT_VISIT + BP_COUNT_MOVE + BP_COUNT_MERGE + BP_COUNT_FREE + BP_COUNT_COPY;
+    BP_COUNT_VISIT = BP_COUNT_MOVE = BP_COUNT_SPLIT = BP_COUNT_MERGE = BP_COUNT_ALLOC = BP_COUNT_FREE = BP_COUNT_COPY = 0;
+    return v;
+}
+
+ArvoreBP* bp_criar(int ordem);
+void bp_inserir(ArvoreBP*, int);
+int bp_remover_chave(ArvoreBP*, int);
+int bp_buscar(ArvoreBP*, int);
+void bp_destruir(ArvoreBP*);
+SnapshotBP* bp_snapshot(ArvoreBP*);
+int bp_snap_buscar(SnapshotBP*, int);
+long bp_snap_percorrer(SnapshotBP*, void (*)(int, void*), void*);
+void bp_snap_liberar(SnapshotBP*);
+
+#define BP_VISIT() (BP_COUNT_VISIT++)
+#define BP_MOVE()  (BP_COUNT_MOVE++)
+#define BP_SPLIT() (BP_COUNT_SPLIT++)
+#define BP_MERGE() (BP_COUNT_MERGE++)
+#define BP_ALLOC() (BP_COUNT_ALLOC++)
+#define BP_FREE()  (BP_COUNT_FREE++)
+#define BP_COPY()  (BP_COUNT_COPY++)
+
+static NoBP* bp_novo_no(int t, int folha) {
+    NoBP* x = (NoBP*) malloc(sizeof(NoBP));
+    x->folha = folha;
+    x->chaves = (int*) malloc(sizeof(int) * (2 * t - 1));
+    x->filhos = folha ? NULL : (NoBP**) calloc(2 * t, sizeof(NoBP*));
+    x->n = 0;
+    atomic_init(&x->refs, 1);
+    BP_ALLOC(); BP_MOVE();
+    return x;
+}
+
+static void bp_liberar_no(NoBP* x) {
+    free(x->chaves); BP_FREE();
+    if (x->filhos) free(x->filhos), BP_FREE();
+    free(x); BP_FREE();
+}
+
+/* ----- contagem de referências ----- */
+
+static void bp_pegar(NoBP* x) {
+    atomic_fetch_add_explicit(&x->refs, 1, memory_order_relaxed);
+}
+
+/* solta uma referência; o último a soltar libera o nó e solta os filhos */
+static void bp_soltar(NoBP* x) {
+    if (atomic_fetch_sub_explicit(&x->refs, 1, memory_order_acq_rel) != 1) return;
+    if (!x->folha) {
+        for (int i = 0; i <= x->n; i++) bp_soltar(x->filhos[i]);
+    }
+    bp_liberar_no(x);
+}
+
+static int bp_exclusivo(NoBP* x) {
+    return atomic_load_explicit(&x->refs, memory_order_acquire) == 1;
+}
+
+/* cópia privada de um nó compartilhado (os filhos passam a ter mais um pai) */
+static NoBP* bp_copiar(NoBP* x, int t) {
+    NoBP* y = bp_novo_no(t, x->folha);
+    y->n = x->n;
+    for (int i = 0; i < x->n; i++) {
+        y->chaves[i] = x->chaves[i]; BP_COPY();
+    }
+    if (!x->folha) {
+        for (int i = 0; i <= x->n; i++) {
+            y->filhos[i] = x->filhos[i]; BP_COPY();
+            bp_pegar(y->filhos[i]);
+        }
+    }
+    return y;
+}
+
+/* x é exclusivo: garante que x->filhos[i] também seja e o devolve */
+static NoBP* bp_mutavel(NoBP* x, int i, int t) {
+    NoBP* c = x->filhos[i];
+    if (bp_exclusivo(c)) return c;
+    NoBP* y = bp_copiar(c, t);
+    x->filhos[i] = y; BP_MOVE();
+    bp_soltar(c);
+    return y;
+}
+
+static NoBP* bp_raiz_mutavel(ArvoreBP* a) {
+    NoBP* r = a->raiz;
+    if (bp_exclusivo(r)) return r;
+    NoBP* y = bp_copiar(r, a->t);
+    a->raiz = y; BP_MOVE();
+    bp_soltar(r);
+    return y;
+}
+
+ArvoreBP* bp_criar(int ordem) {
+    if (ordem < 2) ordem = 2;
+    ArvoreBP* a = (ArvoreBP*) malloc(sizeof(ArvoreBP));
+    a->t = ordem;
+    a->raiz = bp_novo_no(ordem, 1);
+    pthread_mutex_init(&a->escritor, NULL);
+    BP_ALLOC();
+    return a;
+}
+
+/* busca a partir de um nó (só leitura; vale para qualquer versão) */
+static int bp_buscar_no(NoBP* x, int k) {
+    while (x) {
+        int i = 0;
+        while (i < x->n && k > x->chaves[i]) {
+            BP_VISIT();
+            i++;
+        }
+        if (i < x->n && k == x->chaves[i]) return 1;
+        if (x->folha) return 0;
+        x = x->filhos[i];
+    }
+    return 0;
+}
+
+/* ----- inserção ----- */
+
+/* split do filho cheio x->filhos[i] (x exclusivo) */
+static void bp_split_child(NoBP* x, int i, int t) {
+    BP_SPLIT();
+    NoBP* y = bp_mutavel(x, i, t);
+    NoBP* z = bp_novo_no(t, y->folha);
+    z->n = t - 1;
+    for (int j = 0; j < t - 1; j++) {
+        z->chaves[j] = y->chaves[j + t]; BP_MOVE();
+    }
+    if (!y->folha) {
+        /* os filhos mudam de pai: a referência vai junto */
+        for (int j = 0; j < t; j++) {
+            z->filhos[j] = y->filhos[j + t]; BP_MOVE();
+            y->filhos[j + t] = NULL;
+        }
+    }
+    y->n = t - 1;
+
+    for (int j = x->n; j >= i + 1; j--) {
+        x->filhos[j + 1] = x->filhos[j]; BP_MOVE();
+    }
+    x->filhos[i + 1] = z; BP_MOVE();
+    for (int j = x->n - 1; j >= i; j--) {
+        x->chaves[j + 1] = x->chaves[j]; BP_MOVE();
+    }
+    x->chaves[i] = y->chaves[t - 1]; BP_MOVE();
+    x->n = x->n + 1; BP_MOVE();
+}
+
+static void bp_insert_nonfull(NoBP* x, int k, int t) {
+    for (;;) {
+        BP_VISIT();
+        int i = x->n - 1;
+        if (x->folha) {
+            while (i >= 0 && x->chaves[i] > k) {
+                x->chaves[i + 1] = x->chaves[i]; BP_MOVE();
+                i--;
+                BP_VISIT();
+            }
+            x->chaves[i + 1] = k; BP_MOVE();
+            x->n = x->n + 1; BP_MOVE();
+            return;
+        }
+        while (i >= 0 && x->chaves[i] > k) {
+            i--;
+            BP_VISIT();
+        }
+        i++;
+        if (x->filhos[i]->n == 2 * t - 1) {
+            bp_split_child(x, i, t);
+            if (x->chaves[i] < k) i++;
+        }
+        x = bp_mutavel(x, i, t);
+    }
+}
+
+void bp_inserir(ArvoreBP* a, int k) {
+    pthread_mutex_lock(&a->escritor);
+    BP_VISIT();
+    NoBP* r = a->raiz;
+    if (r->n == 2 * a->t - 1) {
+        /* a nova raiz herda a referência que a árvore tinha para r */
+        NoBP* s = bp_novo_no(a->t, 0); BP_MOVE();
+        a->raiz = s; BP_MOVE();
+        s->filhos[0] = r; BP_MOVE();
+        bp_split_child(s, 0, a->t);
+        int i = 0;
+        if (s->chaves[0] < k) i++;
+        bp_insert_nonfull(bp_mutavel(s, i, a->t), k, a->t);
+    } else {
+        bp_insert_nonfull(bp_raiz_mutavel(a), k, a->t);
+    }
+    pthread_mutex_unlock(&a->escritor);
+}
+
+/* ----- remoção ----- */
+
+static int bp_get_pred(NoBP* x, int idx) {
+    NoBP* cur = x->filhos[idx];
+    while (!cur->folha) {
+        BP_VISIT();
+        cur = cur->filhos[cur->n];
+    }
+    return cur->chaves[cur->n - 1];
+}
+
+static int bp_get_succ(NoBP* x, int idx) {
+    NoBP* cur = x->filhos[idx + 1];
+    while (!cur->folha) {
+        BP_VISIT();
+        cur = cur->filhos[0];
+    }
+    return cur->chaves[0];
+}
+
+/* funde x->filhos[idx+1] em x->filhos[idx] (x exclusivo, ambos com t-1 chaves) */
+static NoBP* bp_merge(NoBP* x, int idx, int t) {
+    NoBP* child = bp_mutavel(x, idx, t);
+    NoBP* sibling = x->filhos[idx + 1];
+    int compartilhado = !bp_exclusivo(sibling);
+    child->chaves[t - 1] = x->chaves[idx]; BP_MOVE();
+    for (int i = 0; i < sibling->n; ++i) {
+        child->chaves[i + t] = sibling->chaves[i]; BP_MOVE(); BP_MERGE();
+    }
+    if (!child->folha) {
+        for (int i = 0; i <= sibling->n; ++i) {
+            child->filhos[i + t] = sibling->filhos[i]; BP_MOVE(); BP_MERGE();
+            if (compartilhado) bp_pegar(sibling->filhos[i]);
+        }
+    }
+    for (int i = idx + 1; i < x->n; ++i) {
+        x->chaves[i - 1] = x->chaves[i]; BP_MOVE();
+        x->filhos[i] = x->filhos[i + 1]; BP_MOVE();
+    }
+    x->filhos[x->n] = NULL; BP_MOVE();
+    child->n += sibling->n + 1; BP_MOVE();
+    x->n--; BP_MOVE();
+    /* exclusivo: os filhos foram transferidos, libera só o nó */
+    if (compartilhado) bp_soltar(sibling);
+    else bp_liberar_no(sibling);
+    return child;
+}
+
+/* garante que x->filhos[idx] tenha >= t chaves; devolve o índice do filho a descer */
+static int bp_fill(NoBP* x, int idx, int t) {
+    if (idx != 0 && x->filhos[idx - 1]->n >= t) {
+        NoBP* child = bp_mutavel(x, idx, t);
+        NoBP* sibling = bp_mutavel(x, idx - 1, t);
+        for (int i = child->n - 1; i >= 0; --i) {
+            child->chaves[i + 1] = child->chaves[i]; BP_MOVE();
+        }
+        if (!child->folha) {
+            for (int i = child->n; i >= 0; --i) {
+                child->filhos[i + 1] = child->filhos[i]; BP_MOVE();
+            }
+        }
+        child->chaves[0] = x->chaves[idx - 1]; BP_MOVE();
+        if (!child->folha) child->filhos[0] = sibling->filhos[sibling->n], BP_MOVE();
+        x->chaves[idx - 1] = sibling->chaves[sibling->n - 1]; BP_MOVE();
+        child->n += 1; BP_MOVE();
+        sibling->n -= 1; BP_MOVE();
+        return idx;
+    }
+    if (idx != x->n && x->filhos[idx + 1]->n >= t) {
+        NoBP* child = bp_mutavel(x, idx, t);
+        NoBP* sibling = bp_mutavel(x, idx + 1, t);
+        child->chaves[child->n] = x->chaves[idx]; BP_MOVE();
+        if (!child->folha) child->filhos[child->n + 1] = sibling->filhos[0], BP_MOVE();
+        x->chaves[idx] = sibling->chaves[0]; BP_MOVE();
+        for (int i = 0; i < sibling->n - 1; ++i) {
+            sibling->chaves[i] = sibling->chaves[i + 1]; BP_MOVE();
+        }
+        if (!sibling->folha) {
+            for (int i = 0; i < sibling->n; ++i) {
+                sibling->filhos[i] = sibling->filhos[i + 1]; BP_MOVE();
+            }
+        }
+        child->n += 1; BP_MOVE();
+        sibling->n -= 1; BP_MOVE();
+        return idx;
+    }
+    if (idx != x->n) {
+        bp_merge(x, idx, t);
+        return idx;
+    }
+    bp_merge(x, idx - 1, t);
+    return idx - 1;
+}
+
+/* x exclusivo */
+static void bp_remove_from_node(NoBP* x, int k, int t) {
+    for (;;) {
+        int idx = 0;
+        while (idx < x->n && x->chaves[idx] < k) {
+            idx++;
+            BP_VISIT();
+        }
+
+        if (idx < x->n && x->chaves[idx] == k) {
+            if (x->folha) {
+                for (int i = idx + 1; i < x->n; ++i) {
+                    x->chaves[i - 1] = x->chaves[i]; BP_MOVE();
+                }
+                x->n--; BP_MOVE();
+                return;
+            }
+            if (x->filhos[idx]->n >= t) {
+                int pred = bp_get_pred(x, idx); BP_VISIT();
+                x->chaves[idx] = pred; BP_MOVE();
+                x = bp_mutavel(x, idx, t);
+                k = pred;
+            } else if (x->filhos[idx + 1]->n >= t) {
+                int succ = bp_get_succ(x, idx); BP_VISIT();
+                x->chaves[idx] = succ; BP_MOVE();
+                x = bp_mutavel(x, idx + 1, t);
+                k = succ;
+            } else {
+                x = bp_merge(x, idx, t);
+            }
+        } else {
+            if (x->folha) return;
+            if (x->filhos[idx]->n < t) idx = bp_fill(x, idx, t);
+            x = bp_mutavel(x, idx, t);
+        }
+    }
+}
+
+int bp_remover_chave(ArvoreBP* a, int k) {
+    if (!a) return 0;
+    pthread_mutex_lock(&a->escritor);
+    if (!bp_buscar_no(a->raiz, k)) {
+        pthread_mutex_unlock(&a->escritor);
+        return 0;
+    }
+
+    NoBP* r = bp_raiz_mutavel(a);
+    bp_remove_from_node(r, k, a->t);
+
+    if (r->n == 0 && !r->folha) {
+        a->raiz = r->filhos[0]; BP_MOVE();
+        bp_liberar_no(r); /* a referência de r para o filho passa para a árvore */
+    }
+    BP_VISIT();
+    pthread_mutex_unlock(&a->escritor);
+    return 1;
+}
+
+/* busca na versão corrente (mesma thread do escritor ou sob a mesma trava) */
+int bp_buscar(ArvoreBP* a, int k) {
+    if (!a) return 0;
+    return bp_buscar_no(a->raiz, k);
+}
+
+void bp_destruir(ArvoreBP* a) {
+    if (!a) return;
+    bp_soltar(a->raiz);
+    pthread_mutex_destroy(&a->escritor);
+    free(a);
+}
+
+/* ----- snapshots ----- */
+
+SnapshotBP* bp_snapshot(ArvoreBP* a) {
+    SnapshotBP* s = (SnapshotBP*) malloc(sizeof(SnapshotBP));
+    pthread_mutex_lock(&a->escritor);
+    s->raiz = a->raiz;
+    bp_pegar(s->raiz);
+    pthread_mutex_unlock(&a->escritor);
+    return s;
+}
+
+int bp_snap_buscar(SnapshotBP* s, int k) {
+    return bp_buscar_no(s->raiz, k);
+}
+
+static long bp_percorrer_rec(NoBP* x, void (*f)(int, void*), void* ctx) {
+    long c = 0;
+    for (int i = 0; i < x->n; i++) {
+        if (!x->folha) c += bp_percorrer_rec(x->filhos[i], f, ctx);
+        if (f) f(x->chaves[i], ctx);
+        c++;
+    }
+    if (!x->folha) c += bp_percorrer_rec(x->filhos[x->n], f, ctx);
+    return c;
+}
+
+/* percurso em ordem da versão do snapshot; devolve o número de chaves */
+long bp_snap_percorrer(SnapshotBP* s, void (*f)(int, void*), void* ctx) {
+    return bp_percorrer_rec(s->raiz, f, ctx);
+}
+
+void bp_snap_liberar(SnapshotBP* s) {
+    if (!s) return;
+    bp_soltar(s->raiz);
+    free(s);
+}
@@ -3,6 +3,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <time.h>
 
 typedef struct NoB {
     int *chaves;
@@ -14,14 +16,26 @@ typedef struct NoB {
 typedef struct ArvoreB {
     NoB* raiz;
     int t; // ordem mínima (t)
+    NoB* folha_direita;   // cache de b_anexar (NULL = recalcular)
+    int borda_irregular;  // b_anexar deixou nós abaixo do mínimo na borda direita
+    double limiar_preguica;   // > 0: remoção preguiçosa (b_definir_remocao_preguicosa)
+    int preg_pendente;        // remoções preguiçosas deixaram nós abaixo do mínimo
+    long preg_chaves, preg_nos; // chaves e nós na última reorganização (base da estimativa)
+    long preg_removidas;      // remoções preguiçosas desde então
 } ArvoreB;
 
-static long B_COUNT_VISIT = 0;
-static long B_COUNT_MOVE  = 0;
-static long B_COUNT_SPLIT = 0;
-static long B_COUNT_MERGE = 0;
-static long B_COUNT_ALLOC = 0;
-static long B_COUNT_FREE  = 0;
+// por thread: a carga paralela soma os das threads auxiliares em quem chamou
+static _Thread_local long B_COUNT_VISIT = 0;
+static _Thread_local long B_COUNT_MOVE  = 0;
+static _Thread_local long B_COUNT_SPLIT = 0;
+static _Thread_local long B_COUNT_MERGE = 0;
+static _Thread_local long B_COUNT_ALLOC = 0;
+static _Thread_local long B_COUNT_FREE  = 0;
+static _Thread_local long B_COUNT_REBAL = 0;  // redistribuições/fusões da remoção (1 por operação)
+static _Thread_local long B_COUNT_ADIADO = 0; // remoções preguiçosas que deixaram nó abaixo do mínimo
+static _Thread_local long B_COUNT_REORG = 0;  // custo de b_reorganizar (fora das somas acima)
+static _Thread_local long B_COUNT_DIVISAO = 0; // divisões de nó na inserção (fora das somas)
+static _Thread_local long B_COUNT_REDIST = 0;  // redistribuições com irmão em b_inserir_ascendente
 
 long b_get_insercao_and_reset() {
     long v = B_COUNT_VISIT + B_COUNT_MOVE + B_COUNT_SPLIT + B_COUNT_ALLOC;
@@ -33,11 +47,71 @@ long b_get_remocao_and_reset() {
     B_COUNT_VISIT = B_COUNT_MOVE = B_COUNT_SPLIT = B_COUNT_MERGE = B_COUNT_ALLOC = B_COUNT_FREE = 0;
     return v;
 }
+/* remoção preguiçosa: rebalanceamentos feitos, adiados e custo das reorganizações */
+long b_get_rebalanceamento_and_reset() {
+    long v = B_COUNT_REBAL;
+    B_COUNT_REBAL = 0;
+    return v;
+}
+long b_get_adiados_and_reset() {
+    long v = B_COUNT_ADIADO;
+    B_COUNT_ADIADO = 0;
+    return v;
+}
+long b_get_reorganizacao_and_reset() {
+    long v = B_COUNT_REORG;
+    B_COUNT_REORG = 0;
+    return v;
+}
+/* inserção: divisões de nó e redistribuições (b_inserir_ascendente) */
+long b_get_divisoes_and_reset() {
+    long v = B_COUNT_DIVISAO;
+    B_COUNT_DIVISAO = 0;
+    return v;
+}
+long b_get_redistribuicoes_and_reset() {
+    long v = B_COUNT_REDIST;
+    B_COUNT_REDIST = 0;
+    return v;
+}
 
 ArvoreB* b_criar(int ordem);
 void b_inserir(ArvoreB*, int);
 int b_remover_chave(ArvoreB*, int);
+void b_inserir_lote(ArvoreB*, const int*, int);
+int b_remover_lote(ArvoreB*, const int*, int);
 void b_remover_tudo(ArvoreB*);
+void b_anexar(ArvoreB*, int);
+double b_ocupacao(ArvoreB*);
+int b_altura(ArvoreB*);                         // níveis (0 = vazia); muda só na divisão/fusão da raiz
+long b_remover_intervalo(ArvoreB*, int, int);   // remove todas as chaves em [lo, hi]; retorna quantas
+ArvoreB* b_carregar_paralelo(int, const int*, int, int, double); // ordem, chaves, n, threads, ocupação
+void b_definir_remocao_preguicosa(ArvoreB*, double); // limiar de ocupação (<= 0 desliga; máx. 0.5)
+void b_reorganizar(ArvoreB*);                        // remonta a árvore (corrige remoções preguiçosas)
+void b_inserir_ascendente(ArvoreB*, int);            // divide só no transbordo; antes tenta um irmão
+static int b_remover_preguicosa(ArvoreB*, int);
+typedef struct ArvoreBCompacta ArvoreBCompacta;
+ArvoreBCompacta* b_compactar(ArvoreB*);          // cópia só leitura com chaves por deslocamento
+int b_compacta_buscar(ArvoreBCompacta*, int);
+long b_compacta_percorrer(ArvoreBCompacta*, void (*)(int, int, void*), void*);
+long b_compacta_bytes(ArvoreBCompacta*);
+double b_compacta_fracao_largura(ArvoreBCompacta*, int);
+void b_compacta_liberar(ArvoreBCompacta*);
+long b_bytes(ArvoreB*);
+static void b_reparar_borda(ArvoreB*);
+static void b_contar_nos(NoB*, long*, long*);
+int b_buscar_chave(ArvoreB*, int);
+int b_ordem_auto();                                  // ordem de b_criar(B_ORDEM_AUTO)
+void b_definir_ordem_auto(int);                      // fixa a ordem automática (< 1: relê o arquivo)
+int b_ordem_carregar(const char*);                   // ordem automática de um arquivo de b_calibrar; 0 se inválido
+int b_calibrar(long, double, long, const char*, void (*)(int, double, double, void*), void*);
+int b_definir_arena(int, int);                       // nós numa arena (modo, NUMA; Arena_mod.c); retorna o modo efetivo
+void b_arena_estado(int*, int*, long*);              // modo e NUMA efetivos, bytes mapeados
+static void b_liberar_no(NoB*);
+
+#define B_ORDEM_AUTO (-1)            // b_criar(B_ORDEM_AUTO): ordem calibrada (b_calibrar)
+#define B_ORDEM_PADRAO 16            // sem calibração salva
+#define B_ORDEM_ARQUIVO "b_ordem.cfg"
 
 #define B_VISIT() (B_COUNT_VISIT++)
 #define B_MOVE()  (B_COUNT_MOVE++)
@@ -45,14 +119,39 @@ void b_remover_tudo(ArvoreB*);
 #define B_MERGE() (B_COUNT_MERGE++)
 #define B_ALLOC() (B_COUNT_ALLOC++)
 #define B_FREE()  (B_COUNT_FREE++)
+#define B_REBAL() (B_COUNT_REBAL++)
+
+/* nós numa arena com páginas grandes / política NUMA (ver Arena_mod.c).
+   Com a arena ligada o nó, as chaves e os filhos são um objeto só:
+   [NoB | chaves | filhos]; sem bloco na arena, volta aos três malloc.
+   Os contadores são os mesmos nos dois formatos. */
+#include "Arena_mod.c"
+static Arena B_ARENA = ARENA_INICIAL;
+
+#define B_NO_CAB ((sizeof(NoB) + 7) & ~(size_t) 7)
+
+int b_definir_arena(int modo, int numa) {
+    return arena_definir(&B_ARENA, modo, numa);
+}
+
+void b_arena_estado(int* modo, int* numa, long* bytes) {
+    arena_estado(&B_ARENA, modo, numa, bytes);
+}
 
 NoB* b_novo_no(int t, int folha) {
-    NoB* x = (NoB*) malloc(sizeof(NoB));
-    x->folha = folha;
     int keys_size = (2 * t - 1 > 0) ? (2 * t - 1) : 1;
     int childs_size = (2 * t > 0) ? (2 * t) : 1;
-    x->chaves = (int*) malloc(sizeof(int) * keys_size);
-    x->filhos = (NoB**) malloc(sizeof(NoB*) * childs_size);
+    size_t ch = (sizeof(int) * keys_size + 7) & ~(size_t) 7;
+    NoB* x = (NoB*) arena_reservar(&B_ARENA, B_NO_CAB + ch + sizeof(NoB*) * childs_size);
+    if (x) {
+        x->chaves = (int*) ((char*) x + B_NO_CAB);
+        x->filhos = (NoB**) ((char*) x + B_NO_CAB + ch);
+    } else {
+        x = (NoB*) malloc(sizeof(NoB));
+        x->chaves = (int*) malloc(sizeof(int) * keys_size);
+        x->filhos = (NoB**) malloc(sizeof(NoB*) * childs_size);
+    }
+    x->folha = folha;
     x->n = 0;
     for (int i = 0; i < childs_size; i++) x->filhos[i] = NULL;
     B_ALLOC(); B_MOVE();
@@ -60,10 +159,16 @@ NoB* b_novo_no(int t, int folha) {
 }
 
 ArvoreB* b_criar(int ordem) {
+    if (ordem == B_ORDEM_AUTO) ordem = b_ordem_auto();
     if (ordem < 1) ordem = 1;
     ArvoreB* a = (ArvoreB*) malloc(sizeof(ArvoreB));
     a->t = ordem;
     a->raiz = b_novo_no(ordem, 1);
+    a->folha_direita = NULL;
+    a->borda_irregular = 0;
+    a->limiar_preguica = 0;
+    a->preg_pendente = 0;
+    a->preg_chaves = a->preg_nos = a->preg_removidas = 0;
     B_ALLOC();
     return a;
 }
@@ -82,9 +187,34 @@ int b_buscar(NoB* x, int k) {
     return b_buscar(x->filhos[i], k);
 }
 
+/* busca pública a partir da raiz */
+int b_buscar_chave(ArvoreB* a, int k) {
+    if (!a) return 0;
+    return b_buscar(a->raiz, k);
+}
+
+/* percurso em ordem: cb(chave, 1, ctx) por ocorrência (duplicatas aparecem repetidas) */
+static long b_percorrer_rec(NoB* x, void (*cb)(int, int, void*), void* ctx) {
+    if (!x) return 0;
+    long c = 0;
+    for (int i = 0; i < x->n; i++) {
+        if (!x->folha) c += b_percorrer_rec(x->filhos[i], cb, ctx);
+        cb(x->chaves[i], 1, ctx);
+        c++;
+    }
+    if (!x->folha) c += b_percorrer_rec(x->filhos[x->n], cb, ctx);
+    return c;
+}
+
+long b_percorrer(ArvoreB* a, void (*cb)(int, int, void*), void* ctx) {
+    if (!a) return 0;
+    return b_percorrer_rec(a->raiz, cb, ctx);
+}
+
 /* split child (instrumentado) */
 void b_split_child(NoB* x, int i, int t) {
     B_SPLIT();
+    B_COUNT_DIVISAO++;
     NoB* y = x->filhos[i];
     NoB* z = b_novo_no(t, y->folha);
     z->n = t - 1;
@@ -119,17 +249,23 @@ void b_split_child(NoB* x, int i, int t) {
     x->n = x->n + 1; B_MOVE();
 }
 
+/* insere k numa folha não cheia (desloca da direita) */
+static void b_inserir_na_folha(NoB* x, int k) {
+    int i = x->n - 1;
+    while (i >= 0 && x->chaves[i] > k) {
+        x->chaves[i + 1] = x->chaves[i]; B_MOVE();
+        i--;
+        B_VISIT();
+    }
+    x->chaves[i + 1] = k; B_MOVE();
+    x->n = x->n + 1; B_MOVE();
+}
+
 void b_insert_nonfull(NoB* x, int k, int t) {
     B_VISIT();
     int i = x->n - 1;
     if (x->folha) {
-        while (i >= 0 && x->chaves[i] > k) {
-            x->chaves[i + 1] = x->chaves[i]; B_MOVE();
-            i--;
-            B_VISIT();
-        }
-        x->chaves[i + 1] = k; B_MOVE();
-        x->n = x->n + 1; B_MOVE();
+        b_inserir_na_folha(x, k);
     } else {
         while (i >= 0 && x->chaves[i] > k) {
             i--;
@@ -149,6 +285,7 @@ void b_insert_nonfull(NoB* x, int k, int t) {
 }
 
 void b_inserir(ArvoreB* a, int k) {
+    a->folha_direita = NULL;
     B_VISIT();
     NoB* r = a->raiz;
     if (r->n == 2 * a->t - 1) {
@@ -164,26 +301,31 @@ void b_inserir(ArvoreB* a, int k) {
     }
 }
 
+/* com t = 1 os nós podem ficar vazios: vale a última chave vista no caminho */
 int b_get_pred(NoB* x, int idx, ArvoreB* a) {
     NoB* cur = x->filhos[idx];
     if (!cur) return 0;
+    int pred = cur->n > 0 ? cur->chaves[cur->n - 1] : 0;
     while (!cur->folha) {
         B_VISIT();
         if (cur->filhos[cur->n]) cur = cur->filhos[cur->n];
         else break;
+        if (cur->n > 0) pred = cur->chaves[cur->n - 1];
     }
-    return cur->chaves[cur->n - 1];
+    return pred;
 }
 
 int b_get_succ(NoB* x, int idx) {
     NoB* cur = x->filhos[idx + 1];
     if (!cur) return 0;
+    int succ = cur->n > 0 ? cur->chaves[0] : 0;
     while (!cur->folha) {
         B_VISIT();
         if (cur->filhos[0]) cur = cur->filhos[0];
         else break;
+        if (cur->n > 0) succ = cur->chaves[0];
     }
-    return cur->chaves[0];
+    return succ;
 }
 
 /* b_fill (instrumentado) */
@@ -191,6 +333,7 @@ void b_fill(NoB* x, int idx, int t) {
     if (x == NULL) return;
     if (idx < 0 || idx > x->n) return;
 
+    B_REBAL();
     if (idx != 0 && x->filhos[idx - 1] != NULL && x->filhos[idx - 1]->n >= t) {
         NoB* child = x->filhos[idx];
         NoB* sibling = x->filhos[idx - 1];
@@ -249,10 +392,7 @@ void b_fill(NoB* x, int idx, int t) {
         child->n += sibling->n + 1; B_MOVE();
         x->n--; B_MOVE();
         if (sibling) {
-            if (sibling->chaves) free(sibling->chaves), B_FREE();
-            if (sibling->filhos) free(sibling->filhos), B_FREE();
-            free(sibling); B_FREE();
-            x->filhos[idx + 1] = NULL; B_MOVE();
+            b_liberar_no(sibling);
         }
         return;
     } else if (idx - 1 >= 0 && x->filhos[idx - 1] != NULL) {
@@ -275,10 +415,7 @@ void b_fill(NoB* x, int idx, int t) {
         child->n += sibling->n + 1; B_MOVE();
         x->n--; B_MOVE();
         if (sibling) {
-            if (sibling->chaves) free(sibling->chaves), B_FREE();
-            if (sibling->filhos) free(sibling->filhos), B_FREE();
-            free(sibling); B_FREE();
-            x->filhos[idx] = NULL; B_MOVE();
+            b_liberar_no(sibling);
         }
         return;
     }
@@ -317,6 +454,7 @@ void b_remove_from_node(NoB* x, int k, ArvoreB* a) {
                 }
                 NoB* child = x->filhos[idx];
                 NoB* sibling = x->filhos[idx + 1];
+                B_REBAL();
                 if (t - 1 >= 0) child->chaves[t - 1] = x->chaves[idx], B_MOVE();
                 for (int i = 0; i < sibling->n; ++i) {
                     child->chaves[i + t] = sibling->chaves[i]; B_MOVE(); B_MERGE();
@@ -334,10 +472,7 @@ void b_remove_from_node(NoB* x, int k, ArvoreB* a) {
                 child->n += sibling->n + 1; B_MOVE();
                 x->n--; B_MOVE();
                 if (sibling) {
-                    if (sibling->chaves) free(sibling->chaves), B_FREE();
-                    if (sibling->filhos) free(sibling->filhos), B_FREE();
-                    free(sibling); B_FREE();
-                    x->filhos[idx + 1] = NULL; B_MOVE();
+                    b_liberar_no(sibling);
                 }
                 b_remove_from_node(child, k, a);
             }
@@ -369,6 +504,9 @@ void b_remove_from_node(NoB* x, int k, ArvoreB* a) {
 
 int b_remover_chave(ArvoreB* a, int k) {
     if (!a || !a->raiz) return 0;
+    if (a->limiar_preguica > 0) return b_remover_preguicosa(a, k);
+    if (a->borda_irregular) b_reparar_borda(a);
+    a->folha_direita = NULL;
     if (!b_buscar(a->raiz, k)) return 0;
 
     b_remove_from_node(a->raiz, k, a);
@@ -376,15 +514,11 @@ int b_remover_chave(ArvoreB* a, int k) {
     if (a->raiz->n == 0) {
         NoB* tmp = a->raiz;
         if (a->raiz->folha) {
-            if (tmp->chaves) free(tmp->chaves), B_FREE();
-            if (tmp->filhos) free(tmp->filhos), B_FREE();
-            free(tmp); B_FREE();
+            b_liberar_no(tmp);
             a->raiz = b_novo_no(a->t, 1); B_ALLOC();
         } else {
             NoB* newroot = a->raiz->filhos[0];
-            if (tmp->chaves) free(tmp->chaves), B_FREE();
-            if (tmp->filhos) free(tmp->filhos), B_FREE();
-            free(tmp); B_FREE();
+            b_liberar_no(tmp);
             a->raiz = newroot ? newroot : b_novo_no(a->t, 1); B_ALLOC();
         }
     }
@@ -392,6 +526,139 @@ int b_remover_chave(ArvoreB* a, int k) {
     return 1;
 }
 
+/* --------------------------------------------------
+   Lotes ordenados: o lote é ordenado e a folha da chave anterior é guardada
+   como dedo (com o separador que limita a folha à direita). Enquanto a chave
+   cabe nessa folha ela é inserida/removida ali, sem descer da raiz; senão cai
+   no caminho normal, que reposiciona o dedo.
+   -------------------------------------------------- */
+
+/* o lote é ordenado com o radix sort de Ordenacao_mod.c */
+#include "Ordenacao_mod.c"
+
+typedef struct {
+    NoB* folha;
+    int limite;       // chaves da folha < limite (se tem_limite)
+    int tem_limite;
+} DedoB;
+
+/* igual a b_inserir, mas iterativa e guardando a folha de destino no dedo */
+static void b_inserir_dedo(ArvoreB* a, int k, DedoB* d) {
+    int t = a->t;
+    B_VISIT();
+    NoB* x = a->raiz;
+    if (x->n == 2 * t - 1) {
+        NoB* s = b_novo_no(t, 0); B_MOVE();
+        a->raiz = s; B_MOVE();
+        s->filhos[0] = x; B_MOVE();
+        b_split_child(s, 0, t);
+        x = s;
+    }
+    d->tem_limite = 0;
+    while (!x->folha) {
+        B_VISIT();
+        int i = x->n - 1;
+        while (i >= 0 && x->chaves[i] > k) {
+            i--;
+            B_VISIT();
+        }
+        i++;
+        if (x->filhos[i] == NULL) {
+            x->filhos[i] = b_novo_no(t, 1); B_MOVE();
+        }
+        if (x->filhos[i]->n == 2 * t - 1) {
+            b_split_child(x, i, t);
+            if (x->chaves[i] < k) i++;
+        }
+        if (i < x->n) { d->limite = x->chaves[i]; d->tem_limite = 1; }
+        x = x->filhos[i];
+    }
+    B_VISIT();
+    b_inserir_na_folha(x, k);
+    d->folha = x;
+}
+
+void b_inserir_lote(ArvoreB* a, const int* chaves, int n) {
+    if (!a || !chaves || n <= 0) return;
+    a->folha_direita = NULL;
+    int* v = ordenacao_radix(chaves, n, 1, NULL);
+    DedoB d = { NULL, 0, 0 };
+    for (int i = 0; i < n; i++) {
+        int k = v[i];
+        B_VISIT();
+        if (d.folha && d.folha->n < 2 * a->t - 1 && (!d.tem_limite || k < d.limite)) {
+            b_inserir_na_folha(d.folha, k);
+        } else {
+            b_inserir_dedo(a, k, &d);
+        }
+    }
+    free(v);
+}
+
+/* remove k de x se x é folha, tem chave sobrando (ou é a raiz) e contém k */
+static int b_remover_da_folha(ArvoreB* a, NoB* x, int k) {
+    if (!x || !x->folha || (x != a->raiz && x->n <= a->t - 1)) return 0;
+    int i = 0;
+    while (i < x->n && x->chaves[i] < k) {
+        i++;
+        B_VISIT();
+    }
+    if (i == x->n || x->chaves[i] != k) return 0;
+    for (int j = i + 1; j < x->n; ++j) {
+        x->chaves[j - 1] = x->chaves[j]; B_MOVE();
+    }
+    x->n--; B_MOVE();
+    if (a->limiar_preguica > 0) a->preg_removidas++;
+    return 1;
+}
+
+/* desce até a folha do intervalo de k; NULL se k aparece num nó interno */
+static NoB* b_localizar_folha(ArvoreB* a, int k) {
+    NoB* x = a->raiz;
+    while (x && !x->folha) {
+        B_VISIT();
+        int i = 0;
+        while (i < x->n && x->chaves[i] < k) {
+            i++;
+            B_VISIT();
+        }
+        if (i < x->n && x->chaves[i] == k) return NULL;
+        x = x->filhos[i];
+    }
+    return x;
+}
+
+int b_remover_lote(ArvoreB* a, const int* chaves, int n) {
+    if (!a || !chaves || n <= 0) return 0;
+    if (a->borda_irregular) b_reparar_borda(a);
+    a->folha_direita = NULL;
+    int* v = ordenacao_radix(chaves, n, 1, NULL);
+    NoB* dedo = NULL;
+    int removidos = 0;
+    for (int i = 0; i < n; i++) {
+        int k = v[i];
+        if (b_remover_da_folha(a, dedo, k)) { removidos++; continue; }
+        NoB* f = b_localizar_folha(a, k);
+        if (b_remover_da_folha(a, f, k)) { dedo = f; removidos++; continue; }
+        /* folha no mínimo ou chave em nó interno: remoção normal (pode fundir nós) */
+        dedo = NULL;
+        removidos += b_remover_chave(a, k);
+    }
+    free(v);
+    return removidos;
+}
+
+/* libera um nó (3 B_FREE nos dois formatos de b_novo_no) */
+static void b_liberar_no(NoB* x) {
+    if (arena_devolver(&B_ARENA, x)) {
+        B_FREE(); B_FREE(); B_FREE();
+        return;
+    }
+    if (x->chaves) free(x->chaves), B_FREE();
+    if (x->filhos) free(x->filhos), B_FREE();
+    free(x); B_FREE();
+}
+
 /* remover tudo (liberação recursiva) */
 void b_liberar(NoB* no) {
     if (!no) return;
@@ -400,13 +667,1204 @@ void b_liberar(NoB* no) {
             if (no->filhos[i]) b_liberar(no->filhos[i]);
         }
     }
-    if (no->chaves) free(no->chaves), B_FREE();
-    if (no->filhos) free(no->filhos), B_FREE();
-    free(no); B_FREE();
+    b_liberar_no(no);
 }
 
 void b_remover_tudo(ArvoreB* a) {
     if (!a) return;
     if (a->raiz) b_liberar(a->raiz);
     a->raiz = b_novo_no(a->t, 1); B_ALLOC();
+    a->folha_direita = NULL;
+    a->borda_irregular = 0;
+    a->preg_pendente = 0;
+    a->preg_chaves = a->preg_nos = a->preg_removidas = 0;
+}
+
+/* --------------------------------------------------
+   Anexação de chaves crescentes
+   A folha mais à direita fica em cache: chave >= última chave dela entra no
+   fim, sem descer da raiz. Folha cheia não é dividida ao meio: ela fica com
+   2t-2 chaves, a última sobe como separador e a nova chave abre uma folha
+   nova à direita; nós internos cheios fazem o mesmo ao receber o separador.
+   Assim os nós que saem da borda direita ficam quase cheios (~100% de
+   ocupação numa carga crescente), mas os nós novos da borda começam abaixo
+   do mínimo t-1. Isso é aceito pela busca e pela inserção; antes de uma
+   remoção b_reparar_borda redistribui/funde a borda com o irmão esquerdo.
+   -------------------------------------------------- */
+
+#define B_MAX_PROF 64
+
+static NoB* b_folha_direita(ArvoreB* a) {
+    if (!a->folha_direita) {
+        NoB* x = a->raiz;
+        while (!x->folha) { B_VISIT(); x = x->filhos[x->n]; }
+        a->folha_direita = x;
+    }
+    return a->folha_direita;
+}
+
+/* folha direita cheia: divide toda a borda para a direita (ver acima) */
+static void b_anexar_dividir(ArvoreB* a, int k) {
+    int t = a->t;
+    NoB* borda[B_MAX_PROF];
+    int h = 0;
+    NoB* x = a->raiz;
+    while (!x->folha) { B_VISIT(); borda[h++] = x; x = x->filhos[x->n]; }
+
+    B_SPLIT();
+    int sep = x->chaves[x->n - 1];
+    x->n--; B_MOVE();
+    NoB* novo = b_novo_no(t, 1);
+    novo->chaves[0] = k; novo->n = 1; B_MOVE();
+    a->folha_direita = novo;
+
+    while (h > 0) {
+        NoB* p = borda[--h];
+        if (p->n < 2 * t - 1) {
+            p->chaves[p->n] = sep; B_MOVE();
+            p->filhos[p->n + 1] = novo; B_MOVE();
+            p->n++; B_MOVE();
+            novo = NULL;
+            break;
+        }
+        /* p cheio: fica com 2t-2 chaves; o último filho e o novo formam o nó da direita */
+        B_SPLIT();
+        NoB* y = b_novo_no(t, 0);
+        y->chaves[0] = sep; B_MOVE();
+        y->filhos[0] = p->filhos[p->n]; B_MOVE();
+        y->filhos[1] = novo; B_MOVE();
+        y->n = 1;
+        p->filhos[p->n] = NULL;
+        sep = p->chaves[p->n - 1];
+        p->n--; B_MOVE();
+        novo = y;
+    }
+    if (novo) {
+        NoB* r = b_novo_no(t, 0);
+        r->chaves[0] = sep; B_MOVE();
+        r->filhos[0] = a->raiz; B_MOVE();
+        r->filhos[1] = novo; B_MOVE();
+        r->n = 1;
+        a->raiz = r; B_MOVE();
+    }
+    a->borda_irregular = 1;
+}
+
+void b_anexar(ArvoreB* a, int k) {
+    if (!a) return;
+    /* t=1: folha de uma chave, não há como deixar a esquerda cheia */
+    if (a->t < 2) { b_inserir(a, k); return; }
+    /* remoções preguiçosas pendentes podem ter esvaziado a folha da direita: a
+       última chave dela já não limita o que cabe ali (o separador acima pode
+       ser maior), então a chave desce pelo caminho normal */
+    if (a->preg_pendente) { b_inserir(a, k); return; }
+    NoB* f = b_folha_direita(a);
+    B_VISIT();
+    if (f->n > 0 && k < f->chaves[f->n - 1]) { b_inserir(a, k); return; }
+    if (f->n < 2 * a->t - 1) {
+        f->chaves[f->n] = k; B_MOVE();
+        f->n++; B_MOVE();
+        return;
+    }
+    b_anexar_dividir(a, k);
+}
+
+/* traz o último filho c de p para >= t-1 chaves: empresta do irmão esquerdo ou funde */
+static void b_reparar_filho(ArvoreB* a, NoB* p) {
+    int t = a->t;
+    NoB* c = p->filhos[p->n];
+    NoB* l = p->filhos[p->n - 1];
+    if (c->n >= t - 1) return;
+    if (l->n + c->n + 1 <= 2 * t - 1) {
+        B_MERGE();
+        l->chaves[l->n] = p->chaves[p->n - 1]; B_MOVE();
+        for (int i = 0; i < c->n; i++) { l->chaves[l->n + 1 + i] = c->chaves[i]; B_MOVE(); }
+        if (!l->folha) {
+            for (int i = 0; i <= c->n; i++) { l->filhos[l->n + 1 + i] = c->filhos[i]; B_MOVE(); }
+        }
+        l->n += c->n + 1; B_MOVE();
+        p->filhos[p->n] = NULL;
+        p->n--; B_MOVE();
+        b_liberar_no(c);
+        return;
+    }
+    int m = (t - 1) - c->n;
+    for (int i = c->n - 1; i >= 0; i--) { c->chaves[i + m] = c->chaves[i]; B_MOVE(); }
+    if (!c->folha) {
+        for (int i = c->n; i >= 0; i--) { c->filhos[i + m] = c->filhos[i]; B_MOVE(); }
+    }
+    /* as m últimas chaves de l descem passando pelo separador */
+    c->chaves[m - 1] = p->chaves[p->n - 1]; B_MOVE();
+    for (int i = 0; i < m - 1; i++) { c->chaves[i] = l->chaves[l->n - m + 1 + i]; B_MOVE(); }
+    if (!c->folha) {
+        for (int i = 0; i < m; i++) {
+            c->filhos[i] = l->filhos[l->n - m + 1 + i]; B_MOVE();
+            l->filhos[l->n - m + 1 + i] = NULL;
+        }
+    }
+    p->chaves[p->n - 1] = l->chaves[l->n - m]; B_MOVE();
+    l->n -= m; B_MOVE();
+    c->n += m; B_MOVE();
+}
+
+/* restaura o mínimo t-1 na borda direita, de baixo para cima */
+static void b_reparar_borda(ArvoreB* a) {
+    if (a->preg_pendente) {
+        /* outros nós também podem estar abaixo do mínimo: remonta tudo */
+        b_reorganizar(a);
+        return;
+    }
+    NoB* borda[B_MAX_PROF];
+    int h = 0;
+    NoB* x = a->raiz;
+    while (!x->folha) { B_VISIT(); borda[h++] = x; x = x->filhos[x->n]; }
+    while (h > 0) b_reparar_filho(a, borda[--h]);
+    if (a->raiz->n == 0 && !a->raiz->folha) {
+        NoB* r = a->raiz;
+        a->raiz = r->filhos[0]; B_MOVE();
+        b_liberar_no(r);
+    }
+    a->folha_direita = NULL;
+    a->borda_irregular = 0;
+}
+
+/* --------------------------------------------------
+   Remoção de intervalo
+   A descida segue só os dois caminhos de fronteira (lo e hi). Num nó com chaves
+   em [lo, hi], os filhos entre elas estão inteiros no intervalo e são
+   descartados sem visitar chave a chave, junto com os separadores; o separador
+   que sobra entre as duas fronteiras é trocado pelo predecessor (ou sucessor).
+   Na volta, cada filho da fronteira abaixo de t-1 chaves é corrigido com um
+   irmão (funde se cabe, senão redistribui ao meio). Custo O(t log n + k).
+   Um nó pode voltar sem chaves (só um filho vazio): o pai o funde com um irmão,
+   e a raiz sem chaves é recolhida no fim.
+   -------------------------------------------------- */
+
+/* libera a subárvore; retorna o número de chaves descartadas */
+static long b_descartar(NoB* x) {
+    long c = x->n;
+    if (!x->folha) {
+        for (int i = 0; i <= x->n; i++) c += b_descartar(x->filhos[i]);
+    }
+    b_liberar_no(x);
+    return c;
+}
+
+/* subárvore sem chaves (nós sem chaves têm só filhos[0]) */
+static int b_vazia(NoB* x) {
+    while (x->n == 0 && !x->folha) { B_VISIT(); x = x->filhos[0]; }
+    return x->n == 0;
+}
+
+/* move m chaves de filhos[j+1] para filhos[j], passando pelo separador j */
+static void b_girar_esq(NoB* p, int j, int m) {
+    NoB* l = p->filhos[j];
+    NoB* r = p->filhos[j + 1];
+    l->chaves[l->n] = p->chaves[j]; B_MOVE();
+    for (int i = 0; i < m - 1; i++) { l->chaves[l->n + 1 + i] = r->chaves[i]; B_MOVE(); }
+    p->chaves[j] = r->chaves[m - 1]; B_MOVE();
+    for (int i = m; i < r->n; i++) { r->chaves[i - m] = r->chaves[i]; B_MOVE(); }
+    if (!l->folha) {
+        for (int i = 0; i < m; i++) { l->filhos[l->n + 1 + i] = r->filhos[i]; B_MOVE(); }
+        for (int i = m; i <= r->n; i++) { r->filhos[i - m] = r->filhos[i]; B_MOVE(); }
+        for (int i = r->n - m + 1; i <= r->n; i++) r->filhos[i] = NULL;
+    }
+    l->n += m;
+    r->n -= m; B_MOVE();
+}
+
+/* move m chaves de filhos[j] para filhos[j+1], passando pelo separador j */
+static void b_girar_dir(NoB* p, int j, int m) {
+    NoB* l = p->filhos[j];
+    NoB* r = p->filhos[j + 1];
+    for (int i = r->n - 1; i >= 0; i--) { r->chaves[i + m] = r->chaves[i]; B_MOVE(); }
+    r->chaves[m - 1] = p->chaves[j]; B_MOVE();
+    for (int i = 0; i < m - 1; i++) { r->chaves[i] = l->chaves[l->n - m + 1 + i]; B_MOVE(); }
+    p->chaves[j] = l->chaves[l->n - m]; B_MOVE();
+    if (!r->folha) {
+        for (int i = r->n; i >= 0; i--) { r->filhos[i + m] = r->filhos[i]; B_MOVE(); }
+        for (int i = 0; i < m; i++) {
+            r->filhos[i] = l->filhos[l->n - m + 1 + i]; B_MOVE();
+            l->filhos[l->n - m + 1 + i] = NULL;
+        }
+    }
+    l->n -= m;
+    r->n += m; B_MOVE();
+}
+
+/* funde filhos[j], separador j e filhos[j+1] em filhos[j] */
+static void b_fundir(NoB* p, int j) {
+    NoB* l = p->filhos[j];
+    NoB* r = p->filhos[j + 1];
+    B_MERGE();
+    l->chaves[l->n] = p->chaves[j]; B_MOVE();
+    for (int i = 0; i < r->n; i++) { l->chaves[l->n + 1 + i] = r->chaves[i]; B_MOVE(); }
+    if (!l->folha) {
+        for (int i = 0; i <= r->n; i++) { l->filhos[l->n + 1 + i] = r->filhos[i]; B_MOVE(); }
+    }
+    l->n += r->n + 1; B_MOVE();
+    for (int i = j + 1; i < p->n; i++) { p->chaves[i - 1] = p->chaves[i]; B_MOVE(); }
+    for (int i = j + 2; i <= p->n; i++) { p->filhos[i - 1] = p->filhos[i]; B_MOVE(); }
+    p->filhos[p->n] = NULL;
+    p->n--; B_MOVE();
+    b_liberar_no(r);
+}
+
+static void b_corrigir_filho(ArvoreB* a, NoB* p, int i);
+
+/* só um nó que chegou sem chaves tem filho abaixo do mínimo (o único, vazio) */
+static void b_corrigir_netos(ArvoreB* a, NoB* x) {
+    if (x->folha) return;
+    for (int k = 0; k <= x->n; k++) {
+        if (x->filhos[k]->n < a->t - 1) b_corrigir_filho(a, x, k);
+    }
+}
+
+/* traz filhos[i] de p para >= t-1 chaves: funde com um irmão se cabe, senão
+   redistribui os dois ao meio; p sem chaves fica para o avô */
+static void b_corrigir_filho(ArvoreB* a, NoB* p, int i) {
+    int t = a->t;
+    if (p->n == 0 || p->filhos[i]->n >= t - 1) return;
+    int j = (i < p->n) ? i : i - 1;
+    NoB* l = p->filhos[j];
+    NoB* r = p->filhos[j + 1];
+    if (l->n + r->n + 1 <= 2 * t - 1) {
+        b_fundir(p, j);
+        b_corrigir_netos(a, l);
+        /* dois filhos abaixo do mínimo podem continuar abaixo depois de fundidos */
+        b_corrigir_filho(a, p, j);
+        return;
+    }
+    int nl = (l->n + r->n) / 2;
+    if (l->n < nl) b_girar_esq(p, j, nl - l->n);
+    else if (l->n > nl) b_girar_dir(p, j, l->n - nl);
+    b_corrigir_netos(a, l);
+    b_corrigir_netos(a, r);
+    /* corrigir os netos pode ter fundido chaves de l ou r */
+    b_corrigir_filho(a, p, j);
+    if (j + 1 <= p->n) b_corrigir_filho(a, p, j + 1);
+}
+
+/* tira a maior / menor chave da subárvore (não vazia), corrigindo o caminho */
+static int b_tirar_max(ArvoreB* a, NoB* x) {
+    if (x->folha) {
+        x->n--; B_MOVE();
+        return x->chaves[x->n];
+    }
+    B_VISIT();
+    int k = b_tirar_max(a, x->filhos[x->n]);
+    b_corrigir_filho(a, x, x->n);
+    return k;
+}
+
+static int b_tirar_min(ArvoreB* a, NoB* x) {
+    if (x->folha) {
+        int k = x->chaves[0];
+        for (int i = 1; i < x->n; i++) { x->chaves[i - 1] = x->chaves[i]; B_MOVE(); }
+        x->n--; B_MOVE();
+        return k;
+    }
+    B_VISIT();
+    int k = b_tirar_min(a, x->filhos[0]);
+    b_corrigir_filho(a, x, 0);
+    return k;
+}
+
+static long b_remover_intervalo_rec(ArvoreB* a, NoB* x, int lo, int hi) {
+    int i1 = 0;
+    while (i1 < x->n && x->chaves[i1] < lo) { B_VISIT(); i1++; }
+    int i2 = i1;
+    while (i2 < x->n && x->chaves[i2] <= hi) { B_VISIT(); i2++; }
+    int m = i2 - i1;
+
+    if (x->folha) {
+        if (m == 0) return 0;
+        for (int i = i2; i < x->n; i++) { x->chaves[i - m] = x->chaves[i]; B_MOVE(); }
+        x->n -= m; B_MOVE();
+        return m;
+    }
+    if (m == 0) {
+        long c = b_remover_intervalo_rec(a, x->filhos[i1], lo, hi);
+        b_corrigir_filho(a, x, i1);
+        return c;
+    }
+
+    /* filhos i1+1..i2-1 estão inteiros no intervalo: saem com as chaves i1+1..i2-1 */
+    long c = m;
+    for (int i = i1 + 1; i < i2; i++) c += b_descartar(x->filhos[i]);
+    if (m > 1) {
+        int d = m - 1;
+        for (int i = i2; i < x->n; i++) { x->chaves[i - d] = x->chaves[i]; B_MOVE(); }
+        for (int i = i2; i <= x->n; i++) { x->filhos[i - d] = x->filhos[i]; B_MOVE(); }
+        for (int i = x->n - d + 1; i <= x->n; i++) x->filhos[i] = NULL;
+        x->n -= d; B_MOVE();
+    }
+
+    /* fronteiras: filhos[i1] (lo) e filhos[i1+1] (hi), separados pela chave i1 */
+    NoB* l = x->filhos[i1];
+    NoB* r = x->filhos[i1 + 1];
+    c += b_remover_intervalo_rec(a, l, lo, hi);
+    c += b_remover_intervalo_rec(a, r, lo, hi);
+    if (!b_vazia(l)) {
+        x->chaves[i1] = b_tirar_max(a, l); B_MOVE();
+    } else if (!b_vazia(r)) {
+        x->chaves[i1] = b_tirar_min(a, r); B_MOVE();
+    } else {
+        b_descartar(r);
+        for (int i = i1 + 1; i < x->n; i++) { x->chaves[i - 1] = x->chaves[i]; B_MOVE(); }
+        for (int i = i1 + 2; i <= x->n; i++) { x->filhos[i - 1] = x->filhos[i]; B_MOVE(); }
+        x->filhos[x->n] = NULL;
+        x->n--; B_MOVE();
+    }
+    b_corrigir_filho(a, x, i1);
+    if (i1 + 1 <= x->n) b_corrigir_filho(a, x, i1 + 1);
+    return c;
+}
+
+/* alguma chave em [lo, hi] (caminho de t=1, sem garantia de ocupação) */
+static int b_achar_intervalo(NoB* x, int lo, int hi, int* k) {
+    while (x) {
+        int i = 0;
+        while (i < x->n && x->chaves[i] < lo) { B_VISIT(); i++; }
+        if (i < x->n && x->chaves[i] <= hi) { *k = x->chaves[i]; return 1; }
+        if (x->folha) return 0;
+        x = x->filhos[i];
+    }
+    return 0;
+}
+
+long b_remover_intervalo(ArvoreB* a, int lo, int hi) {
+    if (!a || !a->raiz || lo > hi) return 0;
+    if (a->preg_pendente && a->t >= 2) b_reorganizar(a);
+    if (a->borda_irregular) b_reparar_borda(a);
+    a->folha_direita = NULL;
+    long c = 0;
+    if (a->t < 2) {
+        /* limitado ao total de chaves: a remoção com t=1 pode não achar a chave */
+        long nos = 0, total = 0;
+        int k;
+        b_contar_nos(a->raiz, &nos, &total);
+        while (c < total && b_achar_intervalo(a->raiz, lo, hi, &k) && b_remover_chave(a, k)) c++;
+        return c;
+    }
+    c = b_remover_intervalo_rec(a, a->raiz, lo, hi);
+    while (a->raiz->n == 0 && !a->raiz->folha) {
+        NoB* r = a->raiz;
+        a->raiz = r->filhos[0]; B_MOVE();
+        b_liberar_no(r);
+    }
+    if (a->limiar_preguica > 0) a->preg_chaves -= c;
+    return c;
+}
+
+/* fração das posições de chave ocupadas (chaves / (nós * (2t-1))) */
+static void b_contar_nos(NoB* x, long* nos, long* chaves) {
+    if (!x) return;
+    (*nos)++;
+    *chaves += x->n;
+    if (!x->folha) for (int i = 0; i <= x->n; i++) b_contar_nos(x->filhos[i], nos, chaves);
+}
+
+double b_ocupacao(ArvoreB* a) {
+    long nos = 0, chaves = 0;
+    if (!a) return 0;
+    b_contar_nos(a->raiz, &nos, &chaves);
+    return nos ? (double) chaves / ((double) nos * (2 * a->t - 1)) : 0;
+}
+
+/* níveis da raiz às folhas (todas na mesma profundidade; sem contagem) */
+int b_altura(ArvoreB* a) {
+    if (!a || !a->raiz || (a->raiz->folha && a->raiz->n == 0)) return 0;
+    int h = 1;
+    for (NoB* x = a->raiz; !x->folha; x = x->filhos[0]) h++;
+    return h;
+}
+
+/* --------------------------------------------------
+   Carga paralela a partir de chaves fora de ordem (b_carregar_paralelo)
+   Em vez de n descidas raiz-folha, a árvore é montada de baixo para cima:
+   1. radix sort LSD de Ordenacao_mod.c com um pedaço por thread (cada
+      thread conta e espalha o seu pedaço via b_em_paralelo);
+   2. as folhas saem direto do vetor ordenado, cada thread com uma faixa de
+      folhas, com `ocupacao` * (2t-1) chaves por nó;
+   3. a chave entre duas folhas vizinhas sobe e o nível de cima é montado do
+      mesmo jeito com essas chaves, até sobrar um nó (a raiz).
+   O número de nós de cada nível é escolhido para que todos fiquem entre
+   t-1 e 2t-1 chaves, com a sobra espalhada (sem nó "resto" no fim). Com
+   t = 1 sai uma árvore binária balanceada (nós de 0 ou 1 chave), onde
+   b_inserir chave a chave em ordem formaria uma lista.
+   -------------------------------------------------- */
+
+#define B_CARGA_MAX_THREADS 64
+#define B_CARGA_GRAO 65536   // chaves mínimas por thread numa fase
+
+typedef struct {
+    void (*f)(void*, int, int);
+    void* ctx;
+    int id, total;
+    long contas[6];
+} TrechoB;
+
+static void* b_trecho_executar(void* x) {
+    TrechoB* p = (TrechoB*) x;
+    p->f(p->ctx, p->id, p->total);
+    p->contas[0] = B_COUNT_VISIT; p->contas[1] = B_COUNT_MOVE; p->contas[2] = B_COUNT_SPLIT;
+    p->contas[3] = B_COUNT_MERGE; p->contas[4] = B_COUNT_ALLOC; p->contas[5] = B_COUNT_FREE;
+    return NULL;
+}
+
+/* f(ctx, i, threads) para i = 0..threads-1; quem chama faz o trecho 0 (e os que
+   não conseguiram thread) e soma os contadores das outras */
+static void b_em_paralelo(int threads, void (*f)(void*, int, int), void* ctx) {
+    pthread_t id[B_CARGA_MAX_THREADS];
+    TrechoB p[B_CARGA_MAX_THREADS];
+    int criadas = 1;
+    for (int i = 1; i < threads; i++) {
+        p[i].f = f; p[i].ctx = ctx; p[i].id = i; p[i].total = threads;
+        if (pthread_create(&id[i], NULL, b_trecho_executar, &p[i]) != 0) break;
+        criadas++;
+    }
+    for (int i = criadas; i < threads; i++) f(ctx, i, threads);
+    f(ctx, 0, threads);
+    for (int i = 1; i < criadas; i++) {
+        pthread_join(id[i], NULL);
+        B_COUNT_VISIT += p[i].contas[0]; B_COUNT_MOVE += p[i].contas[1]; B_COUNT_SPLIT += p[i].contas[2];
+        B_COUNT_MERGE += p[i].contas[3]; B_COUNT_ALLOC += p[i].contas[4]; B_COUNT_FREE += p[i].contas[5];
+    }
+}
+
+static int b_carga_threads(int threads, long itens) {
+    long maximo = itens / B_CARGA_GRAO;
+    if (threads > maximo) threads = (int) maximo;
+    if (threads > B_CARGA_MAX_THREADS) threads = B_CARGA_MAX_THREADS;
+    return threads < 1 ? 1 : threads;
+}
+
+/* nós de um nível com k chaves e alvo de m chaves por nó (uma chave sobe entre
+   nós vizinhos); se a divisão igual deixa nó abaixo de t-1, usa um nó a menos,
+   o que nunca passa de 2t-1 */
+static long b_carga_nos(long k, int m, int t) {
+    long nos = (k + 1 + m) / (m + 1);
+    while (nos > 1 && (k - nos + 1) / nos < t - 1) nos--;
+    return nos;
+}
+
+typedef struct {
+    const int* chaves;    // chaves do nível, ordenadas
+    NoB** filhos;         // nós do nível de baixo (NULL nas folhas)
+    long nos, q, r;       // nós do nível; cada um tem q chaves, os r primeiros q+1
+    NoB** saida;
+    int* sobem;           // chave entre o nó j e o j+1 (nível de cima)
+    int t;
+} NivelB;
+
+static void b_nivel_montar(void* x, int i, int total) {
+    NivelB* nv = (NivelB*) x;
+    long j0 = nv->nos * i / total, j1 = nv->nos * (i + 1) / total;
+    for (long j = j0; j < j1; j++) {
+        long ini = j * (nv->q + 1) + (j < nv->r ? j : nv->r);
+        int m = (int) nv->q + (j < nv->r);
+        NoB* no = b_novo_no(nv->t, nv->filhos == NULL);
+        memcpy(no->chaves, nv->chaves + ini, sizeof(int) * m);
+        no->n = m;
+        B_COUNT_MOVE += m;
+        if (nv->filhos) {
+            memcpy(no->filhos, nv->filhos + ini, sizeof(NoB*) * (m + 1));
+            B_COUNT_MOVE += m + 1;
+        }
+        if (j + 1 < nv->nos) { nv->sobem[j] = nv->chaves[ini + m]; B_MOVE(); }
+        nv->saida[j] = no; B_MOVE();
+    }
+}
+
+/* chaves por nó para uma ocupação-alvo, dentro de [max(t-1, 1), 2t-1] */
+static int b_carga_alvo(int t, double ocupacao) {
+    int m = (int) (ocupacao * (2 * t - 1) + 0.5);
+    if (m < t - 1) m = t - 1;
+    if (m < 1) m = 1;
+    if (m > 2 * t - 1) m = 2 * t - 1;
+    return m;
+}
+
+/* monta os níveis a partir de n > 0 chaves ordenadas (v não é liberado);
+   devolve a raiz e, em *total_nos, quantos nós foram criados */
+static NoB* b_montar_niveis(const int* v, long n, int t, int m, int threads, long* total_nos) {
+    const int* nivel = v;
+    long k = n;
+    long nos = 0;
+    NoB** filhos = NULL;
+    NoB* raiz;
+    for (;;) {
+        NivelB nv;
+        nv.chaves = nivel;
+        nv.filhos = filhos;
+        nv.nos = b_carga_nos(k, m, t);
+        nv.q = (k - nv.nos + 1) / nv.nos;
+        nv.r = (k - nv.nos + 1) % nv.nos;
+        nv.saida = (NoB**) malloc(sizeof(NoB*) * nv.nos);
+        nv.sobem = (int*) malloc(sizeof(int) * nv.nos);
+        nv.t = t;
+        b_em_paralelo(b_carga_threads(threads, k), b_nivel_montar, &nv);
+        nos += nv.nos;
+        free(filhos);
+        if (nivel != v) free((int*) nivel);
+        if (nv.nos == 1) {
+            raiz = nv.saida[0];
+            free(nv.saida);
+            free(nv.sobem);
+            break;
+        }
+        nivel = nv.sobem;
+        k = nv.nos - 1;
+        filhos = nv.saida;
+    }
+    if (total_nos) *total_nos = nos;
+    return raiz;
+}
+
+ArvoreB* b_carregar_paralelo(int ordem, const int* chaves, int n, int threads, double ocupacao) {
+    ArvoreB* a = b_criar(ordem);
+    if (!chaves || n <= 0) return a;
+    if (threads < 1) threads = 1;
+    int* v = ordenacao_radix(chaves, n, b_carga_threads(threads, n), b_em_paralelo);
+    NoB* raiz = b_montar_niveis(v, n, a->t, b_carga_alvo(a->t, ocupacao), threads, NULL);
+    b_liberar(a->raiz);
+    a->raiz = raiz; B_MOVE();
+    free(v);
+    return a;
+}
+
+/* --------------------------------------------------
+   Cópia compactada (b_compactar): chaves por deslocamento de uma base
+   Cada nó guarda a menor chave (base) e, para cada chave, chave - base com
+   1, 2 ou 4 bytes: a menor largura em que caiba o maior deslocamento do nó.
+   Com chaves densas ou agrupadas, quase todo nó fica com 1 ou 2 bytes por
+   chave (em vez de 4), e os nós têm o tamanho exato (n chaves, n+1 filhos;
+   folhas sem vetor de filhos), num só bloco.
+   A busca não reconstrói as chaves: converte a chave procurada num
+   deslocamento do nó e conta os deslocamentos menores (laço sem desvio,
+   vetorizável). Cada deslocamento comparado conta uma visita.
+   É uma cópia só leitura da árvore no momento da chamada; alterações
+   posteriores na ArvoreB não aparecem nela.
+   -------------------------------------------------- */
+
+typedef struct NoBCompacto {
+    int base;       // menor chave do nó
+    int n;
+    int largura;    // bytes por deslocamento: 1, 2 ou 4
+    int folha;
+    struct NoBCompacto** filhos;   // NULL nas folhas; aponta para o fim do bloco
+    unsigned char desloc[];        // n deslocamentos de `largura` bytes
+} NoBCompacto;
+
+typedef struct ArvoreBCompacta {
+    NoBCompacto* raiz;
+    long bytes;         // soma dos blocos dos nós
+    long chaves;
+    long nos_largura[3]; // nós com deslocamentos de 1, 2 e 4 bytes
+} ArvoreBCompacta;
+
+static NoBCompacto* b_compactar_no(ArvoreBCompacta* c, NoB* x) {
+    unsigned int maior = 0;
+    int base = x->n ? x->chaves[0] : 0;   /* chaves do nó em ordem: a primeira é a menor */
+    if (x->n) maior = (unsigned int) x->chaves[x->n - 1] - (unsigned int) base;
+    int largura = maior <= 0xFF ? 1 : (maior <= 0xFFFF ? 2 : 4);
+    size_t cab = sizeof(NoBCompacto) + (size_t) x->n * largura;
+    cab = (cab + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+    size_t total = cab + (x->folha ? 0 : sizeof(NoBCompacto*) * (x->n + 1));
+    NoBCompacto* z = (NoBCompacto*) malloc(total);
+    z->base = base;
+    z->n = x->n;
+    z->largura = largura;
+    z->folha = x->folha;
+    z->filhos = x->folha ? NULL : (NoBCompacto**) ((char*) z + cab);
+    for (int i = 0; i < x->n; i++) {
+        unsigned int d = (unsigned int) x->chaves[i] - (unsigned int) base;
+        if (largura == 1) z->desloc[i] = (unsigned char) d;
+        else if (largura == 2) ((unsigned short*) z->desloc)[i] = (unsigned short) d;
+        else ((unsigned int*) z->desloc)[i] = d;
+        B_MOVE();
+    }
+    c->bytes += (long) total;
+    c->chaves += x->n;
+    c->nos_largura[largura == 1 ? 0 : (largura == 2 ? 1 : 2)]++;
+    B_ALLOC();
+    if (!x->folha)
+        for (int i = 0; i <= x->n; i++) z->filhos[i] = b_compactar_no(c, x->filhos[i]);
+    return z;
+}
+
+ArvoreBCompacta* b_compactar(ArvoreB* a) {
+    ArvoreBCompacta* c = (ArvoreBCompacta*) calloc(1, sizeof(ArvoreBCompacta));
+    c->bytes = sizeof(ArvoreBCompacta);
+    c->raiz = b_compactar_no(c, a->raiz);
+    return c;
+}
+
+/* primeira posição com deslocamento >= d (= quantos são menores) */
+#define B_CONTAR_MENORES(tipo, v, n, d, i) \
+    do { \
+        const tipo* p_ = (const tipo*) (v); \
+        tipo d_ = (tipo) (d); \
+        for (int j_ = 0; j_ < (n); j_++) (i) += p_[j_] < d_; \
+    } while (0)
+
+static inline int b_compacta_posicao(const NoBCompacto* x, int k, int* igual) {
+    int i = 0;
+    *igual = 0;
+    if (k < x->base || x->n == 0) return 0;
+    unsigned int d = (unsigned int) k - (unsigned int) x->base;
+    B_COUNT_VISIT += x->n;
+    if (x->largura == 1) {
+        if (d > 0xFF) return x->n;
+        B_CONTAR_MENORES(unsigned char, x->desloc, x->n, d, i);
+        *igual = i < x->n && x->desloc[i] == d;
+    } else if (x->largura == 2) {
+        if (d > 0xFFFF) return x->n;
+        B_CONTAR_MENORES(unsigned short, x->desloc, x->n, d, i);
+        *igual = i < x->n && ((const unsigned short*) x->desloc)[i] == d;
+    } else {
+        B_CONTAR_MENORES(unsigned int, x->desloc, x->n, d, i);
+        *igual = i < x->n && ((const unsigned int*) x->desloc)[i] == d;
+    }
+    return i;
+}
+
+#undef B_CONTAR_MENORES
+
+int b_compacta_buscar(ArvoreBCompacta* c, int k) {
+    NoBCompacto* x = c ? c->raiz : NULL;
+    while (x) {
+        int igual;
+        int i = b_compacta_posicao(x, k, &igual);
+        if (igual) return 1;
+        if (x->folha) return 0;
+        x = x->filhos[i];
+    }
+    return 0;
+}
+
+static inline int b_compacta_chave(const NoBCompacto* x, int i) {
+    unsigned int d = x->largura == 1 ? x->desloc[i]
+                   : x->largura == 2 ? ((const unsigned short*) x->desloc)[i]
+                   : ((const unsigned int*) x->desloc)[i];
+    return (int) ((unsigned int) x->base + d);
+}
+
+static long b_compacta_percorrer_rec(NoBCompacto* x, void (*cb)(int, int, void*), void* ctx) {
+    long c = 0;
+    for (int i = 0; i < x->n; i++) {
+        if (!x->folha) c += b_compacta_percorrer_rec(x->filhos[i], cb, ctx);
+        cb(b_compacta_chave(x, i), 1, ctx);
+        c++;
+    }
+    if (!x->folha) c += b_compacta_percorrer_rec(x->filhos[x->n], cb, ctx);
+    return c;
+}
+
+long b_compacta_percorrer(ArvoreBCompacta* c, void (*cb)(int, int, void*), void* ctx) {
+    if (!c) return 0;
+    return b_compacta_percorrer_rec(c->raiz, cb, ctx);
+}
+
+long b_compacta_bytes(ArvoreBCompacta* c) { return c ? c->bytes : 0; }
+
+/* fração dos nós com deslocamentos de `largura` bytes (1, 2 ou 4) */
+double b_compacta_fracao_largura(ArvoreBCompacta* c, int largura) {
+    if (!c) return 0;
+    long nos = c->nos_largura[0] + c->nos_largura[1] + c->nos_largura[2];
+    long k = c->nos_largura[largura == 1 ? 0 : (largura == 2 ? 1 : 2)];
+    return nos ? (double) k / nos : 0;
+}
+
+static void b_compacta_liberar_rec(NoBCompacto* x) {
+    if (!x->folha)
+        for (int i = 0; i <= x->n; i++) b_compacta_liberar_rec(x->filhos[i]);
+    free(x);
+    B_FREE();
+}
+
+void b_compacta_liberar(ArvoreBCompacta* c) {
+    if (!c) return;
+    b_compacta_liberar_rec(c->raiz);
+    free(c);
+}
+
+/* memória da ArvoreB no formato normal, para comparação: cada nó aloca o
+   cabeçalho, 2t-1 chaves e 2t filhos (também nas folhas) */
+long b_bytes(ArvoreB* a) {
+    long nos = 0, chaves = 0;
+    if (!a) return 0;
+    b_contar_nos(a->raiz, &nos, &chaves);
+    int kc = 2 * a->t - 1 > 0 ? 2 * a->t - 1 : 1;
+    return (long) sizeof(ArvoreB) + nos * (long) (sizeof(NoB) + sizeof(int) * kc + sizeof(NoB*) * (kc + 1));
+}
+
+/* --------------------------------------------------
+   Remoção preguiçosa (b_definir_remocao_preguicosa)
+   Com o modo ligado, b_remover_chave não redistribui nem funde: tira a chave
+   da folha, ou troca a chave de um nó interno pelo predecessor e o tira do
+   nó de onde ele veio, e deixa o nó abaixo do mínimo. Se a subárvore à
+   esquerda da chave ficou sem chaves, ela sai junto com a chave (todas as
+   folhas continuam na mesma profundidade). Busca e inserção aceitam nós
+   abaixo do mínimo, como na borda de b_anexar.
+   A correção é em lote: b_reorganizar tira as chaves em ordem e remonta a
+   árvore pelos níveis da carga, com B_REORG_OCUPACAO da capacidade por nó.
+   Ela roda sozinha quando a ocupação estimada
+       (chaves na última reorganização - remoções preguiçosas) / (nós * (2t-1))
+   fica abaixo do limiar. Inserções não entram na estimativa, que por isso só
+   pode adiantar a reorganização, nunca atrasá-la. Operações que dependem do
+   mínimo (remoção de intervalo, reparo da borda) reorganizam antes se há
+   remoções pendentes; desligar o modo também.
+   O limiar fica no máximo em B_REORG_LIMIAR_MAX, abaixo da ocupação da
+   remontagem (que ainda perde um pouco no arredondamento da carga por nó):
+   com limiar >= B_REORG_OCUPACAO a estimativa logo após reorganizar já
+   estaria abaixo dele, e cada remoção que deixa um nó abaixo do mínimo
+   remontaria a árvore inteira.
+   -------------------------------------------------- */
+
+#define B_REORG_OCUPACAO 0.7
+#define B_REORG_LIMIAR_MAX 0.5
+
+typedef struct {
+    int* v;
+    long n;
+} ColetaB;
+
+static void b_coletar(int k, int q, void* ctx) {
+    (void) q;
+    ColetaB* c = (ColetaB*) ctx;
+    c->v[c->n++] = k;
+}
+
+void b_reorganizar(ArvoreB* a) {
+    if (!a) return;
+    long antes = B_COUNT_VISIT + B_COUNT_MOVE + B_COUNT_SPLIT + B_COUNT_MERGE + B_COUNT_ALLOC + B_COUNT_FREE;
+    long c0[6] = { B_COUNT_VISIT, B_COUNT_MOVE, B_COUNT_SPLIT, B_COUNT_MERGE, B_COUNT_ALLOC, B_COUNT_FREE };
+
+    long nos = 0, total = 0;
+    b_contar_nos(a->raiz, &nos, &total);
+    ColetaB c = { (int*) malloc(sizeof(int) * (total > 0 ? total : 1)), 0 };
+    b_percorrer(a, b_coletar, &c);
+    B_COUNT_VISIT += nos;
+    B_COUNT_MOVE += c.n;
+    b_liberar(a->raiz);
+    if (c.n > 0) {
+        a->raiz = b_montar_niveis(c.v, c.n, a->t, b_carga_alvo(a->t, B_REORG_OCUPACAO), 1, &nos);
+    } else {
+        a->raiz = b_novo_no(a->t, 1);
+        nos = 1;
+    }
+    B_MOVE();
+    free(c.v);
+    a->folha_direita = NULL;
+    a->borda_irregular = 0;
+    a->preg_pendente = 0;
+    a->preg_chaves = c.n;
+    a->preg_nos = nos;
+    a->preg_removidas = 0;
+
+    /* o custo vai só para a categoria própria */
+    long depois = B_COUNT_VISIT + B_COUNT_MOVE + B_COUNT_SPLIT + B_COUNT_MERGE + B_COUNT_ALLOC + B_COUNT_FREE;
+    B_COUNT_VISIT = c0[0]; B_COUNT_MOVE = c0[1]; B_COUNT_SPLIT = c0[2];
+    B_COUNT_MERGE = c0[3]; B_COUNT_ALLOC = c0[4]; B_COUNT_FREE = c0[5];
+    B_COUNT_REORG += depois - antes;
+}
+
+void b_definir_remocao_preguicosa(ArvoreB* a, double limiar) {
+    if (!a) return;
+    if (limiar <= 0) {
+        if (a->preg_pendente) b_reorganizar(a);
+        a->limiar_preguica = 0;
+        return;
+    }
+    if (limiar > B_REORG_LIMIAR_MAX) limiar = B_REORG_LIMIAR_MAX;
+    long nos = 0, chaves = 0;
+    b_contar_nos(a->raiz, &nos, &chaves);
+    a->limiar_preguica = limiar;
+    a->preg_chaves = chaves;
+    a->preg_nos = nos;
+    a->preg_removidas = 0;
+}
+
+/* maior chave da subárvore x (nó e posição); NULL se não há chave. Só segue a
+   borda direita: um nó interno com chave sempre contém um candidato. */
+static NoB* b_maximo_preg(NoB* x, int* pos) {
+    if (!x) return NULL;
+    B_VISIT();
+    if (!x->folha) {
+        NoB* r = b_maximo_preg(x->filhos[x->n], pos);
+        if (r) return r;
+    }
+    if (x->n == 0) return NULL;
+    *pos = x->n - 1;
+    return x;
+}
+
+static int b_remover_preguicosa(ArvoreB* a, int k) {
+    NoB* x = a->raiz;
+    int i;
+    for (;;) {
+        B_VISIT();
+        i = 0;
+        while (i < x->n && k > x->chaves[i]) {
+            i++;
+            B_VISIT();
+        }
+        if (i < x->n && x->chaves[i] == k) break;
+        if (x->folha || !x->filhos[i]) return 0;
+        x = x->filhos[i];
+    }
+    a->folha_direita = NULL;
+
+    /* nó interno: desce trocando pelo predecessor até uma folha, ou até um nó
+       cuja subárvore à esquerda da chave está vazia (sai junto) */
+    while (!x->folha) {
+        int p;
+        NoB* f = b_maximo_preg(x->filhos[i], &p);
+        if (f) {
+            x->chaves[i] = f->chaves[p]; B_MOVE();
+            x = f;
+            i = p;
+            continue;
+        }
+        b_liberar(x->filhos[i]);
+        for (int j = i + 1; j <= x->n; j++) {
+            x->filhos[j - 1] = x->filhos[j]; B_MOVE();
+        }
+        x->filhos[x->n] = NULL;
+        break;
+    }
+    for (int j = i + 1; j < x->n; j++) {
+        x->chaves[j - 1] = x->chaves[j]; B_MOVE();
+    }
+    x->n--; B_MOVE();
+    if (x != a->raiz && (x->n < a->t - 1 || x->n == 0)) {
+        B_COUNT_ADIADO++;
+        a->preg_pendente = 1;
+    }
+    while (!a->raiz->folha && a->raiz->n == 0) {
+        NoB* r = a->raiz;
+        a->raiz = r->filhos[0]; B_MOVE();
+        b_liberar_no(r);
+    }
+
+    a->preg_removidas++;
+    long cap = 2 * a->t - 1 > 0 ? 2 * a->t - 1 : 1;
+    double estimada = a->preg_nos > 0
+        ? (double) (a->preg_chaves - a->preg_removidas) / ((double) a->preg_nos * cap) : 1.0;
+    if (a->preg_pendente && estimada < a->limiar_preguica) b_reorganizar(a);
+    return 1;
+}
+
+/* --------------------------------------------------
+   Inserção ascendente (b_inserir_ascendente)
+   Alternativa a b_inserir, que divide todo nó cheio por onde passa na
+   descida, mesmo quando a folha ainda tem espaço. Aqui a descida só guarda
+   o caminho numa pilha, a chave entra na folha e só um transbordo real
+   (2t chaves) é tratado, subindo:
+   1. se um irmão vizinho (o esquerdo primeiro) tem espaço, as chaves dos
+      dois e o separador do pai são redistribuídos ao meio (como na B*):
+      nenhum nó novo, e o pai não muda de tamanho;
+   2. senão o nó divide (t chaves à esquerda, t-1 à direita) e a chave do
+      meio sobe, o que pode transbordar o pai.
+   Divisões e redistribuições têm contadores próprios, fora das somas
+   (b_get_divisoes_and_reset / b_get_redistribuicoes_and_reset);
+   b_split_child, do esquema de sempre, também conta as suas divisões ali.
+   -------------------------------------------------- */
+
+/* e recebe K[0..L-1] (e filhos), o separador p->chaves[j] vira K[L] e d
+   recebe o resto; L = (total-1)/2 deixa os dois com no máximo 2t-1 chaves */
+static void b_redistribuir(NoB* p, int j, NoB* e, NoB* d, const int* K, NoB** CH, int total) {
+    int L = (total - 1) / 2;
+    memcpy(e->chaves, K, sizeof(int) * L);
+    e->n = L;
+    p->chaves[j] = K[L];
+    memcpy(d->chaves, K + L + 1, sizeof(int) * (total - L - 1));
+    d->n = total - L - 1;
+    B_COUNT_MOVE += total;
+    if (!e->folha) {
+        memcpy(e->filhos, CH, sizeof(NoB*) * (L + 1));
+        memcpy(d->filhos, CH + L + 1, sizeof(NoB*) * (total - L));
+        B_COUNT_MOVE += total + 1;
+    }
+    B_COUNT_REDIST++;
+}
+
+void b_inserir_ascendente(ArvoreB* a, int k) {
+    if (!a) return;
+    int t = a->t;
+    int cap = 2 * t - 1;
+    NoB* pilha[B_MAX_PROF];
+    int pos[B_MAX_PROF];
+    int h = 0;
+    a->folha_direita = NULL;
+
+    NoB* x = a->raiz;
+    B_VISIT();
+    while (!x->folha) {
+        if (h == B_MAX_PROF) {
+            b_inserir(a, k);   /* caminho mais fundo que a pilha (t=1 degenerada) */
+            return;
+        }
+        B_VISIT();
+        int i = x->n;
+        while (i > 0 && x->chaves[i - 1] > k) {
+            i--;
+            B_VISIT();
+        }
+        pilha[h] = x;
+        pos[h] = i;
+        h++;
+        x = x->filhos[i];
+    }
+    if (x->n < cap) {
+        b_inserir_na_folha(x, k);
+        return;
+    }
+
+    /* transbordo: buf tem as 2t chaves do nó (e 2t+1 filhos); comb junta com um irmão */
+    int* buf = (int*) malloc(sizeof(int) * 2 * t);
+    NoB** buf_f = (NoB**) malloc(sizeof(NoB*) * (2 * t + 1));
+    int* comb = (int*) malloc(sizeof(int) * 4 * t);
+    NoB** comb_f = (NoB**) malloc(sizeof(NoB*) * (4 * t + 1));
+    NoB* direito = NULL;   /* filho à direita de k (NULL na folha) */
+    int i = x->n;
+    while (i > 0 && x->chaves[i - 1] > k) {
+        i--;
+        B_VISIT();
+    }
+    for (;;) {
+        if (x->n < cap) {
+            for (int j = x->n; j > i; j--) {
+                x->chaves[j] = x->chaves[j - 1]; B_MOVE();
+            }
+            x->chaves[i] = k; B_MOVE();
+            if (!x->folha) {
+                for (int j = x->n + 1; j > i + 1; j--) {
+                    x->filhos[j] = x->filhos[j - 1]; B_MOVE();
+                }
+                x->filhos[i + 1] = direito; B_MOVE();
+            }
+            x->n++; B_MOVE();
+            break;
+        }
+
+        memcpy(buf, x->chaves, sizeof(int) * i);
+        buf[i] = k;
+        memcpy(buf + i + 1, x->chaves + i, sizeof(int) * (x->n - i));
+        B_COUNT_MOVE += x->n + 1;
+        if (!x->folha) {
+            memcpy(buf_f, x->filhos, sizeof(NoB*) * (i + 1));
+            buf_f[i + 1] = direito;
+            memcpy(buf_f + i + 2, x->filhos + i + 1, sizeof(NoB*) * (x->n - i));
+            B_COUNT_MOVE += x->n + 2;
+        }
+        int nb = x->n + 1;
+
+        if (h > 0) {
+            NoB* p = pilha[h - 1];
+            int j = pos[h - 1];
+            NoB* e = j > 0 ? p->filhos[j - 1] : NULL;
+            NoB* d = j < p->n ? p->filhos[j + 1] : NULL;
+            B_VISIT();
+            if (e && e->n < cap) {
+                memcpy(comb, e->chaves, sizeof(int) * e->n);
+                comb[e->n] = p->chaves[j - 1];
+                memcpy(comb + e->n + 1, buf, sizeof(int) * nb);
+                if (!x->folha) {
+                    memcpy(comb_f, e->filhos, sizeof(NoB*) * (e->n + 1));
+                    memcpy(comb_f + e->n + 1, buf_f, sizeof(NoB*) * (nb + 1));
+                }
+                b_redistribuir(p, j - 1, e, x, comb, comb_f, e->n + 1 + nb);
+                break;
+            }
+            B_VISIT();
+            if (d && d->n < cap) {
+                memcpy(comb, buf, sizeof(int) * nb);
+                comb[nb] = p->chaves[j];
+                memcpy(comb + nb + 1, d->chaves, sizeof(int) * d->n);
+                if (!x->folha) {
+                    memcpy(comb_f, buf_f, sizeof(NoB*) * (nb + 1));
+                    memcpy(comb_f + nb + 1, d->filhos, sizeof(NoB*) * (d->n + 1));
+                }
+                b_redistribuir(p, j, x, d, comb, comb_f, nb + 1 + d->n);
+                break;
+            }
+        }
+
+        /* divide: x fica com buf[0..t-1], buf[t] sobe, o novo nó leva o resto */
+        NoB* novo = b_novo_no(t, x->folha);
+        B_SPLIT();
+        B_COUNT_DIVISAO++;
+        memcpy(x->chaves, buf, sizeof(int) * t);
+        x->n = t;
+        memcpy(novo->chaves, buf + t + 1, sizeof(int) * (nb - t - 1));
+        novo->n = nb - t - 1;
+        B_COUNT_MOVE += nb;
+        if (!x->folha) {
+            memcpy(x->filhos, buf_f, sizeof(NoB*) * (t + 1));
+            for (int j = t + 1; j <= cap; j++) x->filhos[j] = NULL;
+            memcpy(novo->filhos, buf_f + t + 1, sizeof(NoB*) * (nb - t));
+            B_COUNT_MOVE += nb + 1;
+        }
+        k = buf[t];
+        direito = novo;
+        if (h == 0) {
+            NoB* s = b_novo_no(t, 0);
+            s->chaves[0] = k;
+            s->filhos[0] = x;
+            s->filhos[1] = novo;
+            s->n = 1;
+            a->raiz = s;
+            B_COUNT_MOVE += 4;
+            break;
+        }
+        h--;
+        x = pilha[h];
+        i = pos[h];
+    }
+    free(buf);
+    free(buf_f);
+    free(comb);
+    free(comb_f);
+}
+
+/* --------------------------------------------------
+   Ordem automática (b_calibrar / b_criar(B_ORDEM_AUTO))
+   b_calibrar mede, na máquina atual, uma carga curta para cada ordem de
+   B_ORDENS_CALIBRACAO: n chaves aleatórias em [0, 2n) e `operacoes`
+   operações, uma fração `leitura` de buscas e o resto alternando inserção
+   e remoção de chaves aleatórias (o tamanho fica em torno de n). Vale o
+   menor tempo de B_CALIBRACAO_REPETICOES rodadas. A ordem mais rápida vira
+   a ordem automática e, se `arquivo` não for NULL, é salva nele; b_criar
+   com B_ORDEM_AUTO lê B_ORDEM_ARQUIVO na primeira vez (sem ele, usa
+   B_ORDEM_PADRAO), e b_ordem_carregar lê um arquivo salvo em outro
+   caminho. Os contadores de quem chama são preservados.
+   -------------------------------------------------- */
+
+#define B_CALIBRACAO_REPETICOES 3
+
+static const int B_ORDENS_CALIBRACAO[] = { 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128 };
+
+static int b_ordem_auto_valor = 0;   // 0 = ainda não lida
+static pthread_mutex_t b_ordem_auto_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* ordem gravada por b_calibrar em arquivo; 0 se não der para ler */
+static int b_ordem_ler(const char* arquivo) {
+    int t = 0;
+    FILE* f = fopen(arquivo, "r");
+    if (f) {
+        if (fscanf(f, "ordem=%d", &t) != 1) t = 0;
+        fclose(f);
+    }
+    return t >= 1 ? t : 0;
+}
+
+int b_ordem_auto() {
+    pthread_mutex_lock(&b_ordem_auto_mutex);
+    if (b_ordem_auto_valor < 1) {
+        int t = b_ordem_ler(B_ORDEM_ARQUIVO);
+        b_ordem_auto_valor = t ? t : B_ORDEM_PADRAO;
+    }
+    int t = b_ordem_auto_valor;
+    pthread_mutex_unlock(&b_ordem_auto_mutex);
+    return t;
+}
+
+void b_definir_ordem_auto(int t) {
+    pthread_mutex_lock(&b_ordem_auto_mutex);
+    b_ordem_auto_valor = t >= 1 ? t : 0;
+    pthread_mutex_unlock(&b_ordem_auto_mutex);
+}
+
+int b_ordem_carregar(const char* arquivo) {
+    int t = arquivo ? b_ordem_ler(arquivo) : 0;
+    if (t) b_definir_ordem_auto(t);
+    return t;
+}
+
+static unsigned b_calibrar_aleatorio(unsigned* s) {
+    unsigned x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+static double b_calibrar_agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* uma rodada da carga para a ordem t: ns e custo instrumentado por operação */
+static double b_calibrar_rodada(int t, long n, double leitura, long operacoes, unsigned semente, double* ops) {
+    unsigned s = semente;
+    long faixa = 2 * n;
+    ArvoreB* a = b_criar(t);
+    for (long i = 0; i < n; i++) b_inserir(a, (int) (b_calibrar_aleatorio(&s) % faixa));
+    b_get_insercao_and_reset();
+
+    unsigned limite = (unsigned) (leitura * 4294967295.0);
+    int escreve = 0;
+    double t0 = b_calibrar_agora();
+    for (long i = 0; i < operacoes; i++) {
+        int k = (int) (b_calibrar_aleatorio(&s) % faixa);
+        if (b_calibrar_aleatorio(&s) <= limite) b_buscar_chave(a, k);
+        else if ((escreve ^= 1)) b_inserir(a, k);
+        else b_remover_chave(a, k);
+    }
+    double ns = (b_calibrar_agora() - t0) * 1e9 / operacoes;
+    long custo = B_COUNT_VISIT + B_COUNT_MOVE + B_COUNT_SPLIT + B_COUNT_MERGE + B_COUNT_ALLOC + B_COUNT_FREE;
+    b_get_insercao_and_reset();
+    *ops = (double) custo / operacoes;
+
+    b_liberar(a->raiz);
+    free(a);
+    return ns;
+}
+
+int b_calibrar(long n, double leitura, long operacoes, const char* arquivo,
+               void (*cb)(int, double, double, void*), void* ctx) {
+    if (n < 1) n = 1;
+    if (n > 0x3FFFFFFF) n = 0x3FFFFFFF;
+    if (operacoes < 1) operacoes = 1;
+    if (leitura < 0) leitura = 0;
+    if (leitura > 1) leitura = 1;
+
+    long salvo[11] = { B_COUNT_VISIT, B_COUNT_MOVE, B_COUNT_SPLIT, B_COUNT_MERGE, B_COUNT_ALLOC,
+                       B_COUNT_FREE, B_COUNT_REBAL, B_COUNT_ADIADO, B_COUNT_REORG,
+                       B_COUNT_DIVISAO, B_COUNT_REDIST };
+    int melhor = B_ORDEM_PADRAO;
+    double melhor_ns = -1;
+    for (size_t o = 0; o < sizeof(B_ORDENS_CALIBRACAO) / sizeof(B_ORDENS_CALIBRACAO[0]); o++) {
+        int t = B_ORDENS_CALIBRACAO[o];
+        double ns = -1, ops = 0;
+        for (int r = 0; r < B_CALIBRACAO_REPETICOES; r++) {
+            double ops_r;
+            double ns_r = b_calibrar_rodada(t, n, leitura, operacoes, 2463534242u + r, &ops_r);
+            if (ns < 0 || ns_r < ns) ns = ns_r;
+            ops = ops_r;   // a carga é a mesma nas rodadas
+        }
+        if (cb) cb(t, ns, ops, ctx);
+        if (melhor_ns < 0 || ns < melhor_ns) {
+            melhor_ns = ns;
+            melhor = t;
+        }
+    }
+    B_COUNT_VISIT = salvo[0]; B_COUNT_MOVE = salvo[1]; B_COUNT_SPLIT = salvo[2];
+    B_COUNT_MERGE = salvo[3]; B_COUNT_ALLOC = salvo[4]; B_COUNT_FREE = salvo[5];
+    B_COUNT_REBAL = salvo[6]; B_COUNT_ADIADO = salvo[7]; B_COUNT_REORG = salvo[8];
+    B_COUNT_DIVISAO = salvo[9]; B_COUNT_REDIST = salvo[10];
+
+    b_definir_ordem_auto(melhor);
+    if (arquivo) {
+        FILE* f = fopen(arquivo, "w");
+        if (f) {
+            fprintf(f, "ordem=%d\nn=%ld\nleitura=%.4f\nns_por_op=%.2f\n", melhor, n, leitura, melhor_ns);
+            fclose(f);
+        }
+    }
+    return melhor;
 }
@@ -0,0 +1,150 @@
+// Índice congelado (somente leitura) em layout de Eytzinger
+// - as chaves distintas ficam num vetor implícito em ordem de BFS: filhos de k em
+//   2k e 2k+1 (posição 0 não usada); quantidades num vetor paralelo
+// - a busca não tem desvio dependente da chave (k = 2k + (chave[k] < x)) e faz
+//   prefetch da linha com os 16 descendentes 4 níveis abaixo (vetor alinhado em 64 bytes)
+// - construção a partir de qualquer árvore via *_percorrer (em ordem):
+//     Congelado* c = cg_criar();
+//     avl_percorrer(a, cg_coletar, c);   // ou rb_percorrer / b_percorrer
+//     cg_congelar(c);
+//   chaves iguais consecutivas (duplicatas da B-tree) são somadas numa só
+// Contadores: CG_COUNT_VISIT (níveis descidos na busca), CG_COUNT_MOVE (cópias na construção)
+// Exporta funções:
+//   Congelado* cg_criar();
+//   void cg_coletar(int, int, void*);        // callback de *_percorrer
+//   void cg_congelar(Congelado*);            // monta o layout; depois só leitura
+//   int cg_buscar(Congelado*, int);          // 1 se existe
+//   int cg_quantidade(Congelado*, int);      // ocorrências (0 se não existe)
+//   long cg_tamanho(Congelado*);             // chaves distintas
+//   void cg_liberar(Congelado*);
+//   long cg_get_busca_and_reset();
+//   long cg_get_construcao_and_reset();
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CG_LINHA 64                          /* bytes por linha de cache */
+#define CG_PREFETCH (CG_LINHA / sizeof(int)) /* 16 descendentes: 4 níveis abaixo */
+
+typedef struct Congelado {
+    int* chaves;        // 1..n em ordem de Eytzinger (alinhado em CG_LINHA)
+    int* quantidades;   // paralelo a chaves
+    long n;
+    int* ord_chaves;    // coleta em ordem (liberado em cg_congelar)
+    int* ord_qtd;
+    long cap;
+} Congelado;
+
+static long CG_COUNT_VISIT = 0;
+static long CG_COUNT_MOVE  = 0;
+
+#define CG_VISIT() (CG_COUNT_VISIT++)
+#define CG_MOVE()  (CG_COUNT_MOVE++)
+
+long cg_get_busca_and_reset() {
+    long v = CG_COUNT_VISIT;
+    CG_COUNT_VISIT = 0;
+    return v;
+}
+
+long cg_get_construcao_and_reset() {
+    long v = CG_COUNT_MOVE;
+    CG_COUNT_MOVE = 0;
+    return v;
+}
+
+Congelado* cg_criar() {
+    Congelado* c = (Congelado*) calloc(1, sizeof(Congelado));
+    c->cap = 1024;
+    c->ord_chaves = (int*) malloc(sizeof(int) * c->cap);
+    c->ord_qtd = (int*) malloc(sizeof(int) * c->cap);
+    return c;
+}
+
+/* recebe as chaves em ordem crescente (contrato de *_percorrer) */
+void cg_coletar(int valor, int quantidade, void* ctx) {
+    Congelado* c = (Congelado*) ctx;
+    if (!c->ord_chaves || quantidade <= 0) return;
+    if (c->n > 0 && c->ord_chaves[c->n - 1] == valor) {
+        c->ord_qtd[c->n - 1] += quantidade;
+        return;
+    }
+    if (c->n == c->cap) {
+        c->cap *= 2;
+        c->ord_chaves = (int*) realloc(c->ord_chaves, sizeof(int) * c->cap);
+        c->ord_qtd = (int*) realloc(c->ord_qtd, sizeof(int) * c->cap);
+    }
+    c->ord_chaves[c->n] = valor;
+    c->ord_qtd[c->n] = quantidade;
+    c->n++;
+}
+
+/* preenche k (e subárvore) em ordem; i = próxima chave ordenada */
+static void cg_preencher(Congelado* c, long k, long* i) {
+    if (k > c->n) return;
+    cg_preencher(c, 2 * k, i);
+    c->chaves[k] = c->ord_chaves[*i];
+    c->quantidades[k] = c->ord_qtd[*i];
+    CG_MOVE();
+    (*i)++;
+    cg_preencher(c, 2 * k + 1, i);
+}
+
+static int* cg_alocar_alinhado(long n) {
+    size_t bytes = sizeof(int) * (size_t)(n + 1);
+    bytes = (bytes + CG_LINHA - 1) / CG_LINHA * CG_LINHA;
+    int* v = (int*) aligned_alloc(CG_LINHA, bytes);
+    memset(v, 0, bytes);
+    return v;
+}
+
+void cg_congelar(Congelado* c) {
+    if (!c || !c->ord_chaves) return;
+    c->chaves = cg_alocar_alinhado(c->n);
+    c->quantidades = cg_alocar_alinhado(c->n);
+    long i = 0;
+    cg_preencher(c, 1, &i);
+    free(c->ord_chaves);
+    free(c->ord_qtd);
+    c->ord_chaves = c->ord_qtd = NULL;
+}
+
+/* posição da chave (0 se não existe) */
+static long cg_posicao(Congelado* c, int chave) {
+    const int* b = c->chaves;
+    long n = c->n, k = 1;
+    if (!b) return 0;
+    while (k <= n) {
+        __builtin_prefetch(b + k * CG_PREFETCH);
+        CG_VISIT();
+        k = 2 * k + (b[k] < chave);
+    }
+    /* desfaz as descidas à direita após a última à esquerda */
+    k >>= __builtin_ffsl(~k);
+    return (k != 0 && b[k] == chave) ? k : 0;
+}
+
+int cg_buscar(Congelado* c, int chave) {
+    if (!c) return 0;
+    return cg_posicao(c, chave) != 0;
+}
+
+int cg_quantidade(Congelado* c, int chave) {
+    if (!c) return 0;
+    long k = cg_posicao(c, chave);
+    return k ? c->quantidades[k] : 0;
+}
+
+long cg_tamanho(Congelado* c) {
+    return c ? c->n : 0;
+}
+
+void cg_liberar(Congelado* c) {
+    if (!c) return;
+    free(c->chaves);
+    free(c->quantidades);
+    free(c->ord_chaves);
+    free(c->ord_qtd);
+    free(c);
+}
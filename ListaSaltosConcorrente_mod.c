@@ -0,0 +1,357 @@
+// Lista de saltos concorrente sem trava (lock-free; Fraser / Herlihy-Shavit)
+// Mesma estrutura da ListaSaltos_mod.c, mas cada ponteiro proximo[i] é atômico e
+// o bit baixo marca o nó como removido naquele nível:
+// - remoção: marca os níveis de cima para baixo; quem marca o nível 0 é o dono
+//   da remoção (as outras threads desistem), e uma nova busca desliga o nó
+// - busca com desligamento (lsc_localizar): em cada nível, nós marcados no
+//   caminho são desligados com CAS no anterior; se o CAS falhar, recomeça
+// - inserção: liga o nível 0 com CAS (ponto de linearização) e depois os níveis
+//   de cima, refazendo a busca quando o CAS falha; para se o nó for removido
+//   no meio do caminho
+// - lsc_buscar só lê: pula os marcados sem desligar nada
+// É um conjunto: inserir uma chave presente não faz nada (retorna 0).
+// Memória: o nó desligado é aposentado com a época corrente (que avança a cada
+// aposentadoria) e só é liberado quando nenhuma thread dentro de uma operação
+// anunciou uma época <= a dele (epoch-based reclamation, como em
+// MapaConcorrente_mod.c). Só aposenta quem chega por último entre a inserção
+// (terminou de ligar) e a remoção (terminou de desligar), para que um nível
+// ligado tarde pela inserção nunca aponte para memória liberada.
+// Contadores por thread (_Thread_local): mesmas categorias da ListaSaltos_mod.c;
+// MOVE conta cada CAS tentado (os que falham também), FREE as liberações feitas
+// pela recuperação.
+// Exporta funções:
+//   ListaSaltosC* lsc_criar();
+//   int lsc_inserir(ListaSaltosC*, int);        // 1 se inseriu, 0 se já estava
+//   int lsc_remover_chave(ListaSaltosC*, int);  // 1 se removeu
+//   int lsc_buscar(ListaSaltosC*, int);
+//   void lsc_destruir(ListaSaltosC*);           // sem operações em andamento
+//   long lsc_get_insercao_and_reset();
+//   long lsc_get_remocao_and_reset();
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define LSC_NIVEL_MAX 32
+#define LSC_PROMOVER 4            /* como em ListaSaltos_mod.c */
+#define LSC_MAX_THREADS 256       /* threads vivas ao mesmo tempo */
+#define LSC_RECUPERAR_A_CADA 64   /* aposentadorias entre varreduras de recuperação */
+
+typedef struct noLSC {
+    int valor;
+    int nivel;
+    atomic_int estado;              // 1: inserção terminou de ligar; 2: remoção terminou de desligar
+    _Atomic uintptr_t proximo[];    // ponteiro | LSC_MARCA
+} NoLSC;
+
+#define LSC_MARCA ((uintptr_t) 1)
+#define LSC_PTR(p) ((NoLSC*) ((p) & ~LSC_MARCA))
+#define LSC_MARCADO(p) ((p) & LSC_MARCA)
+
+typedef struct {
+    NoLSC** nos;
+    unsigned long* epoca;
+    int n, cap;
+    int desde;   // aposentadorias desde a última recuperação
+} AposentadosLSC;
+
+typedef struct ListaSaltosC {
+    NoLSC* cabeca;                                  // sentinela com LSC_NIVEL_MAX níveis
+    atomic_int nivel;                               // níveis já usados (só cresce)
+    _Atomic unsigned long epoca;                    // começa em 1
+    _Atomic unsigned long ativos[LSC_MAX_THREADS];  // época anunciada por slot (0 = fora)
+    AposentadosLSC aposentados[LSC_MAX_THREADS];    // cada slot mexe só no seu
+} ListaSaltosC;
+
+static _Thread_local long LSC_COUNT_VISIT = 0;
+static _Thread_local long LSC_COUNT_MOVE  = 0;
+static _Thread_local long LSC_COUNT_NIVEL = 0;
+static _Thread_local long LSC_COUNT_ALLOC = 0;
+static _Thread_local long LSC_COUNT_FREE  = 0;
+
+long lsc_get_insercao_and_reset() {
+    long v = LSC_COUNT_VISIT + LSC_COUNT_MOVE + LSC_COUNT_NIVEL + LSC_COUNT_ALLOC;
+    LSC_COUNT_VISIT = LSC_COUNT_MOVE = LSC_COUNT_NIVEL = LSC_COUNT_ALLOC = LSC_COUNT_FREE = 0;
+    return v;
+}
+long lsc_get_remocao_and_reset() {
+    long v = LSC_COUNT_VISIT + LSC_COUNT_MOVE + LSC_COUNT_NIVEL + LSC_COUNT_FREE;
+    LSC_COUNT_VISIT = LSC_COUNT_MOVE = LSC_COUNT_NIVEL = LSC_COUNT_ALLOC = LSC_COUNT_FREE = 0;
+    return v;
+}
+
+#define LSC_VISIT() (LSC_COUNT_VISIT++)
+#define LSC_MOVE()  (LSC_COUNT_MOVE++)
+#define LSC_NIVEL() (LSC_COUNT_NIVEL++)
+#define LSC_ALLOC() (LSC_COUNT_ALLOC++)
+#define LSC_FREE()  (LSC_COUNT_FREE++)
+
+/* --------------------------------------------------
+   Slots de thread (épocas e aposentados); o slot volta a ficar livre quando
+   a thread termina, e quem o pega herda os aposentados pendentes
+   -------------------------------------------------- */
+
+static atomic_int LSC_SLOT_USADO[LSC_MAX_THREADS];
+static _Thread_local int LSC_SLOT = -1;
+static _Thread_local unsigned long long LSC_SEMENTE = 0;
+static pthread_key_t LSC_CHAVE;
+static pthread_once_t LSC_UMA_VEZ = PTHREAD_ONCE_INIT;
+
+static void lsc_soltar_slot(void* x) {
+    atomic_store(&LSC_SLOT_USADO[(int) (intptr_t) x - 1], 0);
+}
+
+static void lsc_iniciar_chave() {
+    pthread_key_create(&LSC_CHAVE, lsc_soltar_slot);
+}
+
+static int lsc_slot() {
+    if (LSC_SLOT < 0) {
+        pthread_once(&LSC_UMA_VEZ, lsc_iniciar_chave);
+        for (int i = 0; i < LSC_MAX_THREADS && LSC_SLOT < 0; i++) {
+            int livre = 0;
+            if (atomic_compare_exchange_strong(&LSC_SLOT_USADO[i], &livre, 1)) LSC_SLOT = i;
+        }
+        if (LSC_SLOT < 0) {
+            fprintf(stderr, "ListaSaltosConcorrente: mais de %d threads\n", LSC_MAX_THREADS);
+            abort();
+        }
+        pthread_setspecific(LSC_CHAVE, (void*) (intptr_t) (LSC_SLOT + 1));
+        LSC_SEMENTE = 0x9E3779B97F4A7C15ULL * (unsigned long long) (LSC_SLOT + 1);
+    }
+    return LSC_SLOT;
+}
+
+/* seq_cst: o anúncio da época precisa ficar visível antes de ler a lista */
+static int lsc_entrar(ListaSaltosC* l) {
+    int s = lsc_slot();
+    atomic_store(&l->ativos[s], atomic_load(&l->epoca));
+    return s;
+}
+
+static void lsc_sair(ListaSaltosC* l, int s) {
+    atomic_store_explicit(&l->ativos[s], 0, memory_order_release);
+}
+
+/* libera os aposentados do slot que ninguém dentro de uma operação pode ver */
+static void lsc_recuperar(ListaSaltosC* l, AposentadosLSC* a) {
+    unsigned long minimo = (unsigned long) -1;
+    for (int i = 0; i < LSC_MAX_THREADS; i++) {
+        unsigned long v = atomic_load(&l->ativos[i]);
+        if (v != 0 && v < minimo) minimo = v;
+    }
+    int j = 0;
+    for (int i = 0; i < a->n; i++) {
+        if (a->epoca[i] < minimo) {
+            free(a->nos[i]);
+            LSC_FREE();
+        } else {
+            a->nos[j] = a->nos[i];
+            a->epoca[j] = a->epoca[i];
+            j++;
+        }
+    }
+    a->n = j;
+}
+
+/* o nó já está desligado de todos os níveis */
+static void lsc_aposentar(ListaSaltosC* l, int s, NoLSC* x) {
+    AposentadosLSC* a = &l->aposentados[s];
+    if (a->n == a->cap) {
+        a->cap = a->cap ? 2 * a->cap : 256;
+        a->nos = (NoLSC**) realloc(a->nos, sizeof(NoLSC*) * a->cap);
+        a->epoca = (unsigned long*) realloc(a->epoca, sizeof(unsigned long) * a->cap);
+    }
+    a->nos[a->n] = x;
+    a->epoca[a->n] = atomic_fetch_add(&l->epoca, 1);
+    a->n++;
+    if (++a->desde >= LSC_RECUPERAR_A_CADA) {
+        a->desde = 0;
+        lsc_recuperar(l, a);
+    }
+}
+
+/* --------------------------------------------------
+   Lista
+   -------------------------------------------------- */
+
+ListaSaltosC* lsc_criar() {
+    ListaSaltosC* l = (ListaSaltosC*) calloc(1, sizeof(ListaSaltosC));
+    l->cabeca = (NoLSC*) malloc(sizeof(NoLSC) + sizeof(uintptr_t) * LSC_NIVEL_MAX);
+    l->cabeca->valor = 0;
+    l->cabeca->nivel = LSC_NIVEL_MAX;
+    atomic_init(&l->cabeca->estado, 3);
+    for (int i = 0; i < LSC_NIVEL_MAX; i++) atomic_init(&l->cabeca->proximo[i], 0);
+    atomic_init(&l->nivel, 1);
+    atomic_init(&l->epoca, 1);
+    for (int i = 0; i < LSC_MAX_THREADS; i++) atomic_init(&l->ativos[i], 0);
+    return l;
+}
+
+static int lsc_sortear_nivel() {
+    int nivel = 1;
+    for (;;) {
+        LSC_SEMENTE ^= LSC_SEMENTE >> 12;
+        LSC_SEMENTE ^= LSC_SEMENTE << 25;
+        LSC_SEMENTE ^= LSC_SEMENTE >> 27;
+        unsigned long long r = (LSC_SEMENTE * 0x2545F4914F6CDD1DULL) >> 32;
+        if (nivel >= LSC_NIVEL_MAX || r % LSC_PROMOVER != 0) return nivel;
+        nivel++;
+        LSC_NIVEL();
+    }
+}
+
+/* em cada nível, ant[i] é o último nó com valor < chave e seg[i] o seguinte
+   (não marcado); desliga os marcados que encontra. Retorna 1 se seg[0] tem a
+   chave. */
+static int lsc_localizar(ListaSaltosC* l, int chave, NoLSC** ant, NoLSC** seg) {
+tentar:;
+    NoLSC* pred = l->cabeca;
+    NoLSC* curr = NULL;
+    for (int i = atomic_load(&l->nivel) - 1; i >= 0; i--) {
+        curr = LSC_PTR(atomic_load(&pred->proximo[i]));
+        while (curr) {
+            LSC_VISIT();
+            uintptr_t succ = atomic_load(&curr->proximo[i]);
+            if (LSC_MARCADO(succ)) {
+                uintptr_t esperado = (uintptr_t) curr;
+                LSC_MOVE();
+                if (!atomic_compare_exchange_strong(&pred->proximo[i], &esperado, succ & ~LSC_MARCA))
+                    goto tentar;   // o anterior mudou ou foi marcado
+                curr = LSC_PTR(succ);
+                continue;
+            }
+            if (curr->valor >= chave) break;
+            pred = curr;
+            curr = LSC_PTR(succ);
+        }
+        ant[i] = pred;
+        seg[i] = curr;
+    }
+    return curr && curr->valor == chave;
+}
+
+int lsc_inserir(ListaSaltosC* l, int chave) {
+    NoLSC* ant[LSC_NIVEL_MAX];
+    NoLSC* seg[LSC_NIVEL_MAX];
+    int s = lsc_entrar(l);
+    int nivel = lsc_sortear_nivel();
+    int usado = atomic_load(&l->nivel);
+    while (usado < nivel && !atomic_compare_exchange_weak(&l->nivel, &usado, nivel))
+        ;
+    if (usado < nivel) LSC_NIVEL();
+
+    NoLSC* n = NULL;
+    for (;;) {
+        if (lsc_localizar(l, chave, ant, seg)) {
+            if (n) { free(n); LSC_FREE(); }   // nunca publicado
+            lsc_sair(l, s);
+            return 0;
+        }
+        if (!n) {
+            n = (NoLSC*) malloc(sizeof(NoLSC) + sizeof(uintptr_t) * nivel);
+            LSC_ALLOC();
+            n->valor = chave;
+            n->nivel = nivel;
+            atomic_init(&n->estado, 0);
+        }
+        for (int i = 0; i < nivel; i++) atomic_store_explicit(&n->proximo[i], (uintptr_t) seg[i], memory_order_relaxed);
+        uintptr_t esperado = (uintptr_t) seg[0];
+        LSC_MOVE();
+        if (atomic_compare_exchange_strong(&ant[0]->proximo[0], &esperado, (uintptr_t) n)) break;
+    }
+
+    for (int i = 1; i < nivel; i++) {
+        for (;;) {
+            uintptr_t nx = atomic_load(&n->proximo[i]);
+            if (LSC_MARCADO(nx)) goto ligado;   // removido enquanto subia
+            if (LSC_PTR(nx) != seg[i]) {
+                LSC_MOVE();
+                if (!atomic_compare_exchange_strong(&n->proximo[i], &nx, (uintptr_t) seg[i])) goto ligado;
+            }
+            uintptr_t esperado = (uintptr_t) seg[i];
+            LSC_MOVE();
+            if (atomic_compare_exchange_strong(&ant[i]->proximo[i], &esperado, (uintptr_t) n)) break;
+            lsc_localizar(l, chave, ant, seg);
+            if (seg[0] != n) goto ligado;       // já removido do nível 0
+        }
+    }
+ligado:
+    /* removido durante a subida: a remoção pode ter desligado antes de um
+       nível que ligamos depois */
+    if (LSC_MARCADO(atomic_load(&n->proximo[0]))) lsc_localizar(l, chave, ant, seg);
+    if (atomic_fetch_or(&n->estado, 1) & 2) lsc_aposentar(l, s, n);
+    lsc_sair(l, s);
+    return 1;
+}
+
+int lsc_remover_chave(ListaSaltosC* l, int chave) {
+    NoLSC* ant[LSC_NIVEL_MAX];
+    NoLSC* seg[LSC_NIVEL_MAX];
+    int s = lsc_entrar(l);
+    if (!lsc_localizar(l, chave, ant, seg)) {
+        lsc_sair(l, s);
+        return 0;
+    }
+    NoLSC* v = seg[0];
+    for (int i = v->nivel - 1; i >= 1; i--) {
+        uintptr_t nx = atomic_load(&v->proximo[i]);
+        while (!LSC_MARCADO(nx)) {
+            LSC_MOVE();
+            atomic_compare_exchange_weak(&v->proximo[i], &nx, nx | LSC_MARCA);
+        }
+    }
+    uintptr_t nx = atomic_load(&v->proximo[0]);
+    for (;;) {
+        if (LSC_MARCADO(nx)) {   // outra thread removeu antes
+            lsc_sair(l, s);
+            return 0;
+        }
+        LSC_MOVE();
+        if (atomic_compare_exchange_strong(&v->proximo[0], &nx, nx | LSC_MARCA)) break;
+    }
+    lsc_localizar(l, chave, ant, seg);   // desliga de todos os níveis
+    if (atomic_fetch_or(&v->estado, 2) & 1) lsc_aposentar(l, s, v);
+    lsc_sair(l, s);
+    return 1;
+}
+
+int lsc_buscar(ListaSaltosC* l, int chave) {
+    int s = lsc_entrar(l);
+    NoLSC* pred = l->cabeca;
+    NoLSC* curr = NULL;
+    for (int i = atomic_load(&l->nivel) - 1; i >= 0; i--) {
+        curr = LSC_PTR(atomic_load(&pred->proximo[i]));
+        while (curr) {
+            LSC_VISIT();
+            uintptr_t succ = atomic_load(&curr->proximo[i]);
+            if (LSC_MARCADO(succ)) { curr = LSC_PTR(succ); continue; }
+            if (curr->valor >= chave) break;
+            pred = curr;
+            curr = LSC_PTR(succ);
+        }
+    }
+    int achou = curr && curr->valor == chave;
+    lsc_sair(l, s);
+    return achou;
+}
+
+void lsc_destruir(ListaSaltosC* l) {
+    if (!l) return;
+    NoLSC* x = LSC_PTR(atomic_load(&l->cabeca->proximo[0]));
+    while (x) {
+        NoLSC* p = LSC_PTR(atomic_load(&x->proximo[0]));
+        free(x);
+        x = p;
+    }
+    for (int i = 0; i < LSC_MAX_THREADS; i++) {
+        AposentadosLSC* a = &l->aposentados[i];
+        for (int j = 0; j < a->n; j++) free(a->nos[j]);
+        free(a->nos);
+        free(a->epoca);
+    }
+    free(l->cabeca);
+    free(l);
+}
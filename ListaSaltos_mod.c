@@ -0,0 +1,184 @@
+// Lista de saltos (skip list, Pugh)
+// Alternativa probabilística às árvores balanceadas: cada nó sorteia um nível
+// (promovido com probabilidade 1/LS_PROMOVER a cada nível, até LS_NIVEL_MAX) e
+// entra nas listas encadeadas dos níveis 0..nivel-1. A busca desce do nível mais
+// alto em uso, avançando em cada nível enquanto a próxima chave for menor.
+// Não há rebalanceamento: o custo esperado é O(log n) por causa do sorteio.
+// Chaves repetidas aumentam a quantidade do nó (como na AVL).
+// O sorteio usa um gerador próprio de cada lista (semente fixa), então os
+// níveis não dependem de rand() e o experimento é reprodutível.
+// Conta de forma consistente (mesmas categorias da AVL, com NIVEL no lugar de
+// HEIGHT/ROT):
+// - comparações/visitas (COUNT_VISIT)
+// - movimentação de ponteiros/atribuições estruturais (COUNT_MOVE)
+// - mudanças de nível: promoções sorteadas para o nó novo e subidas/descidas
+//   do nível em uso da lista (COUNT_NIVEL)
+// - alocação/liberação de nós (COUNT_ALLOC / COUNT_FREE)
+// Exporta funções:
+//   ListaSaltos* ls_criar();
+//   void ls_inserir(ListaSaltos*, int);
+//   int ls_remover_chave(ListaSaltos*, int); // remove 1 ocorrência
+//   int ls_buscar(ListaSaltos*, int);
+//   long ls_percorrer(ListaSaltos*, void (*)(int, int, void*), void*); // em ordem (valor, quantidade)
+//   int ls_nivel(ListaSaltos*);              // níveis em uso (0 = vazia)
+//   void ls_remover_tudo(ListaSaltos*);
+//   long ls_get_insercao_and_reset();
+//   long ls_get_remocao_and_reset();
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#define LS_NIVEL_MAX 32
+#define LS_PROMOVER 4      // promove com probabilidade 1/4 (Pugh)
+
+typedef struct noLS {
+    int valor;
+    int quantidade;
+    int nivel;
+    struct noLS* proximo[];   // nivel ponteiros
+} NoLS;
+
+typedef struct ListaSaltos {
+    NoLS* cabeca[LS_NIVEL_MAX];   // primeiro nó de cada nível
+    int nivel;                    // níveis em uso
+    unsigned long long semente;   // gerador dos níveis (xorshift64*)
+} ListaSaltos;
+
+static _Thread_local long LS_COUNT_VISIT = 0;  // comparações / visitas (navegação)
+static _Thread_local long LS_COUNT_MOVE  = 0;  // atribuições / mov. ponteiros (links)
+static _Thread_local long LS_COUNT_NIVEL = 0;  // promoções e mudanças do nível da lista
+static _Thread_local long LS_COUNT_ALLOC = 0;  // alocações de nós
+static _Thread_local long LS_COUNT_FREE  = 0;  // liberações de nós
+
+long ls_get_insercao_and_reset() {
+    long total = LS_COUNT_VISIT + LS_COUNT_MOVE + LS_COUNT_NIVEL + LS_COUNT_ALLOC;
+    LS_COUNT_VISIT = LS_COUNT_MOVE = LS_COUNT_NIVEL = LS_COUNT_ALLOC = 0;
+    return total;
+}
+long ls_get_remocao_and_reset() {
+    long total = LS_COUNT_VISIT + LS_COUNT_MOVE + LS_COUNT_NIVEL + LS_COUNT_FREE;
+    LS_COUNT_VISIT = LS_COUNT_MOVE = LS_COUNT_NIVEL = LS_COUNT_FREE = 0;
+    return total;
+}
+
+#define LS_VISIT() (LS_COUNT_VISIT++)
+#define LS_MOVE()  (LS_COUNT_MOVE++)
+#define LS_NIVEL() (LS_COUNT_NIVEL++)
+#define LS_ALLOC() (LS_COUNT_ALLOC++)
+#define LS_FREE()  (LS_COUNT_FREE++)
+
+ListaSaltos* ls_criar() {
+    ListaSaltos* l = (ListaSaltos*) malloc(sizeof(ListaSaltos));
+    for (int i = 0; i < LS_NIVEL_MAX; i++) l->cabeca[i] = NULL;
+    l->nivel = 0;
+    l->semente = 0x9E3779B97F4A7C15ULL;
+    return l;
+}
+
+static int ls_sortear_nivel(ListaSaltos* l) {
+    int nivel = 1;
+    for (;;) {
+        l->semente ^= l->semente >> 12;
+        l->semente ^= l->semente << 25;
+        l->semente ^= l->semente >> 27;
+        unsigned long long r = (l->semente * 0x2545F4914F6CDD1DULL) >> 32;
+        if (nivel >= LS_NIVEL_MAX || r % LS_PROMOVER != 0) return nivel;
+        nivel++;
+        LS_NIVEL();
+    }
+}
+
+/* desce da cabeça até a chave: anterior[i] aponta para o campo que liga, no
+   nível i, o último nó com valor < chave ao seguinte (um campo de cabeca ou o
+   proximo[i] de um nó) */
+static NoLS* ls_localizar(ListaSaltos* l, int chave, NoLS*** anterior) {
+    NoLS** x = l->cabeca;
+    for (int i = l->nivel - 1; i >= 0; i--) {
+        while (x[i]) {
+            LS_VISIT();
+            if (x[i]->valor >= chave) break;
+            x = x[i]->proximo;
+        }
+        if (anterior) anterior[i] = &x[i];
+    }
+    return l->nivel > 0 ? x[0] : NULL;
+}
+
+void ls_inserir(ListaSaltos* l, int chave) {
+    NoLS** anterior[LS_NIVEL_MAX];
+    NoLS* y = ls_localizar(l, chave, anterior);
+    if (y && y->valor == chave) {
+        y->quantidade++; LS_MOVE();
+        return;
+    }
+    int nivel = ls_sortear_nivel(l);
+    for (int i = l->nivel; i < nivel; i++) {
+        anterior[i] = &l->cabeca[i];
+        LS_NIVEL();
+    }
+    if (nivel > l->nivel) l->nivel = nivel;
+
+    NoLS* n = (NoLS*) malloc(sizeof(NoLS) + sizeof(NoLS*) * nivel);
+    LS_ALLOC();
+    n->valor = chave;
+    n->quantidade = 1;
+    n->nivel = nivel;
+    for (int i = 0; i < nivel; i++) {
+        n->proximo[i] = *anterior[i]; LS_MOVE();
+        *anterior[i] = n; LS_MOVE();
+    }
+}
+
+int ls_remover_chave(ListaSaltos* l, int chave) {
+    NoLS** anterior[LS_NIVEL_MAX];
+    NoLS* y = ls_localizar(l, chave, anterior);
+    if (!y || y->valor != chave) return 0;
+    if (y->quantidade > 1) {
+        y->quantidade--; LS_MOVE();
+        return 1;
+    }
+    for (int i = 0; i < y->nivel; i++) {
+        *anterior[i] = y->proximo[i]; LS_MOVE();
+    }
+    free(y);
+    LS_FREE();
+    while (l->nivel > 0 && l->cabeca[l->nivel - 1] == NULL) {
+        l->nivel--;
+        LS_NIVEL();
+    }
+    return 1;
+}
+
+int ls_buscar(ListaSaltos* l, int chave) {
+    if (!l) return 0;
+    NoLS* y = ls_localizar(l, chave, NULL);
+    return y && y->valor == chave;
+}
+
+/* percurso em ordem: cb(valor, quantidade, ctx) por chave distinta */
+long ls_percorrer(ListaSaltos* l, void (*cb)(int, int, void*), void* ctx) {
+    long c = 0;
+    if (!l) return 0;
+    for (NoLS* x = l->cabeca[0]; x; x = x->proximo[0]) {
+        cb(x->valor, x->quantidade, ctx);
+        c++;
+    }
+    return c;
+}
+
+int ls_nivel(ListaSaltos* l) {
+    return l ? l->nivel : 0;
+}
+
+void ls_remover_tudo(ListaSaltos* l) {
+    if (!l) return;
+    NoLS* x = l->cabeca[0];
+    while (x) {
+        NoLS* p = x->proximo[0];
+        free(x);
+        LS_FREE();
+        x = p;
+    }
+    for (int i = 0; i < LS_NIVEL_MAX; i++) l->cabeca[i] = NULL;
+    l->nivel = 0;
+}
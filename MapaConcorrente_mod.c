@@ -0,0 +1,450 @@
+// AVL e Rubro-Negra com leitores sem trava (1 escritor, N leitores)
+// - o escritor nunca altera um nó publicado: a inserção copia o caminho raiz -> folha
+//   (path copying) e rotaciona/recolore só as cópias; a nova raiz é publicada com
+//   um store atômico (release)
+// - leitores não pegam trava: anunciam a época corrente, leem a raiz e percorrem
+//   uma versão imutável da árvore (busca e percurso em ordem são consistentes)
+// - nós substituídos são aposentados com a época da escrita e só liberados quando
+//   nenhum leitor ativo anunciou uma época <= a dela (epoch-based reclamation)
+// Escritores são serializados por um mutex (o caso de uso é um escritor só).
+// Contadores (só do escritor, mesmas categorias da AVL_mod.c / RubroNegra_mod.c):
+// VISIT, MOVE, HEIGHT, ROT, ALLOC (inclui cópias do caminho), FREE (recuperação).
+// Exporta funções:
+//   ArvoreCAVL* cavl_criar();          ArvoreCRB* crb_criar();
+//   void cavl_inserir(ArvoreCAVL*, int);   void crb_inserir(ArvoreCRB*, int);
+//   int cavl_buscar(ArvoreCAVL*, int);     int crb_buscar(ArvoreCRB*, int);
+//   long cavl_percorrer(ArvoreCAVL*, void (*)(int, int, void*), void*);
+//   long crb_percorrer(ArvoreCRB*, void (*)(int, int, void*), void*);
+//   void cavl_destruir(ArvoreCAVL*);       void crb_destruir(ArvoreCRB*);
+//   long cavl_get_insercao_and_reset();    long crb_get_insercao_and_reset();
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define MAX_LEITORES 128   /* threads leitoras vivas ao mesmo tempo */
+#define RECUPERAR_A_CADA 64   /* escritas entre varreduras de recuperação */
+
+/* --------------------------------------------------
+   Épocas (reclamação de memória)
+   -------------------------------------------------- */
+
+typedef struct {
+    _Atomic unsigned long epoca;                    /* começa em 1 */
+    _Atomic unsigned long leitores[MAX_LEITORES];   /* 0 = fora de leitura */
+    void** aposentados;
+    unsigned long* epoca_aposentado;
+    int n_aposentados, cap_aposentados;
+    int escritas;
+    pthread_mutex_t escritor;
+} Epocas;
+
+/* slots de leitor: o slot volta a ficar livre quando a thread termina (fora de
+   leitura, o anúncio dela já é 0 em todas as árvores) */
+static atomic_int SLOT_USADO[MAX_LEITORES];
+static _Thread_local int MEU_SLOT = -1;
+static pthread_key_t CHAVE_SLOT;
+static pthread_once_t CHAVE_SLOT_UMA_VEZ = PTHREAD_ONCE_INIT;
+
+static void soltar_slot(void* x) {
+    atomic_store(&SLOT_USADO[(int) (intptr_t) x - 1], 0);
+}
+
+static void iniciar_chave_slot() {
+    pthread_key_create(&CHAVE_SLOT, soltar_slot);
+}
+
+static int slot_leitor() {
+    if (MEU_SLOT < 0) {
+        pthread_once(&CHAVE_SLOT_UMA_VEZ, iniciar_chave_slot);
+        for (int i = 0; i < MAX_LEITORES && MEU_SLOT < 0; i++) {
+            int livre = 0;
+            if (atomic_compare_exchange_strong(&SLOT_USADO[i], &livre, 1)) MEU_SLOT = i;
+        }
+        if (MEU_SLOT < 0) {
+            fprintf(stderr, "MapaConcorrente: mais de %d threads leitoras vivas\n", MAX_LEITORES);
+            abort();
+        }
+        pthread_setspecific(CHAVE_SLOT, (void*) (intptr_t) (MEU_SLOT + 1));
+    }
+    return MEU_SLOT;
+}
+
+static void epocas_iniciar(Epocas* e) {
+    atomic_init(&e->epoca, 1);
+    for (int i = 0; i < MAX_LEITORES; i++) atomic_init(&e->leitores[i], 0);
+    e->cap_aposentados = 1024;
+    e->aposentados = (void**) malloc(sizeof(void*) * e->cap_aposentados);
+    e->epoca_aposentado = (unsigned long*) malloc(sizeof(unsigned long) * e->cap_aposentados);
+    e->n_aposentados = 0;
+    e->escritas = 0;
+    pthread_mutex_init(&e->escritor, NULL);
+}
+
+/* seq_cst: o anúncio da época precisa ficar visível antes da leitura da raiz */
+static void leitura_entrar(Epocas* e) {
+    int s = slot_leitor();
+    atomic_store(&e->leitores[s], atomic_load(&e->epoca));
+}
+
+static void leitura_sair(Epocas* e) {
+    atomic_store_explicit(&e->leitores[MEU_SLOT], 0, memory_order_release);
+}
+
+static void aposentar(Epocas* e, void* no) {
+    if (e->n_aposentados == e->cap_aposentados) {
+        e->cap_aposentados *= 2;
+        e->aposentados = (void**) realloc(e->aposentados, sizeof(void*) * e->cap_aposentados);
+        e->epoca_aposentado = (unsigned long*) realloc(e->epoca_aposentado, sizeof(unsigned long) * e->cap_aposentados);
+    }
+    e->aposentados[e->n_aposentados] = no;
+    e->epoca_aposentado[e->n_aposentados] = atomic_load_explicit(&e->epoca, memory_order_relaxed);
+    e->n_aposentados++;
+}
+
+/* libera os aposentados que nenhum leitor ativo pode estar vendo; devolve quantos */
+static long recuperar(Epocas* e) {
+    unsigned long minimo = (unsigned long) -1;
+    for (int i = 0; i < MAX_LEITORES; i++) {
+        unsigned long v = atomic_load(&e->leitores[i]);
+        if (v != 0 && v < minimo) minimo = v;
+    }
+    long liberados = 0;
+    int j = 0;
+    for (int i = 0; i < e->n_aposentados; i++) {
+        if (e->epoca_aposentado[i] < minimo) {
+            free(e->aposentados[i]);
+            liberados++;
+        } else {
+            e->aposentados[j] = e->aposentados[i];
+            e->epoca_aposentado[j] = e->epoca_aposentado[i];
+            j++;
+        }
+    }
+    e->n_aposentados = j;
+    return liberados;
+}
+
+/* chamada pelo escritor logo após publicar a nova raiz */
+static long escrita_concluida(Epocas* e) {
+    atomic_fetch_add(&e->epoca, 1);
+    if (++e->escritas % RECUPERAR_A_CADA == 0) return recuperar(e);
+    return 0;
+}
+
+static void epocas_finalizar(Epocas* e) {
+    for (int i = 0; i < e->n_aposentados; i++) free(e->aposentados[i]);
+    free(e->aposentados);
+    free(e->epoca_aposentado);
+    pthread_mutex_destroy(&e->escritor);
+}
+
+/* ==================================================
+   AVL com path copying
+   ================================================== */
+
+typedef struct noCA {
+    struct noCA* esquerda;
+    struct noCA* direita;
+    int altura;
+    int valor;
+    int quantidade;
+} NoCA;
+
+typedef struct arvoreCAVL {
+    NoCA* _Atomic raiz;
+    Epocas ep;
+} ArvoreCAVL;
+
+static long CAVL_COUNT_VISIT = 0;
+static long CAVL_COUNT_MOVE = 0;
+static long CAVL_COUNT_HEIGHT = 0;
+static long CAVL_COUNT_ROT = 0;
+static long CAVL_COUNT_ALLOC = 0;
+static long CAVL_COUNT_FREE = 0;
+
+long cavl_get_insercao_and_reset() {
+    long total = CAVL_COUNT_VISIT + CAVL_COUNT_MOVE + CAVL_COUNT_HEIGHT + CAVL_COUNT_ROT + CAVL_COUNT_ALLOC;
+    CAVL_COUNT_VISIT = CAVL_COUNT_MOVE = CAVL_COUNT_HEIGHT = CAVL_COUNT_ROT = CAVL_COUNT_ALLOC = CAVL_COUNT_FREE = 0;
+    return total;
+}
+
+static inline int cavl_altura(NoCA* n) { return n ? n->altura : 0; }
+static inline int cavl_max(int a, int b) { return a > b ? a : b; }
+
+static void cavl_atualiza(NoCA* n) {
+    n->altura = 1 + cavl_max(cavl_altura(n->esquerda), cavl_altura(n->direita));
+    CAVL_COUNT_HEIGHT++;
+}
+
+ArvoreCAVL* cavl_criar() {
+    ArvoreCAVL* a = (ArvoreCAVL*) malloc(sizeof(ArvoreCAVL));
+    atomic_init(&a->raiz, NULL);
+    epocas_iniciar(&a->ep);
+    return a;
+}
+
+/* cópia privada do escritor; o original vai para a fila de aposentados */
+static NoCA* cavl_copiar(ArvoreCAVL* a, NoCA* n) {
+    NoCA* c = (NoCA*) malloc(sizeof(NoCA));
+    *c = *n;
+    aposentar(&a->ep, n);
+    CAVL_COUNT_ALLOC++; CAVL_COUNT_MOVE++;
+    return c;
+}
+
+/* rotações só tocam cópias do caminho (ainda não publicadas) */
+static NoCA* cavl_rot_esq(NoCA* x) {
+    CAVL_COUNT_ROT++;
+    NoCA* y = x->direita;
+    x->direita = y->esquerda; CAVL_COUNT_MOVE++;
+    y->esquerda = x; CAVL_COUNT_MOVE++;
+    cavl_atualiza(x);
+    cavl_atualiza(y);
+    return y;
+}
+
+static NoCA* cavl_rot_dir(NoCA* y) {
+    CAVL_COUNT_ROT++;
+    NoCA* x = y->esquerda;
+    y->esquerda = x->direita; CAVL_COUNT_MOVE++;
+    x->direita = y; CAVL_COUNT_MOVE++;
+    cavl_atualiza(y);
+    cavl_atualiza(x);
+    return x;
+}
+
+static NoCA* cavl_ins(ArvoreCAVL* a, NoCA* n, int chave) {
+    if (!n) {
+        NoCA* novo = (NoCA*) malloc(sizeof(NoCA));
+        novo->esquerda = novo->direita = NULL;
+        novo->altura = 1;
+        novo->valor = chave;
+        novo->quantidade = 1;
+        CAVL_COUNT_ALLOC++; CAVL_COUNT_MOVE++;
+        return novo;
+    }
+    CAVL_COUNT_VISIT++;
+    NoCA* c = cavl_copiar(a, n);
+    if (chave < c->valor) {
+        c->esquerda = cavl_ins(a, c->esquerda, chave); CAVL_COUNT_MOVE++;
+    } else if (chave > c->valor) {
+        c->direita = cavl_ins(a, c->direita, chave); CAVL_COUNT_MOVE++;
+    } else {
+        c->quantidade++; CAVL_COUNT_MOVE++;
+        return c;
+    }
+
+    cavl_atualiza(c);
+    int fb = cavl_altura(c->esquerda) - cavl_altura(c->direita);
+    CAVL_COUNT_VISIT++;
+
+    /* o filho pesado está no caminho da inserção: também é cópia */
+    if (fb > 1) {
+        if (chave > c->esquerda->valor) c->esquerda = cavl_rot_esq(c->esquerda);
+        return cavl_rot_dir(c);
+    }
+    if (fb < -1) {
+        if (chave < c->direita->valor) c->direita = cavl_rot_dir(c->direita);
+        return cavl_rot_esq(c);
+    }
+    return c;
+}
+
+void cavl_inserir(ArvoreCAVL* a, int chave) {
+    pthread_mutex_lock(&a->ep.escritor);
+    NoCA* r = atomic_load_explicit(&a->raiz, memory_order_relaxed);
+    NoCA* nova = cavl_ins(a, r, chave);
+    atomic_store_explicit(&a->raiz, nova, memory_order_release); CAVL_COUNT_MOVE++;
+    CAVL_COUNT_FREE += escrita_concluida(&a->ep);
+    pthread_mutex_unlock(&a->ep.escritor);
+}
+
+int cavl_buscar(ArvoreCAVL* a, int chave) {
+    leitura_entrar(&a->ep);
+    NoCA* n = atomic_load(&a->raiz);
+    while (n && n->valor != chave) n = (chave < n->valor) ? n->esquerda : n->direita;
+    int achou = n != NULL;
+    leitura_sair(&a->ep);
+    return achou;
+}
+
+static long cavl_percorrer_rec(NoCA* n, void (*f)(int, int, void*), void* ctx) {
+    if (!n) return 0;
+    long c = cavl_percorrer_rec(n->esquerda, f, ctx);
+    if (f) f(n->valor, n->quantidade, ctx);
+    return c + 1 + cavl_percorrer_rec(n->direita, f, ctx);
+}
+
+/* percurso em ordem de uma única versão; devolve o número de nós visitados */
+long cavl_percorrer(ArvoreCAVL* a, void (*f)(int, int, void*), void* ctx) {
+    leitura_entrar(&a->ep);
+    long c = cavl_percorrer_rec(atomic_load(&a->raiz), f, ctx);
+    leitura_sair(&a->ep);
+    return c;
+}
+
+static void cavl_liberar_rec(NoCA* n) {
+    if (!n) return;
+    cavl_liberar_rec(n->esquerda);
+    cavl_liberar_rec(n->direita);
+    free(n);
+}
+
+/* sem leitores ativos */
+void cavl_destruir(ArvoreCAVL* a) {
+    if (!a) return;
+    cavl_liberar_rec(atomic_load(&a->raiz));
+    epocas_finalizar(&a->ep);
+    free(a);
+}
+
+/* ==================================================
+   Rubro-Negra com path copying (balanceamento de Okasaki)
+   ================================================== */
+
+enum coloracaoC {VermelhoC, PretoC};
+
+typedef struct noCR {
+    struct noCR* esquerda;
+    struct noCR* direita;
+    int cor;
+    int valor;
+    int quantidade;
+} NoCR;
+
+typedef struct arvoreCRB {
+    NoCR* _Atomic raiz;
+    Epocas ep;
+} ArvoreCRB;
+
+static long CRB_COUNT_VISIT = 0;
+static long CRB_COUNT_MOVE = 0;
+static long CRB_COUNT_ROT = 0;
+static long CRB_COUNT_ALLOC = 0;
+static long CRB_COUNT_FREE = 0;
+
+long crb_get_insercao_and_reset() {
+    long v = CRB_COUNT_VISIT + CRB_COUNT_MOVE + CRB_COUNT_ROT + CRB_COUNT_ALLOC;
+    CRB_COUNT_VISIT = CRB_COUNT_MOVE = CRB_COUNT_ROT = CRB_COUNT_ALLOC = CRB_COUNT_FREE = 0;
+    return v;
+}
+
+static inline int crb_vermelho(NoCR* n) { return n && n->cor == VermelhoC; }
+
+ArvoreCRB* crb_criar() {
+    ArvoreCRB* a = (ArvoreCRB*) malloc(sizeof(ArvoreCRB));
+    atomic_init(&a->raiz, NULL);
+    epocas_iniciar(&a->ep);
+    return a;
+}
+
+static NoCR* crb_copiar(ArvoreCRB* a, NoCR* n) {
+    NoCR* c = (NoCR*) malloc(sizeof(NoCR));
+    *c = *n;
+    aposentar(&a->ep, n);
+    CRB_COUNT_ALLOC++; CRB_COUNT_MOVE++;
+    return c;
+}
+
+/* z preto com filho e neto vermelhos (ambos cópias do caminho): reorganiza em
+   y vermelho com dois filhos pretos. Nenhum nó compartilhado é alterado. */
+static NoCR* crb_balancear(NoCR* z) {
+    if (z->cor != PretoC) return z;
+    NoCR *x, *y, *w;  /* em ordem: x < y < w */
+    if (crb_vermelho(z->esquerda) && crb_vermelho(z->esquerda->esquerda)) {
+        y = z->esquerda; x = y->esquerda; w = z;
+        w->esquerda = y->direita;
+    } else if (crb_vermelho(z->esquerda) && crb_vermelho(z->esquerda->direita)) {
+        x = z->esquerda; y = x->direita; w = z;
+        x->direita = y->esquerda;
+        w->esquerda = y->direita;
+    } else if (crb_vermelho(z->direita) && crb_vermelho(z->direita->esquerda)) {
+        x = z; w = z->direita; y = w->esquerda;
+        x->direita = y->esquerda;
+        w->esquerda = y->direita;
+    } else if (crb_vermelho(z->direita) && crb_vermelho(z->direita->direita)) {
+        x = z; y = z->direita; w = y->direita;
+        x->direita = y->esquerda;
+    } else {
+        return z;
+    }
+    CRB_COUNT_ROT++;
+    y->esquerda = x; y->direita = w;
+    CRB_COUNT_MOVE += 4;
+    y->cor = VermelhoC; x->cor = PretoC; w->cor = PretoC;
+    CRB_COUNT_MOVE += 3;
+    return y;
+}
+
+static NoCR* crb_ins(ArvoreCRB* a, NoCR* n, int chave) {
+    if (!n) {
+        NoCR* novo = (NoCR*) malloc(sizeof(NoCR));
+        novo->esquerda = novo->direita = NULL;
+        novo->cor = VermelhoC;
+        novo->valor = chave;
+        novo->quantidade = 1;
+        CRB_COUNT_ALLOC++; CRB_COUNT_MOVE++;
+        return novo;
+    }
+    CRB_COUNT_VISIT++;
+    NoCR* c = crb_copiar(a, n);
+    if (chave < c->valor) {
+        c->esquerda = crb_ins(a, c->esquerda, chave); CRB_COUNT_MOVE++;
+    } else if (chave > c->valor) {
+        c->direita = crb_ins(a, c->direita, chave); CRB_COUNT_MOVE++;
+    } else {
+        c->quantidade++; CRB_COUNT_MOVE++;
+        return c;
+    }
+    return crb_balancear(c);
+}
+
+void crb_inserir(ArvoreCRB* a, int chave) {
+    pthread_mutex_lock(&a->ep.escritor);
+    NoCR* r = atomic_load_explicit(&a->raiz, memory_order_relaxed);
+    NoCR* nova = crb_ins(a, r, chave);
+    nova->cor = PretoC; CRB_COUNT_MOVE++;   /* nova é cópia privada */
+    atomic_store_explicit(&a->raiz, nova, memory_order_release); CRB_COUNT_MOVE++;
+    CRB_COUNT_FREE += escrita_concluida(&a->ep);
+    pthread_mutex_unlock(&a->ep.escritor);
+}
+
+int crb_buscar(ArvoreCRB* a, int chave) {
+    leitura_entrar(&a->ep);
+    NoCR* n = atomic_load(&a->raiz);
+    while (n && n->valor != chave) n = (chave < n->valor) ? n->esquerda : n->direita;
+    int achou = n != NULL;
+    leitura_sair(&a->ep);
+    return achou;
+}
+
+static long crb_percorrer_rec(NoCR* n, void (*f)(int, int, void*), void* ctx) {
+    if (!n) return 0;
+    long c = crb_percorrer_rec(n->esquerda, f, ctx);
+    if (f) f(n->valor, n->quantidade, ctx);
+    return c + 1 + crb_percorrer_rec(n->direita, f, ctx);
+}
+
+long crb_percorrer(ArvoreCRB* a, void (*f)(int, int, void*), void* ctx) {
+    leitura_entrar(&a->ep);
+    long c = crb_percorrer_rec(atomic_load(&a->raiz), f, ctx);
+    leitura_sair(&a->ep);
+    return c;
+}
+
+static void crb_liberar_rec(NoCR* n) {
+    if (!n) return;
+    crb_liberar_rec(n->esquerda);
+    crb_liberar_rec(n->direita);
+    free(n);
+}
+
+void crb_destruir(ArvoreCRB* a) {
+    if (!a) return;
+    crb_liberar_rec(atomic_load(&a->raiz));
+    epocas_finalizar(&a->ep);
+    free(a);
+}
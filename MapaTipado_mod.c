@@ -0,0 +1,890 @@
+// Mapas chave -> valor especializados em tempo de compilação (AVL, Rubro-Negra, B)
+// - cada especialização fixa o tipo da chave, o tipo do valor e a comparação
+//   (macro MT_CMP, expandida no código: sem callback de comparação)
+// - o valor fica no próprio nó (na B-tree, no mesmo bloco das chaves), então a
+//   busca devolve um ponteiro para ele sem segunda indireção
+// - chaves únicas: inserir numa chave existente só troca o valor
+// O arquivo se inclui uma vez por especialização: sem MT_NOME definido ele
+// declara os tipos comuns e as especializações; com MT_NOME, gera as três
+// árvores para aquela chave/valor.
+// Especializações (prefixo, tipo, chave, valor):
+//   mapa_u32     MapaU32     uint32_t       ValorMapa8
+//   mapa_u64     MapaU64     uint64_t       ValorMapa8
+//   mapa_u64v16  MapaU64V16  uint64_t       ValorMapa16
+//   mapa_s16     MapaS16     ChaveTexto16   ValorMapa8   (16 bytes, memcmp)
+// Contadores por especialização e árvore (mesmas categorias dos *_mod.c):
+// VISIT (comparações), MOVE (ponteiros, alturas, cores, deslocamentos),
+// ESTRUT (rotações / splits / merges e empréstimos), ALLOC, FREE.
+// Exporta funções, para cada prefixo P e tipo T (K = chave, V = valor):
+//   TAVL* P_avl_criar();       TRB* P_rb_criar();       TB* P_b_criar(int ordem);  // ordem >= 2
+//   int P_avl_inserir(TAVL*, K, V);   // 1 se a chave é nova, 0 se só atualizou o valor
+//   V* P_avl_buscar(TAVL*, K);        // ponteiro para o valor no nó; NULL se ausente
+//   int P_avl_remover(TAVL*, K);      // 1 se removeu
+//   long P_avl_tamanho(TAVL*);
+//   long P_avl_percorrer(TAVL*, void (*)(K, V*, void*), void*);  // em ordem
+//   void P_avl_destruir(TAVL*);
+//   long P_avl_get_busca_and_reset();
+//   long P_avl_get_insercao_and_reset();
+//   long P_avl_get_remocao_and_reset();
+//   (idem com P_rb_* / TRB e P_b_* / TB)
+
+#ifndef MT_NOME
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct { char c[16]; } ChaveTexto16;
+typedef struct { uint64_t v; } ValorMapa8;
+typedef struct { uint64_t v[2]; } ValorMapa16;
+
+typedef struct {
+    long visit, move, estrut, alloc, free;
+} ContasMapa;
+
+static long contas_mapa_zerar(ContasMapa* c, long total) {
+    c->visit = c->move = c->estrut = c->alloc = c->free = 0;
+    return total;
+}
+
+#define MT_CAT_(a, b) a##b
+#define MT_CAT(a, b) MT_CAT_(a, b)
+#define MT_F(s) MT_CAT(MT_NOME, _##s)     /* mapa_u64 + avl_criar -> mapa_u64_avl_criar */
+#define MT_T(s) MT_CAT(MT_TIPO, s)        /* MapaU64 + AVL -> MapaU64AVL */
+
+#define MT_CMP_INT(a, b) (((a) > (b)) - ((a) < (b)))
+
+/* --------------------------------------------------
+   Especializações
+   -------------------------------------------------- */
+
+#define MT_NOME mapa_u32
+#define MT_TIPO MapaU32
+#define MT_CHAVE uint32_t
+#define MT_VALOR ValorMapa8
+#define MT_CMP(a, b) MT_CMP_INT(a, b)
+#include "MapaTipado_mod.c"
+
+#define MT_NOME mapa_u64
+#define MT_TIPO MapaU64
+#define MT_CHAVE uint64_t
+#define MT_VALOR ValorMapa8
+#define MT_CMP(a, b) MT_CMP_INT(a, b)
+#include "MapaTipado_mod.c"
+
+#define MT_NOME mapa_u64v16
+#define MT_TIPO MapaU64V16
+#define MT_CHAVE uint64_t
+#define MT_VALOR ValorMapa16
+#define MT_CMP(a, b) MT_CMP_INT(a, b)
+#include "MapaTipado_mod.c"
+
+#define MT_NOME mapa_s16
+#define MT_TIPO MapaS16
+#define MT_CHAVE ChaveTexto16
+#define MT_VALOR ValorMapa8
+#define MT_CMP(a, b) memcmp((a).c, (b).c, sizeof((a).c))
+#include "MapaTipado_mod.c"
+
+#else /* MT_NOME: corpo gerado para uma especialização */
+
+/* ==================================================
+   AVL (recursiva, sem ponteiro para o pai)
+   ================================================== */
+
+typedef struct MT_T(NoAVL) {
+    struct MT_T(NoAVL)* esquerda;
+    struct MT_T(NoAVL)* direita;
+    MT_CHAVE chave;
+    MT_VALOR valor;
+    int altura;
+} MT_T(NoAVL);
+
+typedef struct MT_T(AVL) {
+    MT_T(NoAVL)* raiz;
+    long tamanho;
+} MT_T(AVL);
+
+static _Thread_local ContasMapa MT_F(avl_contas);
+#define MT_CA MT_F(avl_contas)
+
+long MT_F(avl_get_busca_and_reset)() {
+    return contas_mapa_zerar(&MT_CA, MT_CA.visit);
+}
+long MT_F(avl_get_insercao_and_reset)() {
+    return contas_mapa_zerar(&MT_CA, MT_CA.visit + MT_CA.move + MT_CA.estrut + MT_CA.alloc);
+}
+long MT_F(avl_get_remocao_and_reset)() {
+    return contas_mapa_zerar(&MT_CA, MT_CA.visit + MT_CA.move + MT_CA.estrut + MT_CA.free);
+}
+
+MT_T(AVL)* MT_F(avl_criar)() {
+    MT_T(AVL)* m = (MT_T(AVL)*) malloc(sizeof(MT_T(AVL)));
+    m->raiz = NULL;
+    m->tamanho = 0;
+    return m;
+}
+
+static inline int MT_F(avl_altura)(MT_T(NoAVL)* x) { return x ? x->altura : 0; }
+
+static inline void MT_F(avl_atualizar)(MT_T(NoAVL)* x) {
+    int he = MT_F(avl_altura)(x->esquerda), hd = MT_F(avl_altura)(x->direita);
+    x->altura = 1 + (he > hd ? he : hd);
+    MT_CA.move++;
+}
+
+static MT_T(NoAVL)* MT_F(avl_rot_dir)(MT_T(NoAVL)* y) {
+    MT_T(NoAVL)* x = y->esquerda;
+    y->esquerda = x->direita;
+    x->direita = y;
+    MT_CA.estrut++; MT_CA.move += 2;
+    MT_F(avl_atualizar)(y);
+    MT_F(avl_atualizar)(x);
+    return x;
+}
+
+static MT_T(NoAVL)* MT_F(avl_rot_esq)(MT_T(NoAVL)* x) {
+    MT_T(NoAVL)* y = x->direita;
+    x->direita = y->esquerda;
+    y->esquerda = x;
+    MT_CA.estrut++; MT_CA.move += 2;
+    MT_F(avl_atualizar)(x);
+    MT_F(avl_atualizar)(y);
+    return y;
+}
+
+static MT_T(NoAVL)* MT_F(avl_balancear)(MT_T(NoAVL)* x) {
+    MT_F(avl_atualizar)(x);
+    int fb = MT_F(avl_altura)(x->esquerda) - MT_F(avl_altura)(x->direita);
+    if (fb > 1) {
+        if (MT_F(avl_altura)(x->esquerda->esquerda) < MT_F(avl_altura)(x->esquerda->direita))
+            x->esquerda = MT_F(avl_rot_esq)(x->esquerda);
+        return MT_F(avl_rot_dir)(x);
+    }
+    if (fb < -1) {
+        if (MT_F(avl_altura)(x->direita->direita) < MT_F(avl_altura)(x->direita->esquerda))
+            x->direita = MT_F(avl_rot_dir)(x->direita);
+        return MT_F(avl_rot_esq)(x);
+    }
+    return x;
+}
+
+/* *mudou = 1 quando um nó foi criado (só então é preciso rebalancear na volta) */
+static MT_T(NoAVL)* MT_F(avl_ins)(MT_T(NoAVL)* x, MT_CHAVE k, const MT_VALOR* v, int* mudou) {
+    if (!x) {
+        MT_T(NoAVL)* z = (MT_T(NoAVL)*) malloc(sizeof(MT_T(NoAVL)));
+        z->esquerda = z->direita = NULL;
+        z->chave = k;
+        z->valor = *v;
+        z->altura = 1;
+        MT_CA.alloc++;
+        *mudou = 1;
+        return z;
+    }
+    MT_CA.visit++;
+    int c = MT_CMP(k, x->chave);
+    if (c == 0) {
+        x->valor = *v;
+        return x;
+    }
+    if (c < 0) x->esquerda = MT_F(avl_ins)(x->esquerda, k, v, mudou);
+    else x->direita = MT_F(avl_ins)(x->direita, k, v, mudou);
+    if (!*mudou) return x;
+    MT_CA.move++;
+    return MT_F(avl_balancear)(x);
+}
+
+int MT_F(avl_inserir)(MT_T(AVL)* m, MT_CHAVE k, MT_VALOR v) {
+    int mudou = 0;
+    m->raiz = MT_F(avl_ins)(m->raiz, k, &v, &mudou);
+    m->tamanho += mudou;
+    return mudou;
+}
+
+MT_VALOR* MT_F(avl_buscar)(MT_T(AVL)* m, MT_CHAVE k) {
+    MT_T(NoAVL)* x = m->raiz;
+    while (x) {
+        MT_CA.visit++;
+        int c = MT_CMP(k, x->chave);
+        if (c == 0) return &x->valor;
+        x = c < 0 ? x->esquerda : x->direita;
+    }
+    return NULL;
+}
+
+/* tira o mínimo da subárvore x e o devolve em *min */
+static MT_T(NoAVL)* MT_F(avl_tirar_min)(MT_T(NoAVL)* x, MT_T(NoAVL)** min) {
+    MT_CA.visit++;
+    if (!x->esquerda) {
+        *min = x;
+        return x->direita;
+    }
+    x->esquerda = MT_F(avl_tirar_min)(x->esquerda, min);
+    MT_CA.move++;
+    return MT_F(avl_balancear)(x);
+}
+
+static MT_T(NoAVL)* MT_F(avl_rem)(MT_T(NoAVL)* x, MT_CHAVE k, int* removeu) {
+    if (!x) return NULL;
+    MT_CA.visit++;
+    int c = MT_CMP(k, x->chave);
+    if (c < 0) x->esquerda = MT_F(avl_rem)(x->esquerda, k, removeu);
+    else if (c > 0) x->direita = MT_F(avl_rem)(x->direita, k, removeu);
+    else {
+        MT_T(NoAVL)* resto;
+        *removeu = 1;
+        if (!x->esquerda || !x->direita) {
+            resto = x->esquerda ? x->esquerda : x->direita;
+        } else {
+            x->direita = MT_F(avl_tirar_min)(x->direita, &resto);
+            resto->esquerda = x->esquerda;
+            resto->direita = x->direita;
+            MT_CA.move += 2;
+            resto = MT_F(avl_balancear)(resto);
+        }
+        free(x);
+        MT_CA.free++;
+        return resto;
+    }
+    if (!*removeu) return x;
+    MT_CA.move++;
+    return MT_F(avl_balancear)(x);
+}
+
+int MT_F(avl_remover)(MT_T(AVL)* m, MT_CHAVE k) {
+    int removeu = 0;
+    m->raiz = MT_F(avl_rem)(m->raiz, k, &removeu);
+    m->tamanho -= removeu;
+    return removeu;
+}
+
+long MT_F(avl_tamanho)(MT_T(AVL)* m) { return m->tamanho; }
+
+static long MT_F(avl_percorrer_rec)(MT_T(NoAVL)* x, void (*f)(MT_CHAVE, MT_VALOR*, void*), void* ctx) {
+    if (!x) return 0;
+    long c = MT_F(avl_percorrer_rec)(x->esquerda, f, ctx);
+    f(x->chave, &x->valor, ctx);
+    return c + 1 + MT_F(avl_percorrer_rec)(x->direita, f, ctx);
+}
+
+long MT_F(avl_percorrer)(MT_T(AVL)* m, void (*f)(MT_CHAVE, MT_VALOR*, void*), void* ctx) {
+    return MT_F(avl_percorrer_rec)(m->raiz, f, ctx);
+}
+
+static void MT_F(avl_liberar)(MT_T(NoAVL)* x) {
+    if (!x) return;
+    MT_F(avl_liberar)(x->esquerda);
+    MT_F(avl_liberar)(x->direita);
+    free(x);
+    MT_CA.free++;
+}
+
+void MT_F(avl_destruir)(MT_T(AVL)* m) {
+    MT_F(avl_liberar)(m->raiz);
+    free(m);
+}
+
+#undef MT_CA
+
+/* ==================================================
+   Rubro-Negra (CLRS, sentinela própria da árvore)
+   ================================================== */
+
+typedef struct MT_T(NoRB) {
+    struct MT_T(NoRB)* esquerda;
+    struct MT_T(NoRB)* direita;
+    struct MT_T(NoRB)* pai;
+    MT_CHAVE chave;
+    MT_VALOR valor;
+    char vermelho;
+} MT_T(NoRB);
+
+typedef struct MT_T(RB) {
+    MT_T(NoRB)* raiz;
+    MT_T(NoRB) nulo;    // sentinela: preta, filhos apontam para ela mesma
+    long tamanho;
+} MT_T(RB);
+
+static _Thread_local ContasMapa MT_F(rb_contas);
+#define MT_CR MT_F(rb_contas)
+
+long MT_F(rb_get_busca_and_reset)() {
+    return contas_mapa_zerar(&MT_CR, MT_CR.visit);
+}
+long MT_F(rb_get_insercao_and_reset)() {
+    return contas_mapa_zerar(&MT_CR, MT_CR.visit + MT_CR.move + MT_CR.estrut + MT_CR.alloc);
+}
+long MT_F(rb_get_remocao_and_reset)() {
+    return contas_mapa_zerar(&MT_CR, MT_CR.visit + MT_CR.move + MT_CR.estrut + MT_CR.free);
+}
+
+MT_T(RB)* MT_F(rb_criar)() {
+    MT_T(RB)* m = (MT_T(RB)*) malloc(sizeof(MT_T(RB)));
+    memset(&m->nulo, 0, sizeof(m->nulo));
+    m->nulo.esquerda = m->nulo.direita = m->nulo.pai = &m->nulo;
+    m->nulo.vermelho = 0;
+    m->raiz = &m->nulo;
+    m->tamanho = 0;
+    return m;
+}
+
+static void MT_F(rb_rot_esq)(MT_T(RB)* m, MT_T(NoRB)* x) {
+    MT_T(NoRB)* nulo = &m->nulo;
+    MT_T(NoRB)* y = x->direita;
+    x->direita = y->esquerda;
+    if (y->esquerda != nulo) y->esquerda->pai = x;
+    y->pai = x->pai;
+    if (x->pai == nulo) m->raiz = y;
+    else if (x == x->pai->esquerda) x->pai->esquerda = y;
+    else x->pai->direita = y;
+    y->esquerda = x;
+    x->pai = y;
+    MT_CR.estrut++; MT_CR.move += 6;
+}
+
+static void MT_F(rb_rot_dir)(MT_T(RB)* m, MT_T(NoRB)* x) {
+    MT_T(NoRB)* nulo = &m->nulo;
+    MT_T(NoRB)* y = x->esquerda;
+    x->esquerda = y->direita;
+    if (y->direita != nulo) y->direita->pai = x;
+    y->pai = x->pai;
+    if (x->pai == nulo) m->raiz = y;
+    else if (x == x->pai->direita) x->pai->direita = y;
+    else x->pai->esquerda = y;
+    y->direita = x;
+    x->pai = y;
+    MT_CR.estrut++; MT_CR.move += 6;
+}
+
+static void MT_F(rb_inserir_fixup)(MT_T(RB)* m, MT_T(NoRB)* z) {
+    while (z->pai->vermelho) {
+        MT_T(NoRB)* avo = z->pai->pai;
+        if (z->pai == avo->esquerda) {
+            MT_T(NoRB)* tio = avo->direita;
+            if (tio->vermelho) {
+                z->pai->vermelho = 0; tio->vermelho = 0; avo->vermelho = 1;
+                MT_CR.move += 3;
+                z = avo;
+            } else {
+                if (z == z->pai->direita) {
+                    z = z->pai;
+                    MT_F(rb_rot_esq)(m, z);
+                }
+                z->pai->vermelho = 0; z->pai->pai->vermelho = 1;
+                MT_CR.move += 2;
+                MT_F(rb_rot_dir)(m, z->pai->pai);
+            }
+        } else {
+            MT_T(NoRB)* tio = avo->esquerda;
+            if (tio->vermelho) {
+                z->pai->vermelho = 0; tio->vermelho = 0; avo->vermelho = 1;
+                MT_CR.move += 3;
+                z = avo;
+            } else {
+                if (z == z->pai->esquerda) {
+                    z = z->pai;
+                    MT_F(rb_rot_dir)(m, z);
+                }
+                z->pai->vermelho = 0; z->pai->pai->vermelho = 1;
+                MT_CR.move += 2;
+                MT_F(rb_rot_esq)(m, z->pai->pai);
+            }
+        }
+    }
+    m->raiz->vermelho = 0;
+}
+
+int MT_F(rb_inserir)(MT_T(RB)* m, MT_CHAVE k, MT_VALOR v) {
+    MT_T(NoRB)* nulo = &m->nulo;
+    MT_T(NoRB)* y = nulo;
+    MT_T(NoRB)* x = m->raiz;
+    int c = 0;
+    while (x != nulo) {
+        MT_CR.visit++;
+        c = MT_CMP(k, x->chave);
+        if (c == 0) {
+            x->valor = v;
+            return 0;
+        }
+        y = x;
+        x = c < 0 ? x->esquerda : x->direita;
+    }
+    MT_T(NoRB)* z = (MT_T(NoRB)*) malloc(sizeof(MT_T(NoRB)));
+    z->chave = k;
+    z->valor = v;
+    z->esquerda = z->direita = nulo;
+    z->pai = y;
+    z->vermelho = 1;
+    MT_CR.alloc++; MT_CR.move++;
+    if (y == nulo) m->raiz = z;
+    else if (c < 0) y->esquerda = z;
+    else y->direita = z;
+    m->tamanho++;
+    MT_F(rb_inserir_fixup)(m, z);
+    return 1;
+}
+
+MT_VALOR* MT_F(rb_buscar)(MT_T(RB)* m, MT_CHAVE k) {
+    MT_T(NoRB)* x = m->raiz;
+    while (x != &m->nulo) {
+        MT_CR.visit++;
+        int c = MT_CMP(k, x->chave);
+        if (c == 0) return &x->valor;
+        x = c < 0 ? x->esquerda : x->direita;
+    }
+    return NULL;
+}
+
+static void MT_F(rb_transplantar)(MT_T(RB)* m, MT_T(NoRB)* u, MT_T(NoRB)* v) {
+    if (u->pai == &m->nulo) m->raiz = v;
+    else if (u == u->pai->esquerda) u->pai->esquerda = v;
+    else u->pai->direita = v;
+    v->pai = u->pai;
+    MT_CR.move += 2;
+}
+
+static void MT_F(rb_remover_fixup)(MT_T(RB)* m, MT_T(NoRB)* x) {
+    while (x != m->raiz && !x->vermelho) {
+        if (x == x->pai->esquerda) {
+            MT_T(NoRB)* w = x->pai->direita;
+            if (w->vermelho) {
+                w->vermelho = 0; x->pai->vermelho = 1;
+                MT_CR.move += 2;
+                MT_F(rb_rot_esq)(m, x->pai);
+                w = x->pai->direita;
+            }
+            if (!w->esquerda->vermelho && !w->direita->vermelho) {
+                w->vermelho = 1;
+                MT_CR.move++;
+                x = x->pai;
+            } else {
+                if (!w->direita->vermelho) {
+                    w->esquerda->vermelho = 0; w->vermelho = 1;
+                    MT_CR.move += 2;
+                    MT_F(rb_rot_dir)(m, w);
+                    w = x->pai->direita;
+                }
+                w->vermelho = x->pai->vermelho;
+                x->pai->vermelho = 0; w->direita->vermelho = 0;
+                MT_CR.move += 3;
+                MT_F(rb_rot_esq)(m, x->pai);
+                x = m->raiz;
+            }
+        } else {
+            MT_T(NoRB)* w = x->pai->esquerda;
+            if (w->vermelho) {
+                w->vermelho = 0; x->pai->vermelho = 1;
+                MT_CR.move += 2;
+                MT_F(rb_rot_dir)(m, x->pai);
+                w = x->pai->esquerda;
+            }
+            if (!w->direita->vermelho && !w->esquerda->vermelho) {
+                w->vermelho = 1;
+                MT_CR.move++;
+                x = x->pai;
+            } else {
+                if (!w->esquerda->vermelho) {
+                    w->direita->vermelho = 0; w->vermelho = 1;
+                    MT_CR.move += 2;
+                    MT_F(rb_rot_esq)(m, w);
+                    w = x->pai->esquerda;
+                }
+                w->vermelho = x->pai->vermelho;
+                x->pai->vermelho = 0; w->esquerda->vermelho = 0;
+                MT_CR.move += 3;
+                MT_F(rb_rot_dir)(m, x->pai);
+                x = m->raiz;
+            }
+        }
+    }
+    x->vermelho = 0;
+}
+
+int MT_F(rb_remover)(MT_T(RB)* m, MT_CHAVE k) {
+    MT_T(NoRB)* nulo = &m->nulo;
+    MT_T(NoRB)* z = m->raiz;
+    while (z != nulo) {
+        MT_CR.visit++;
+        int c = MT_CMP(k, z->chave);
+        if (c == 0) break;
+        z = c < 0 ? z->esquerda : z->direita;
+    }
+    if (z == nulo) return 0;
+
+    MT_T(NoRB)* y = z;
+    MT_T(NoRB)* x;
+    int y_vermelho = y->vermelho;
+    if (z->esquerda == nulo) {
+        x = z->direita;
+        MT_F(rb_transplantar)(m, z, z->direita);
+    } else if (z->direita == nulo) {
+        x = z->esquerda;
+        MT_F(rb_transplantar)(m, z, z->esquerda);
+    } else {
+        y = z->direita;
+        while (y->esquerda != nulo) { MT_CR.visit++; y = y->esquerda; }
+        y_vermelho = y->vermelho;
+        x = y->direita;
+        if (y->pai == z) {
+            x->pai = y;     /* pode ser a sentinela: o fixup sobe por ela */
+            MT_CR.move++;
+        } else {
+            MT_F(rb_transplantar)(m, y, y->direita);
+            y->direita = z->direita;
+            y->direita->pai = y;
+            MT_CR.move += 2;
+        }
+        MT_F(rb_transplantar)(m, z, y);
+        y->esquerda = z->esquerda;
+        y->esquerda->pai = y;
+        y->vermelho = z->vermelho;
+        MT_CR.move += 3;
+    }
+    free(z);
+    MT_CR.free++;
+    m->tamanho--;
+    if (!y_vermelho) MT_F(rb_remover_fixup)(m, x);
+    nulo->pai = nulo;
+    return 1;
+}
+
+long MT_F(rb_tamanho)(MT_T(RB)* m) { return m->tamanho; }
+
+static long MT_F(rb_percorrer_rec)(MT_T(RB)* m, MT_T(NoRB)* x, void (*f)(MT_CHAVE, MT_VALOR*, void*), void* ctx) {
+    if (x == &m->nulo) return 0;
+    long c = MT_F(rb_percorrer_rec)(m, x->esquerda, f, ctx);
+    f(x->chave, &x->valor, ctx);
+    return c + 1 + MT_F(rb_percorrer_rec)(m, x->direita, f, ctx);
+}
+
+long MT_F(rb_percorrer)(MT_T(RB)* m, void (*f)(MT_CHAVE, MT_VALOR*, void*), void* ctx) {
+    return MT_F(rb_percorrer_rec)(m, m->raiz, f, ctx);
+}
+
+static void MT_F(rb_liberar)(MT_T(RB)* m, MT_T(NoRB)* x) {
+    if (x == &m->nulo) return;
+    MT_F(rb_liberar)(m, x->esquerda);
+    MT_F(rb_liberar)(m, x->direita);
+    free(x);
+    MT_CR.free++;
+}
+
+void MT_F(rb_destruir)(MT_T(RB)* m) {
+    MT_F(rb_liberar)(m, m->raiz);
+    free(m);
+}
+
+#undef MT_CR
+
+/* ==================================================
+   B-tree (CLRS, ordem mínima t >= 2)
+   Chaves, valores e filhos de um nó ficam num único bloco logo após o
+   cabeçalho: chaves[2t-1], valores[2t-1], filhos[2t].
+   ================================================== */
+
+typedef struct MT_T(NoB) {
+    MT_CHAVE* chaves;
+    MT_VALOR* valores;
+    struct MT_T(NoB)** filhos;
+    int n;
+    int folha;
+} MT_T(NoB);
+
+typedef struct MT_T(B) {
+    MT_T(NoB)* raiz;
+    int t;
+    long tamanho;
+} MT_T(B);
+
+static _Thread_local ContasMapa MT_F(b_contas);
+#define MT_CB MT_F(b_contas)
+
+long MT_F(b_get_busca_and_reset)() {
+    return contas_mapa_zerar(&MT_CB, MT_CB.visit);
+}
+long MT_F(b_get_insercao_and_reset)() {
+    return contas_mapa_zerar(&MT_CB, MT_CB.visit + MT_CB.move + MT_CB.estrut + MT_CB.alloc);
+}
+long MT_F(b_get_remocao_and_reset)() {
+    return contas_mapa_zerar(&MT_CB, MT_CB.visit + MT_CB.move + MT_CB.estrut + MT_CB.free);
+}
+
+#define MT_ALINHAR(x) (((x) + 15) & ~(size_t) 15)
+
+static MT_T(NoB)* MT_F(b_novo_no)(int t, int folha) {
+    size_t cab = MT_ALINHAR(sizeof(MT_T(NoB)));
+    size_t ch = MT_ALINHAR(sizeof(MT_CHAVE) * (2 * t - 1));
+    size_t va = MT_ALINHAR(sizeof(MT_VALOR) * (2 * t - 1));
+    char* bloco = (char*) malloc(cab + ch + va + sizeof(MT_T(NoB)*) * 2 * t);
+    MT_T(NoB)* x = (MT_T(NoB)*) bloco;
+    x->chaves = (MT_CHAVE*) (bloco + cab);
+    x->valores = (MT_VALOR*) (bloco + cab + ch);
+    x->filhos = (MT_T(NoB)**) (bloco + cab + ch + va);
+    x->n = 0;
+    x->folha = folha;
+    MT_CB.alloc++;
+    return x;
+}
+
+#undef MT_ALINHAR
+
+MT_T(B)* MT_F(b_criar)(int ordem) {
+    if (ordem < 2) ordem = 2;
+    MT_T(B)* m = (MT_T(B)*) malloc(sizeof(MT_T(B)));
+    m->t = ordem;
+    m->raiz = MT_F(b_novo_no)(ordem, 1);
+    m->tamanho = 0;
+    return m;
+}
+
+/* primeira posição i com chaves[i] >= k; *igual = 1 se chaves[i] == k */
+static inline int MT_F(b_posicao)(MT_T(NoB)* x, MT_CHAVE k, int* igual) {
+    int i = 0;
+    *igual = 0;
+    while (i < x->n) {
+        MT_CB.visit++;
+        int c = MT_CMP(k, x->chaves[i]);
+        if (c <= 0) {
+            *igual = (c == 0);
+            break;
+        }
+        i++;
+    }
+    return i;
+}
+
+MT_VALOR* MT_F(b_buscar)(MT_T(B)* m, MT_CHAVE k) {
+    MT_T(NoB)* x = m->raiz;
+    for (;;) {
+        int igual;
+        int i = MT_F(b_posicao)(x, k, &igual);
+        if (igual) return &x->valores[i];
+        if (x->folha) return NULL;
+        x = x->filhos[i];
+    }
+}
+
+/* divide o filho cheio x->filhos[i]; a chave do meio sobe para x->chaves[i] */
+static void MT_F(b_dividir)(MT_T(NoB)* x, int i, int t) {
+    MT_T(NoB)* y = x->filhos[i];
+    MT_T(NoB)* z = MT_F(b_novo_no)(t, y->folha);
+    MT_CB.estrut++;
+    z->n = t - 1;
+    memcpy(z->chaves, y->chaves + t, sizeof(MT_CHAVE) * (t - 1));
+    memcpy(z->valores, y->valores + t, sizeof(MT_VALOR) * (t - 1));
+    MT_CB.move += t - 1;
+    if (!y->folha) {
+        memcpy(z->filhos, y->filhos + t, sizeof(MT_T(NoB)*) * t);
+        MT_CB.move += t;
+    }
+    y->n = t - 1;
+    memmove(x->filhos + i + 2, x->filhos + i + 1, sizeof(MT_T(NoB)*) * (x->n - i));
+    memmove(x->chaves + i + 1, x->chaves + i, sizeof(MT_CHAVE) * (x->n - i));
+    memmove(x->valores + i + 1, x->valores + i, sizeof(MT_VALOR) * (x->n - i));
+    MT_CB.move += 2 * (x->n - i) + 1;
+    x->filhos[i + 1] = z;
+    x->chaves[i] = y->chaves[t - 1];
+    x->valores[i] = y->valores[t - 1];
+    x->n++;
+    MT_CB.move += 2;
+}
+
+int MT_F(b_inserir)(MT_T(B)* m, MT_CHAVE k, MT_VALOR v) {
+    int t = m->t;
+    if (m->raiz->n == 2 * t - 1) {
+        MT_T(NoB)* s = MT_F(b_novo_no)(t, 0);
+        s->filhos[0] = m->raiz;
+        m->raiz = s;
+        MT_CB.move++;
+        MT_F(b_dividir)(s, 0, t);
+    }
+    MT_T(NoB)* x = m->raiz;
+    for (;;) {
+        int igual;
+        int i = MT_F(b_posicao)(x, k, &igual);
+        if (igual) {
+            x->valores[i] = v;
+            return 0;
+        }
+        if (x->folha) {
+            memmove(x->chaves + i + 1, x->chaves + i, sizeof(MT_CHAVE) * (x->n - i));
+            memmove(x->valores + i + 1, x->valores + i, sizeof(MT_VALOR) * (x->n - i));
+            x->chaves[i] = k;
+            x->valores[i] = v;
+            x->n++;
+            MT_CB.move += x->n - i + 1;
+            m->tamanho++;
+            return 1;
+        }
+        if (x->filhos[i]->n == 2 * t - 1) {
+            MT_F(b_dividir)(x, i, t);
+            MT_CB.visit++;
+            int c = MT_CMP(k, x->chaves[i]);
+            if (c == 0) {
+                x->valores[i] = v;
+                return 0;
+            }
+            if (c > 0) i++;
+        }
+        x = x->filhos[i];
+    }
+}
+
+/* junta x->filhos[i], x->chaves[i] e x->filhos[i+1] (ambos com t-1 chaves) */
+static void MT_F(b_fundir)(MT_T(NoB)* x, int i, int t) {
+    MT_T(NoB)* y = x->filhos[i];
+    MT_T(NoB)* z = x->filhos[i + 1];
+    MT_CB.estrut++;
+    y->chaves[t - 1] = x->chaves[i];
+    y->valores[t - 1] = x->valores[i];
+    memcpy(y->chaves + t, z->chaves, sizeof(MT_CHAVE) * z->n);
+    memcpy(y->valores + t, z->valores, sizeof(MT_VALOR) * z->n);
+    if (!y->folha) memcpy(y->filhos + t, z->filhos, sizeof(MT_T(NoB)*) * (z->n + 1));
+    MT_CB.move += 1 + z->n + (y->folha ? 0 : z->n + 1);
+    y->n += z->n + 1;
+    memmove(x->chaves + i, x->chaves + i + 1, sizeof(MT_CHAVE) * (x->n - i - 1));
+    memmove(x->valores + i, x->valores + i + 1, sizeof(MT_VALOR) * (x->n - i - 1));
+    memmove(x->filhos + i + 1, x->filhos + i + 2, sizeof(MT_T(NoB)*) * (x->n - i - 1));
+    MT_CB.move += 2 * (x->n - i - 1);
+    x->n--;
+    free(z);
+    MT_CB.free++;
+}
+
+/* garante que x->filhos[i] tenha >= t chaves antes de descer; devolve o índice
+   do filho a seguir (muda se houve fusão com o irmão esquerdo) */
+static int MT_F(b_reforcar)(MT_T(NoB)* x, int i, int t) {
+    MT_T(NoB)* c = x->filhos[i];
+    if (i > 0 && x->filhos[i - 1]->n >= t) {
+        MT_T(NoB)* e = x->filhos[i - 1];
+        MT_CB.estrut++;
+        memmove(c->chaves + 1, c->chaves, sizeof(MT_CHAVE) * c->n);
+        memmove(c->valores + 1, c->valores, sizeof(MT_VALOR) * c->n);
+        if (!c->folha) memmove(c->filhos + 1, c->filhos, sizeof(MT_T(NoB)*) * (c->n + 1));
+        c->chaves[0] = x->chaves[i - 1];
+        c->valores[0] = x->valores[i - 1];
+        if (!c->folha) c->filhos[0] = e->filhos[e->n];
+        x->chaves[i - 1] = e->chaves[e->n - 1];
+        x->valores[i - 1] = e->valores[e->n - 1];
+        c->n++;
+        e->n--;
+        MT_CB.move += c->n + 3;
+        return i;
+    }
+    if (i < x->n && x->filhos[i + 1]->n >= t) {
+        MT_T(NoB)* d = x->filhos[i + 1];
+        MT_CB.estrut++;
+        c->chaves[c->n] = x->chaves[i];
+        c->valores[c->n] = x->valores[i];
+        if (!c->folha) c->filhos[c->n + 1] = d->filhos[0];
+        x->chaves[i] = d->chaves[0];
+        x->valores[i] = d->valores[0];
+        memmove(d->chaves, d->chaves + 1, sizeof(MT_CHAVE) * (d->n - 1));
+        memmove(d->valores, d->valores + 1, sizeof(MT_VALOR) * (d->n - 1));
+        if (!d->folha) memmove(d->filhos, d->filhos + 1, sizeof(MT_T(NoB)*) * d->n);
+        c->n++;
+        d->n--;
+        MT_CB.move += d->n + 3;
+        return i;
+    }
+    if (i < x->n) {
+        MT_F(b_fundir)(x, i, t);
+        return i;
+    }
+    MT_F(b_fundir)(x, i - 1, t);
+    return i - 1;
+}
+
+static int MT_F(b_rem)(MT_T(NoB)* x, MT_CHAVE k, int t) {
+    for (;;) {
+        int igual;
+        int i = MT_F(b_posicao)(x, k, &igual);
+        if (igual && x->folha) {
+            memmove(x->chaves + i, x->chaves + i + 1, sizeof(MT_CHAVE) * (x->n - i - 1));
+            memmove(x->valores + i, x->valores + i + 1, sizeof(MT_VALOR) * (x->n - i - 1));
+            x->n--;
+            MT_CB.move += x->n - i + 1;
+            return 1;
+        }
+        if (igual) {
+            MT_T(NoB)* e = x->filhos[i];
+            MT_T(NoB)* d = x->filhos[i + 1];
+            if (e->n >= t || d->n >= t) {
+                /* troca pelo predecessor (ou sucessor) e o remove da subárvore */
+                MT_T(NoB)* y = e->n >= t ? e : d;
+                MT_T(NoB)* w = y;
+                if (y == e) {
+                    while (!w->folha) { MT_CB.visit++; w = w->filhos[w->n]; }
+                    x->chaves[i] = w->chaves[w->n - 1];
+                    x->valores[i] = w->valores[w->n - 1];
+                } else {
+                    while (!w->folha) { MT_CB.visit++; w = w->filhos[0]; }
+                    x->chaves[i] = w->chaves[0];
+                    x->valores[i] = w->valores[0];
+                }
+                MT_CB.move += 2;
+                k = x->chaves[i];
+                x = y;
+                continue;
+            }
+            MT_F(b_fundir)(x, i, t);
+            x = e;
+            continue;
+        }
+        if (x->folha) return 0;
+        if (x->filhos[i]->n < t) i = MT_F(b_reforcar)(x, i, t);
+        x = x->filhos[i];
+    }
+}
+
+int MT_F(b_remover)(MT_T(B)* m, MT_CHAVE k) {
+    int removeu = MT_F(b_rem)(m->raiz, k, m->t);
+    if (m->raiz->n == 0 && !m->raiz->folha) {
+        MT_T(NoB)* velha = m->raiz;
+        m->raiz = velha->filhos[0];
+        free(velha);
+        MT_CB.free++; MT_CB.move++;
+    }
+    m->tamanho -= removeu;
+    return removeu;
+}
+
+long MT_F(b_tamanho)(MT_T(B)* m) { return m->tamanho; }
+
+static long MT_F(b_percorrer_rec)(MT_T(NoB)* x, void (*f)(MT_CHAVE, MT_VALOR*, void*), void* ctx) {
+    long c = 0;
+    for (int i = 0; i < x->n; i++) {
+        if (!x->folha) c += MT_F(b_percorrer_rec)(x->filhos[i], f, ctx);
+        f(x->chaves[i], &x->valores[i], ctx);
+        c++;
+    }
+    if (!x->folha) c += MT_F(b_percorrer_rec)(x->filhos[x->n], f, ctx);
+    return c;
+}
+
+long MT_F(b_percorrer)(MT_T(B)* m, void (*f)(MT_CHAVE, MT_VALOR*, void*), void* ctx) {
+    return MT_F(b_percorrer_rec)(m->raiz, f, ctx);
+}
+
+static void MT_F(b_liberar)(MT_T(NoB)* x) {
+    if (!x->folha)
+        for (int i = 0; i <= x->n; i++) MT_F(b_liberar)(x->filhos[i]);
+    free(x);
+    MT_CB.free++;
+}
+
+void MT_F(b_destruir)(MT_T(B)* m) {
+    MT_F(b_liberar)(m->raiz);
+    free(m);
+}
+
+#undef MT_CB
+
+#undef MT_NOME
+#undef MT_TIPO
+#undef MT_CHAVE
+#undef MT_VALOR
+#undef MT_CMP
+
+#endif /* MT_NOME */
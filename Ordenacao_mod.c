@@ -0,0 +1,88 @@
+// Radix sort LSD das chaves int, compartilhado pelos lotes e pela carga.
+// Não é compilado à parte: AVL_mod.c, RubroNegra_mod.c e B_mod.c fazem
+// #include "Ordenacao_mod.c" (tudo aqui é static, como em Arena_mod.c).
+//
+// 4 passadas de 8 bits com o bit de sinal invertido (a ordem dos unsigned
+// vira a dos int), estável. Cada passada conta os dígitos por pedaço do
+// vetor, os deslocamentos saem da soma na ordem (dígito, pedaço) e cada
+// pedaço é espalhado na região reservada para ele; passadas em que todas as
+// chaves têm o mesmo dígito são puladas. Os pedaços podem rodar em threads:
+// quem chama passa o executor (que também soma os contadores do módulo);
+// sem executor roda tudo na thread atual.
+
+#ifndef ORDENACAO_MOD_C
+#define ORDENACAO_MOD_C
+
+#include <stdlib.h>
+#include <string.h>
+
+/* roda f(ctx, i, total) para i = 0..total-1 */
+typedef void (*OrdenacaoExecutor)(int, void (*)(void*, int, int), void*);
+
+typedef struct {
+    const int* de;
+    int* para;
+    int n;
+    int s;                // deslocamento do dígito
+    int (*cont)[256];     // [pedaço][dígito]; vira posição inicial antes de espalhar
+} RadixOrd;
+
+#define ORD_DIGITO(k, s) ((((unsigned) (k) ^ 0x80000000u) >> (s)) & 0xFF)
+
+static void ordenacao_contar(void* x, int i, int total) {
+    RadixOrd* r = (RadixOrd*) x;
+    int lo = (int) ((long) r->n * i / total), hi = (int) ((long) r->n * (i + 1) / total);
+    int* c = r->cont[i];
+    memset(c, 0, sizeof(int) * 256);
+    for (int j = lo; j < hi; j++) c[ORD_DIGITO(r->de[j], r->s)]++;
+}
+
+static void ordenacao_espalhar(void* x, int i, int total) {
+    RadixOrd* r = (RadixOrd*) x;
+    int lo = (int) ((long) r->n * i / total), hi = (int) ((long) r->n * (i + 1) / total);
+    int* c = r->cont[i];
+    for (int j = lo; j < hi; j++) r->para[c[ORD_DIGITO(r->de[j], r->s)]++] = r->de[j];
+}
+
+static void ordenacao_rodar(OrdenacaoExecutor executor, int pedacos, void (*f)(void*, int, int), void* ctx) {
+    if (executor && pedacos > 1) {
+        executor(pedacos, f, ctx);
+        return;
+    }
+    for (int i = 0; i < pedacos; i++) f(ctx, i, pedacos);
+}
+
+/* cópia ordenada de chaves[0..n) em `pedacos` pedaços (>= 1); quem chama libera */
+static int* ordenacao_radix(const int* chaves, int n, int pedacos, OrdenacaoExecutor executor) {
+    if (pedacos < 1) pedacos = 1;
+    int* v = (int*) malloc(sizeof(int) * (n > 0 ? n : 1));
+    int* tmp = (int*) malloc(sizeof(int) * (n > 0 ? n : 1));
+    int (*cont)[256] = malloc(sizeof(int[256]) * pedacos);
+    RadixOrd r = { chaves, v, n, 0, cont };
+    for (int s = 0; s < 32; s += 8) {
+        r.s = s;
+        ordenacao_rodar(executor, pedacos, ordenacao_contar, &r);
+        int pos = 0, unico = 0;
+        for (int d = 0; d < 256; d++) {
+            int soma = 0;
+            for (int i = 0; i < pedacos; i++) {
+                int c = cont[i][d];
+                cont[i][d] = pos + soma;
+                soma += c;
+            }
+            if (soma == n) unico = 1;
+            pos += soma;
+        }
+        if (unico) continue;
+        r.para = (r.de == v) ? tmp : v;
+        ordenacao_rodar(executor, pedacos, ordenacao_espalhar, &r);
+        r.de = r.para;
+    }
+    if (r.de == chaves && n > 0) memcpy(v, chaves, sizeof(int) * n);
+    else if (r.de == tmp) { int* x = v; v = tmp; tmp = x; }
+    free(tmp);
+    free(cont);
+    return v;
+}
+
+#endif
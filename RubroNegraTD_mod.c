@@ -0,0 +1,236 @@
+// Rubro-Negra top-down (passada única, sem ponteiro para o pai)
+// Inserção e remoção recolorem/rotacionam durante a descida: cada operação
+// percorre apenas o caminho raiz -> folha, sem laço de fixup subindo a árvore.
+// Contadores com as mesmas categorias da RubroNegra_mod.c (CLRS):
+//   RBTD_COUNT_VISIT, RBTD_COUNT_MOVE, RBTD_COUNT_HEIGHT, RBTD_COUNT_ROT,
+//   RBTD_COUNT_ALLOC, RBTD_COUNT_FREE
+// Exporta funções:
+//   ArvoreRBTD* rbtd_criar();
+//   void rbtd_inserir(ArvoreRBTD*, int);
+//   int rbtd_remover_chave(ArvoreRBTD*, int); // remove 1 ocorrência
+//   void rbtd_remover_tudo(ArvoreRBTD*);
+//   long rbtd_get_insercao_and_reset();
+//   long rbtd_get_remocao_and_reset();
+
+#include <stdlib.h>
+#include <stdio.h>
+
+enum coloracao {Vermelho, Preto};
+typedef enum coloracao Cor;
+
+typedef struct noRBTD {
+    struct noRBTD* filho[2]; /* 0 = esquerda, 1 = direita */
+    Cor cor;
+    int valor;
+    int quantidade;
+} NoRBTD;
+
+typedef struct arvoreRBTD {
+    NoRBTD* raiz;
+} ArvoreRBTD;
+
+static long RBTD_COUNT_VISIT  = 0;   // comparações / visitas (navegação)
+static long RBTD_COUNT_MOVE   = 0;   // atribuições / mov. ponteiros / recolorações
+static long RBTD_COUNT_HEIGHT = 0;   // atualizações estruturais (p/ compatibilidade)
+static long RBTD_COUNT_ROT    = 0;   // rotações simples (dupla conta 2)
+static long RBTD_COUNT_ALLOC  = 0;   // alocações de nós
+static long RBTD_COUNT_FREE   = 0;   // liberações de nós
+
+
+long rbtd_get_insercao_and_reset() {
+    long v = RBTD_COUNT_VISIT + RBTD_COUNT_MOVE + RBTD_COUNT_ROT + RBTD_COUNT_ALLOC;
+    RBTD_COUNT_VISIT = RBTD_COUNT_MOVE = RBTD_COUNT_HEIGHT = RBTD_COUNT_ROT = RBTD_COUNT_ALLOC = 0;
+    return v;
+}
+
+long rbtd_get_remocao_and_reset() {
+    long v = RBTD_COUNT_VISIT + RBTD_COUNT_MOVE + RBTD_COUNT_ROT + RBTD_COUNT_FREE;
+    RBTD_COUNT_VISIT = RBTD_COUNT_MOVE = RBTD_COUNT_HEIGHT = RBTD_COUNT_ROT = RBTD_COUNT_FREE = 0;
+    return v;
+}
+
+ArvoreRBTD* rbtd_criar();
+void rbtd_inserir(ArvoreRBTD*, int);
+int rbtd_remover_chave(ArvoreRBTD*, int);
+void rbtd_remover_tudo(ArvoreRBTD*);
+
+/* macros internas para contagem */
+#define RBTD_VISIT()  (RBTD_COUNT_VISIT++)
+#define RBTD_MOVE()   (RBTD_COUNT_MOVE++)
+#define RBTD_ROT()    (RBTD_COUNT_ROT++)
+#define RBTD_ALLOC()  (RBTD_COUNT_ALLOC++)
+#define RBTD_FREE()   (RBTD_COUNT_FREE++)
+#define RBTD_HEIGHT() (RBTD_COUNT_HEIGHT++)
+
+/* NULL conta como folha preta */
+static inline int vermelho(NoRBTD* n) { return n != NULL && n->cor == Vermelho; }
+
+static NoRBTD* novo_no_td(int valor) {
+    NoRBTD* n = (NoRBTD*) malloc(sizeof(NoRBTD));
+    n->filho[0] = n->filho[1] = NULL;
+    n->cor = Vermelho;
+    n->valor = valor;
+    n->quantidade = 1;
+    RBTD_ALLOC();
+    RBTD_MOVE(); /* ponteiros iniciais */
+    return n;
+}
+
+ArvoreRBTD* rbtd_criar() {
+    ArvoreRBTD* arv = (ArvoreRBTD*) malloc(sizeof(ArvoreRBTD));
+    arv->raiz = NULL;
+    RBTD_ALLOC(); /* contagem simbólica da árvore (sem sentinel) */
+    return arv;
+}
+
+/* rotação simples na direção dir: o filho !dir sobe; recolore como na inserção */
+static NoRBTD* rotacao_simples(NoRBTD* r, int dir) {
+    RBTD_ROT();
+    NoRBTD* s = r->filho[!dir];
+    r->filho[!dir] = s->filho[dir]; RBTD_MOVE();
+    s->filho[dir] = r; RBTD_MOVE();
+    r->cor = Vermelho; RBTD_MOVE();
+    s->cor = Preto; RBTD_MOVE();
+    RBTD_HEIGHT(); RBTD_HEIGHT();
+    return s;
+}
+
+static NoRBTD* rotacao_dupla(NoRBTD* r, int dir) {
+    r->filho[!dir] = rotacao_simples(r->filho[!dir], !dir); RBTD_MOVE();
+    return rotacao_simples(r, dir);
+}
+
+/* inserção top-down: color flip na descida, rotação quando pai e filho ficam vermelhos */
+void rbtd_inserir(ArvoreRBTD* arv, int valor) {
+    RBTD_VISIT();
+    if (arv->raiz == NULL) {
+        arv->raiz = novo_no_td(valor); RBTD_MOVE();
+        arv->raiz->cor = Preto; RBTD_MOVE();
+        return;
+    }
+
+    NoRBTD cabeca = { { NULL, NULL }, Preto, 0, 0 }; /* raiz falsa */
+    NoRBTD *g = NULL, *t = &cabeca, *p = NULL, *q = arv->raiz;
+    int dir = 0, ultimo = 0, criado = 0;
+    t->filho[1] = q;
+
+    for (;;) {
+        if (q == NULL) {
+            q = novo_no_td(valor);
+            p->filho[dir] = q; RBTD_MOVE();
+            criado = 1;
+        } else if (vermelho(q->filho[0]) && vermelho(q->filho[1])) {
+            q->cor = Vermelho; RBTD_MOVE();
+            q->filho[0]->cor = Preto; RBTD_MOVE();
+            q->filho[1]->cor = Preto; RBTD_MOVE();
+        }
+
+        /* vermelho-vermelho: rotaciona no avô */
+        if (vermelho(q) && vermelho(p)) {
+            int dir2 = t->filho[1] == g;
+            if (q == p->filho[ultimo]) t->filho[dir2] = rotacao_simples(g, !ultimo);
+            else t->filho[dir2] = rotacao_dupla(g, !ultimo);
+            RBTD_MOVE();
+        }
+
+        RBTD_VISIT();
+        if (q->valor == valor) {
+            if (!criado) { q->quantidade++; RBTD_MOVE(); }
+            break;
+        }
+
+        ultimo = dir;
+        dir = q->valor < valor;
+        if (g != NULL) t = g;
+        g = p; p = q;
+        q = q->filho[dir];
+    }
+
+    arv->raiz = cabeca.filho[1]; RBTD_MOVE();
+    arv->raiz->cor = Preto; RBTD_MOVE();
+}
+
+/* remoção top-down: empurra um nó vermelho para baixo durante a descida,
+   de forma que o nó físico removido (folha ou com um filho) seja vermelho */
+int rbtd_remover_chave(ArvoreRBTD* arv, int chave) {
+    if (!arv || arv->raiz == NULL) return 0;
+
+    NoRBTD cabeca = { { NULL, NULL }, Preto, 0, 0 }; /* raiz falsa */
+    NoRBTD *q = &cabeca, *p = NULL, *g = NULL, *f = NULL;
+    int dir = 1, removido = 0;
+    q->filho[1] = arv->raiz;
+
+    while (q->filho[dir] != NULL) {
+        int ultimo = dir;
+        g = p; p = q;
+        q = q->filho[dir];
+        RBTD_VISIT();
+        dir = q->valor < chave;
+
+        if (q->valor == chave) {
+            if (q->quantidade > 1) {
+                /* só decrementa; a árvore já é válida após cada passo da descida */
+                q->quantidade--; RBTD_MOVE();
+                removido = 1;
+                break;
+            }
+            f = q;
+        }
+
+        if (!vermelho(q) && !vermelho(q->filho[dir])) {
+            if (vermelho(q->filho[!dir])) {
+                p->filho[ultimo] = rotacao_simples(q, dir); RBTD_MOVE();
+                p = p->filho[ultimo];
+            } else {
+                NoRBTD* s = p->filho[!ultimo];
+                if (s != NULL) {
+                    RBTD_VISIT();
+                    if (!vermelho(s->filho[!ultimo]) && !vermelho(s->filho[ultimo])) {
+                        /* color flip */
+                        p->cor = Preto; RBTD_MOVE();
+                        s->cor = Vermelho; RBTD_MOVE();
+                        q->cor = Vermelho; RBTD_MOVE();
+                    } else {
+                        int dir2 = g->filho[1] == p;
+                        if (vermelho(s->filho[ultimo])) g->filho[dir2] = rotacao_dupla(p, ultimo);
+                        else g->filho[dir2] = rotacao_simples(p, ultimo);
+                        RBTD_MOVE();
+
+                        /* garante a coloração correta */
+                        q->cor = Vermelho; RBTD_MOVE();
+                        g->filho[dir2]->cor = Vermelho; RBTD_MOVE();
+                        g->filho[dir2]->filho[0]->cor = Preto; RBTD_MOVE();
+                        g->filho[dir2]->filho[1]->cor = Preto; RBTD_MOVE();
+                    }
+                }
+            }
+        }
+    }
+
+    if (f != NULL && !removido) {
+        /* q é o predecessor/sucessor em nível de folha: copia e desliga q */
+        f->valor = q->valor; RBTD_MOVE();
+        f->quantidade = q->quantidade; RBTD_MOVE();
+        p->filho[p->filho[1] == q] = q->filho[q->filho[0] == NULL]; RBTD_MOVE();
+        free(q); RBTD_FREE();
+        removido = 1;
+    }
+
+    arv->raiz = cabeca.filho[1]; RBTD_MOVE();
+    if (arv->raiz != NULL) { arv->raiz->cor = Preto; RBTD_MOVE(); }
+    return removido;
+}
+
+static void liberar_rec_td(NoRBTD* n) {
+    if (!n) return;
+    liberar_rec_td(n->filho[0]);
+    liberar_rec_td(n->filho[1]);
+    free(n); RBTD_FREE();
+}
+
+void rbtd_remover_tudo(ArvoreRBTD* arv) {
+    if (!arv) return;
+    liberar_rec_td(arv->raiz);
+    arv->raiz = NULL;
+    RBTD_COUNT_VISIT = RBTD_COUNT_MOVE = RBTD_COUNT_HEIGHT = RBTD_COUNT_ROT = RBTD_COUNT_ALLOC = RBTD_COUNT_FREE = 0;
+}
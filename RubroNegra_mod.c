@@ -1,7 +1,19 @@
 // Contadores detalhados: RB_COUNT_VISIT, RB_COUNT_MOVE, RB_COUNT_HEIGHT, RB_COUNT_ROT, RB_COUNT_ALLOC, RB_COUNT_FREE
+// e RB_COUNT_TAMANHO (atualizações do tamanho da subárvore; só em rb_get_tamanho_and_reset)
+// Serialização: rb_salvar grava um arquivo pré-ordem sem ponteiros; rb_carregar o
+// mapeia (mmap) e reconstrói a árvore numa passada; rb_mapear usa o arquivo mapeado
+// direto como árvore somente leitura (rb_mapa_buscar / rb_mapa_fechar).
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 
 enum coloracao {Vermelho, Preto};
 typedef enum coloracao Cor;
@@ -13,19 +25,23 @@ typedef struct noRB {
     Cor cor;
     int valor;
     int quantidade;
+    int tamanho;    /* ocorrências na subárvore (0 no sentinela), se RB_TAMANHO */
 } NoRB;
 
 typedef struct arvoreRB {
     NoRB* raiz;
     NoRB* nulo; /* sentinel */
+    NoRB* maximo; /* nó mais à direita, usado por rb_anexar (NULL = recalcular) */
 } ArvoreRB;
 
-static long RB_COUNT_VISIT  = 0;   // comparações / visitas (navegação)
-static long RB_COUNT_MOVE   = 0;   // atribuições / mov. ponteiros (links)
-static long RB_COUNT_HEIGHT = 0;   // atualizações estruturais (p/ compatibilidade)
-static long RB_COUNT_ROT    = 0;   // rotações
-static long RB_COUNT_ALLOC  = 0;   // alocações de nós
-static long RB_COUNT_FREE   = 0;   // liberações de nós
+/* por thread: as tarefas paralelas de rb_uniao & cia. devolvem suas contas a quem as criou */
+static _Thread_local long RB_COUNT_VISIT  = 0;   // comparações / visitas (navegação)
+static _Thread_local long RB_COUNT_MOVE   = 0;   // atribuições / mov. ponteiros (links)
+static _Thread_local long RB_COUNT_HEIGHT = 0;   // atualizações estruturais (p/ compatibilidade)
+static _Thread_local long RB_COUNT_ROT    = 0;   // rotações
+static _Thread_local long RB_COUNT_ALLOC  = 0;   // alocações de nós
+static _Thread_local long RB_COUNT_FREE   = 0;   // liberações de nós
+static _Thread_local long RB_COUNT_TAMANHO = 0;  // atualizações de tamanho da subárvore
 
 
 long rb_get_insercao_and_reset() {
@@ -40,10 +56,46 @@ long rb_get_remocao_and_reset() {
     return v;
 }
 
+/* operações de conjunto: todas as categorias */
+long rb_get_conjunto_and_reset() {
+    long v = RB_COUNT_VISIT + RB_COUNT_MOVE + RB_COUNT_ROT + RB_COUNT_ALLOC + RB_COUNT_FREE;
+    RB_COUNT_VISIT = RB_COUNT_MOVE = RB_COUNT_HEIGHT = RB_COUNT_ROT = RB_COUNT_ALLOC = RB_COUNT_FREE = 0;
+    return v;
+}
+
+/* custo do aumento por tamanho (rb_rank & cia.), separado das outras categorias */
+long rb_get_tamanho_and_reset() {
+    long v = RB_COUNT_TAMANHO;
+    RB_COUNT_TAMANHO = 0;
+    return v;
+}
+
 ArvoreRB* rb_criar();
 void rb_inserir(ArvoreRB*, int);
 int rb_remover_chave(ArvoreRB*, int);
+void rb_inserir_lote(ArvoreRB*, const int*, int);   // ordena e insere a partir de um dedo
+int rb_remover_lote(ArvoreRB*, const int*, int);    // idem; retorna quantas removeu
+void rb_anexar(ArvoreRB*, int);                     // inserção com dica: O(1) amortizado se chave >= máximo (sem RB_TAMANHO)
+long rb_remover_intervalo(ArvoreRB*, int, int);     // remove [lo, hi] (split/join); retorna ocorrências
+void rb_uniao(ArvoreRB*, ArvoreRB*);                // a = a ∪ b (quantidades somadas); b fica vazia
+void rb_intersecao(ArvoreRB*, ArvoreRB*);           // a = a ∩ b (menor quantidade); b fica vazia
+void rb_diferenca(ArvoreRB*, ArvoreRB*);            // a = a \ b (quantidades subtraídas); b fica vazia
+void rb_definir_threads(int);                       // threads das operações de conjunto (padrão 1)
+int rb_definir_arena(int, int);                     // nós numa arena (modo, NUMA; Arena_mod.c); retorna o modo efetivo
+void rb_arena_estado(int*, int*, long*);            // modo e NUMA efetivos, bytes mapeados
 void rb_remover_tudo(ArvoreRB*);
+int rb_buscar(ArvoreRB*, int);
+int rb_altura_preta(ArvoreRB*);                     // nós pretos da raiz a uma folha (0 = vazia)
+long rb_percorrer(ArvoreRB*, void (*)(int, int, void*), void*);
+long rb_rank(ArvoreRB*, int);                       // ocorrências < chave
+int rb_select(ArvoreRB*, long, int*);               // k-ésima ocorrência (k a partir de 0); 0 se k >= total
+long rb_contar_intervalo(ArvoreRB*, int, int);      // ocorrências em [lo, hi]
+typedef struct arvoreMapeadaRB ArvoreMapeadaRB;
+int rb_salvar(ArvoreRB*, const char*);
+ArvoreRB* rb_carregar(const char*);
+ArvoreMapeadaRB* rb_mapear(const char*);
+int rb_mapa_buscar(ArvoreMapeadaRB*, int);
+void rb_mapa_fechar(ArvoreMapeadaRB*);
 
 /* macros internas para contagem */
 #define RB_VISIT()  (RB_COUNT_VISIT++)
@@ -52,16 +104,50 @@ void rb_remover_tudo(ArvoreRB*);
 #define RB_ALLOC()  (RB_COUNT_ALLOC++)
 #define RB_FREE()   (RB_COUNT_FREE++)
 #define RB_HEIGHT() (RB_COUNT_HEIGHT++)
+#define RB_TAM()    (RB_COUNT_TAMANHO++)
+
+/* Aumento por tamanho da subárvore (ver AVL_mod.c): rotações recalculam os
+   dois nós, mudanças de forma ou de quantidade sobem até a raiz antes dos
+   fixups. Desligado por padrão, como na AVL; -DRB_TAMANHO=1 liga. Sem ele
+   rb_rank & cia. somam a subárvore. */
+#ifndef RB_TAMANHO
+#define RB_TAMANHO 0
+#endif
 
+static inline void rb_tam_atualizar(NoRB* x) {
+    if (!RB_TAMANHO) return;
+    x->tamanho = x->quantidade + x->esquerda->tamanho + x->direita->tamanho;
+    RB_TAM();
+}
+
+/* recalcula de x até a raiz */
+static void rb_tam_subir(ArvoreRB* arv, NoRB* x) {
+    if (!RB_TAMANHO) return;
+    for (; x != arv->nulo; x = x->pai) rb_tam_atualizar(x);
+}
+
+/* nós numa arena com páginas grandes / política NUMA (ver Arena_mod.c);
+   o sentinela de cada árvore continua em malloc */
+#include "Arena_mod.c"
+static Arena RB_ARENA = ARENA_INICIAL;
+
+int rb_definir_arena(int modo, int numa) {
+    return arena_definir(&RB_ARENA, modo, numa);
+}
+
+void rb_arena_estado(int* modo, int* numa, long* bytes) {
+    arena_estado(&RB_ARENA, modo, numa, bytes);
+}
 
 static NoRB* novo_no(ArvoreRB* arv, NoRB* pai, int valor) {
-    NoRB* n = (NoRB*) malloc(sizeof(NoRB));
+    NoRB* n = (NoRB*) arena_alocar(&RB_ARENA, sizeof(NoRB));
     n->pai = pai ? pai : arv->nulo;
     n->esquerda = arv->nulo;
     n->direita = arv->nulo;
     n->cor = Vermelho;
     n->valor = valor;
     n->quantidade = 1;
+    n->tamanho = 1;
     RB_ALLOC();
     RB_MOVE(); /* ponteiros iniciais */
     return n;
@@ -76,7 +162,9 @@ ArvoreRB* rb_criar() {
     arv->nulo->cor = Preto;
     arv->nulo->valor = 0;
     arv->nulo->quantidade = 0;
+    arv->nulo->tamanho = 0;
     arv->raiz = arv->nulo;
+    arv->maximo = NULL;
     RB_ALLOC(); RB_ALLOC(); /* uma para a arvore e outra para sentinel (contagem simbólica) */
     return arv;
 }
@@ -96,6 +184,8 @@ static void rotacao_esq(ArvoreRB* arv, NoRB* x) {
     y->esquerda = x; RB_MOVE();
     x->pai = y; RB_MOVE();
     RB_HEIGHT(); RB_HEIGHT();
+    rb_tam_atualizar(x);
+    rb_tam_atualizar(y);
 }
 
 static void rotacao_dir(ArvoreRB* arv, NoRB* x) {
@@ -112,6 +202,8 @@ static void rotacao_dir(ArvoreRB* arv, NoRB* x) {
     y->direita = x; RB_MOVE();
     x->pai = y; RB_MOVE();
     RB_HEIGHT(); RB_HEIGHT();
+    rb_tam_atualizar(x);
+    rb_tam_atualizar(y);
 }
 
 /* busca (visitas contadas) */
@@ -218,23 +310,8 @@ static void delete_fixup(ArvoreRB* arv, NoRB* x) {
     if (x && x != arv->nulo) { x->cor = Preto; RB_MOVE(); }
 }
 
-/* inserção pública */
-void rb_inserir(ArvoreRB* arv, int valor) {
-    RB_VISIT();
-    NoRB* y = arv->nulo;
-    NoRB* x = arv->raiz;
-    while (x != arv->nulo) {
-        y = x;
-        RB_VISIT();
-        if (valor == x->valor) { x->quantidade++; RB_MOVE(); return; }
-        if (valor < x->valor) x = x->esquerda;
-        else x = x->direita;
-    }
-    NoRB* z = novo_no(arv, y==arv->nulo?arv->nulo:y, valor);
-    if (y == arv->nulo) { arv->raiz = z; RB_MOVE(); }
-    else if (z->valor < y->valor) { y->esquerda = z; RB_MOVE(); }
-    else { y->direita = z; RB_MOVE(); }
-
+/* insert_fixup com contagem; retorna 1 se a raiz ficou vermelha e foi repintada (bh + 1) */
+static int insert_fixup(ArvoreRB* arv, NoRB* z) {
     while (z->pai != arv->nulo && z->pai->cor == Vermelho) {
         RB_VISIT();
         if (z->pai == z->pai->pai->esquerda) {
@@ -271,7 +348,30 @@ void rb_inserir(ArvoreRB* arv, int valor) {
             }
         }
     }
+    int subiu = arv->raiz->cor == Vermelho;
     arv->raiz->cor = Preto; RB_MOVE();
+    return subiu;
+}
+
+/* inserção pública */
+void rb_inserir(ArvoreRB* arv, int valor) {
+    if (arv->maximo && valor > arv->maximo->valor) arv->maximo = NULL;
+    RB_VISIT();
+    NoRB* y = arv->nulo;
+    NoRB* x = arv->raiz;
+    while (x != arv->nulo) {
+        y = x;
+        RB_VISIT();
+        if (valor == x->valor) { x->quantidade++; RB_MOVE(); rb_tam_subir(arv, x); return; }
+        if (valor < x->valor) x = x->esquerda;
+        else x = x->direita;
+    }
+    NoRB* z = novo_no(arv, y==arv->nulo?arv->nulo:y, valor);
+    if (y == arv->nulo) { arv->raiz = z; RB_MOVE(); }
+    else if (z->valor < y->valor) { y->esquerda = z; RB_MOVE(); }
+    else { y->direita = z; RB_MOVE(); }
+    rb_tam_subir(arv, y);
+    insert_fixup(arv, z);
 }
 
 /* buscar público */
@@ -279,21 +379,99 @@ static NoRB* rb_buscar_public(ArvoreRB* arv, int chave) {
     return buscar_no(arv, chave);
 }
 
-/* remoção por chave (CLRS com proteções) */
-int rb_remover_chave(ArvoreRB* arv, int chave) {
-    if (!arv || arv->raiz == arv->nulo) return 0;
-    NoRB* z = rb_buscar_public(arv, chave);
-    if (!z) return 0;
+int rb_buscar(ArvoreRB* arv, int chave) {
+    if (!arv) return 0;
+    return rb_buscar_public(arv, chave) != NULL;
+}
 
-    if (z->quantidade > 1) {
-        z->quantidade--; RB_MOVE();
+/* altura preta: nós pretos no caminho raiz -> folha (igual em todos; sem contagem) */
+int rb_altura_preta(ArvoreRB* arv) {
+    int h = 0;
+    if (!arv) return 0;
+    for (NoRB* x = arv->raiz; x != arv->nulo; x = x->esquerda)
+        if (x->cor == Preto) h++;
+    return h;
+}
+
+/* percurso em ordem: cb(valor, quantidade, ctx) por chave distinta */
+static long rb_percorrer_rec(ArvoreRB* arv, NoRB* x, void (*cb)(int, int, void*), void* ctx) {
+    if (x == arv->nulo) return 0;
+    long c = rb_percorrer_rec(arv, x->esquerda, cb, ctx);
+    cb(x->valor, x->quantidade, ctx);
+    return c + 1 + rb_percorrer_rec(arv, x->direita, cb, ctx);
+}
+
+long rb_percorrer(ArvoreRB* arv, void (*cb)(int, int, void*), void* ctx) {
+    if (!arv) return 0;
+    return rb_percorrer_rec(arv, arv->raiz, cb, ctx);
+}
+
+/* --------------------------------------------------
+   Estatísticas de ordem por ocorrência (ver AVL_mod.c): uma descida usando o
+   tamanho das subárvores, O(log n).
+   -------------------------------------------------- */
+
+/* tamanho da subárvore; sem o aumento, soma os nós */
+static long rb_tam(ArvoreRB* arv, NoRB* x) {
+    if (x == arv->nulo) return 0;
+    if (RB_TAMANHO) return x->tamanho;
+    return x->quantidade + rb_tam(arv, x->esquerda) + rb_tam(arv, x->direita);
+}
+
+/* ocorrências < chave (ou <= chave se inclusivo) */
+static long rb_contar_abaixo(ArvoreRB* arv, int chave, int inclusivo) {
+    long c = 0;
+    NoRB* x = arv->raiz;
+    while (x != arv->nulo) {
         RB_VISIT();
-        return 1;
+        if (chave < x->valor) {
+            x = x->esquerda;
+        } else if (chave == x->valor) {
+            return c + rb_tam(arv, x->esquerda) + (inclusivo ? x->quantidade : 0);
+        } else {
+            c += rb_tam(arv, x->esquerda) + x->quantidade;
+            x = x->direita;
+        }
     }
+    return c;
+}
+
+long rb_rank(ArvoreRB* arv, int chave) {
+    if (!arv) return 0;
+    return rb_contar_abaixo(arv, chave, 0);
+}
 
+int rb_select(ArvoreRB* arv, long k, int* chave) {
+    if (!arv || k < 0) return 0;
+    NoRB* x = arv->raiz;
+    while (x != arv->nulo) {
+        RB_VISIT();
+        long e = rb_tam(arv, x->esquerda);
+        if (k < e) {
+            x = x->esquerda;
+        } else if (k < e + x->quantidade) {
+            if (chave) *chave = x->valor;
+            return 1;
+        } else {
+            k -= e + x->quantidade;
+            x = x->direita;
+        }
+    }
+    return 0;
+}
+
+long rb_contar_intervalo(ArvoreRB* arv, int lo, int hi) {
+    if (!arv || lo > hi) return 0;
+    return rb_contar_abaixo(arv, hi, 1) - rb_contar_abaixo(arv, lo, 0);
+}
+
+/* remove fisicamente z (CLRS); devolve um nó que continua na árvore */
+static NoRB* rb_remover_no(ArvoreRB* arv, NoRB* z) {
     NoRB* y = z;
     NoRB* x;
     Cor y_original_cor = y->cor;
+    NoRB* dedo = z->pai;
+    NoRB* subir = z->pai;   /* mais baixo cujo tamanho muda */
 
     if (z->esquerda == arv->nulo) {
         x = z->direita; RB_VISIT();
@@ -303,7 +481,8 @@ int rb_remover_chave(ArvoreRB* arv, int chave) {
         transplant(arv, z, z->esquerda);
     } else {
         y = minimo(arv, z->direita);
-        if (!y) return 0;
+        dedo = y;
+        subir = (y->pai == z) ? y : y->pai;
         y_original_cor = y->cor;
         x = y->direita;
         if (y->pai == z) {
@@ -319,25 +498,799 @@ int rb_remover_chave(ArvoreRB* arv, int chave) {
         y->cor = z->cor; RB_MOVE();
     }
 
-    free(z); RB_FREE();
+    arena_liberar(&RB_ARENA, z); RB_FREE();
+    rb_tam_subir(arv, subir);
 
     if (y_original_cor == Preto) {
         if (!x) x = arv->nulo;
         delete_fixup(arv, x);
     }
+    return dedo != arv->nulo ? dedo : arv->raiz;
+}
+
+/* remoção por chave (CLRS com proteções) */
+int rb_remover_chave(ArvoreRB* arv, int chave) {
+    if (!arv || arv->raiz == arv->nulo) return 0;
+    NoRB* z = rb_buscar_public(arv, chave);
+    if (!z) return 0;
+    if (z == arv->maximo && z->quantidade == 1) arv->maximo = NULL;
+
+    if (z->quantidade > 1) {
+        z->quantidade--; RB_MOVE();
+        RB_VISIT();
+        rb_tam_subir(arv, z);
+        return 1;
+    }
+
+    rb_remover_no(arv, z);
     return 1;
 }
 
+/* --------------------------------------------------
+   Lotes ordenados com busca a partir de um dedo (ver AVL_mod.c): cada chave
+   parte do nó tocado pela anterior, sobe só até a subárvore que a contém e
+   desce dali; inserção e remoção seguem com os mesmos fixups.
+   -------------------------------------------------- */
+
+/* o lote é ordenado com o radix sort de Ordenacao_mod.c */
+#include "Ordenacao_mod.c"
+
+/* sobe do dedo até o primeiro ancestral cuja subárvore contém a chave */
+static NoRB* rb_dedo_subir(ArvoreRB* arv, NoRB* x, int chave) {
+    if (chave >= x->valor) {
+        while (x->pai != arv->nulo && !(x == x->pai->esquerda && chave < x->pai->valor)) { RB_VISIT(); x = x->pai; }
+    } else {
+        while (x->pai != arv->nulo && !(x == x->pai->direita && chave > x->pai->valor)) { RB_VISIT(); x = x->pai; }
+    }
+    return x;
+}
+
+/* desce de x; devolve o nó da chave ou, se não existe, o pai onde ela entraria (*achou = 0) */
+static NoRB* rb_descer(ArvoreRB* arv, NoRB* x, int chave, int* achou) {
+    NoRB* pai = arv->nulo;
+    *achou = 0;
+    while (x != arv->nulo) {
+        RB_VISIT();
+        if (chave == x->valor) { *achou = 1; return x; }
+        pai = x;
+        x = (chave < x->valor) ? x->esquerda : x->direita;
+    }
+    return pai;
+}
+
+static NoRB* rb_inserir_dedo(ArvoreRB* arv, NoRB* dedo, int valor) {
+    int achou;
+    NoRB* y = rb_descer(arv, dedo ? rb_dedo_subir(arv, dedo, valor) : arv->raiz, valor, &achou);
+    if (achou) { y->quantidade++; RB_MOVE(); rb_tam_subir(arv, y); return y; }
+    NoRB* z = novo_no(arv, y, valor);
+    if (y == arv->nulo) { arv->raiz = z; RB_MOVE(); }
+    else if (valor < y->valor) { y->esquerda = z; RB_MOVE(); }
+    else { y->direita = z; RB_MOVE(); }
+    rb_tam_subir(arv, y);
+    insert_fixup(arv, z);
+    return z;
+}
+
+void rb_inserir_lote(ArvoreRB* arv, const int* chaves, int n) {
+    if (!arv || !chaves || n <= 0) return;
+    arv->maximo = NULL;
+    int* v = ordenacao_radix(chaves, n, 1, NULL);
+    NoRB* dedo = NULL;
+    for (int i = 0; i < n; i++) dedo = rb_inserir_dedo(arv, dedo, v[i]);
+    free(v);
+}
+
+int rb_remover_lote(ArvoreRB* arv, const int* chaves, int n) {
+    if (!arv || !chaves || n <= 0) return 0;
+    arv->maximo = NULL;
+    int* v = ordenacao_radix(chaves, n, 1, NULL);
+    NoRB* dedo = NULL;
+    int removidos = 0;
+    for (int i = 0; i < n && arv->raiz != arv->nulo; i++) {
+        int achou;
+        NoRB* z = rb_descer(arv, dedo ? rb_dedo_subir(arv, dedo, v[i]) : arv->raiz, v[i], &achou);
+        if (!achou) { dedo = z; continue; }
+        removidos++;
+        if (z->quantidade > 1) { z->quantidade--; RB_MOVE(); rb_tam_subir(arv, z); dedo = z; continue; }
+        dedo = rb_remover_no(arv, z);
+    }
+    free(v);
+    return removidos;
+}
+
+/* --------------------------------------------------
+   Anexação de chaves crescentes: o nó máximo fica em cache e uma chave >=
+   máximo vira filho direito dele, seguido do insert_fixup (O(1) amortizado;
+   O(log n) com RB_TAMANHO, que sobe os tamanhos até a raiz).
+   Chave menor cai em rb_inserir.
+   -------------------------------------------------- */
+
+static NoRB* rb_maximo(ArvoreRB* arv) {
+    if (!arv->maximo && arv->raiz != arv->nulo) {
+        NoRB* x = arv->raiz;
+        while (x->direita != arv->nulo) { RB_VISIT(); x = x->direita; }
+        arv->maximo = x;
+    }
+    return arv->maximo;
+}
+
+void rb_anexar(ArvoreRB* arv, int valor) {
+    if (!arv) return;
+    NoRB* m = rb_maximo(arv);
+    if (m) {
+        RB_VISIT();
+        if (valor < m->valor) { rb_inserir(arv, valor); return; }
+        if (valor == m->valor) { m->quantidade++; RB_MOVE(); rb_tam_subir(arv, m); return; }
+    }
+    NoRB* z = novo_no(arv, m, valor);
+    if (!m) { arv->raiz = z; RB_MOVE(); }
+    else { m->direita = z; RB_MOVE(); rb_tam_subir(arv, m); }
+    insert_fixup(arv, z);
+    arv->maximo = z;
+}
+
 static void liberar_rec(ArvoreRB* arv, NoRB* n) {
     if (!n || n == arv->nulo) return;
     liberar_rec(arv, n->esquerda);
     liberar_rec(arv, n->direita);
-    free(n); RB_FREE();
+    arena_liberar(&RB_ARENA, n); RB_FREE();
 }
 
 void rb_remover_tudo(ArvoreRB* arv) {
     if (!arv) return;
     liberar_rec(arv, arv->raiz);
     arv->raiz = arv->nulo;
+    arv->maximo = NULL;
     RB_COUNT_VISIT = RB_COUNT_MOVE = RB_COUNT_HEIGHT = RB_COUNT_ROT = RB_COUNT_ALLOC = RB_COUNT_FREE = 0;
+    RB_COUNT_TAMANHO = 0;
+}
+
+/* --------------------------------------------------
+   Remoção de intervalo por split/join
+   As subárvores em trânsito têm sempre raiz preta e altura negra (bh) conhecida:
+   o split desce passando bh para os filhos (bh - 1 se o pai é preto) e pinta de
+   preto um filho vermelho que vira raiz (bh + 1).
+   join(l, k, r) com bh(l) > bh(r): desce a espinha direita de l até um nó preto
+   com bh(r), põe k vermelho no lugar dele (filhos: esse nó e r) e corrige com
+   insert_fixup (bh + 1 se ele repinta a raiz); simétrico se bh(r) > bh(l); com
+   bh iguais k vira raiz preta.
+   rb_remover_intervalo: dois splits, libera o meio (O(k)) e junta as pontas.
+   O join corrige dentro de uma ArvoreRB local (mesmo sentinela): split/join não
+   tocam arv->raiz e podem rodar em paralelo em subárvores disjuntas.
+   Faixas com até RB_INTERVALO_CURTO nós saem uma a uma com rb_remover_no.
+   -------------------------------------------------- */
+
+#define RB_INTERVALO_CURTO 8
+
+static NoRB* rb_join(ArvoreRB* arv, NoRB* l, int bl, NoRB* k, NoRB* r, int br, int* bh) {
+    NoRB* nulo = arv->nulo;
+    ArvoreRB sub = { nulo, nulo, NULL };
+    if (bl > br) {
+        NoRB* p = nulo;
+        NoRB* c = l;
+        int b = bl;
+        while (!(c->cor == Preto && b == br)) {
+            RB_VISIT();
+            if (c->cor == Preto) b--;
+            p = c;
+            c = c->direita;
+        }
+        k->esquerda = c; RB_MOVE();
+        k->direita = r; RB_MOVE();
+        if (c != nulo) c->pai = k;
+        if (r != nulo) r->pai = k;
+        k->cor = Vermelho;
+        k->pai = p; p->direita = k; RB_MOVE();
+        l->pai = nulo;
+        sub.raiz = l;
+        rb_tam_subir(&sub, k);
+        *bh = bl + insert_fixup(&sub, k);
+        return sub.raiz;
+    }
+    if (br > bl) {
+        NoRB* p = nulo;
+        NoRB* c = r;
+        int b = br;
+        while (!(c->cor == Preto && b == bl)) {
+            RB_VISIT();
+            if (c->cor == Preto) b--;
+            p = c;
+            c = c->esquerda;
+        }
+        k->esquerda = l; RB_MOVE();
+        k->direita = c; RB_MOVE();
+        if (l != nulo) l->pai = k;
+        if (c != nulo) c->pai = k;
+        k->cor = Vermelho;
+        k->pai = p; p->esquerda = k; RB_MOVE();
+        r->pai = nulo;
+        sub.raiz = r;
+        rb_tam_subir(&sub, k);
+        *bh = br + insert_fixup(&sub, k);
+        return sub.raiz;
+    }
+    k->esquerda = l; RB_MOVE();
+    k->direita = r; RB_MOVE();
+    if (l != nulo) l->pai = k;
+    if (r != nulo) r->pai = k;
+    k->pai = nulo;
+    k->cor = Preto;
+    rb_tam_atualizar(k);
+    *bh = bl + 1;
+    return k;
+}
+
+static void rb_split(ArvoreRB* arv, NoRB* t, int bh, int chave,
+                     NoRB** menor, int* b_menor, NoRB** igual, NoRB** maior, int* b_maior) {
+    NoRB* nulo = arv->nulo;
+    if (t == nulo) {
+        *menor = *maior = nulo;
+        *b_menor = *b_maior = 0;
+        *igual = NULL;
+        return;
+    }
+    RB_VISIT();
+    int bf = bh - (t->cor == Preto ? 1 : 0);
+    NoRB* l = t->esquerda;
+    NoRB* r = t->direita;
+    int bl = bf, br = bf;
+    if (l != nulo) {
+        l->pai = nulo;
+        if (l->cor == Vermelho) { l->cor = Preto; bl++; RB_MOVE(); }
+    }
+    if (r != nulo) {
+        r->pai = nulo;
+        if (r->cor == Vermelho) { r->cor = Preto; br++; RB_MOVE(); }
+    }
+    t->esquerda = t->direita = nulo; RB_MOVE();
+    if (chave == t->valor) {
+        *menor = l; *b_menor = bl;
+        *igual = t;
+        *maior = r; *b_maior = br;
+    } else if (chave < t->valor) {
+        NoRB* lr;
+        int b_lr;
+        rb_split(arv, l, bl, chave, menor, b_menor, igual, &lr, &b_lr);
+        *maior = rb_join(arv, lr, b_lr, t, r, br, b_maior);
+    } else {
+        NoRB* rl;
+        int b_rl;
+        rb_split(arv, r, br, chave, &rl, &b_rl, igual, maior, b_maior);
+        *menor = rb_join(arv, l, bl, t, rl, b_rl, b_menor);
+    }
+}
+
+/* junta l e r (todas as chaves de l < r) usando o máximo de l como chave do meio */
+static NoRB* rb_join2(ArvoreRB* arv, NoRB* l, int bl, NoRB* r, int br, int* bh) {
+    if (l == arv->nulo) { *bh = br; return r; }
+    if (r == arv->nulo) { *bh = bl; return l; }
+    NoRB* m = l;
+    while (m->direita != arv->nulo) { RB_VISIT(); m = m->direita; }
+    NoRB *l2, *meio, *vazio;
+    int b2, bv;
+    rb_split(arv, l, bl, m->valor, &l2, &b2, &meio, &vazio, &bv);
+    return rb_join(arv, l2, b2, meio, r, br, bh);
+}
+
+/* libera a subárvore; retorna o número de ocorrências removidas */
+static long rb_descartar(ArvoreRB* arv, NoRB* x) {
+    if (!x || x == arv->nulo) return 0;
+    long c = x->quantidade + rb_descartar(arv, x->esquerda) + rb_descartar(arv, x->direita);
+    arena_liberar(&RB_ARENA, x); RB_FREE();
+    return c;
+}
+
+static int rb_altura_negra(ArvoreRB* arv, NoRB* x) {
+    int bh = 0;
+    for (; x != arv->nulo; x = x->esquerda) {
+        RB_VISIT();
+        if (x->cor == Preto) bh++;
+    }
+    return bh;
+}
+
+long rb_remover_intervalo(ArvoreRB* arv, int lo, int hi) {
+    if (!arv || arv->raiz == arv->nulo || lo > hi) return 0;
+    arv->maximo = NULL;
+
+    NoRB* nulo = arv->nulo;
+    NoRB* z = nulo;
+    for (NoRB* x = arv->raiz; x != nulo; ) {
+        RB_VISIT();
+        if (x->valor >= lo) { z = x; x = x->esquerda; }
+        else x = x->direita;
+    }
+    NoRB* curtos[RB_INTERVALO_CURTO];
+    int nc = 0;
+    while (z != nulo && z->valor <= hi && nc < RB_INTERVALO_CURTO) {
+        curtos[nc++] = z;
+        if (z->direita != nulo) z = minimo(arv, z->direita);
+        else {
+            while (z->pai != nulo && z == z->pai->direita) { RB_VISIT(); z = z->pai; }
+            z = z->pai;
+        }
+    }
+    if (z == nulo || z->valor > hi) {
+        /* rb_remover_no move nós, não valores: os ponteiros guardados continuam valendo */
+        long removidos = 0;
+        for (int i = 0; i < nc; i++) {
+            removidos += curtos[i]->quantidade;
+            rb_remover_no(arv, curtos[i]);
+        }
+        return removidos;
+    }
+
+    int bh = rb_altura_negra(arv, arv->raiz);
+    NoRB *l, *m1, *resto, *meio, *m2, *r;
+    int bl, b_resto, b_meio, br;
+    rb_split(arv, arv->raiz, bh, lo, &l, &bl, &m1, &resto, &b_resto);
+    rb_split(arv, resto, b_resto, hi, &meio, &b_meio, &m2, &r, &br);
+    long removidos = rb_descartar(arv, m1) + rb_descartar(arv, meio) + rb_descartar(arv, m2);
+    arv->raiz = rb_join2(arv, l, bl, r, br, &bh);
+    arv->raiz->pai = arv->nulo;
+    arv->raiz->cor = Preto;
+    return removidos;
+}
+
+/* --------------------------------------------------
+   Operações de conjunto por split/join (união, interseção, diferença)
+   Mesmo esquema da AVL_mod.c: separa uma árvore pela chave da raiz da outra,
+   resolve as duas metades (em paralelo, no pool fork-join, enquanto a altura
+   negra for >= RB_GRAO_BH) e junta; trabalho O(m log(n/m + 1)).
+   Cada árvore tem seu sentinela: na união os nós da menor das duas passam a
+   apontar para o sentinela da maior antes de começar (O(min), também em
+   paralelo); se a menor é a, a e b trocam de sentinela, então o custo não
+   depende da ordem dos argumentos. Na interseção/diferença os nós de b só são
+   lidos e liberados.
+   -------------------------------------------------- */
+
+#define RB_GRAO_BH 8
+#define RB_MAX_THREADS 64
+
+/* pool fork-join: pilha de tarefas + trabalhadores; quem espera um join executa
+   tarefas pendentes (inclusive a sua) em vez de bloquear */
+typedef struct TarefaRB {
+    void (*f)(void*);
+    void* arg;
+    atomic_int feita;
+    long contas[7];               // contadores da tarefa, somados por quem a criou
+    struct TarefaRB* prox;
+} TarefaRB;
+
+static pthread_mutex_t RB_POOL_TRAVA = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t RB_POOL_SINAL = PTHREAD_COND_INITIALIZER;
+static TarefaRB* RB_POOL_PILHA = NULL;
+static int RB_POOL_THREADS = 1;      // incluindo a que chama
+static int RB_POOL_INICIADAS = 0;    // trabalhadores criados
+
+static void rb_tarefa_executar(TarefaRB* t) {
+    long salvo[7] = { RB_COUNT_VISIT, RB_COUNT_MOVE, RB_COUNT_HEIGHT, RB_COUNT_ROT, RB_COUNT_ALLOC, RB_COUNT_FREE, RB_COUNT_TAMANHO };
+    RB_COUNT_VISIT = RB_COUNT_MOVE = RB_COUNT_HEIGHT = RB_COUNT_ROT = RB_COUNT_ALLOC = RB_COUNT_FREE = RB_COUNT_TAMANHO = 0;
+    t->f(t->arg);
+    t->contas[0] = RB_COUNT_VISIT; t->contas[1] = RB_COUNT_MOVE; t->contas[2] = RB_COUNT_HEIGHT;
+    t->contas[3] = RB_COUNT_ROT; t->contas[4] = RB_COUNT_ALLOC; t->contas[5] = RB_COUNT_FREE;
+    t->contas[6] = RB_COUNT_TAMANHO;
+    RB_COUNT_VISIT = salvo[0]; RB_COUNT_MOVE = salvo[1]; RB_COUNT_HEIGHT = salvo[2];
+    RB_COUNT_ROT = salvo[3]; RB_COUNT_ALLOC = salvo[4]; RB_COUNT_FREE = salvo[5];
+    RB_COUNT_TAMANHO = salvo[6];
+    atomic_store_explicit(&t->feita, 1, memory_order_release);
+}
+
+static TarefaRB* rb_pool_tirar() {
+    pthread_mutex_lock(&RB_POOL_TRAVA);
+    TarefaRB* t = RB_POOL_PILHA;
+    if (t) RB_POOL_PILHA = t->prox;
+    pthread_mutex_unlock(&RB_POOL_TRAVA);
+    return t;
+}
+
+static void* rb_pool_trabalhador(void* x) {
+    (void) x;
+    for (;;) {
+        pthread_mutex_lock(&RB_POOL_TRAVA);
+        while (!RB_POOL_PILHA) pthread_cond_wait(&RB_POOL_SINAL, &RB_POOL_TRAVA);
+        TarefaRB* t = RB_POOL_PILHA;
+        RB_POOL_PILHA = t->prox;
+        pthread_mutex_unlock(&RB_POOL_TRAVA);
+        rb_tarefa_executar(t);
+    }
+    return NULL;
+}
+
+/* trabalhadores são criados sob demanda e ficam até o fim do processo */
+void rb_definir_threads(int n) {
+    if (n < 1) n = 1;
+    if (n > RB_MAX_THREADS) n = RB_MAX_THREADS;
+    pthread_mutex_lock(&RB_POOL_TRAVA);
+    while (RB_POOL_INICIADAS < n - 1) {
+        pthread_t id;
+        if (pthread_create(&id, NULL, rb_pool_trabalhador, NULL) != 0) break;
+        pthread_detach(id);
+        RB_POOL_INICIADAS++;
+    }
+    RB_POOL_THREADS = RB_POOL_INICIADAS + 1 < n ? RB_POOL_INICIADAS + 1 : n;
+    pthread_mutex_unlock(&RB_POOL_TRAVA);
+}
+
+/* executa f(a) e g(b); g vai para o pool se houver threads */
+static void rb_em_paralelo(void (*f)(void*), void* a, void (*g)(void*), void* b) {
+    if (RB_POOL_THREADS < 2) { f(a); g(b); return; }
+    TarefaRB t;
+    t.f = g;
+    t.arg = b;
+    atomic_init(&t.feita, 0);
+    pthread_mutex_lock(&RB_POOL_TRAVA);
+    t.prox = RB_POOL_PILHA;
+    RB_POOL_PILHA = &t;
+    pthread_cond_signal(&RB_POOL_SINAL);
+    pthread_mutex_unlock(&RB_POOL_TRAVA);
+    f(a);
+    while (!atomic_load_explicit(&t.feita, memory_order_acquire)) {
+        TarefaRB* o = rb_pool_tirar();
+        if (o) rb_tarefa_executar(o);
+        else sched_yield();
+    }
+    RB_COUNT_VISIT += t.contas[0]; RB_COUNT_MOVE += t.contas[1]; RB_COUNT_HEIGHT += t.contas[2];
+    RB_COUNT_ROT += t.contas[3]; RB_COUNT_ALLOC += t.contas[4]; RB_COUNT_FREE += t.contas[5];
+    RB_COUNT_TAMANHO += t.contas[6];
+}
+
+/* troca o sentinela de uma subárvore (filhos que apontam para 'velho') */
+typedef struct {
+    NoRB* x;
+    int bh;
+    NoRB* velho;
+    NoRB* novo;
+} SentinelaRB;
+
+static void rb_trocar_sentinela(void* p) {
+    SentinelaRB* s = (SentinelaRB*) p;
+    NoRB* x = s->x;
+    if (x == s->velho) return;
+    RB_MOVE();
+    int bf = s->bh - (x->cor == Preto ? 1 : 0);
+    SentinelaRB e = { x->esquerda, bf, s->velho, s->novo };
+    SentinelaRB d = { x->direita, bf, s->velho, s->novo };
+    if (x->esquerda == s->velho) x->esquerda = s->novo;
+    if (x->direita == s->velho) x->direita = s->novo;
+    if (s->bh >= RB_GRAO_BH) rb_em_paralelo(rb_trocar_sentinela, &e, rb_trocar_sentinela, &d);
+    else { rb_trocar_sentinela(&e); rb_trocar_sentinela(&d); }
+}
+
+enum { RB_UNIAO, RB_INTERSECAO, RB_DIFERENCA };
+
+typedef struct {
+    int op;
+    ArvoreRB* a;      // sentinela de t1 e do resultado
+    ArvoreRB* b;      // sentinela de t2
+    NoRB* t1; int b1;
+    NoRB* t2; int b2;
+    NoRB* r;  int br;
+} ConjuntoRB;
+
+static void rb_conjunto_rec(ConjuntoRB* c);
+
+static void rb_conjunto_tarefa(void* x) { rb_conjunto_rec((ConjuntoRB*) x); }
+
+/* solta os filhos de x como subárvores de raiz preta (como no split) */
+static void rb_soltar_filhos(NoRB* nulo, NoRB* x, int bh, NoRB** l, int* bl, NoRB** r, int* br) {
+    int bf = bh - (x->cor == Preto ? 1 : 0);
+    *l = x->esquerda; *bl = bf;
+    *r = x->direita;  *br = bf;
+    if (*l != nulo) {
+        (*l)->pai = nulo;
+        if ((*l)->cor == Vermelho) { (*l)->cor = Preto; (*bl)++; RB_MOVE(); }
+    }
+    if (*r != nulo) {
+        (*r)->pai = nulo;
+        if ((*r)->cor == Vermelho) { (*r)->cor = Preto; (*br)++; RB_MOVE(); }
+    }
+    x->esquerda = x->direita = nulo; RB_MOVE();
+}
+
+static void rb_conjunto_rec(ConjuntoRB* c) {
+    ArvoreRB* a = c->a;
+    NoRB* nulo = a->nulo;
+    /* t2 vazia primeiro: com as duas vazias o resultado é o sentinela de a, não o de b */
+    if (c->t2 == c->b->nulo) {
+        if (c->op != RB_INTERSECAO) { c->r = c->t1; c->br = c->b1; return; }
+        rb_descartar(a, c->t1);
+        c->r = nulo; c->br = 0;
+        return;
+    }
+    if (c->t1 == nulo) {
+        if (c->op == RB_UNIAO) { c->r = c->t2; c->br = c->b2; return; }
+        rb_descartar(c->b, c->t2);
+        c->r = nulo; c->br = 0;
+        return;
+    }
+    RB_VISIT();
+    ConjuntoRB e = *c, d = *c;
+    NoRB* m;
+    if (c->op == RB_UNIAO) {
+        /* a raiz de t1 fica; t2 é separado pela chave dela */
+        NoRB* k = c->t1;
+        rb_soltar_filhos(nulo, k, c->b1, &e.t1, &e.b1, &d.t1, &d.b1);
+        rb_split(a, c->t2, c->b2, k->valor, &e.t2, &e.b2, &m, &d.t2, &d.b2);
+        if (m) {
+            k->quantidade += m->quantidade; RB_MOVE();
+            arena_liberar(&RB_ARENA, m); RB_FREE();
+        }
+        if (c->b1 >= RB_GRAO_BH) rb_em_paralelo(rb_conjunto_tarefa, &e, rb_conjunto_tarefa, &d);
+        else { rb_conjunto_rec(&e); rb_conjunto_rec(&d); }
+        c->r = rb_join(a, e.r, e.br, k, d.r, d.br, &c->br);
+        return;
+    }
+    /* interseção / diferença: o resultado só tem nós de t1, separado pela raiz de t2 */
+    NoRB* z = c->t2;
+    int q2 = z->quantidade;
+    rb_soltar_filhos(c->b->nulo, z, c->b2, &e.t2, &e.b2, &d.t2, &d.b2);
+    rb_split(a, c->t1, c->b1, z->valor, &e.t1, &e.b1, &m, &d.t1, &d.b1);
+    arena_liberar(&RB_ARENA, z); RB_FREE();
+    if (c->b2 >= RB_GRAO_BH) rb_em_paralelo(rb_conjunto_tarefa, &e, rb_conjunto_tarefa, &d);
+    else { rb_conjunto_rec(&e); rb_conjunto_rec(&d); }
+    if (m) {
+        int q = (c->op == RB_INTERSECAO) ? (m->quantidade < q2 ? m->quantidade : q2) : m->quantidade - q2;
+        if (q > 0) {
+            m->quantidade = q; RB_MOVE();
+            c->r = rb_join(a, e.r, e.br, m, d.r, d.br, &c->br);
+            return;
+        }
+        arena_liberar(&RB_ARENA, m); RB_FREE();
+    }
+    c->r = rb_join2(a, e.r, e.br, d.r, d.br, &c->br);
+}
+
+static void rb_conjunto(int op, ArvoreRB* a, ArvoreRB* b) {
+    if (!a || !b || a == b) return;
+    ConjuntoRB c = { op, a, b, a->raiz, rb_altura_negra(a, a->raiz), b->raiz, rb_altura_negra(b, b->raiz), a->nulo, 0 };
+    if (op == RB_UNIAO && b->raiz != b->nulo) {
+        /* tamanho O(1) com o aumento; sem ele, a altura negra serve de estimativa */
+        int a_menor = RB_TAMANHO ? rb_tam(a, a->raiz) < rb_tam(b, b->raiz) : c.b1 < c.b2;
+        if (a_menor) {
+            SentinelaRB s = { a->raiz, c.b1, a->nulo, b->nulo };
+            rb_trocar_sentinela(&s);
+            NoRB* nulo = a->nulo;
+            a->nulo = b->nulo; RB_MOVE();
+            b->nulo = nulo; RB_MOVE();
+            if (a->raiz == nulo) a->raiz = a->nulo;
+            a->raiz->pai = a->nulo;
+            c.t1 = a->raiz;
+            c.r = a->nulo;
+        } else {
+            SentinelaRB s = { b->raiz, c.b2, b->nulo, a->nulo };
+            rb_trocar_sentinela(&s);
+            b->raiz->pai = a->nulo;
+        }
+        c.b = a;
+    }
+    rb_conjunto_rec(&c);
+    a->raiz = c.r;
+    a->raiz->pai = a->nulo;
+    a->raiz->cor = Preto;
+    a->maximo = NULL;
+    b->raiz = b->nulo;
+    b->maximo = NULL;
+}
+
+void rb_uniao(ArvoreRB* a, ArvoreRB* b) { rb_conjunto(RB_UNIAO, a, b); }
+void rb_intersecao(ArvoreRB* a, ArvoreRB* b) { rb_conjunto(RB_INTERSECAO, a, b); }
+void rb_diferenca(ArvoreRB* a, ArvoreRB* b) { rb_conjunto(RB_DIFERENCA, a, b); }
+
+/* --------------------------------------------------
+   Serialização (pré-ordem, sem ponteiros) e carga via mmap
+   Arquivo: CabecalhoRB + n registros em pré-ordem. O filho esquerdo do
+   registro i (se existe) é o registro i+1; o direito é o índice em 'direita'.
+   -------------------------------------------------- */
+
+#define RB_MAGICA   0x31544252u   /* "RBT1" */
+#define RB_TEM_ESQ 1             /* bit 0 de info */
+#define RB_PRETO    2             /* bit 1 de info: cor */
+
+typedef struct {
+    uint32_t magica;
+    uint32_t tam_registro;
+    uint64_t n;
+} CabecalhoRB;
+
+typedef struct {
+    int32_t valor;
+    int32_t quantidade;
+    int32_t direita;      // índice do filho direito (-1 = nenhum)
+    int32_t info;
+} RegistroRB;
+
+typedef struct arvoreMapeadaRB {
+    void* base;
+    size_t tamanho;
+    const RegistroRB* r;
+    uint64_t n;
+} ArvoreMapeadaRB;
+
+/* pilha de nós (ou índices) pendentes; cresce sob demanda */
+typedef struct {
+    NoRB** no;
+    int64_t* idx;
+    int topo, cap;
+} PilhaSerRB;
+
+static void rb_pilha_push(PilhaSerRB* p, NoRB* no, int64_t idx) {
+    if (p->topo == p->cap) {
+        p->cap = p->cap ? 2 * p->cap : 64;
+        p->no = (NoRB**) realloc(p->no, sizeof(NoRB*) * p->cap);
+        p->idx = (int64_t*) realloc(p->idx, sizeof(int64_t) * p->cap);
+    }
+    p->no[p->topo] = no;
+    p->idx[p->topo] = idx;
+    p->topo++;
+}
+
+/* 0 = ok, -1 = erro de E/S */
+int rb_salvar(ArvoreRB* a, const char* caminho) {
+    PilhaSerRB p = { NULL, NULL, 0, 0 };
+    uint64_t n = 0;
+    NoRB* cur = a->raiz != a->nulo ? a->raiz : NULL;
+    while (cur || p.topo) {
+        if (!cur) cur = p.no[--p.topo];
+        n++;
+        if (cur->direita != a->nulo) rb_pilha_push(&p, cur->direita, 0);
+        cur = cur->esquerda != a->nulo ? cur->esquerda : NULL;
+    }
+
+    size_t tamanho = sizeof(CabecalhoRB) + n * sizeof(RegistroRB);
+    int fd = open(caminho, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t) tamanho) != 0) {
+        if (fd >= 0) close(fd);
+        free(p.no); free(p.idx);
+        return -1;
+    }
+    void* base = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        free(p.no); free(p.idx);
+        return -1;
+    }
+    CabecalhoRB* c = (CabecalhoRB*) base;
+    c->magica = RB_MAGICA;
+    c->tam_registro = sizeof(RegistroRB);
+    c->n = n;
+    RegistroRB* r = (RegistroRB*) (c + 1);
+
+    /* pré-ordem: ao desempilhar o filho direito, corrige o índice no pai */
+    int64_t i = 0;
+    cur = a->raiz != a->nulo ? a->raiz : NULL;
+    while (cur || p.topo) {
+        if (!cur) {
+            p.topo--;
+            cur = p.no[p.topo];
+            r[p.idx[p.topo]].direita = (int32_t) i;
+        }
+        r[i].valor = cur->valor;
+        r[i].quantidade = cur->quantidade;
+        r[i].direita = -1;
+        r[i].info = (cur->cor == Preto ? RB_PRETO : 0) | (cur->esquerda != a->nulo ? RB_TEM_ESQ : 0);
+        if (cur->direita != a->nulo) rb_pilha_push(&p, cur->direita, i);
+        i++;
+        cur = cur->esquerda != a->nulo ? cur->esquerda : NULL;
+    }
+    free(p.no); free(p.idx);
+    return munmap(base, tamanho);
+}
+
+static void* rb_abrir_mapa(const char* caminho, size_t* tamanho, uint64_t* n) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(CabecalhoRB)) {
+        close(fd);
+        return NULL;
+    }
+    void* base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+    const CabecalhoRB* c = (const CabecalhoRB*) base;
+    if (c->magica != RB_MAGICA || c->tam_registro != sizeof(RegistroRB) ||
+        (size_t) st.st_size < sizeof(CabecalhoRB) + c->n * sizeof(RegistroRB)) {
+        munmap(base, (size_t) st.st_size);
+        return NULL;
+    }
+    *tamanho = (size_t) st.st_size;
+    *n = c->n;
+    return base;
+}
+
+/* o arquivo não guarda tamanhos: recalculados em pós-ordem depois da carga */
+static void rb_tam_calcular(ArvoreRB* arv, NoRB* x) {
+    if (x == arv->nulo) return;
+    rb_tam_calcular(arv, x->esquerda);
+    rb_tam_calcular(arv, x->direita);
+    rb_tam_atualizar(x);
+}
+
+/* reconstrói a árvore de ponteiros numa passada linear sobre o arquivo mapeado;
+   NULL se o arquivo não é uma árvore válida */
+ArvoreRB* rb_carregar(const char* caminho) {
+    size_t tamanho;
+    uint64_t n;
+    void* base = rb_abrir_mapa(caminho, &tamanho, &n);
+    if (!base) return NULL;
+    madvise(base, tamanho, MADV_SEQUENTIAL);
+    const RegistroRB* r = (const RegistroRB*) ((const CabecalhoRB*) base + 1);
+
+    ArvoreRB* a = rb_criar();
+    PilhaSerRB p = { NULL, NULL, 0, 0 };  /* nós que ainda esperam o filho direito */
+    NoRB* ant = NULL;
+    int ant_tem_esq = 0, corrompido = 0;
+    for (uint64_t i = 0; i < n && !corrompido; i++) {
+        NoRB* x = novo_no(a, NULL, r[i].valor);
+        x->quantidade = r[i].quantidade;
+        x->cor = (r[i].info & RB_PRETO) ? Preto : Vermelho;
+        if (!ant) {
+            a->raiz = x;
+        } else if (ant_tem_esq) {
+            ant->esquerda = x;
+            x->pai = ant; RB_MOVE();
+        } else if (p.topo > 0) {
+            NoRB* pai = p.no[--p.topo];
+            pai->direita = x;
+            x->pai = pai; RB_MOVE();
+        } else {
+            arena_liberar(&RB_ARENA, x); RB_FREE();
+            corrompido = 1;
+            continue;
+        }
+        if (r[i].direita >= 0) rb_pilha_push(&p, x, 0);
+        ant = x;
+        ant_tem_esq = r[i].info & RB_TEM_ESQ;
+    }
+    /* sobrou filho anunciado e não gravado: arquivo truncado */
+    if (ant_tem_esq || p.topo > 0) corrompido = 1;
+    free(p.no); free(p.idx);
+    munmap(base, tamanho);
+    if (corrompido) {
+        fprintf(stderr, "rb_carregar: arquivo corrompido (%s)\n", caminho);
+        liberar_rec(a, a->raiz);
+        free(a->nulo);
+        free(a);
+        return NULL;
+    }
+    if (RB_TAMANHO) rb_tam_calcular(a, a->raiz);
+    return a;
+}
+
+/* usa o arquivo mapeado diretamente como árvore somente leitura */
+ArvoreMapeadaRB* rb_mapear(const char* caminho) {
+    ArvoreMapeadaRB* m = (ArvoreMapeadaRB*) malloc(sizeof(ArvoreMapeadaRB));
+    m->base = rb_abrir_mapa(caminho, &m->tamanho, &m->n);
+    if (!m->base) {
+        free(m);
+        return NULL;
+    }
+    m->r = (const RegistroRB*) ((const CabecalhoRB*) m->base + 1);
+    return m;
+}
+
+/* índices conferidos a cada passo, como em avl_mapa_buscar: i só cresce e
+   fica em [0, n) mesmo com arquivo corrompido */
+int rb_mapa_buscar(ArvoreMapeadaRB* m, int chave) {
+    if (!m || m->n == 0) return 0;
+    int64_t i = 0;
+    for (;;) {
+        const RegistroRB* x = &m->r[i];
+        RB_VISIT();
+        if (chave == x->valor) return 1;
+        if (chave < x->valor) {
+            if (!(x->info & RB_TEM_ESQ) || (uint64_t) (i + 1) >= m->n) return 0;
+            i++;
+        } else {
+            if (x->direita <= i || (uint64_t) x->direita >= m->n) return 0;
+            i = x->direita;
+        }
+    }
+}
+
+void rb_mapa_fechar(ArvoreMapeadaRB* m) {
+    if (!m) return;
+    munmap(m->base, m->tamanho);
+    free(m);
 }
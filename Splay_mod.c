@@ -0,0 +1,200 @@
+// Árvore splay (Sleator e Tarjan), splay descendente (top-down)
+// Sem informação de balanceamento: toda operação leva a chave procurada (ou a
+// última chave visitada) para a raiz numa única descida. O caminho é partido em
+// duas árvores auxiliares (menores à esquerda, maiores à direita) presas num nó
+// cabeçalho; zig-zig vira uma rotação seguida de ligação, zig-zag só ligações.
+// Custo O(log n) amortizado, mas chaves acessadas com frequência ficam perto da
+// raiz: sob acessos concentrados (Zipf) a busca custa O(log 1/p) amortizado,
+// enquanto AVL/RB pagam a altura inteira. A busca também reestrutura a árvore.
+// Chaves repetidas aumentam a quantidade do nó (como na AVL).
+// Conta de forma consistente (mesmas categorias da AVL, sem HEIGHT):
+// - comparações/visitas (COUNT_VISIT)
+// - movimentação de ponteiros/atribuições estruturais (COUNT_MOVE)
+// - rotações (COUNT_ROT; só as do zig-zig, ligações contam como MOVE)
+// - alocação/liberação de nós (COUNT_ALLOC / COUNT_FREE)
+// Exporta funções:
+//   ArvoreSplay* sp_criar();
+//   void sp_inserir(ArvoreSplay*, int);
+//   int sp_remover_chave(ArvoreSplay*, int); // remove 1 ocorrência
+//   int sp_buscar(ArvoreSplay*, int);        // faz splay da chave
+//   void sp_remover_tudo(ArvoreSplay*);
+//   long sp_get_insercao_and_reset();
+//   long sp_get_remocao_and_reset();
+
+#include <stdlib.h>
+#include <stdio.h>
+
+typedef struct noSplay {
+    struct noSplay* esquerda;
+    struct noSplay* direita;
+    int valor;
+    int quantidade;
+} NoSplay;
+
+typedef struct arvoreSplay {
+    NoSplay* raiz;
+} ArvoreSplay;
+
+static _Thread_local long SP_COUNT_VISIT = 0;  // comparações / visitas (navegação)
+static _Thread_local long SP_COUNT_MOVE  = 0;  // atribuições / mov. ponteiros (links)
+static _Thread_local long SP_COUNT_ROT   = 0;  // rotações (cada rotação conta 1)
+static _Thread_local long SP_COUNT_ALLOC = 0;  // alocações de nós
+static _Thread_local long SP_COUNT_FREE  = 0;  // liberações de nós
+
+/* wrappers para obter "esforço total" e reset */
+long sp_get_insercao_and_reset() {
+    long total = SP_COUNT_VISIT + SP_COUNT_MOVE + SP_COUNT_ROT + SP_COUNT_ALLOC;
+    SP_COUNT_VISIT = SP_COUNT_MOVE = SP_COUNT_ROT = SP_COUNT_ALLOC = 0;
+    return total;
+}
+long sp_get_remocao_and_reset() {
+    long total = SP_COUNT_VISIT + SP_COUNT_MOVE + SP_COUNT_ROT + SP_COUNT_FREE;
+    SP_COUNT_VISIT = SP_COUNT_MOVE = SP_COUNT_ROT = SP_COUNT_FREE = 0;
+    return total;
+}
+
+#define SP_VISIT() (SP_COUNT_VISIT++)
+#define SP_MOVE()  (SP_COUNT_MOVE++)
+#define SP_ROT()   (SP_COUNT_ROT++)
+#define SP_ALLOC() (SP_COUNT_ALLOC++)
+#define SP_FREE()  (SP_COUNT_FREE++)
+
+ArvoreSplay* sp_criar() {
+    ArvoreSplay* a = (ArvoreSplay*) malloc(sizeof(ArvoreSplay));
+    a->raiz = NULL;
+    return a;
+}
+
+/* splay descendente: devolve a nova raiz, que é a chave se ela existe ou o
+   último nó do caminho de busca (antecessor ou sucessor) se não existe.
+   cab.direita acumula a árvore dos menores (l é seu nó mais à direita) e
+   cab.esquerda a dos maiores (r é seu nó mais à esquerda). */
+static NoSplay* sp_splay(NoSplay* t, int chave) {
+    NoSplay cab, *l, *r, *y;
+    if (!t) return t;
+    cab.esquerda = cab.direita = NULL;
+    l = r = &cab;
+    for (;;) {
+        SP_VISIT();
+        if (chave < t->valor) {
+            if (!t->esquerda) break;
+            SP_VISIT();
+            if (chave < t->esquerda->valor) {
+                /* zig-zig: rotação à direita antes de ligar */
+                y = t->esquerda;
+                t->esquerda = y->direita; SP_MOVE();
+                y->direita = t; SP_MOVE();
+                SP_ROT();
+                t = y;
+                if (!t->esquerda) break;
+            }
+            /* liga t à árvore dos maiores */
+            r->esquerda = t; SP_MOVE();
+            r = t;
+            t = t->esquerda;
+        } else if (chave > t->valor) {
+            if (!t->direita) break;
+            SP_VISIT();
+            if (chave > t->direita->valor) {
+                y = t->direita;
+                t->direita = y->esquerda; SP_MOVE();
+                y->esquerda = t; SP_MOVE();
+                SP_ROT();
+                t = y;
+                if (!t->direita) break;
+            }
+            /* liga t à árvore dos menores */
+            l->direita = t; SP_MOVE();
+            l = t;
+            t = t->direita;
+        } else {
+            break;
+        }
+    }
+    /* remonta: subárvores de t vão para as pontas das auxiliares */
+    l->direita = t->esquerda; SP_MOVE();
+    r->esquerda = t->direita; SP_MOVE();
+    t->esquerda = cab.direita; SP_MOVE();
+    t->direita = cab.esquerda; SP_MOVE();
+    return t;
+}
+
+void sp_inserir(ArvoreSplay* a, int chave) {
+    if (a->raiz) {
+        a->raiz = sp_splay(a->raiz, chave);
+        if (a->raiz->valor == chave) {
+            a->raiz->quantidade++; SP_MOVE();
+            return;
+        }
+    }
+    NoSplay* n = (NoSplay*) malloc(sizeof(NoSplay));
+    SP_ALLOC();
+    n->valor = chave;
+    n->quantidade = 1;
+    n->esquerda = n->direita = NULL;
+    /* a raiz após o splay é vizinha da chave: parte-a em volta do nó novo */
+    if (a->raiz) {
+        if (chave < a->raiz->valor) {
+            n->esquerda = a->raiz->esquerda; SP_MOVE();
+            n->direita = a->raiz; SP_MOVE();
+            a->raiz->esquerda = NULL; SP_MOVE();
+        } else {
+            n->direita = a->raiz->direita; SP_MOVE();
+            n->esquerda = a->raiz; SP_MOVE();
+            a->raiz->direita = NULL; SP_MOVE();
+        }
+    }
+    a->raiz = n; SP_MOVE();
+}
+
+int sp_remover_chave(ArvoreSplay* a, int chave) {
+    if (!a || !a->raiz) return 0;
+    a->raiz = sp_splay(a->raiz, chave);
+    NoSplay* t = a->raiz;
+    if (t->valor != chave) return 0;
+    if (t->quantidade > 1) {
+        t->quantidade--; SP_MOVE();
+        return 1;
+    }
+    /* junta as subárvores: o splay da chave na esquerda (todas menores) traz o
+       máximo dela para a raiz, que fica sem filho direito */
+    NoSplay* x;
+    if (!t->esquerda) {
+        x = t->direita;
+    } else {
+        x = sp_splay(t->esquerda, chave);
+        x->direita = t->direita; SP_MOVE();
+    }
+    a->raiz = x; SP_MOVE();
+    free(t);
+    SP_FREE();
+    return 1;
+}
+
+int sp_buscar(ArvoreSplay* a, int chave) {
+    if (!a || !a->raiz) return 0;
+    a->raiz = sp_splay(a->raiz, chave);
+    return a->raiz->valor == chave;
+}
+
+/* libera sem recursão (a árvore pode ter altura n): rotaciona à direita
+   enquanto houver filho esquerdo e libera a raiz quando não houver */
+void sp_remover_tudo(ArvoreSplay* a) {
+    if (!a) return;
+    NoSplay* x = a->raiz;
+    while (x) {
+        if (x->esquerda) {
+            NoSplay* y = x->esquerda;
+            x->esquerda = y->direita;
+            y->direita = x;
+            x = y;
+        } else {
+            NoSplay* p = x->direita;
+            free(x);
+            SP_FREE();
+            x = p;
+        }
+    }
+    a->raiz = NULL;
+    SP_COUNT_VISIT = SP_COUNT_MOVE = SP_COUNT_ROT = SP_COUNT_ALLOC = SP_COUNT_FREE = 0;
+}
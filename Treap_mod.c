@@ -0,0 +1,234 @@
+// Treap (Aragon e Seidel): árvore de busca pelas chaves e heap de máximo pelas
+// prioridades sorteadas na inserção. Equivale a uma árvore inserida em ordem
+// aleatória: profundidade esperada O(log n) sem guardar altura nem cor, e
+// inserção/remoção com O(1) rotações esperadas.
+// Modo adaptativo (tp_definir_adaptativo): a cada busca bem-sucedida sorteia uma
+// prioridade nova e fica com a maior (a prioridade de um nó é o máximo de k
+// sorteios para k acessos). O nó sobe por rotações na volta da busca; a
+// profundidade esperada de uma chave com frequência p cai para O(log 1/p), como
+// na splay, mas sem reestruturar a árvore em toda busca.
+// As prioridades vêm de um gerador próprio de cada árvore (semente fixa), então
+// o experimento é reprodutível.
+// Chaves repetidas aumentam a quantidade do nó (como na AVL).
+// Conta de forma consistente (mesmas categorias da AVL, sem HEIGHT):
+// - comparações/visitas (COUNT_VISIT)
+// - movimentação de ponteiros/atribuições estruturais (COUNT_MOVE)
+// - rotações (COUNT_ROT)
+// - alocação/liberação de nós (COUNT_ALLOC / COUNT_FREE)
+// Exporta funções:
+//   ArvoreTreap* tp_criar();
+//   void tp_definir_adaptativo(ArvoreTreap*, int); // 1 = busca reforça prioridade
+//   void tp_inserir(ArvoreTreap*, int);
+//   int tp_remover_chave(ArvoreTreap*, int); // remove 1 ocorrência
+//   int tp_buscar(ArvoreTreap*, int);
+//   void tp_remover_tudo(ArvoreTreap*);
+//   long tp_get_insercao_and_reset();
+//   long tp_get_remocao_and_reset();
+
+#include <stdlib.h>
+#include <stdio.h>
+
+typedef struct noTreap {
+    struct noTreap* esquerda;
+    struct noTreap* direita;
+    unsigned prioridade;
+    int valor;
+    int quantidade;
+} NoTreap;
+
+typedef struct arvoreTreap {
+    NoTreap* raiz;
+    unsigned long long semente;   // gerador das prioridades (xorshift64*)
+    int adaptativo;
+} ArvoreTreap;
+
+static _Thread_local long TP_COUNT_VISIT = 0;  // comparações / visitas (navegação)
+static _Thread_local long TP_COUNT_MOVE  = 0;  // atribuições / mov. ponteiros (links)
+static _Thread_local long TP_COUNT_ROT   = 0;  // rotações (cada rotação conta 1)
+static _Thread_local long TP_COUNT_ALLOC = 0;  // alocações de nós
+static _Thread_local long TP_COUNT_FREE  = 0;  // liberações de nós
+
+/* wrappers para obter "esforço total" e reset */
+long tp_get_insercao_and_reset() {
+    long total = TP_COUNT_VISIT + TP_COUNT_MOVE + TP_COUNT_ROT + TP_COUNT_ALLOC;
+    TP_COUNT_VISIT = TP_COUNT_MOVE = TP_COUNT_ROT = TP_COUNT_ALLOC = 0;
+    return total;
+}
+long tp_get_remocao_and_reset() {
+    long total = TP_COUNT_VISIT + TP_COUNT_MOVE + TP_COUNT_ROT + TP_COUNT_FREE;
+    TP_COUNT_VISIT = TP_COUNT_MOVE = TP_COUNT_ROT = TP_COUNT_FREE = 0;
+    return total;
+}
+
+#define TP_VISIT() (TP_COUNT_VISIT++)
+#define TP_MOVE()  (TP_COUNT_MOVE++)
+#define TP_ROT()   (TP_COUNT_ROT++)
+#define TP_ALLOC() (TP_COUNT_ALLOC++)
+#define TP_FREE()  (TP_COUNT_FREE++)
+
+ArvoreTreap* tp_criar() {
+    ArvoreTreap* a = (ArvoreTreap*) malloc(sizeof(ArvoreTreap));
+    a->raiz = NULL;
+    a->semente = 0x9E3779B97F4A7C15ULL;
+    a->adaptativo = 0;
+    return a;
+}
+
+void tp_definir_adaptativo(ArvoreTreap* a, int adaptativo) {
+    if (a) a->adaptativo = adaptativo != 0;
+}
+
+static unsigned tp_sortear(ArvoreTreap* a) {
+    a->semente ^= a->semente >> 12;
+    a->semente ^= a->semente << 25;
+    a->semente ^= a->semente >> 27;
+    return (unsigned)((a->semente * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/* rotações: o filho sobe e devolve a nova raiz da subárvore */
+static NoTreap* tp_rotacao_dir(NoTreap* y) {
+    NoTreap* x = y->esquerda;
+    TP_ROT();
+    y->esquerda = x->direita; TP_MOVE();
+    x->direita = y; TP_MOVE();
+    return x;
+}
+
+static NoTreap* tp_rotacao_esq(NoTreap* x) {
+    NoTreap* y = x->direita;
+    TP_ROT();
+    x->direita = y->esquerda; TP_MOVE();
+    y->esquerda = x; TP_MOVE();
+    return y;
+}
+
+/* inserção BST; na volta, o filho que ficou com prioridade maior sobe */
+static NoTreap* tp_inserir_rec(ArvoreTreap* a, NoTreap* no, int chave) {
+    if (!no) {
+        NoTreap* n = (NoTreap*) malloc(sizeof(NoTreap));
+        TP_ALLOC();
+        n->esquerda = n->direita = NULL;
+        n->prioridade = tp_sortear(a);
+        n->valor = chave;
+        n->quantidade = 1;
+        return n;
+    }
+    TP_VISIT();
+    if (chave < no->valor) {
+        NoTreap* f = tp_inserir_rec(a, no->esquerda, chave);
+        if (f != no->esquerda) { no->esquerda = f; TP_MOVE(); }
+        if (f->prioridade > no->prioridade) return tp_rotacao_dir(no);
+    } else if (chave > no->valor) {
+        NoTreap* f = tp_inserir_rec(a, no->direita, chave);
+        if (f != no->direita) { no->direita = f; TP_MOVE(); }
+        if (f->prioridade > no->prioridade) return tp_rotacao_esq(no);
+    } else {
+        no->quantidade++; TP_MOVE();
+    }
+    return no;
+}
+
+void tp_inserir(ArvoreTreap* a, int chave) {
+    NoTreap* r = tp_inserir_rec(a, a->raiz, chave);
+    if (r != a->raiz) { a->raiz = r; TP_MOVE(); }
+}
+
+/* o nó a remover desce rotacionando com o filho de maior prioridade até ter
+   no máximo um filho, que toma o lugar dele */
+static NoTreap* tp_remover_rec(NoTreap* no, int chave, int* removido) {
+    if (!no) return NULL;
+    TP_VISIT();
+    if (chave < no->valor) {
+        NoTreap* f = tp_remover_rec(no->esquerda, chave, removido);
+        if (f != no->esquerda) { no->esquerda = f; TP_MOVE(); }
+        return no;
+    }
+    if (chave > no->valor) {
+        NoTreap* f = tp_remover_rec(no->direita, chave, removido);
+        if (f != no->direita) { no->direita = f; TP_MOVE(); }
+        return no;
+    }
+    *removido = 1;
+    if (no->quantidade > 1) {
+        no->quantidade--; TP_MOVE();
+        return no;
+    }
+    if (!no->esquerda || !no->direita) {
+        NoTreap* f = no->esquerda ? no->esquerda : no->direita;
+        free(no);
+        TP_FREE();
+        return f;
+    }
+    TP_VISIT();
+    if (no->esquerda->prioridade > no->direita->prioridade) {
+        NoTreap* r = tp_rotacao_dir(no);
+        r->direita = tp_remover_rec(no, chave, removido); TP_MOVE();
+        return r;
+    } else {
+        NoTreap* r = tp_rotacao_esq(no);
+        r->esquerda = tp_remover_rec(no, chave, removido); TP_MOVE();
+        return r;
+    }
+}
+
+int tp_remover_chave(ArvoreTreap* a, int chave) {
+    if (!a) return 0;
+    int removido = 0;
+    NoTreap* r = tp_remover_rec(a->raiz, chave, &removido);
+    if (r != a->raiz) { a->raiz = r; TP_MOVE(); }
+    return removido;
+}
+
+/* busca adaptativa: reforça a prioridade do nó achado e o sobe na volta */
+static NoTreap* tp_buscar_rec(ArvoreTreap* a, NoTreap* no, int chave, int* achou) {
+    if (!no) return NULL;
+    TP_VISIT();
+    if (chave == no->valor) {
+        *achou = 1;
+        unsigned p = tp_sortear(a);
+        if (p > no->prioridade) { no->prioridade = p; TP_MOVE(); }
+        return no;
+    }
+    if (chave < no->valor) {
+        NoTreap* f = tp_buscar_rec(a, no->esquerda, chave, achou);
+        if (f != no->esquerda) { no->esquerda = f; TP_MOVE(); }
+        if (f && f->prioridade > no->prioridade) return tp_rotacao_dir(no);
+    } else {
+        NoTreap* f = tp_buscar_rec(a, no->direita, chave, achou);
+        if (f != no->direita) { no->direita = f; TP_MOVE(); }
+        if (f && f->prioridade > no->prioridade) return tp_rotacao_esq(no);
+    }
+    return no;
+}
+
+int tp_buscar(ArvoreTreap* a, int chave) {
+    if (!a) return 0;
+    if (a->adaptativo) {
+        int achou = 0;
+        NoTreap* r = tp_buscar_rec(a, a->raiz, chave, &achou);
+        if (r != a->raiz) { a->raiz = r; TP_MOVE(); }
+        return achou;
+    }
+    NoTreap* cur = a->raiz;
+    while (cur) {
+        TP_VISIT();
+        if (chave == cur->valor) return 1;
+        cur = (chave < cur->valor) ? cur->esquerda : cur->direita;
+    }
+    return 0;
+}
+
+static void tp_liberar_rec(NoTreap* n) {
+    if (!n) return;
+    tp_liberar_rec(n->esquerda);
+    tp_liberar_rec(n->direita);
+    free(n);
+    TP_FREE();
+}
+
+void tp_remover_tudo(ArvoreTreap* a) {
+    if (!a) return;
+    tp_liberar_rec(a->raiz);
+    a->raiz = NULL;
+    TP_COUNT_VISIT = TP_COUNT_MOVE = TP_COUNT_ROT = TP_COUNT_ALLOC = TP_COUNT_FREE = 0;
+}
@@ -0,0 +1,282 @@
+// Árvore WAVL (weak AVL / rank-balanced)
+// Mesmo formato da AVL_mod.c, mas o balanceamento usa posto (rank) em vez de altura:
+// - diferença de posto pai-filho sempre 1 ou 2; folhas têm posto 0 (NULL = -1)
+// - só com inserções a árvore é exatamente uma AVL (mesmas rotações)
+// - cada remoção faz no máximo 2 rotações (AVL pode rotacionar em todos os níveis)
+// Conta de forma consistente (mesmas categorias da AVL):
+// - comparações/visitas (COUNT_VISIT)
+// - movimentação de ponteiros/atribuições estruturais (COUNT_MOVE)
+// - atualizações de posto (COUNT_HEIGHT)
+// - rotações (COUNT_ROT)
+// - alocação/liberação de nós (COUNT_ALLOC / COUNT_FREE)
+// Exporta funções:
+//   ArvoreWAVL* wavl_criar();
+//   void wavl_inserir(ArvoreWAVL*, int);
+//   int wavl_remover_chave(ArvoreWAVL*, int); // remove 1 ocorrência
+//   void wavl_remover_tudo(ArvoreWAVL*);
+//   long wavl_get_insercao_and_reset();
+//   long wavl_get_remocao_and_reset();
+
+#include <stdlib.h>
+#include <stdio.h>
+
+typedef struct noWAVL {
+    struct noWAVL* pai;
+    struct noWAVL* esquerda;
+    struct noWAVL* direita;
+    int posto;
+    int valor;
+    int quantidade;
+} NoWAVL;
+
+typedef struct arvoreWAVL {
+    NoWAVL* raiz;
+} ArvoreWAVL;
+
+
+static long WAVL_COUNT_VISIT  = 0;  // comparações / visitas (navegação)
+static long WAVL_COUNT_MOVE   = 0;  // atribuições / mov. ponteiros (links)
+static long WAVL_COUNT_HEIGHT = 0;  // promoções / rebaixamentos de posto
+static long WAVL_COUNT_ROT    = 0;  // rotações (cada rotação conta 1)
+static long WAVL_COUNT_ALLOC  = 0;  // alocações de nós
+static long WAVL_COUNT_FREE   = 0;  // liberações de nós
+
+/* wrappers para obter "esforço total" e reset */
+long wavl_get_insercao_and_reset() {
+    long total = WAVL_COUNT_VISIT + WAVL_COUNT_MOVE + WAVL_COUNT_HEIGHT + WAVL_COUNT_ROT + WAVL_COUNT_ALLOC;
+    WAVL_COUNT_VISIT = WAVL_COUNT_MOVE = WAVL_COUNT_HEIGHT = WAVL_COUNT_ROT = WAVL_COUNT_ALLOC = 0;
+    return total;
+}
+long wavl_get_remocao_and_reset() {
+    long total = WAVL_COUNT_VISIT + WAVL_COUNT_MOVE + WAVL_COUNT_HEIGHT + WAVL_COUNT_ROT + WAVL_COUNT_FREE;
+    WAVL_COUNT_VISIT = WAVL_COUNT_MOVE = WAVL_COUNT_HEIGHT = WAVL_COUNT_ROT = WAVL_COUNT_FREE = 0;
+    return total;
+}
+
+
+static inline void COUNT_VISIT() { WAVL_COUNT_VISIT++; }
+static inline void COUNT_MOVE()  { WAVL_COUNT_MOVE++; }
+static inline void COUNT_HEIGHT(){ WAVL_COUNT_HEIGHT++; }
+static inline void COUNT_ROT()   { WAVL_COUNT_ROT++; }
+static inline void COUNT_ALLOC() { WAVL_COUNT_ALLOC++; }
+static inline void COUNT_FREEF() { WAVL_COUNT_FREE++; }
+
+static inline int posto_no(NoWAVL* n) { return n ? n->posto : -1; }
+
+/* diferença de posto entre pai e filho (filho pode ser NULL) */
+static inline int dif_posto(NoWAVL* pai, NoWAVL* filho) { return posto_no(pai) - posto_no(filho); }
+
+static inline void promover(NoWAVL* n) { n->posto++; COUNT_HEIGHT(); }
+static inline void rebaixar(NoWAVL* n) { n->posto--; COUNT_HEIGHT(); }
+
+ArvoreWAVL* wavl_criar() {
+    ArvoreWAVL* a = (ArvoreWAVL*) malloc(sizeof(ArvoreWAVL));
+    a->raiz = NULL;
+    return a;
+}
+
+static NoWAVL* novo_no_wavl(int valor, NoWAVL* pai) {
+    NoWAVL* n = (NoWAVL*) malloc(sizeof(NoWAVL));
+    n->valor = valor;
+    n->pai = pai;
+    n->esquerda = n->direita = NULL;
+    n->quantidade = 1;
+    n->posto = 0;
+    COUNT_ALLOC();
+    COUNT_MOVE(); // atribuições de ponteiro iniciais
+    return n;
+}
+
+/* Rotações instrumentadas; postos são ajustados por quem chama */
+
+static NoWAVL* rotacao_esq(ArvoreWAVL* a, NoWAVL* x) {
+    COUNT_ROT();
+    NoWAVL* y = x->direita;
+    COUNT_VISIT(); COUNT_MOVE();
+
+    x->direita = y->esquerda; COUNT_MOVE();
+    if (y->esquerda) { y->esquerda->pai = x; COUNT_MOVE(); }
+    y->pai = x->pai; COUNT_MOVE();
+
+    if (!x->pai) {
+        a->raiz = y; COUNT_MOVE();
+    } else if (x == x->pai->esquerda) {
+        x->pai->esquerda = y; COUNT_MOVE();
+    } else {
+        x->pai->direita = y; COUNT_MOVE();
+    }
+
+    y->esquerda = x; COUNT_MOVE();
+    x->pai = y; COUNT_MOVE();
+    return y;
+}
+
+static NoWAVL* rotacao_dir(ArvoreWAVL* a, NoWAVL* y) {
+    COUNT_ROT();
+    NoWAVL* x = y->esquerda;
+    COUNT_VISIT(); COUNT_MOVE();
+
+    y->esquerda = x->direita; COUNT_MOVE();
+    if (x->direita) { x->direita->pai = y; COUNT_MOVE(); }
+    x->pai = y->pai; COUNT_MOVE();
+
+    if (!y->pai) {
+        a->raiz = x; COUNT_MOVE();
+    } else if (y == y->pai->esquerda) {
+        y->pai->esquerda = x; COUNT_MOVE();
+    } else {
+        y->pai->direita = x; COUNT_MOVE();
+    }
+
+    x->direita = y; COUNT_MOVE();
+    y->pai = x; COUNT_MOVE();
+    return x;
+}
+
+/* Inserção: x acabou de virar 0-filho de p. Sobe promovendo enquanto o irmão
+   for 1-filho; no máximo uma rotação (simples ou dupla) encerra o laço. */
+static void rebalancear_insercao(ArvoreWAVL* a, NoWAVL* x) {
+    NoWAVL* p = x->pai;
+    while (p && dif_posto(p, x) == 0) {
+        COUNT_VISIT();
+        int esq = (x == p->esquerda);
+        NoWAVL* s = esq ? p->direita : p->esquerda;
+        if (dif_posto(p, s) == 1) {
+            promover(p);
+            x = p;
+            p = x->pai;
+            continue;
+        }
+        /* irmão é 2-filho: rotação */
+        NoWAVL* y = esq ? x->direita : x->esquerda; /* filho interno de x */
+        if (!y || dif_posto(x, y) == 2) {
+            if (esq) rotacao_dir(a, p); else rotacao_esq(a, p);
+            rebaixar(p);
+        } else {
+            if (esq) { rotacao_esq(a, x); rotacao_dir(a, p); }
+            else     { rotacao_dir(a, x); rotacao_esq(a, p); }
+            promover(y);
+            rebaixar(x);
+            rebaixar(p);
+        }
+        break;
+    }
+}
+
+void wavl_inserir(ArvoreWAVL* a, int chave) {
+    NoWAVL* p = NULL;
+    NoWAVL* cur = a->raiz;
+    while (cur) {
+        COUNT_VISIT(); // visitando cur
+        if (chave == cur->valor) {
+            cur->quantidade++;
+            COUNT_MOVE();
+            return;
+        }
+        p = cur;
+        cur = (chave < cur->valor) ? cur->esquerda : cur->direita;
+    }
+
+    NoWAVL* novo = novo_no_wavl(chave, p);
+    if (!p) { a->raiz = novo; COUNT_MOVE(); return; }
+    if (chave < p->valor) p->esquerda = novo; else p->direita = novo;
+    COUNT_MOVE();
+
+    rebalancear_insercao(a, novo);
+}
+
+/* Remoção: x (possivelmente NULL) substituiu o nó removido como filho de p.
+   Rebaixa subindo enquanto x for 3-filho; no máximo uma rotação simples ou
+   dupla encerra o laço (logo, no máximo 2 rotações por remoção). */
+static void rebalancear_remocao(ArvoreWAVL* a, NoWAVL* x, NoWAVL* p) {
+    if (!p) return;
+
+    /* p virou folha 2,2: rebaixa e continua a partir dele */
+    if (!p->esquerda && !p->direita && p->posto == 1) {
+        rebaixar(p);
+        x = p;
+        p = x->pai;
+    }
+
+    while (p && dif_posto(p, x) == 3) {
+        COUNT_VISIT();
+        int esq = (x == p->esquerda);
+        NoWAVL* y = esq ? p->direita : p->esquerda;   /* irmão (nunca NULL aqui) */
+
+        if (dif_posto(p, y) == 2) {
+            rebaixar(p);
+        } else if (dif_posto(y, y->esquerda) == 2 && dif_posto(y, y->direita) == 2) {
+            rebaixar(p);
+            rebaixar(y);
+        } else {
+            NoWAVL* z = esq ? y->direita : y->esquerda;  /* filho externo de y */
+            NoWAVL* w = esq ? y->esquerda : y->direita;  /* filho interno de y */
+            if (dif_posto(y, z) == 1) {
+                if (esq) rotacao_esq(a, p); else rotacao_dir(a, p);
+                promover(y);
+                rebaixar(p);
+                if (!p->esquerda && !p->direita) rebaixar(p); /* não deixa folha 2,2 */
+            } else {
+                if (esq) { rotacao_dir(a, y); rotacao_esq(a, p); }
+                else     { rotacao_esq(a, y); rotacao_dir(a, p); }
+                promover(w); promover(w);
+                rebaixar(y);
+                rebaixar(p); rebaixar(p);
+            }
+            break;
+        }
+        x = p;
+        p = x->pai;
+    }
+}
+
+int wavl_remover_chave(ArvoreWAVL* a, int chave) {
+    NoWAVL* node = a->raiz;
+    while (node) {
+        COUNT_VISIT();
+        if (chave == node->valor) break;
+        node = (chave < node->valor) ? node->esquerda : node->direita;
+    }
+    if (!node) return 0;
+
+    if (node->quantidade > 1) {
+        node->quantidade--; COUNT_MOVE();
+        return 1;
+    }
+
+    /* dois filhos: copia o sucessor e remove o nó do sucessor */
+    if (node->esquerda && node->direita) {
+        NoWAVL* suc = node->direita;
+        while (suc->esquerda) { COUNT_VISIT(); suc = suc->esquerda; }
+        node->valor = suc->valor; COUNT_MOVE();
+        node->quantidade = suc->quantidade; COUNT_MOVE();
+        node = suc;
+    }
+
+    NoWAVL* filho = node->esquerda ? node->esquerda : node->direita;
+    NoWAVL* p = node->pai;
+    if (filho) { filho->pai = p; COUNT_MOVE(); }
+    if (!p) a->raiz = filho;
+    else if (node == p->esquerda) p->esquerda = filho;
+    else p->direita = filho;
+    COUNT_MOVE();
+
+    COUNT_FREEF(); free(node);
+
+    rebalancear_remocao(a, filho, p);
+    return 1;
+}
+
+static void liberar_rec(NoWAVL* n) {
+    if (!n) return;
+    liberar_rec(n->esquerda);
+    liberar_rec(n->direita);
+    free(n); COUNT_FREEF();
+}
+
+void wavl_remover_tudo(ArvoreWAVL* a) {
+    if (!a) return;
+    liberar_rec(a->raiz);
+    a->raiz = NULL;
+    WAVL_COUNT_VISIT = WAVL_COUNT_MOVE = WAVL_COUNT_HEIGHT = WAVL_COUNT_ROT = WAVL_COUNT_ALLOC = WAVL_COUNT_FREE = 0;
+}
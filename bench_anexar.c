@@ -0,0 +1,131 @@
+/*
+    Benchmark de inserção com dica para chaves crescentes (avl/rb/b_anexar).
+    As n chaves simulam timestamps: crescentes, com passos aleatórios de 0 a 3
+    (passo 0 = repetição). Para cada árvore:
+      - inserir: *_inserir (desce da raiz a cada chave)
+      - anexar:  *_anexar (máximo / folha mais à direita em cache)
+    Para cada modo: tempo e custo instrumentado por inserção; na B-tree também
+    a ocupação final dos nós (chaves / posições).
+
+    Compile:
+    gcc bench_anexar.c AVL_mod.c RubroNegra_mod.c B_mod.c -O2 -pthread -o bench_anexar
+
+    Uso:
+    ./bench_anexar [n] [ordem_b]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+void avl_anexar(Arvore1*, int);
+void avl_remover_tudo(Arvore1*);
+long avl_get_insercao_and_reset();
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+void rb_anexar(ArvoreRB*, int);
+void rb_remover_tudo(ArvoreRB*);
+long rb_get_insercao_and_reset();
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+void b_anexar(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+double b_ocupacao(ArvoreB*);
+long b_get_insercao_and_reset();
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void linha(FILE* f, const char* arvore, const char* modo, double ns, double ops, double ocupacao) {
+    if (ocupacao >= 0) {
+        printf("%-5s %-8s %10.1f %10.1f %10.3f\n", arvore, modo, ns, ops, ocupacao);
+        fprintf(f, "%s,%s,%.2f,%.2f,%.4f\n", arvore, modo, ns, ops, ocupacao);
+    } else {
+        printf("%-5s %-8s %10.1f %10.1f %10s\n", arvore, modo, ns, ops, "-");
+        fprintf(f, "%s,%s,%.2f,%.2f,\n", arvore, modo, ns, ops);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int t = 16;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) t = atoi(argv[2]);
+    if (n < 1) n = 1;
+    if (t < 2) t = 2;
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * n);
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        chaves[i] = k;
+        k += rand() % 4;
+    }
+
+    FILE* f = fopen("resultados_anexar.csv", "w");
+    fprintf(f, "arvore,modo,ns_por_insercao,ops_por_insercao,ocupacao_b\n");
+    printf("n=%d ordem_b=%d\n", n, t);
+    printf("%-5s %-8s %10s %10s %10s\n", "arv", "modo", "ns", "ops", "ocupacao");
+
+    for (int anexar = 0; anexar <= 1; anexar++) {
+        const char* modo = anexar ? "anexar" : "inserir";
+        Arvore1* a = avl_criar();
+        avl_get_insercao_and_reset();
+        double t0 = agora();
+        for (int i = 0; i < n; i++) {
+            if (anexar) avl_anexar(a, chaves[i]);
+            else avl_inserir(a, chaves[i]);
+        }
+        double ns = (agora() - t0) * 1e9 / n;
+        linha(f, "avl", modo, ns, (double) avl_get_insercao_and_reset() / n, -1);
+        avl_remover_tudo(a);
+        free(a);
+    }
+
+    for (int anexar = 0; anexar <= 1; anexar++) {
+        const char* modo = anexar ? "anexar" : "inserir";
+        ArvoreRB* r = rb_criar();
+        rb_get_insercao_and_reset();
+        double t0 = agora();
+        for (int i = 0; i < n; i++) {
+            if (anexar) rb_anexar(r, chaves[i]);
+            else rb_inserir(r, chaves[i]);
+        }
+        double ns = (agora() - t0) * 1e9 / n;
+        linha(f, "rb", modo, ns, (double) rb_get_insercao_and_reset() / n, -1);
+        rb_remover_tudo(r);
+        free(r);
+    }
+
+    for (int anexar = 0; anexar <= 1; anexar++) {
+        const char* modo = anexar ? "anexar" : "inserir";
+        ArvoreB* b = b_criar(t);
+        b_get_insercao_and_reset();
+        double t0 = agora();
+        for (int i = 0; i < n; i++) {
+            if (anexar) b_anexar(b, chaves[i]);
+            else b_inserir(b, chaves[i]);
+        }
+        double ns = (agora() - t0) * 1e9 / n;
+        linha(f, "b", modo, ns, (double) b_get_insercao_and_reset() / n, b_ocupacao(b));
+        b_remover_tudo(b);
+        free(b);
+    }
+
+    fclose(f);
+    free(chaves);
+    printf("\nArquivo gerado:\n - resultados_anexar.csv\n");
+    return 0;
+}
@@ -0,0 +1,232 @@
+/*
+    Benchmark das arenas de nós (avl/rb/b_definir_arena, Arena_mod.c).
+    Para AVL, rubro-negra e B-tree (ordem ordem_b), em cada modo de alocação:
+      - malloc:  arena desligada (como sempre)
+      - paginas: arena com páginas de 4 KiB
+      - thp:     arena com madvise(MADV_HUGEPAGE)
+      - hugetlb: arena com MAP_HUGETLB (cai para thp sem páginas reservadas)
+    insere n chaves aleatórias e faz `consultas` buscas aleatórias (metade
+    presentes) divididas entre `threads` threads. NUMA (numa = 0 nenhum,
+    1 intercalado, 2 local) vale para os modos com arena.
+    Para cada linha: modo efetivo, ns por inserção, ns por busca (tempo x
+    threads / consultas), faltas de dTLB por busca (perf_event_open; -1 se o
+    contador não estiver disponível), memória em páginas grandes (THP +
+    hugetlb, em MiB) e, contra a linha malloc da mesma árvore, aceleração da
+    busca e redução das faltas de TLB.
+
+    Compile:
+    gcc bench_arena.c AVL_mod.c RubroNegra_mod.c B_mod.c -O2 -pthread -o bench_arena
+
+    Uso:
+    ./bench_arena [n] [consultas] [threads] [numa] [ordem_b]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+int avl_buscar(Arvore1*, int);
+void avl_remover_tudo(Arvore1*);
+int avl_definir_arena(int, int);
+void avl_arena_estado(int*, int*, long*);
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+int rb_buscar(ArvoreRB*, int);
+void rb_remover_tudo(ArvoreRB*);
+int rb_definir_arena(int, int);
+void rb_arena_estado(int*, int*, long*);
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+int b_buscar_chave(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+int b_definir_arena(int, int);
+void b_arena_estado(int*, int*, long*);
+
+static const char* MODOS[] = { "malloc", "paginas", "thp", "hugetlb" };
+static const char* NUMAS[] = { "nenhum", "intercalado", "local" };
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int aleatorio(int limite) {
+    return (int) (((long long) rand() * RAND_MAX + rand()) % limite);
+}
+
+/* faltas de dTLB em leituras, desta thread e das que ela criar; -1 se indisponível */
+static int tlb_abrir() {
+    struct perf_event_attr pe;
+    memset(&pe, 0, sizeof(pe));
+    pe.type = PERF_TYPE_HW_CACHE;
+    pe.size = sizeof(pe);
+    pe.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    pe.disabled = 1;
+    pe.inherit = 1;
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    return (int) syscall(SYS_perf_event_open, &pe, 0, -1, -1, 0);
+}
+
+/* campo (em kB) de um arquivo /proc no formato "Nome:   valor kB" */
+static long proc_kb(const char* arquivo, const char* campo) {
+    char linha[256];
+    long v = 0;
+    size_t n = strlen(campo);
+    FILE* f = fopen(arquivo, "r");
+    if (!f) return 0;
+    while (fgets(linha, sizeof(linha), f))
+        if (strncmp(linha, campo, n) == 0 && linha[n] == ':') {
+            v = atol(linha + n + 1);
+            break;
+        }
+    fclose(f);
+    return v;
+}
+
+/* MiB em páginas grandes: THP do processo + páginas hugetlb em uso no sistema */
+static double mb_paginas_grandes() {
+    long thp = proc_kb("/proc/self/smaps_rollup", "AnonHugePages");
+    long total = proc_kb("/proc/meminfo", "HugePages_Total");
+    long livres = proc_kb("/proc/meminfo", "HugePages_Free");
+    long tam = proc_kb("/proc/meminfo", "Hugepagesize");
+    return (thp + (total - livres) * tam) / 1024.0;
+}
+
+typedef struct {
+    int arvore;       /* 0 avl, 1 rb, 2 b */
+    void* a;
+    const int* consultas;
+    int ini, fim;
+    long achadas;
+} TarefaBusca;
+
+static void* buscar_fatia(void* x) {
+    TarefaBusca* t = (TarefaBusca*) x;
+    long achadas = 0;
+    if (t->arvore == 0) for (int i = t->ini; i < t->fim; i++) achadas += avl_buscar((Arvore1*) t->a, t->consultas[i]) != 0;
+    else if (t->arvore == 1) for (int i = t->ini; i < t->fim; i++) achadas += rb_buscar((ArvoreRB*) t->a, t->consultas[i]) != 0;
+    else for (int i = t->ini; i < t->fim; i++) achadas += b_buscar_chave((ArvoreB*) t->a, t->consultas[i]) != 0;
+    t->achadas = achadas;
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    int n = 10000000;
+    int q = 2000000;
+    int threads = 1;
+    int numa = 0;
+    int ordem = 10;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) q = atoi(argv[2]);
+    if (argc > 3) threads = atoi(argv[3]);
+    if (argc > 4) numa = atoi(argv[4]);
+    if (argc > 5) ordem = atoi(argv[5]);
+    if (n < 1) n = 1;
+    if (q < 1) q = 1;
+    if (threads < 1) threads = 1;
+    if (threads > 64) threads = 64;
+    if (numa < 0 || numa > 2) numa = 0;
+    if (ordem < 2) ordem = 2;
+
+    int* chaves = malloc(sizeof(int) * n);
+    int* consultas = malloc(sizeof(int) * q);
+    srand(12345);
+    for (int i = 0; i < n; i++) chaves[i] = aleatorio(1 << 30);
+    for (int i = 0; i < q; i++) consultas[i] = (i & 1) ? aleatorio(1 << 30) : chaves[aleatorio(n)];
+
+    int tlb = tlb_abrir();
+    if (tlb < 0) printf("AVISO: contador de dTLB indisponível (perf_event_open); faltas = -1\n");
+
+    FILE* f = fopen("resultados_arena.csv", "w");
+    fprintf(f, "arvore,modo,modo_efetivo,numa_efetivo,threads,ns_por_insercao,ns_por_busca,"
+               "tlb_por_busca,mb_paginas_grandes,aceleracao_busca,reducao_tlb\n");
+    printf("n=%d consultas=%d threads=%d numa=%s ordem_b=%d\n", n, q, threads, NUMAS[numa], ordem);
+    printf("%-4s %-8s %-8s %-11s %9s %9s %8s %8s %7s %7s\n", "arv", "modo", "efetivo", "numa",
+           "ns ins", "ns busca", "tlb/b", "MiB gr", "acel", "red tlb");
+
+    const char* nomes[3] = { "avl", "rb", "b" };
+    for (int arv = 0; arv < 3; arv++) {
+        double ns_base = 0, tlb_base = 0;
+        for (int modo = 0; modo < 4; modo++) {
+            int (*definir)(int, int) = arv == 0 ? avl_definir_arena : arv == 1 ? rb_definir_arena : b_definir_arena;
+            void (*estado)(int*, int*, long*) = arv == 0 ? avl_arena_estado : arv == 1 ? rb_arena_estado : b_arena_estado;
+            definir(modo, numa);
+
+            void* a = arv == 0 ? (void*) avl_criar() : arv == 1 ? (void*) rb_criar() : (void*) b_criar(ordem);
+            double t0 = agora();
+            if (arv == 0) for (int i = 0; i < n; i++) avl_inserir((Arvore1*) a, chaves[i]);
+            else if (arv == 1) for (int i = 0; i < n; i++) rb_inserir((ArvoreRB*) a, chaves[i]);
+            else for (int i = 0; i < n; i++) b_inserir((ArvoreB*) a, chaves[i]);
+            double ns_ins = (agora() - t0) * 1e9 / n;
+            int efetivo, numa_efetivo;
+            estado(&efetivo, &numa_efetivo, NULL);
+            double mb = mb_paginas_grandes();
+
+            TarefaBusca tarefas[64];
+            pthread_t ids[64];
+            for (int i = 0; i < threads; i++) {
+                tarefas[i].arvore = arv;
+                tarefas[i].a = a;
+                tarefas[i].consultas = consultas;
+                tarefas[i].ini = (int) ((long long) q * i / threads);
+                tarefas[i].fim = (int) ((long long) q * (i + 1) / threads);
+            }
+            long long faltas = -1;
+            if (tlb >= 0) {
+                ioctl(tlb, PERF_EVENT_IOC_RESET, 0);
+                ioctl(tlb, PERF_EVENT_IOC_ENABLE, 0);
+            }
+            t0 = agora();
+            for (int i = 1; i < threads; i++) pthread_create(&ids[i], NULL, buscar_fatia, &tarefas[i]);
+            buscar_fatia(&tarefas[0]);
+            for (int i = 1; i < threads; i++) pthread_join(ids[i], NULL);
+            double ns_busca = (agora() - t0) * 1e9 * threads / q;
+            if (tlb >= 0) {
+                ioctl(tlb, PERF_EVENT_IOC_DISABLE, 0);
+                if (read(tlb, &faltas, sizeof(faltas)) != sizeof(faltas)) faltas = -1;
+            }
+            double tlb_busca = faltas >= 0 ? (double) faltas / q : -1;
+
+            if (modo == 0) {
+                ns_base = ns_busca;
+                tlb_base = tlb_busca;
+            }
+            double acel = ns_busca > 0 ? ns_base / ns_busca : 0;
+            double red = tlb_base > 0 && tlb_busca >= 0 ? 1.0 - tlb_busca / tlb_base : 0;
+            printf("%-4s %-8s %-8s %-11s %9.1f %9.1f %8.3f %8.1f %7.2f %7.2f\n", nomes[arv], MODOS[modo],
+                   MODOS[efetivo], NUMAS[numa_efetivo], ns_ins, ns_busca, tlb_busca, mb, acel, red);
+            fprintf(f, "%s,%s,%s,%s,%d,%.2f,%.2f,%.4f,%.1f,%.3f,%.3f\n", nomes[arv], MODOS[modo],
+                    MODOS[efetivo], NUMAS[numa_efetivo], threads, ns_ins, ns_busca, tlb_busca, mb, acel, red);
+
+            if (arv == 0) avl_remover_tudo((Arvore1*) a);
+            else if (arv == 1) rb_remover_tudo((ArvoreRB*) a);
+            else b_remover_tudo((ArvoreB*) a);
+            free(a);
+        }
+        (arv == 0 ? avl_definir_arena : arv == 1 ? rb_definir_arena : b_definir_arena)(0, 0);
+    }
+
+    if (tlb >= 0) close(tlb);
+    fclose(f);
+    free(chaves);
+    free(consultas);
+    printf("\nArquivo gerado:\n - resultados_arena.csv\n");
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+    Benchmark da inserção ascendente da B-tree (b_inserir_ascendente: divide só
+    no transbordo da folha e antes tenta redistribuir com um irmão) contra
+    b_inserir (divide todo nó cheio na descida).
+    Para cada ordem t em 2, 3, 4, 8, 16 e 64 e cada distribuição de n chaves
+    (aleatoria, crescente, decrescente):
+      - tempo e custo instrumentado por inserção
+      - divisões e redistribuições por 1000 inserções
+      - ocupação final (chaves / (nós * (2t-1))) e número de nós
+
+    Compile:
+    gcc bench_ascendente.c B_mod.c -O2 -pthread -o bench_ascendente
+
+    Uso:
+    ./bench_ascendente [n]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+void b_inserir_ascendente(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+double b_ocupacao(ArvoreB*);
+long b_get_insercao_and_reset();
+long b_get_divisoes_and_reset();
+long b_get_redistribuicoes_and_reset();
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    if (argc > 1) n = atoi(argv[1]);
+    if (n < 1) n = 1;
+
+    const int ordens[] = { 2, 3, 4, 8, 16, 64 };
+    const char* distribuicoes[] = { "aleatoria", "crescente", "decrescente" };
+    int* chaves = malloc(sizeof(int) * n);
+
+    FILE* f = fopen("resultados_ascendente.csv", "w");
+    fprintf(f, "t,distribuicao,modo,ns_por_insercao,ops_por_insercao,divisoes_por_mil,"
+               "redistribuicoes_por_mil,ocupacao,nos\n");
+    printf("n=%d\n", n);
+    printf("%3s %-11s %-10s %8s %8s %8s %8s %6s %9s\n", "t", "distrib", "modo", "ns", "ops",
+           "div/1k", "red/1k", "ocup", "nos");
+
+    for (size_t o = 0; o < sizeof(ordens) / sizeof(ordens[0]); o++) {
+        int t = ordens[o];
+        for (int d = 0; d < 3; d++) {
+            srand(12345);
+            for (int i = 0; i < n; i++) chaves[i] = d == 0 ? rand() : (d == 1 ? i : n - i);
+            for (int ascendente = 0; ascendente <= 1; ascendente++) {
+                const char* modo = ascendente ? "ascendente" : "inserir";
+                ArvoreB* b = b_criar(t);
+                b_get_insercao_and_reset();
+                b_get_divisoes_and_reset();
+                b_get_redistribuicoes_and_reset();
+                double t0 = agora();
+                if (ascendente) for (int i = 0; i < n; i++) b_inserir_ascendente(b, chaves[i]);
+                else for (int i = 0; i < n; i++) b_inserir(b, chaves[i]);
+                double ns = (agora() - t0) * 1e9 / n;
+                double ops = (double) b_get_insercao_and_reset() / n;
+                double div = 1000.0 * b_get_divisoes_and_reset() / n;
+                double red = 1000.0 * b_get_redistribuicoes_and_reset() / n;
+                double ocup = b_ocupacao(b);
+                long nos = (long) (n / (ocup * (2 * t - 1)) + 0.5);
+                printf("%3d %-11s %-10s %8.1f %8.1f %8.2f %8.2f %6.3f %9ld\n", t, distribuicoes[d], modo,
+                       ns, ops, div, red, ocup, nos);
+                fprintf(f, "%d,%s,%s,%.2f,%.2f,%.3f,%.3f,%.4f,%ld\n", t, distribuicoes[d], modo,
+                        ns, ops, div, red, ocup, nos);
+                b_remover_tudo(b);
+                free(b);
+            }
+        }
+    }
+
+    fclose(f);
+    free(chaves);
+    printf("\nArquivo gerado:\n - resultados_ascendente.csv\n");
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+    Benchmark da ordem automática da B-tree (b_calibrar / b_criar(B_ORDEM_AUTO)).
+    Calibra a ordem para três perfis de carga (fração de buscas 0.5, 0.99 e a
+    declarada em `leitura`, por último): para cada ordem candidata, tempo e
+    custo instrumentado por operação da carga curta de b_calibrar. A escolha
+    do perfil declarado fica salva em b_ordem.cfg, que b_criar(B_ORDEM_AUTO)
+    lê nas próximas execuções.
+    Depois, com o perfil declarado, compara a ordem automática com as ordens
+    fixas do experimento (5 e 10) numa carga maior: n chaves e `operacoes`
+    operações (buscas e inserções/remoções alternadas), ns e custo por operação.
+
+    Compile:
+    gcc bench_autoajuste.c B_mod.c -O2 -pthread -o bench_autoajuste
+
+    Uso:
+    ./bench_autoajuste [n] [operacoes] [leitura]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+int b_remover_chave(ArvoreB*, int);
+int b_buscar_chave(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+int b_ordem_auto();
+int b_calibrar(long, double, long, const char*, void (*)(int, double, double, void*), void*);
+long b_get_insercao_and_reset();
+long b_get_remocao_and_reset();
+
+#define B_ORDEM_AUTO (-1)
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int aleatorio(int limite) {
+    return (int) (((long long) rand() * RAND_MAX + rand()) % limite);
+}
+
+typedef struct {
+    FILE* f;
+    double leitura;
+} Saida;
+
+static void linha_calibracao(int t, double ns, double ops, void* ctx) {
+    Saida* s = (Saida*) ctx;
+    printf("calibrar %5.2f %4d %10.1f %10.1f\n", s->leitura, t, ns, ops);
+    fprintf(s->f, "calibrar,%.2f,%d,%.2f,%.2f\n", s->leitura, t, ns, ops);
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int q = 1000000;
+    double leitura = 0.9;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) q = atoi(argv[2]);
+    if (argc > 3) leitura = atof(argv[3]);
+    if (n < 1) n = 1;
+    if (q < 1) q = 1;
+    if (leitura < 0) leitura = 0;
+    if (leitura > 1) leitura = 1;
+
+    /* a calibração usa cargas curtas: até 100000 chaves e operações */
+    long n_cal = n < 100000 ? n : 100000;
+    long q_cal = q < 100000 ? q : 100000;
+
+    FILE* f = fopen("resultados_autoajuste.csv", "w");
+    fprintf(f, "fase,leitura,t,ns_por_op,ops_por_op\n");
+    printf("n=%d operacoes=%d leitura=%.2f (calibracao: n=%ld operacoes=%ld)\n", n, q, leitura, n_cal, q_cal);
+    printf("%-8s %5s %4s %10s %10s\n", "fase", "leit", "t", "ns", "ops");
+
+    const double perfis[] = { 0.5, 0.99 };
+    for (int p = 0; p < 2; p++) {
+        Saida s = { f, perfis[p] };
+        int t = b_calibrar(n_cal, perfis[p], q_cal, NULL, linha_calibracao, &s);
+        printf("  -> leitura %.2f: t=%d\n", perfis[p], t);
+    }
+    Saida s = { f, leitura };
+    int escolhida = b_calibrar(n_cal, leitura, q_cal, "b_ordem.cfg", linha_calibracao, &s);
+    printf("  -> leitura %.2f: t=%d (salva em b_ordem.cfg)\n", leitura, escolhida);
+
+    /* validação: ordem automática contra as ordens fixas do experimento */
+    const int ordens[] = { 5, 10, B_ORDEM_AUTO };
+    for (int o = 0; o < 3; o++) {
+        srand(12345);
+        ArvoreB* b = b_criar(ordens[o]);
+        for (int i = 0; i < n; i++) b_inserir(b, aleatorio(2 * n));
+        b_get_insercao_and_reset();
+        int limite = (int) (leitura * 1000000);
+        int escreve = 0;
+        long custo = 0;   /* cada getter zera todos os contadores: um por operação */
+        double t0 = agora();
+        for (int i = 0; i < q; i++) {
+            int k = aleatorio(2 * n);
+            if (aleatorio(1000000) < limite) {
+                b_buscar_chave(b, k);
+                custo += b_get_insercao_and_reset();
+            } else if ((escreve ^= 1)) {
+                b_inserir(b, k);
+                custo += b_get_insercao_and_reset();
+            } else {
+                b_remover_chave(b, k);
+                custo += b_get_remocao_and_reset();
+            }
+        }
+        double ns = (agora() - t0) * 1e9 / q;
+        double ops = (double) custo / q;
+        int t = ordens[o] == B_ORDEM_AUTO ? b_ordem_auto() : ordens[o];
+        const char* fase = ordens[o] == B_ORDEM_AUTO ? "auto" : "fixa";
+        printf("%-8s %5.2f %4d %10.1f %10.1f\n", fase, leitura, t, ns, ops);
+        fprintf(f, "%s,%.2f,%d,%.2f,%.2f\n", fase, leitura, t, ns, ops);
+        b_remover_tudo(b);
+        free(b);
+    }
+
+    fclose(f);
+    printf("\nArquivos gerados:\n - resultados_autoajuste.csv\n - b_ordem.cfg\n");
+    return 0;
+}
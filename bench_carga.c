@@ -0,0 +1,150 @@
+/*
+    Benchmark de carga a partir do formato serializado (AVL_mod.c e RubroNegra_mod.c).
+    Para cada árvore:
+      - reconstrucao: n inserções (o que o reinício custa hoje)
+      - salvar:       grava o arquivo pré-ordem sem ponteiros
+      - carregar:     mmap + reconstrução linear da árvore com ponteiros
+      - mapear:       mmap + n/10 buscas direto no arquivo (nenhum nó alocado)
+    Para cada fase: tempo e custo instrumentado por chave.
+
+    Compile:
+    gcc bench_carga.c AVL_mod.c RubroNegra_mod.c -O2 -pthread -o bench_carga
+
+    Uso:
+    ./bench_carga [n] [prefixo_arquivo]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* AVL */
+typedef struct arvore1 Arvore1;
+typedef struct arvoreMapeadaAVL ArvoreMapeadaAVL;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+int avl_buscar(Arvore1*, int);
+void avl_remover_tudo(Arvore1*);
+int avl_salvar(Arvore1*, const char*);
+Arvore1* avl_carregar(const char*);
+ArvoreMapeadaAVL* avl_mapear(const char*);
+int avl_mapa_buscar(ArvoreMapeadaAVL*, int);
+void avl_mapa_fechar(ArvoreMapeadaAVL*);
+long avl_get_insercao_and_reset();
+
+/* Rubro-Negra */
+typedef struct arvoreRB ArvoreRB;
+typedef struct arvoreMapeadaRB ArvoreMapeadaRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+int rb_buscar(ArvoreRB*, int);
+void rb_remover_tudo(ArvoreRB*);
+int rb_salvar(ArvoreRB*, const char*);
+ArvoreRB* rb_carregar(const char*);
+ArvoreMapeadaRB* rb_mapear(const char*);
+int rb_mapa_buscar(ArvoreMapeadaRB*, int);
+void rb_mapa_fechar(ArvoreMapeadaRB*);
+long rb_get_insercao_and_reset();
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void linha(FILE* f, const char* arvore, const char* fase, double ms, double ops) {
+    printf("%-6s %-14s %12.1f %12.2f\n", arvore, fase, ms, ops);
+    fprintf(f, "%s,%s,%.3f,%.2f\n", arvore, fase, ms, ops);
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    const char* prefixo = "arvore";
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) prefixo = argv[2];
+    if (n < 1) n = 1;
+    int buscas = n / 10 > 0 ? n / 10 : 1;
+
+    char arq_avl[512], arq_rb[512];
+    snprintf(arq_avl, sizeof(arq_avl), "%s.avl", prefixo);
+    snprintf(arq_rb, sizeof(arq_rb), "%s.rb", prefixo);
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) chaves[i] = rand();
+
+    FILE* f = fopen("resultados_carga.csv", "w");
+    fprintf(f, "arvore,fase,tempo_ms,ops_por_chave\n");
+    printf("n=%d buscas=%d\n", n, buscas);
+    printf("%-6s %-14s %12s %12s\n", "arvore", "fase", "ms", "ops/chave");
+
+    /* ---------- AVL ---------- */
+    avl_get_insercao_and_reset();
+    double t0 = agora();
+    Arvore1* a = avl_criar();
+    for (int i = 0; i < n; i++) avl_inserir(a, chaves[i]);
+    double ms = (agora() - t0) * 1000.0;
+    linha(f, "avl", "reconstrucao", ms, (double) avl_get_insercao_and_reset() / n);
+
+    t0 = agora();
+    if (avl_salvar(a, arq_avl) != 0) { printf("ERRO: não foi possível gravar %s\n", arq_avl); return 1; }
+    ms = (agora() - t0) * 1000.0;
+    linha(f, "avl", "salvar", ms, (double) avl_get_insercao_and_reset() / n);
+
+    t0 = agora();
+    Arvore1* c = avl_carregar(arq_avl);
+    ms = (agora() - t0) * 1000.0;
+    linha(f, "avl", "carregar", ms, (double) avl_get_insercao_and_reset() / n);
+
+    long achadas = 0;
+    t0 = agora();
+    ArvoreMapeadaAVL* m = avl_mapear(arq_avl);
+    for (int i = 0; i < buscas; i++) achadas += avl_mapa_buscar(m, chaves[(i * 10) % n]);
+    ms = (agora() - t0) * 1000.0;
+    linha(f, "avl", "mapear", ms, (double) avl_get_insercao_and_reset() / buscas);
+    avl_mapa_fechar(m);
+    for (int i = 0; i < buscas; i++) achadas -= avl_buscar(c, chaves[(i * 10) % n]);
+    if (achadas != 0) printf("AVISO: árvore mapeada e carregada divergem (AVL)\n");
+    avl_get_insercao_and_reset();
+    avl_remover_tudo(a);
+    avl_remover_tudo(c);
+    free(a);
+    free(c);
+
+    /* ---------- Rubro-Negra ---------- */
+    rb_get_insercao_and_reset();
+    t0 = agora();
+    ArvoreRB* r = rb_criar();
+    for (int i = 0; i < n; i++) rb_inserir(r, chaves[i]);
+    ms = (agora() - t0) * 1000.0;
+    linha(f, "rb", "reconstrucao", ms, (double) rb_get_insercao_and_reset() / n);
+
+    t0 = agora();
+    if (rb_salvar(r, arq_rb) != 0) { printf("ERRO: não foi possível gravar %s\n", arq_rb); return 1; }
+    ms = (agora() - t0) * 1000.0;
+    linha(f, "rb", "salvar", ms, (double) rb_get_insercao_and_reset() / n);
+
+    t0 = agora();
+    ArvoreRB* s = rb_carregar(arq_rb);
+    ms = (agora() - t0) * 1000.0;
+    linha(f, "rb", "carregar", ms, (double) rb_get_insercao_and_reset() / n);
+
+    achadas = 0;
+    t0 = agora();
+    ArvoreMapeadaRB* q = rb_mapear(arq_rb);
+    for (int i = 0; i < buscas; i++) achadas += rb_mapa_buscar(q, chaves[(i * 10) % n]);
+    ms = (agora() - t0) * 1000.0;
+    linha(f, "rb", "mapear", ms, (double) rb_get_insercao_and_reset() / buscas);
+    rb_mapa_fechar(q);
+    for (int i = 0; i < buscas; i++) achadas -= rb_buscar(s, chaves[(i * 10) % n]);
+    if (achadas != 0) printf("AVISO: árvore mapeada e carregada divergem (RB)\n");
+    rb_remover_tudo(r);
+    rb_remover_tudo(s);
+
+    fclose(f);
+    free(chaves);
+    printf("\nArquivo gerado:\n - resultados_carga.csv\n");
+    return 0;
+}
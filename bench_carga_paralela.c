@@ -0,0 +1,120 @@
+/*
+    Benchmark de carga da B-tree a partir de chaves fora de ordem (B_mod.c).
+    n chaves aleatórias (com repetições). Modos:
+      - inserir:   n chamadas de b_inserir (uma descida raiz-folha por chave)
+      - lote:      b_inserir_lote (ordena e insere a partir de um dedo)
+      - paralelo:  b_carregar_paralelo com 1, 2, 4, ... threads, ocupação 1.0
+    Depois, para ocupações alvo 1.0, 0.85 e 0.7, carrega a árvore e mede n/10
+    inserções aleatórias em seguida (inserir_apos): folhas cheias dividem já
+    na primeira inserção.
+    Para cada linha: tempo e custo instrumentado por chave, speedup sobre o
+    paralelo com 1 thread e a ocupação final dos nós.
+
+    Compile:
+    gcc bench_carga_paralela.c B_mod.c -O2 -pthread -o bench_carga_paralela
+
+    Uso:
+    ./bench_carga_paralela [n] [ordem_b] [max_threads]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+void b_inserir_lote(ArvoreB*, const int*, int);
+ArvoreB* b_carregar_paralelo(int, const int*, int, int, double);
+void b_remover_tudo(ArvoreB*);
+double b_ocupacao(ArvoreB*);
+long b_get_insercao_and_reset();
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void linha(FILE* f, const char* modo, double alvo, int threads, double ns, double ops,
+                  double speedup, double ocupacao) {
+    printf("%-13s %5.2f %7d %10.1f %10.2f %8.2f %9.3f\n", modo, alvo, threads, ns, ops, speedup, ocupacao);
+    fprintf(f, "%s,%.2f,%d,%.2f,%.3f,%.3f,%.4f\n", modo, alvo, threads, ns, ops, speedup, ocupacao);
+}
+
+static void liberar(ArvoreB* b) {
+    b_remover_tudo(b);
+    free(b);
+}
+
+int main(int argc, char **argv)
+{
+    int n = 4000000;
+    int t = 16;
+    int max_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) t = atoi(argv[2]);
+    if (argc > 3) max_threads = atoi(argv[3]);
+    if (n < 1) n = 1;
+    if (t < 2) t = 2;
+    if (max_threads < 1) max_threads = 1;
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) chaves[i] = rand();
+    int extra = n / 10 > 0 ? n / 10 : 1;
+    int* novas = malloc(sizeof(int) * extra);
+    for (int i = 0; i < extra; i++) novas[i] = rand();
+
+    FILE* f = fopen("resultados_carga_paralela.csv", "w");
+    fprintf(f, "modo,ocupacao_alvo,threads,ns_por_chave,ops_por_chave,speedup,ocupacao\n");
+    printf("n=%d ordem_b=%d max_threads=%d\n", n, t, max_threads);
+    printf("%-13s %5s %7s %10s %10s %8s %9s\n", "modo", "alvo", "threads", "ns", "ops", "speedup", "ocupacao");
+
+    ArvoreB* b = b_criar(t);
+    b_get_insercao_and_reset();
+    double t0 = agora();
+    for (int i = 0; i < n; i++) b_inserir(b, chaves[i]);
+    double ns = (agora() - t0) * 1e9 / n;
+    linha(f, "inserir", 0, 1, ns, (double) b_get_insercao_and_reset() / n, 0, b_ocupacao(b));
+    liberar(b);
+
+    b = b_criar(t);
+    b_get_insercao_and_reset();
+    t0 = agora();
+    b_inserir_lote(b, chaves, n);
+    ns = (agora() - t0) * 1e9 / n;
+    linha(f, "lote", 0, 1, ns, (double) b_get_insercao_and_reset() / n, 0, b_ocupacao(b));
+    liberar(b);
+
+    double base = 0;
+    for (int th = 1; ; th *= 2) {
+        if (th > max_threads) th = max_threads;
+        b_get_insercao_and_reset();
+        t0 = agora();
+        b = b_carregar_paralelo(t, chaves, n, th, 1.0);
+        double s = agora() - t0;
+        if (th == 1) base = s;
+        linha(f, "paralelo", 1.0, th, s * 1e9 / n, (double) b_get_insercao_and_reset() / n, base / s, b_ocupacao(b));
+        liberar(b);
+        if (th == max_threads) break;
+    }
+
+    double alvos[] = { 1.0, 0.85, 0.7 };
+    for (int a = 0; a < 3; a++) {
+        b = b_carregar_paralelo(t, chaves, n, max_threads, alvos[a]);
+        b_get_insercao_and_reset();
+        t0 = agora();
+        for (int i = 0; i < extra; i++) b_inserir(b, novas[i]);
+        ns = (agora() - t0) * 1e9 / extra;
+        linha(f, "inserir_apos", alvos[a], 1, ns, (double) b_get_insercao_and_reset() / extra, 0, b_ocupacao(b));
+        liberar(b);
+    }
+
+    fclose(f);
+    free(chaves);
+    free(novas);
+    printf("\nArquivo gerado:\n - resultados_carga_paralela.csv\n");
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+    Benchmark da B-tree compactada (b_compactar: chaves como deslocamentos de
+    1, 2 ou 4 bytes a partir da menor chave de cada nó) contra a B-tree normal.
+    Três distribuições de n chaves, inseridas em ordem aleatória:
+      - densa:    permutação de 0..n-1
+      - agrupada: crescentes com passos aleatórios de 0 a 3 (como bench_anexar),
+                  mais um salto de até 2^16 a cada 1000 chaves
+      - esparsa:  rand() (31 bits, espalhadas)
+    Para cada uma: bytes por chave das duas (a normal com a capacidade alocada
+    dos nós), fração dos nós com deslocamentos de 1 / 2 / 4 bytes, tempo de
+    b_compactar e, para `consultas` buscas (metade chaves presentes, metade
+    aleatórias no intervalo das chaves), ns e visitas instrumentadas por busca.
+
+    Compile:
+    gcc bench_compacta.c B_mod.c -O2 -pthread -o bench_compacta
+
+    Uso:
+    ./bench_compacta [n] [ordem_b] [consultas]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+int b_buscar_chave(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+long b_bytes(ArvoreB*);
+long b_get_insercao_and_reset();
+
+typedef struct ArvoreBCompacta ArvoreBCompacta;
+ArvoreBCompacta* b_compactar(ArvoreB*);
+int b_compacta_buscar(ArvoreBCompacta*, int);
+long b_compacta_bytes(ArvoreBCompacta*);
+double b_compacta_fracao_largura(ArvoreBCompacta*, int);
+void b_compacta_liberar(ArvoreBCompacta*);
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long long aleatorio(long long limite) {
+    return ((long long) rand() * RAND_MAX + rand()) % limite;
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int t = 64;
+    int q = 1000000;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) t = atoi(argv[2]);
+    if (argc > 3) q = atoi(argv[3]);
+    if (n < 1) n = 1;
+    if (t < 2) t = 2;
+    if (q < 1) q = 1;
+
+    int* chaves = malloc(sizeof(int) * n);
+    int* consultas = malloc(sizeof(int) * q);
+    const char* nomes[3] = { "densa", "agrupada", "esparsa" };
+
+    FILE* f = fopen("resultados_compacta.csv", "w");
+    fprintf(f, "distribuicao,bytes_chave_b,bytes_chave_compacta,nos_1byte,nos_2bytes,nos_4bytes,"
+               "compactar_ms,b_ns,compacta_ns,visitas_b,visitas_compacta\n");
+    printf("n=%d ordem_b=%d consultas=%d\n", n, t, q);
+    printf("%-9s %7s %7s | %5s %5s %5s | %8s | %7s %7s | %6s %6s\n", "distrib",
+           "B/ch b", "B/ch cp", "1B", "2B", "4B", "cp ms", "b ns", "cp ns", "v b", "v cp");
+
+    for (int d = 0; d < 3; d++) {
+        srand(12345);
+        int k = 0;
+        for (int i = 0; i < n; i++) {
+            if (d == 0) chaves[i] = i;
+            else if (d == 1) {
+                if (i % 1000 == 0) k += (int) aleatorio(1 << 16);
+                chaves[i] = k;
+                k += rand() % 4;
+            } else chaves[i] = rand();
+        }
+        int menor = chaves[0], maior = chaves[0];
+        for (int i = 0; i < n; i++) {
+            if (chaves[i] < menor) menor = chaves[i];
+            if (chaves[i] > maior) maior = chaves[i];
+        }
+        for (int i = n - 1; i > 0; i--) {
+            int j = (int) aleatorio(i + 1);
+            int x = chaves[i]; chaves[i] = chaves[j]; chaves[j] = x;
+        }
+        for (int i = 0; i < q; i++)
+            consultas[i] = (i & 1) ? (int) (menor + aleatorio((long long) maior - menor + 1)) : chaves[aleatorio(n)];
+
+        ArvoreB* b = b_criar(t);
+        for (int i = 0; i < n; i++) b_inserir(b, chaves[i]);
+
+        double t0 = agora();
+        ArvoreBCompacta* c = b_compactar(b);
+        double compactar_ms = (agora() - t0) * 1000.0;
+
+        long achadas[2] = { 0, 0 };
+        b_get_insercao_and_reset();
+        t0 = agora();
+        for (int i = 0; i < q; i++) achadas[0] += b_buscar_chave(b, consultas[i]);
+        double b_ns = (agora() - t0) * 1e9 / q;
+        double v_b = (double) b_get_insercao_and_reset() / q;
+        t0 = agora();
+        for (int i = 0; i < q; i++) achadas[1] += b_compacta_buscar(c, consultas[i]);
+        double cp_ns = (agora() - t0) * 1e9 / q;
+        double v_cp = (double) b_get_insercao_and_reset() / q;
+        if (achadas[0] != achadas[1])
+            printf("AVISO: buscas divergem (%ld %ld)\n", achadas[0], achadas[1]);
+
+        double by_b = (double) b_bytes(b) / n;
+        double by_cp = (double) b_compacta_bytes(c) / n;
+        double l1 = b_compacta_fracao_largura(c, 1);
+        double l2 = b_compacta_fracao_largura(c, 2);
+        double l4 = b_compacta_fracao_largura(c, 4);
+        printf("%-9s %7.2f %7.2f | %5.2f %5.2f %5.2f | %8.2f | %7.1f %7.1f | %6.1f %6.1f\n", nomes[d],
+               by_b, by_cp, l1, l2, l4, compactar_ms, b_ns, cp_ns, v_b, v_cp);
+        fprintf(f, "%s,%.3f,%.3f,%.4f,%.4f,%.4f,%.3f,%.2f,%.2f,%.2f,%.2f\n", nomes[d],
+                by_b, by_cp, l1, l2, l4, compactar_ms, b_ns, cp_ns, v_b, v_cp);
+
+        b_compacta_liberar(c);
+        b_remover_tudo(b);
+        free(b);
+    }
+
+    fclose(f);
+    free(chaves);
+    free(consultas);
+    printf("\nArquivo gerado:\n - resultados_compacta.csv\n");
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*
+    Benchmark de escalabilidade da B-tree concorrente (BConcorrente_mod.c)
+    e da lista de saltos sem trava (ListaSaltosConcorrente_mod.c) contra a
+    B_mod.c serializada por um mutex global.
+
+    Compile:
+    gcc bench_concorrente.c BConcorrente_mod.c ListaSaltosConcorrente_mod.c B_mod.c -O2 -pthread -o bench_concorrente
+
+    Uso:
+    ./bench_concorrente [max_threads] [ordem] [%leitura]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/* --------------------------------------------------
+   PARÂMETROS DO EXPERIMENTO
+   -------------------------------------------------- */
+#define N_INICIAL   200000      /* chaves pré-carregadas */
+#define UNIVERSO    (4 * N_INICIAL)
+#define OPS_TOTAL   2000000     /* operações divididas entre as threads */
+
+/* B-tree concorrente */
+typedef struct ArvoreBC ArvoreBC;
+ArvoreBC* bc_criar(int);
+void bc_inserir(ArvoreBC*, int);
+int bc_buscar(ArvoreBC*, int);
+int bc_remover_chave(ArvoreBC*, int);
+void bc_destruir(ArvoreBC*);
+
+/* lista de saltos sem trava */
+typedef struct ListaSaltosC ListaSaltosC;
+ListaSaltosC* lsc_criar();
+int lsc_inserir(ListaSaltosC*, int);
+int lsc_remover_chave(ListaSaltosC*, int);
+int lsc_buscar(ListaSaltosC*, int);
+void lsc_destruir(ListaSaltosC*);
+
+/* B-tree sequencial */
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+int b_remover_chave(ArvoreB*, int);
+int b_buscar_chave(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+
+typedef struct {
+    int concorrente;    /* 1 = ArvoreBC, 2 = ListaSaltosC, 0 = ArvoreB + mutex global */
+    void* arvore;
+    int ops;
+    int pct_leitura;
+    unsigned semente;
+} Tarefa;
+
+static pthread_mutex_t MUTEX_GLOBAL = PTHREAD_MUTEX_INITIALIZER;
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* trabalhador(void* arg) {
+    Tarefa* tf = (Tarefa*) arg;
+    unsigned s = tf->semente;
+    for (int i = 0; i < tf->ops; i++) {
+        int k = (int)(rand_r(&s) % UNIVERSO) + 1;
+        int r = (int)(rand_r(&s) % 100);
+        if (tf->concorrente == 1) {
+            ArvoreBC* a = (ArvoreBC*) tf->arvore;
+            if (r < tf->pct_leitura) bc_buscar(a, k);
+            else if (r % 2 == 0) bc_inserir(a, k);
+            else bc_remover_chave(a, k);
+        } else if (tf->concorrente == 2) {
+            ListaSaltosC* l = (ListaSaltosC*) tf->arvore;
+            if (r < tf->pct_leitura) lsc_buscar(l, k);
+            else if (r % 2 == 0) lsc_inserir(l, k);
+            else lsc_remover_chave(l, k);
+        } else {
+            ArvoreB* a = (ArvoreB*) tf->arvore;
+            pthread_mutex_lock(&MUTEX_GLOBAL);
+            if (r < tf->pct_leitura) b_buscar_chave(a, k);
+            else if (r % 2 == 0) b_inserir(a, k);
+            else b_remover_chave(a, k);
+            pthread_mutex_unlock(&MUTEX_GLOBAL);
+        }
+    }
+    return NULL;
+}
+
+/* executa OPS_TOTAL operações com nthreads e devolve Mops/s */
+static double medir(int concorrente, void* arvore, int nthreads, int pct_leitura) {
+    pthread_t* th = malloc(sizeof(pthread_t) * nthreads);
+    Tarefa* tf = malloc(sizeof(Tarefa) * nthreads);
+    double t0 = agora();
+    for (int i = 0; i < nthreads; i++) {
+        tf[i].concorrente = concorrente;
+        tf[i].arvore = arvore;
+        tf[i].ops = OPS_TOTAL / nthreads;
+        tf[i].pct_leitura = pct_leitura;
+        tf[i].semente = 12345u + 7919u * (unsigned)i;
+        pthread_create(&th[i], NULL, trabalhador, &tf[i]);
+    }
+    for (int i = 0; i < nthreads; i++) pthread_join(th[i], NULL);
+    double dt = agora() - t0;
+    free(th);
+    free(tf);
+    return (OPS_TOTAL / nthreads) * (double) nthreads / dt / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    int max_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    int ordem = 16;
+    int pct_leitura = 80;
+    if (argc > 1) max_threads = atoi(argv[1]);
+    if (argc > 2) ordem = atoi(argv[2]);
+    if (argc > 3) pct_leitura = atoi(argv[3]);
+    if (max_threads < 1) max_threads = 1;
+
+    /* mesmas chaves iniciais para as três estruturas (a lista ignora repetidas) */
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * N_INICIAL);
+    for (int i = 0; i < N_INICIAL; i++) chaves[i] = rand() % UNIVERSO + 1;
+
+    FILE* f = fopen("resultados_concorrencia.csv", "w");
+    fprintf(f, "threads,bc_mops,lsc_mops,global_mops,bc_speedup,lsc_speedup\n");
+    printf("ordem=%d leitura=%d%% ops=%d\n", ordem, pct_leitura, OPS_TOTAL);
+    printf("%8s %12s %12s %12s %10s %10s\n", "threads", "bc Mops/s", "lsc Mops/s", "mutex Mops/s",
+           "bc speedup", "lsc speedup");
+
+    double base = 0, base_lsc = 0;
+    /* 1, 2, 4, ... e sempre max_threads no fim */
+    for (int nt = 1; nt <= max_threads; nt = (nt < max_threads && nt * 2 > max_threads) ? max_threads : nt * 2) {
+        ArvoreBC* bc = bc_criar(ordem);
+        ListaSaltosC* lsc = lsc_criar();
+        ArvoreB* b = b_criar(ordem);
+        for (int i = 0; i < N_INICIAL; i++) {
+            bc_inserir(bc, chaves[i]);
+            lsc_inserir(lsc, chaves[i]);
+            b_inserir(b, chaves[i]);
+        }
+
+        double m_bc = medir(1, bc, nt, pct_leitura);
+        double m_lsc = medir(2, lsc, nt, pct_leitura);
+        double m_gl = medir(0, b, nt, pct_leitura);
+        if (nt == 1) {
+            base = m_bc;
+            base_lsc = m_lsc;
+        }
+
+        printf("%8d %12.3f %12.3f %12.3f %10.2f %10.2f\n", nt, m_bc, m_lsc, m_gl, m_bc / base, m_lsc / base_lsc);
+        fprintf(f, "%d,%.4f,%.4f,%.4f,%.3f,%.3f\n", nt, m_bc, m_lsc, m_gl, m_bc / base, m_lsc / base_lsc);
+
+        bc_destruir(bc);
+        lsc_destruir(lsc);
+        b_remover_tudo(b);
+        free(b);
+    }
+
+    fclose(f);
+    free(chaves);
+    printf("\nArquivo gerado:\n - resultados_concorrencia.csv\n");
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+    Benchmark de buscas: árvores com ponteiros x índice congelado (Congelado_mod.c).
+    Para n = 10^3, 10^4, ..., N:
+      - monta AVL, Rubro-Negra e B-tree (t=16) com as mesmas n chaves
+      - congela cada uma (avl/rb/b_percorrer + cg_congelar) e mede o tempo
+      - faz B buscas (metade chaves presentes, metade aleatórias) em cada árvore
+        e no índice congelado
+    Para cada n: ns por busca, tempo de congelamento e visitas instrumentadas por busca.
+
+    Compile:
+    gcc bench_congelado.c Congelado_mod.c AVL_mod.c RubroNegra_mod.c B_mod.c -O2 -pthread -o bench_congelado
+
+    Uso:
+    ./bench_congelado [N] [buscas]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+int avl_buscar(Arvore1*, int);
+void avl_remover_tudo(Arvore1*);
+long avl_percorrer(Arvore1*, void (*)(int, int, void*), void*);
+long avl_get_insercao_and_reset();
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+int rb_buscar(ArvoreRB*, int);
+void rb_remover_tudo(ArvoreRB*);
+long rb_percorrer(ArvoreRB*, void (*)(int, int, void*), void*);
+long rb_get_insercao_and_reset();
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+int b_buscar_chave(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+long b_percorrer(ArvoreB*, void (*)(int, int, void*), void*);
+long b_get_insercao_and_reset();
+
+typedef struct Congelado Congelado;
+Congelado* cg_criar();
+void cg_coletar(int, int, void*);
+void cg_congelar(Congelado*);
+int cg_buscar(Congelado*, int);
+void cg_liberar(Congelado*);
+long cg_get_busca_and_reset();
+
+#define ORDEM_B 16
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    int N = 1000000;
+    int B = 1000000;
+    if (argc > 1) N = atoi(argv[1]);
+    if (argc > 2) B = atoi(argv[2]);
+    if (N < 1000) N = 1000;
+    if (B < 1) B = 1;
+
+    int* chaves = malloc(sizeof(int) * N);
+    int* consultas = malloc(sizeof(int) * B);
+
+    FILE* f = fopen("resultados_congelado.csv", "w");
+    fprintf(f, "n,avl_ns,rb_ns,b_ns,congelado_ns,congelar_avl_ms,congelar_rb_ms,congelar_b_ms,"
+               "visitas_avl,visitas_rb,visitas_b,visitas_congelado\n");
+    printf("buscas=%d ordem_b=%d\n", B, ORDEM_B);
+    printf("%9s %8s %8s %8s %8s | %9s %9s %9s | %6s %6s %6s %6s\n", "n",
+           "avl ns", "rb ns", "b ns", "cg ns", "cg avl", "cg rb", "cg b",
+           "v avl", "v rb", "v b", "v cg");
+
+    for (int n = 1000; n <= N; n *= 10) {
+        srand(12345);
+        for (int i = 0; i < n; i++) chaves[i] = rand();
+        for (int i = 0; i < B; i++) consultas[i] = (i & 1) ? rand() : chaves[rand() % n];
+
+        Arvore1* a = avl_criar();
+        ArvoreRB* r = rb_criar();
+        ArvoreB* b = b_criar(ORDEM_B);
+        for (int i = 0; i < n; i++) {
+            avl_inserir(a, chaves[i]);
+            rb_inserir(r, chaves[i]);
+            b_inserir(b, chaves[i]);
+        }
+
+        /* congelamento (o índice é o mesmo para as três; busca medida no da AVL) */
+        double t0 = agora();
+        Congelado* ca = cg_criar();
+        avl_percorrer(a, cg_coletar, ca);
+        cg_congelar(ca);
+        double cg_avl_ms = (agora() - t0) * 1000.0;
+
+        t0 = agora();
+        Congelado* cr = cg_criar();
+        rb_percorrer(r, cg_coletar, cr);
+        cg_congelar(cr);
+        double cg_rb_ms = (agora() - t0) * 1000.0;
+
+        t0 = agora();
+        Congelado* cb = cg_criar();
+        b_percorrer(b, cg_coletar, cb);
+        cg_congelar(cb);
+        double cg_b_ms = (agora() - t0) * 1000.0;
+
+        avl_get_insercao_and_reset();
+        rb_get_insercao_and_reset();
+        b_get_insercao_and_reset();
+        cg_get_busca_and_reset();
+
+        long achadas[4] = { 0, 0, 0, 0 };
+        t0 = agora();
+        for (int i = 0; i < B; i++) achadas[0] += avl_buscar(a, consultas[i]);
+        double avl_ns = (agora() - t0) * 1e9 / B;
+        t0 = agora();
+        for (int i = 0; i < B; i++) achadas[1] += rb_buscar(r, consultas[i]);
+        double rb_ns = (agora() - t0) * 1e9 / B;
+        t0 = agora();
+        for (int i = 0; i < B; i++) achadas[2] += b_buscar_chave(b, consultas[i]);
+        double b_ns = (agora() - t0) * 1e9 / B;
+        t0 = agora();
+        for (int i = 0; i < B; i++) achadas[3] += cg_buscar(ca, consultas[i]);
+        double cg_ns = (agora() - t0) * 1e9 / B;
+
+        if (achadas[0] != achadas[1] || achadas[0] != achadas[2] || achadas[0] != achadas[3])
+            printf("AVISO: buscas divergem (%ld %ld %ld %ld)\n", achadas[0], achadas[1], achadas[2], achadas[3]);
+
+        double v_avl = (double) avl_get_insercao_and_reset() / B;
+        double v_rb = (double) rb_get_insercao_and_reset() / B;
+        double v_b = (double) b_get_insercao_and_reset() / B;
+        double v_cg = (double) cg_get_busca_and_reset() / B;
+
+        printf("%9d %8.1f %8.1f %8.1f %8.1f | %9.2f %9.2f %9.2f | %6.1f %6.1f %6.1f %6.1f\n", n,
+               avl_ns, rb_ns, b_ns, cg_ns, cg_avl_ms, cg_rb_ms, cg_b_ms, v_avl, v_rb, v_b, v_cg);
+        fprintf(f, "%d,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%.3f,%.2f,%.2f,%.2f,%.2f\n", n,
+                avl_ns, rb_ns, b_ns, cg_ns, cg_avl_ms, cg_rb_ms, cg_b_ms, v_avl, v_rb, v_b, v_cg);
+
+        cg_liberar(ca);
+        cg_liberar(cr);
+        cg_liberar(cb);
+        avl_remover_tudo(a);
+        rb_remover_tudo(r);
+        b_remover_tudo(b);
+        free(a);
+        free(b);
+    }
+
+    fclose(f);
+    free(chaves);
+    free(consultas);
+    printf("\nArquivo gerado:\n - resultados_congelado.csv\n");
+    return 0;
+}
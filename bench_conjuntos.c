@@ -0,0 +1,202 @@
+/*
+    Benchmark de operações de conjunto por split/join (avl/rb_uniao, _intersecao,
+    _diferenca) contra o jeito de hoje: percorrer uma árvore e inserir/remover
+    chave a chave na outra.
+    a tem n chaves e b tem m chaves, aleatórias em [0, 2n) (parte se repete).
+    Para cada árvore:
+      - insercao:  a ∪ b inserindo cada ocorrência de b em a (*_percorrer + *_inserir)
+      - remocao:   a \ b removendo cada ocorrência de b de a (*_percorrer + *_remover_chave)
+      - uniao / intersecao / diferenca com 1, 2, 4, ... threads (*_definir_threads)
+    Para cada linha: tempo, speedup sobre a mesma operação com 1 thread e custo
+    instrumentado por chave de b.
+
+    Compile:
+    gcc bench_conjuntos.c AVL_mod.c RubroNegra_mod.c -O2 -pthread -o bench_conjuntos
+
+    Uso:
+    ./bench_conjuntos [n] [m] [max_threads]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+int avl_remover_chave(Arvore1*, int);
+void avl_inserir_lote(Arvore1*, const int*, int);
+long avl_remover_intervalo(Arvore1*, int, int);
+long avl_percorrer(Arvore1*, void (*)(int, int, void*), void*);
+void avl_uniao(Arvore1*, Arvore1*);
+void avl_intersecao(Arvore1*, Arvore1*);
+void avl_diferenca(Arvore1*, Arvore1*);
+void avl_definir_threads(int);
+long avl_get_insercao_and_reset();
+long avl_get_remocao_and_reset();
+long avl_get_conjunto_and_reset();
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+int rb_remover_chave(ArvoreRB*, int);
+void rb_inserir_lote(ArvoreRB*, const int*, int);
+void rb_remover_tudo(ArvoreRB*);
+long rb_percorrer(ArvoreRB*, void (*)(int, int, void*), void*);
+void rb_uniao(ArvoreRB*, ArvoreRB*);
+void rb_intersecao(ArvoreRB*, ArvoreRB*);
+void rb_diferenca(ArvoreRB*, ArvoreRB*);
+void rb_definir_threads(int);
+long rb_get_insercao_and_reset();
+long rb_get_remocao_and_reset();
+long rb_get_conjunto_and_reset();
+
+/* uma árvore vista pelo benchmark */
+typedef struct {
+    const char* nome;
+    void* (*criar)(void);
+    void (*inserir_lote)(void*, const int*, int);
+    void (*destruir)(void*);
+    long (*percorrer)(void*, void (*)(int, int, void*), void*);
+    void (*inserir)(void*, int);
+    int (*remover)(void*, int);
+    void (*conjunto[3])(void*, void*);
+    void (*threads)(int);
+    long (*ops_insercao)(void);
+    long (*ops_remocao)(void);
+    long (*ops_conjunto)(void);
+} Alvo;
+
+static void* criar_avl(void) { return avl_criar(); }
+static void lote_avl(void* a, const int* v, int n) { avl_inserir_lote(a, v, n); }
+static void destruir_avl(void* a) { avl_remover_intervalo(a, INT_MIN, INT_MAX); free(a); }
+static long percorrer_avl(void* a, void (*cb)(int, int, void*), void* ctx) { return avl_percorrer(a, cb, ctx); }
+static void ins_avl(void* a, int k) { avl_inserir(a, k); }
+static int rem_avl(void* a, int k) { return avl_remover_chave(a, k); }
+static void uniao_avl(void* a, void* b) { avl_uniao(a, b); }
+static void intersecao_avl(void* a, void* b) { avl_intersecao(a, b); }
+static void diferenca_avl(void* a, void* b) { avl_diferenca(a, b); }
+
+static void* criar_rb(void) { return rb_criar(); }
+static void lote_rb(void* a, const int* v, int n) { rb_inserir_lote(a, v, n); }
+static void destruir_rb(void* a) { rb_remover_tudo(a); }
+static long percorrer_rb(void* a, void (*cb)(int, int, void*), void* ctx) { return rb_percorrer(a, cb, ctx); }
+static void ins_rb(void* a, int k) { rb_inserir(a, k); }
+static int rem_rb(void* a, int k) { return rb_remover_chave(a, k); }
+static void uniao_rb(void* a, void* b) { rb_uniao(a, b); }
+static void intersecao_rb(void* a, void* b) { rb_intersecao(a, b); }
+static void diferenca_rb(void* a, void* b) { rb_diferenca(a, b); }
+
+/* chave a chave: o callback de *_percorrer aplica a operação no destino */
+typedef struct {
+    Alvo* alvo;
+    void* destino;
+} Aplicar;
+
+static void inserir_cb(int valor, int quantidade, void* ctx) {
+    Aplicar* p = (Aplicar*) ctx;
+    for (int i = 0; i < quantidade; i++) p->alvo->inserir(p->destino, valor);
+}
+
+static void remover_cb(int valor, int quantidade, void* ctx) {
+    Aplicar* p = (Aplicar*) ctx;
+    for (int i = 0; i < quantidade; i++) p->alvo->remover(p->destino, valor);
+}
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void linha(FILE* f, const char* arvore, const char* op, int threads, double ms, double speedup, double ops) {
+    printf("%-5s %-11s %7d %10.1f %8.2f %10.2f\n", arvore, op, threads, ms, speedup, ops);
+    fprintf(f, "%s,%s,%d,%.3f,%.3f,%.3f\n", arvore, op, threads, ms, speedup, ops);
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int m = 100000;
+    int max_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) m = atoi(argv[2]);
+    if (argc > 3) max_threads = atoi(argv[3]);
+    if (n < 1) n = 1;
+    if (m < 1) m = 1;
+    if (max_threads < 1) max_threads = 1;
+
+    Alvo alvos[] = {
+        { "avl", criar_avl, lote_avl, destruir_avl, percorrer_avl, ins_avl, rem_avl,
+          { uniao_avl, intersecao_avl, diferenca_avl }, avl_definir_threads,
+          avl_get_insercao_and_reset, avl_get_remocao_and_reset, avl_get_conjunto_and_reset },
+        { "rb", criar_rb, lote_rb, destruir_rb, percorrer_rb, ins_rb, rem_rb,
+          { uniao_rb, intersecao_rb, diferenca_rb }, rb_definir_threads,
+          rb_get_insercao_and_reset, rb_get_remocao_and_reset, rb_get_conjunto_and_reset },
+    };
+    const char* nomes[3] = { "uniao", "intersecao", "diferenca" };
+
+    srand(12345);
+    int* va = malloc(sizeof(int) * n);
+    int* vb = malloc(sizeof(int) * m);
+    for (int i = 0; i < n; i++) va[i] = rand() % (2 * n);
+    for (int i = 0; i < m; i++) vb[i] = rand() % (2 * n);
+
+    FILE* f = fopen("resultados_conjuntos.csv", "w");
+    fprintf(f, "arvore,operacao,threads,tempo_ms,speedup,ops_por_chave_b\n");
+    printf("n=%d m=%d max_threads=%d\n", n, m, max_threads);
+    printf("%-5s %-11s %7s %10s %8s %10s\n", "arv", "operacao", "threads", "ms", "speedup", "ops/chave");
+
+    for (int x = 0; x < 2; x++) {
+        Alvo* t = &alvos[x];
+
+        /* chave a chave */
+        for (int remover = 0; remover <= 1; remover++) {
+            void* a = t->criar();
+            void* b = t->criar();
+            t->inserir_lote(a, va, n);
+            t->inserir_lote(b, vb, m);
+            Aplicar p = { t, a };
+            t->ops_insercao();
+            t->ops_remocao();
+            double t0 = agora();
+            t->percorrer(b, remover ? remover_cb : inserir_cb, &p);
+            double ms = (agora() - t0) * 1000.0;
+            long ops = remover ? t->ops_remocao() : t->ops_insercao();
+            linha(f, t->nome, remover ? "remocao" : "insercao", 1, ms, 1.0, (double) ops / m);
+            t->destruir(a);
+            t->destruir(b);
+        }
+
+        /* split/join */
+        for (int op = 0; op < 3; op++) {
+            double ms1 = 0;
+            for (int th = 1; th <= max_threads; th *= 2) {
+                void* a = t->criar();
+                void* b = t->criar();
+                t->inserir_lote(a, va, n);
+                t->inserir_lote(b, vb, m);
+                t->threads(th);
+                t->ops_conjunto();
+                double t0 = agora();
+                t->conjunto[op](a, b);
+                double ms = (agora() - t0) * 1000.0;
+                long ops = t->ops_conjunto();
+                if (th == 1) ms1 = ms;
+                linha(f, t->nome, nomes[op], th, ms, ms > 0 ? ms1 / ms : 0, (double) ops / m);
+                t->threads(1);
+                t->destruir(a);
+                t->destruir(b);
+            }
+        }
+    }
+
+    fclose(f);
+    free(va);
+    free(vb);
+    printf("\nArquivo gerado:\n - resultados_conjuntos.csv\n");
+    return 0;
+}
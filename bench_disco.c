@@ -0,0 +1,110 @@
+/*
+    Benchmark da B-tree em disco (BDisco_mod.c).
+    Fases:
+      - construcao: n inserções num arquivo novo (pool de q quadros de 4 KiB)
+      - reabertura: fecha, reabre o arquivo e faz n/10 buscas (reinício sem
+                    reconstrução)
+      - reconstrucao_memoria: o que o reinício custaria sem persistência —
+                    reinserir as n chaves na B_mod.c com o mesmo t
+    Para cada fase: tempo, páginas lidas/escritas e custo instrumentado por operação.
+
+    Compile:
+    gcc bench_disco.c BDisco_mod.c B_mod.c -O2 -pthread -o bench_disco
+
+    Uso:
+    ./bench_disco [arquivo] [n] [quadros]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* B-tree em disco */
+typedef struct ArvoreBD ArvoreBD;
+ArvoreBD* bd_abrir(const char*, int);
+void bd_fechar(ArvoreBD*);
+void bd_inserir(ArvoreBD*, int);
+int bd_buscar(ArvoreBD*, int);
+void bd_remover_tudo(ArvoreBD*);
+int bd_ordem(ArvoreBD*);
+long bd_get_leituras();
+long bd_get_escritas();
+long bd_get_insercao_and_reset();
+
+/* B-tree em memória */
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+long b_get_insercao_and_reset();
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void linha(FILE* f, const char* fase, double ms, long leituras, long escritas, double ops) {
+    printf("%-22s %10.1f %10ld %10ld %12.1f\n", fase, ms, leituras, escritas, ops);
+    fprintf(f, "%s,%.3f,%ld,%ld,%.2f\n", fase, ms, leituras, escritas, ops);
+}
+
+int main(int argc, char **argv)
+{
+    const char* arquivo = "arvore.bd";
+    int n = 1000000;
+    int quadros = 256;
+    if (argc > 1) arquivo = argv[1];
+    if (argc > 2) n = atoi(argv[2]);
+    if (argc > 3) quadros = atoi(argv[3]);
+    if (n < 1) n = 1;
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) chaves[i] = rand();
+
+    FILE* f = fopen("resultados_disco.csv", "w");
+    fprintf(f, "fase,tempo_ms,leituras,escritas,ops_por_operacao\n");
+
+    ArvoreBD* a = bd_abrir(arquivo, quadros);
+    if (!a) return 1;
+    bd_remover_tudo(a);
+    int t = bd_ordem(a);
+    printf("arquivo=%s n=%d quadros=%d (%d KiB) t=%d\n", arquivo, n, quadros, quadros * 4, t);
+    printf("%-22s %10s %10s %10s %12s\n", "fase", "ms", "leituras", "escritas", "ops/op");
+
+    bd_get_insercao_and_reset();
+    double t0 = agora();
+    for (int i = 0; i < n; i++) bd_inserir(a, chaves[i]);
+    bd_fechar(a);
+    double ms = (agora() - t0) * 1000.0;
+    long lidas = bd_get_leituras(), escritas = bd_get_escritas();
+    linha(f, "construcao", ms, lidas, escritas, (double) bd_get_insercao_and_reset() / n);
+
+    int buscas = n / 10 > 0 ? n / 10 : 1;
+    long achadas = 0;
+    t0 = agora();
+    a = bd_abrir(arquivo, quadros);
+    if (!a) return 1;
+    for (int i = 0; i < buscas; i++) achadas += bd_buscar(a, chaves[(i * 10) % n]);
+    ms = (agora() - t0) * 1000.0;
+    lidas = bd_get_leituras(); escritas = bd_get_escritas();
+    linha(f, "reabertura", ms, lidas, escritas, (double) bd_get_insercao_and_reset() / buscas);
+    if (achadas != buscas) printf("AVISO: %ld de %d chaves encontradas após reabrir\n", achadas, buscas);
+    bd_fechar(a);
+
+    b_get_insercao_and_reset();
+    t0 = agora();
+    ArvoreB* b = b_criar(t);
+    for (int i = 0; i < n; i++) b_inserir(b, chaves[i]);
+    ms = (agora() - t0) * 1000.0;
+    linha(f, "reconstrucao_memoria", ms, 0, 0, (double) b_get_insercao_and_reset() / n);
+    b_remover_tudo(b);
+    free(b);
+
+    fclose(f);
+    free(chaves);
+    printf("\nArquivo gerado:\n - resultados_disco.csv\n");
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*
+    Benchmark de remoção de intervalo (avl/rb/b_remover_intervalo).
+    As n chaves 0..n-1 (ex.: timestamps) são inseridas em ordem aleatória e depois
+    removidas em faixas contíguas [c*k, c*k + k - 1], com as faixas em ordem
+    aleatória, até esvaziar a árvore. Para cada árvore e cada k (1, 16, 256, ... <= kmax):
+      - unitario:  *_remover_chave para cada chave da faixa
+      - intervalo: uma chamada de *_remover_intervalo por faixa (split/join na
+                   AVL/RB; descarte de subárvores inteiras + reparo das fronteiras na B)
+    Para cada modo: tempo e custo instrumentado por chave removida e tempo por faixa.
+
+    Compile:
+    gcc bench_intervalo.c AVL_mod.c RubroNegra_mod.c B_mod.c -O2 -pthread -o bench_intervalo
+
+    Uso:
+    ./bench_intervalo [n] [kmax]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+int avl_remover_chave(Arvore1*, int);
+long avl_remover_intervalo(Arvore1*, int, int);
+long avl_get_insercao_and_reset();
+long avl_get_remocao_and_reset();
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+int rb_remover_chave(ArvoreRB*, int);
+long rb_remover_intervalo(ArvoreRB*, int, int);
+void rb_remover_tudo(ArvoreRB*);
+long rb_get_insercao_and_reset();
+long rb_get_remocao_and_reset();
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+int b_remover_chave(ArvoreB*, int);
+long b_remover_intervalo(ArvoreB*, int, int);
+void b_remover_tudo(ArvoreB*);
+long b_get_insercao_and_reset();
+long b_get_remocao_and_reset();
+
+#define ORDEM_B 16
+
+/* uma árvore vista pelo benchmark */
+typedef struct {
+    const char* nome;
+    void* (*criar)(void);
+    void (*inserir)(void*, int);
+    int (*remover)(void*, int);
+    long (*remover_intervalo)(void*, int, int);
+    void (*destruir)(void*);
+    long (*ops_insercao)(void);
+    long (*ops_remocao)(void);
+} Alvo;
+
+static void* criar_avl(void) { return avl_criar(); }
+static void ins_avl(void* a, int k) { avl_inserir(a, k); }
+static int rem_avl(void* a, int k) { return avl_remover_chave(a, k); }
+static long int_avl(void* a, int lo, int hi) { return avl_remover_intervalo(a, lo, hi); }
+static void destruir_avl(void* a) { free(a); }
+static long ops_ins_avl(void) { return avl_get_insercao_and_reset(); }
+static long ops_rem_avl(void) { return avl_get_remocao_and_reset(); }
+
+static void* criar_rb(void) { return rb_criar(); }
+static void ins_rb(void* a, int k) { rb_inserir(a, k); }
+static int rem_rb(void* a, int k) { return rb_remover_chave(a, k); }
+static long int_rb(void* a, int lo, int hi) { return rb_remover_intervalo(a, lo, hi); }
+static void destruir_rb(void* a) { rb_remover_tudo(a); }
+static long ops_ins_rb(void) { return rb_get_insercao_and_reset(); }
+static long ops_rem_rb(void) { return rb_get_remocao_and_reset(); }
+
+static void* criar_b(void) { return b_criar(ORDEM_B); }
+static void ins_b(void* a, int k) { b_inserir(a, k); }
+static int rem_b(void* a, int k) { return b_remover_chave(a, k); }
+static long int_b(void* a, int lo, int hi) { return b_remover_intervalo(a, lo, hi); }
+static void destruir_b(void* a) { b_remover_tudo(a); free(a); }
+static long ops_ins_b(void) { return b_get_insercao_and_reset(); }
+static long ops_rem_b(void) { return b_get_remocao_and_reset(); }
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void embaralhar(int* v, int n) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1), tmp = v[i];
+        v[i] = v[j]; v[j] = tmp;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int n = 500000;
+    int kmax = 65536;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) kmax = atoi(argv[2]);
+    if (n < 1) n = 1;
+    if (kmax < 1) kmax = 1;
+
+    Alvo alvos[] = {
+        { "avl", criar_avl, ins_avl, rem_avl, int_avl, destruir_avl, ops_ins_avl, ops_rem_avl },
+        { "rb",  criar_rb,  ins_rb,  rem_rb,  int_rb,  destruir_rb,  ops_ins_rb,  ops_rem_rb },
+        { "b",   criar_b,   ins_b,   rem_b,   int_b,   destruir_b,   ops_ins_b,   ops_rem_b },
+    };
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) chaves[i] = i;
+    embaralhar(chaves, n);
+    int* faixas = malloc(sizeof(int) * n);
+
+    FILE* f = fopen("resultados_intervalo.csv", "w");
+    fprintf(f, "arvore,k,modo,ns_por_chave,ops_por_chave,us_por_faixa\n");
+    printf("n=%d kmax=%d ordem_b=%d\n", n, kmax, ORDEM_B);
+    printf("%-5s %7s %-9s %10s %10s %12s\n", "arv", "k", "modo", "ns/chave", "ops/chave", "us/faixa");
+
+    for (int a = 0; a < 3; a++) {
+        Alvo* x = &alvos[a];
+        for (long k = 1; k <= kmax && k <= n; k *= 16) {
+            int nf = (int) ((n + k - 1) / k);
+            for (int c = 0; c < nf; c++) faixas[c] = c;
+            embaralhar(faixas, nf);
+
+            for (int intervalo = 0; intervalo <= 1; intervalo++) {
+                void* arv = x->criar();
+                for (int i = 0; i < n; i++) x->inserir(arv, chaves[i]);
+                x->ops_insercao();
+
+                long removidas = 0;
+                double t0 = agora();
+                for (int c = 0; c < nf; c++) {
+                    int lo = (int) (faixas[c] * k);
+                    int hi = (int) (lo + k - 1);
+                    if (intervalo) removidas += x->remover_intervalo(arv, lo, hi);
+                    else for (int q = lo; q <= hi && q < n; q++) removidas += x->remover(arv, q);
+                }
+                double seg = agora() - t0;
+                double ops = (double) x->ops_remocao() / n;
+                if (removidas != n) printf("AVISO: %s removeu %ld de %d\n", x->nome, removidas, n);
+
+                const char* modo = intervalo ? "intervalo" : "unitario";
+                double ns = seg * 1e9 / n, us = seg * 1e6 / nf;
+                printf("%-5s %7ld %-9s %10.1f %10.2f %12.2f\n", x->nome, k, modo, ns, ops, us);
+                fprintf(f, "%s,%ld,%s,%.2f,%.3f,%.3f\n", x->nome, k, modo, ns, ops, us);
+                x->destruir(arv);
+            }
+        }
+    }
+
+    fclose(f);
+    free(chaves);
+    free(faixas);
+    printf("\nArquivo gerado:\n - resultados_intervalo.csv\n");
+    return 0;
+}
@@ -0,0 +1,238 @@
+/*
+    Benchmark de escalabilidade de leitura: 1 escritor com taxa fixa de inserções
+    e de 1 a N leitores fazendo buscas. Compara as árvores com leitores sem trava
+    (MapaConcorrente_mod.c) com AVL_mod.c / RubroNegra_mod.c atrás de um mutex global.
+
+    Compile:
+    gcc bench_leitores.c MapaConcorrente_mod.c AVL_mod.c RubroNegra_mod.c -O2 -pthread -o bench_leitores
+
+    Uso:
+    ./bench_leitores [max_leitores] [insercoes_por_segundo] [duracao_ms]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+/* --------------------------------------------------
+   PARÂMETROS DO EXPERIMENTO
+   -------------------------------------------------- */
+#define N_INICIAL 200000
+#define UNIVERSO  (4 * N_INICIAL)
+
+/* leitores sem trava */
+typedef struct arvoreCAVL ArvoreCAVL;
+ArvoreCAVL* cavl_criar();
+void cavl_inserir(ArvoreCAVL*, int);
+int cavl_buscar(ArvoreCAVL*, int);
+void cavl_destruir(ArvoreCAVL*);
+
+typedef struct arvoreCRB ArvoreCRB;
+ArvoreCRB* crb_criar();
+void crb_inserir(ArvoreCRB*, int);
+int crb_buscar(ArvoreCRB*, int);
+void crb_destruir(ArvoreCRB*);
+
+/* AVL / RB sequenciais */
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+int avl_buscar(Arvore1*, int);
+void avl_remover_tudo(Arvore1*);
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+int rb_buscar(ArvoreRB*, int);
+void rb_remover_tudo(ArvoreRB*);
+
+enum { CAVL, CRB, AVL_MUTEX, RB_MUTEX, N_ESTRUTURAS };
+static const char* NOMES[N_ESTRUTURAS] = { "cavl", "crb", "avl_mutex", "rb_mutex" };
+
+static pthread_mutex_t MUTEX_GLOBAL = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int PARAR;
+
+typedef struct {
+    int estrutura;
+    void* arvore;
+    unsigned semente;
+    long ops;
+    long achados;       /* só leitores (mantém as buscas vivas) */
+    int taxa;           /* só escritor */
+} Tarefa;
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void inserir(int e, void* a, int k) {
+    switch (e) {
+    case CAVL: cavl_inserir((ArvoreCAVL*) a, k); break;
+    case CRB:  crb_inserir((ArvoreCRB*) a, k); break;
+    case AVL_MUTEX:
+        pthread_mutex_lock(&MUTEX_GLOBAL);
+        avl_inserir((Arvore1*) a, k);
+        pthread_mutex_unlock(&MUTEX_GLOBAL);
+        break;
+    case RB_MUTEX:
+        pthread_mutex_lock(&MUTEX_GLOBAL);
+        rb_inserir((ArvoreRB*) a, k);
+        pthread_mutex_unlock(&MUTEX_GLOBAL);
+        break;
+    }
+}
+
+static int buscar(int e, void* a, int k) {
+    int r = 0;
+    switch (e) {
+    case CAVL: r = cavl_buscar((ArvoreCAVL*) a, k); break;
+    case CRB:  r = crb_buscar((ArvoreCRB*) a, k); break;
+    case AVL_MUTEX:
+        pthread_mutex_lock(&MUTEX_GLOBAL);
+        r = avl_buscar((Arvore1*) a, k);
+        pthread_mutex_unlock(&MUTEX_GLOBAL);
+        break;
+    case RB_MUTEX:
+        pthread_mutex_lock(&MUTEX_GLOBAL);
+        r = rb_buscar((ArvoreRB*) a, k);
+        pthread_mutex_unlock(&MUTEX_GLOBAL);
+        break;
+    }
+    return r;
+}
+
+static void* leitor(void* arg) {
+    Tarefa* tf = (Tarefa*) arg;
+    unsigned s = tf->semente;
+    long ops = 0, achados = 0;
+    while (!atomic_load_explicit(&PARAR, memory_order_relaxed)) {
+        for (int i = 0; i < 64; i++) {
+            achados += buscar(tf->estrutura, tf->arvore, (int)(rand_r(&s) % UNIVERSO) + 1);
+        }
+        ops += 64;
+    }
+    tf->ops = ops;
+    tf->achados = achados;
+    return NULL;
+}
+
+/* escritor em ritmo constante: lotes de 100 inserções, dormindo até o horário previsto */
+static void* escritor(void* arg) {
+    Tarefa* tf = (Tarefa*) arg;
+    unsigned s = tf->semente;
+    double t0 = agora();
+    long ops = 0;
+    while (!atomic_load_explicit(&PARAR, memory_order_relaxed)) {
+        for (int i = 0; i < 100; i++) inserir(tf->estrutura, tf->arvore, (int)(rand_r(&s) % UNIVERSO) + 1);
+        ops += 100;
+        double previsto = t0 + (double) ops / tf->taxa;
+        double falta = previsto - agora();
+        if (falta > 0) {
+            struct timespec ts = { (time_t) falta, (long)((falta - (time_t) falta) * 1e9) };
+            nanosleep(&ts, NULL);
+        }
+    }
+    tf->ops = ops;
+    return NULL;
+}
+
+static void* criar(int e, const int* chaves) {
+    void* a = NULL;
+    switch (e) {
+    case CAVL: a = cavl_criar(); break;
+    case CRB:  a = crb_criar(); break;
+    case AVL_MUTEX: a = avl_criar(); break;
+    case RB_MUTEX:  a = rb_criar(); break;
+    }
+    for (int i = 0; i < N_INICIAL; i++) inserir(e, a, chaves[i]);
+    return a;
+}
+
+static void destruir(int e, void* a) {
+    switch (e) {
+    case CAVL: cavl_destruir((ArvoreCAVL*) a); break;
+    case CRB:  crb_destruir((ArvoreCRB*) a); break;
+    case AVL_MUTEX: avl_remover_tudo((Arvore1*) a); free(a); break;
+    case RB_MUTEX:  rb_remover_tudo((ArvoreRB*) a); free(a); break;
+    }
+}
+
+/* devolve leituras por segundo (milhões) com nl leitores e o escritor ativo */
+static double medir(int e, void* a, int nl, int taxa, int duracao_ms) {
+    pthread_t* th = malloc(sizeof(pthread_t) * (nl + 1));
+    Tarefa* tf = malloc(sizeof(Tarefa) * (nl + 1));
+    atomic_store(&PARAR, 0);
+
+    tf[nl].estrutura = e; tf[nl].arvore = a; tf[nl].semente = 99991u; tf[nl].taxa = taxa;
+    pthread_create(&th[nl], NULL, escritor, &tf[nl]);
+    double t0 = agora();
+    for (int i = 0; i < nl; i++) {
+        tf[i].estrutura = e; tf[i].arvore = a; tf[i].semente = 12345u + 7919u * (unsigned) i;
+        pthread_create(&th[i], NULL, leitor, &tf[i]);
+    }
+    struct timespec ts = { duracao_ms / 1000, (duracao_ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+    atomic_store(&PARAR, 1);
+
+    long leituras = 0;
+    for (int i = 0; i < nl; i++) {
+        pthread_join(th[i], NULL);
+        leituras += tf[i].ops;
+    }
+    double dt = agora() - t0;
+    pthread_join(th[nl], NULL);
+    free(th);
+    free(tf);
+    return leituras / dt / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    int max_leitores = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    int taxa = 20000;
+    int duracao_ms = 1000;
+    if (argc > 1) max_leitores = atoi(argv[1]);
+    if (argc > 2) taxa = atoi(argv[2]);
+    if (argc > 3) duracao_ms = atoi(argv[3]);
+    if (max_leitores < 1) max_leitores = 1;
+    if (taxa < 1) taxa = 1;
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * N_INICIAL);
+    for (int i = 0; i < N_INICIAL; i++) chaves[i] = rand() % UNIVERSO + 1;
+
+    FILE* f = fopen("resultados_leitores.csv", "w");
+    fprintf(f, "leitores");
+    for (int e = 0; e < N_ESTRUTURAS; e++) fprintf(f, ",%s_mops", NOMES[e]);
+    fprintf(f, "\n");
+
+    printf("escritor=%d ins/s duracao=%dms\n%8s", taxa, duracao_ms, "leitores");
+    for (int e = 0; e < N_ESTRUTURAS; e++) printf(" %12s", NOMES[e]);
+    printf("   (Mleituras/s)\n");
+
+    for (int nl = 1; nl <= max_leitores; nl = (nl < max_leitores && nl * 2 > max_leitores) ? max_leitores : nl * 2) {
+        printf("%8d", nl);
+        fprintf(f, "%d", nl);
+        for (int e = 0; e < N_ESTRUTURAS; e++) {
+            void* a = criar(e, chaves);
+            double m = medir(e, a, nl, taxa, duracao_ms);
+            destruir(e, a);
+            printf(" %12.3f", m);
+            fprintf(f, ",%.4f", m);
+            fflush(stdout);
+        }
+        printf("\n");
+        fprintf(f, "\n");
+    }
+
+    fclose(f);
+    free(chaves);
+    printf("\nArquivo gerado:\n - resultados_leitores.csv\n");
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+    Benchmark de lotes ordenados (avl/rb/b_inserir_lote e *_remover_lote).
+    As n chaves chegam em blocos de L chaves, em ordem aleatória dentro do bloco.
+    padrao 0: chaves aleatórias em todo o universo; padrao 1: cada bloco cobre
+    uma faixa contígua (ex.: ingestão por intervalo de tempo). Para cada árvore:
+      - unitario: cada chave do bloco com *_inserir / *_remover_chave (parte da raiz)
+      - lote:     o bloco inteiro com *_inserir_lote / *_remover_lote (ordena e
+                  parte do dedo da chave anterior)
+    Para cada modo: tempo e custo instrumentado por chave, na inserção e na remoção.
+
+    Compile:
+    gcc bench_lote.c AVL_mod.c RubroNegra_mod.c B_mod.c -O2 -pthread -o bench_lote
+
+    Uso:
+    ./bench_lote [n] [bloco] [padrao]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+int avl_remover_chave(Arvore1*, int);
+void avl_inserir_lote(Arvore1*, const int*, int);
+int avl_remover_lote(Arvore1*, const int*, int);
+long avl_get_insercao_and_reset();
+long avl_get_remocao_and_reset();
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+int rb_remover_chave(ArvoreRB*, int);
+void rb_inserir_lote(ArvoreRB*, const int*, int);
+int rb_remover_lote(ArvoreRB*, const int*, int);
+long rb_get_insercao_and_reset();
+long rb_get_remocao_and_reset();
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_criar(int);
+void b_inserir(ArvoreB*, int);
+int b_remover_chave(ArvoreB*, int);
+void b_inserir_lote(ArvoreB*, const int*, int);
+int b_remover_lote(ArvoreB*, const int*, int);
+void b_remover_tudo(ArvoreB*);
+long b_get_insercao_and_reset();
+long b_get_remocao_and_reset();
+
+#define ORDEM_B 16
+
+/* uma árvore vista pelo benchmark: operações unitárias, em lote e contadores */
+typedef struct {
+    const char* nome;
+    void* (*criar)(void);
+    void (*inserir)(void*, int);
+    int (*remover)(void*, int);
+    void (*inserir_lote)(void*, const int*, int);
+    int (*remover_lote)(void*, const int*, int);
+    long (*ops_insercao)(void);
+    long (*ops_remocao)(void);
+} Alvo;
+
+static void* criar_avl(void) { return avl_criar(); }
+static void ins_avl(void* a, int k) { avl_inserir(a, k); }
+static int rem_avl(void* a, int k) { return avl_remover_chave(a, k); }
+static void ins_lote_avl(void* a, const int* v, int n) { avl_inserir_lote(a, v, n); }
+static int rem_lote_avl(void* a, const int* v, int n) { return avl_remover_lote(a, v, n); }
+static long ops_ins_avl(void) { return avl_get_insercao_and_reset(); }
+static long ops_rem_avl(void) { return avl_get_remocao_and_reset(); }
+
+static void* criar_rb(void) { return rb_criar(); }
+static void ins_rb(void* a, int k) { rb_inserir(a, k); }
+static int rem_rb(void* a, int k) { return rb_remover_chave(a, k); }
+static void ins_lote_rb(void* a, const int* v, int n) { rb_inserir_lote(a, v, n); }
+static int rem_lote_rb(void* a, const int* v, int n) { return rb_remover_lote(a, v, n); }
+static long ops_ins_rb(void) { return rb_get_insercao_and_reset(); }
+static long ops_rem_rb(void) { return rb_get_remocao_and_reset(); }
+
+static void* criar_b(void) { return b_criar(ORDEM_B); }
+static void ins_b(void* a, int k) { b_inserir(a, k); }
+static int rem_b(void* a, int k) { return b_remover_chave(a, k); }
+static void ins_lote_b(void* a, const int* v, int n) { b_inserir_lote(a, v, n); }
+static int rem_lote_b(void* a, const int* v, int n) { return b_remover_lote(a, v, n); }
+static long ops_ins_b(void) { return b_get_insercao_and_reset(); }
+static long ops_rem_b(void) { return b_get_remocao_and_reset(); }
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int L = 4096;
+    int padrao = 0;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) L = atoi(argv[2]);
+    if (argc > 3) padrao = atoi(argv[3]);
+    if (n < 1) n = 1;
+    if (L < 1) L = 1;
+
+    Alvo alvos[] = {
+        { "avl", criar_avl, ins_avl, rem_avl, ins_lote_avl, rem_lote_avl, ops_ins_avl, ops_rem_avl },
+        { "rb",  criar_rb,  ins_rb,  rem_rb,  ins_lote_rb,  rem_lote_rb,  ops_ins_rb,  ops_rem_rb },
+        { "b",   criar_b,   ins_b,   rem_b,   ins_lote_b,   rem_lote_b,   ops_ins_b,   ops_rem_b },
+    };
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * n);
+    if (padrao == 1) {
+        /* bloco b: faixa [b*3L, b*3L + 3L) em ordem embaralhada, blocos em ordem aleatória */
+        int blocos = (n + L - 1) / L;
+        int* ordem = malloc(sizeof(int) * blocos);
+        for (int b = 0; b < blocos; b++) ordem[b] = b;
+        for (int b = blocos - 1; b > 0; b--) {
+            int j = rand() % (b + 1), tmp = ordem[b];
+            ordem[b] = ordem[j]; ordem[j] = tmp;
+        }
+        for (int i = 0; i < n; i++) chaves[i] = ordem[i / L] * 3 * L + (i % L) * 3;
+        for (int i = 0; i < n; i += L) {
+            int m = (n - i < L) ? n - i : L;
+            for (int j = m - 1; j > 0; j--) {
+                int r = rand() % (j + 1), tmp = chaves[i + j];
+                chaves[i + j] = chaves[i + r]; chaves[i + r] = tmp;
+            }
+        }
+        free(ordem);
+    } else {
+        for (int i = 0; i < n; i++) chaves[i] = rand();
+    }
+
+    FILE* f = fopen("resultados_lote.csv", "w");
+    fprintf(f, "arvore,modo,ins_ns,ins_ops,rem_ns,rem_ops\n");
+    printf("n=%d bloco=%d padrao=%d ordem_b=%d\n", n, L, padrao, ORDEM_B);
+    printf("%-5s %-9s %10s %10s %10s %10s\n", "arv", "modo", "ins ns", "ins ops", "rem ns", "rem ops");
+
+    for (int a = 0; a < 3; a++) {
+        Alvo* x = &alvos[a];
+        for (int lote = 0; lote <= 1; lote++) {
+            void* arv = x->criar();
+            x->ops_insercao();
+
+            double t0 = agora();
+            for (int i = 0; i < n; i += L) {
+                int m = (n - i < L) ? n - i : L;
+                if (lote) x->inserir_lote(arv, chaves + i, m);
+                else for (int j = 0; j < m; j++) x->inserir(arv, chaves[i + j]);
+            }
+            double ins_ns = (agora() - t0) * 1e9 / n;
+            double ins_ops = (double) x->ops_insercao() / n;
+
+            long removidas = 0;
+            t0 = agora();
+            for (int i = 0; i < n; i += L) {
+                int m = (n - i < L) ? n - i : L;
+                if (lote) removidas += x->remover_lote(arv, chaves + i, m);
+                else for (int j = 0; j < m; j++) removidas += x->remover(arv, chaves[i + j]);
+            }
+            double rem_ns = (agora() - t0) * 1e9 / n;
+            double rem_ops = (double) x->ops_remocao() / n;
+            if (removidas != n) printf("AVISO: %s removeu %ld de %d\n", x->nome, removidas, n);
+
+            const char* modo = lote ? "lote" : "unitario";
+            printf("%-5s %-9s %10.1f %10.1f %10.1f %10.1f\n", x->nome, modo, ins_ns, ins_ops, rem_ns, rem_ops);
+            fprintf(f, "%s,%s,%.2f,%.2f,%.2f,%.2f\n", x->nome, modo, ins_ns, ins_ops, rem_ns, rem_ops);
+            /* AVL/RB já estão vazias; B-tree guarda uma raiz vazia */
+            if (a == 2) b_remover_tudo(arv);
+            free(arv);
+        }
+    }
+
+    fclose(f);
+    free(chaves);
+    printf("\nArquivo gerado:\n - resultados_lote.csv\n");
+    return 0;
+}
@@ -0,0 +1,196 @@
+/*
+    Benchmark dos mapas chave -> valor especializados (MapaTipado_mod.c).
+    n chaves distintas pseudoaleatórias de 64 bits; cada especialização usa a
+    mesma sequência (uint32: 32 bits baixos de uma permutação; texto: as 16
+    letras hexadecimais da chave de 64 bits). O valor é o índice da chave.
+    Para cada especialização e árvore (avl, rb, b):
+      - inserir: as n chaves na ordem gerada
+      - buscar:  as n chaves em outra ordem (o valor lido entra numa soma)
+      - remover: as n chaves nessa mesma ordem
+    Para cada operação: tempo e custo instrumentado por operação.
+    As medições são laços gerados por macro (uma chamada direta por operação),
+    para a busca não pagar uma chamada indireta a mais.
+
+    Compile:
+    gcc bench_mapa.c MapaTipado_mod.c -O2 -o bench_mapa
+
+    Uso:
+    ./bench_mapa [n] [ordem_b]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct { char c[16]; } ChaveTexto16;
+typedef struct { uint64_t v; } ValorMapa8;
+typedef struct { uint64_t v[2]; } ValorMapa16;
+
+#define MAPA_PROTOTIPOS(P, T, K, V) \
+    typedef struct T T; \
+    int P##_inserir(T*, K, V); \
+    V* P##_buscar(T*, K); \
+    int P##_remover(T*, K); \
+    long P##_tamanho(T*); \
+    void P##_destruir(T*); \
+    long P##_get_busca_and_reset(); \
+    long P##_get_insercao_and_reset(); \
+    long P##_get_remocao_and_reset();
+
+MAPA_PROTOTIPOS(mapa_u32_avl, MapaU32AVL, uint32_t, ValorMapa8)
+MAPA_PROTOTIPOS(mapa_u32_rb, MapaU32RB, uint32_t, ValorMapa8)
+MAPA_PROTOTIPOS(mapa_u32_b, MapaU32B, uint32_t, ValorMapa8)
+MapaU32AVL* mapa_u32_avl_criar();
+MapaU32RB* mapa_u32_rb_criar();
+MapaU32B* mapa_u32_b_criar(int);
+
+MAPA_PROTOTIPOS(mapa_u64_avl, MapaU64AVL, uint64_t, ValorMapa8)
+MAPA_PROTOTIPOS(mapa_u64_rb, MapaU64RB, uint64_t, ValorMapa8)
+MAPA_PROTOTIPOS(mapa_u64_b, MapaU64B, uint64_t, ValorMapa8)
+MapaU64AVL* mapa_u64_avl_criar();
+MapaU64RB* mapa_u64_rb_criar();
+MapaU64B* mapa_u64_b_criar(int);
+
+MAPA_PROTOTIPOS(mapa_u64v16_avl, MapaU64V16AVL, uint64_t, ValorMapa16)
+MAPA_PROTOTIPOS(mapa_u64v16_rb, MapaU64V16RB, uint64_t, ValorMapa16)
+MAPA_PROTOTIPOS(mapa_u64v16_b, MapaU64V16B, uint64_t, ValorMapa16)
+MapaU64V16AVL* mapa_u64v16_avl_criar();
+MapaU64V16RB* mapa_u64v16_rb_criar();
+MapaU64V16B* mapa_u64v16_b_criar(int);
+
+MAPA_PROTOTIPOS(mapa_s16_avl, MapaS16AVL, ChaveTexto16, ValorMapa8)
+MAPA_PROTOTIPOS(mapa_s16_rb, MapaS16RB, ChaveTexto16, ValorMapa8)
+MAPA_PROTOTIPOS(mapa_s16_b, MapaS16B, ChaveTexto16, ValorMapa8)
+MapaS16AVL* mapa_s16_avl_criar();
+MapaS16RB* mapa_s16_rb_criar();
+MapaS16B* mapa_s16_b_criar(int);
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void linha(FILE* f, const char* esp, const char* arvore, const char* op, double ns, double ops) {
+    printf("%-12s %-5s %-8s %10.1f %10.1f\n", esp, arvore, op, ns, ops);
+    fprintf(f, "%s,%s,%s,%.2f,%.2f\n", esp, arvore, op, ns, ops);
+}
+
+/* mistura de 64 bits inversível (splitmix64): chaves distintas para i distintos */
+static uint64_t misturar(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/* inserir / buscar / remover para um mapa P (criado por CRIAR) sobre chaves[] */
+#define MAPA_MEDIR(P, T, K, V, CRIAR) \
+static void medir_##P(FILE* f, const char* esp, const char* arvore, int t, \
+                      const K* chaves, const int* ordem, int n) { \
+    (void) t; \
+    T* m = CRIAR; \
+    V v; \
+    memset(&v, 0, sizeof(v)); \
+    P##_get_insercao_and_reset(); \
+    double t0 = agora(); \
+    for (int i = 0; i < n; i++) { \
+        uint64_t x = (uint64_t) i; \
+        memcpy(&v, &x, sizeof(x)); \
+        P##_inserir(m, chaves[i], v); \
+    } \
+    double ns = (agora() - t0) * 1e9 / n; \
+    linha(f, esp, arvore, "inserir", ns, (double) P##_get_insercao_and_reset() / n); \
+    if (P##_tamanho(m) != n) fprintf(stderr, "%s/%s: tamanho %ld != %d\n", esp, arvore, P##_tamanho(m), n); \
+    uint64_t soma = 0; \
+    long faltas = 0; \
+    P##_get_busca_and_reset(); \
+    t0 = agora(); \
+    for (int i = 0; i < n; i++) { \
+        V* p = P##_buscar(m, chaves[ordem[i]]); \
+        if (p) { \
+            uint64_t x; \
+            memcpy(&x, p, sizeof(x)); \
+            soma += x; \
+        } else faltas++; \
+    } \
+    ns = (agora() - t0) * 1e9 / n; \
+    linha(f, esp, arvore, "buscar", ns, (double) P##_get_busca_and_reset() / n); \
+    if (faltas || soma != (uint64_t) n * (n - 1) / 2) \
+        fprintf(stderr, "%s/%s: busca inconsistente (%ld faltas)\n", esp, arvore, faltas); \
+    P##_get_remocao_and_reset(); \
+    t0 = agora(); \
+    for (int i = 0; i < n; i++) P##_remover(m, chaves[ordem[i]]); \
+    ns = (agora() - t0) * 1e9 / n; \
+    linha(f, esp, arvore, "remover", ns, (double) P##_get_remocao_and_reset() / n); \
+    P##_destruir(m); \
+}
+
+MAPA_MEDIR(mapa_u32_avl, MapaU32AVL, uint32_t, ValorMapa8, mapa_u32_avl_criar())
+MAPA_MEDIR(mapa_u32_rb, MapaU32RB, uint32_t, ValorMapa8, mapa_u32_rb_criar())
+MAPA_MEDIR(mapa_u32_b, MapaU32B, uint32_t, ValorMapa8, mapa_u32_b_criar(t))
+MAPA_MEDIR(mapa_u64_avl, MapaU64AVL, uint64_t, ValorMapa8, mapa_u64_avl_criar())
+MAPA_MEDIR(mapa_u64_rb, MapaU64RB, uint64_t, ValorMapa8, mapa_u64_rb_criar())
+MAPA_MEDIR(mapa_u64_b, MapaU64B, uint64_t, ValorMapa8, mapa_u64_b_criar(t))
+MAPA_MEDIR(mapa_u64v16_avl, MapaU64V16AVL, uint64_t, ValorMapa16, mapa_u64v16_avl_criar())
+MAPA_MEDIR(mapa_u64v16_rb, MapaU64V16RB, uint64_t, ValorMapa16, mapa_u64v16_rb_criar())
+MAPA_MEDIR(mapa_u64v16_b, MapaU64V16B, uint64_t, ValorMapa16, mapa_u64v16_b_criar(t))
+MAPA_MEDIR(mapa_s16_avl, MapaS16AVL, ChaveTexto16, ValorMapa8, mapa_s16_avl_criar())
+MAPA_MEDIR(mapa_s16_rb, MapaS16RB, ChaveTexto16, ValorMapa8, mapa_s16_rb_criar())
+MAPA_MEDIR(mapa_s16_b, MapaS16B, ChaveTexto16, ValorMapa8, mapa_s16_b_criar(t))
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int t = 16;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) t = atoi(argv[2]);
+    if (n < 1) n = 1;
+    if (t < 2) t = 2;
+
+    uint64_t* k64 = malloc(sizeof(uint64_t) * n);
+    uint32_t* k32 = malloc(sizeof(uint32_t) * n);
+    ChaveTexto16* ks = malloc(sizeof(ChaveTexto16) * n);
+    int* ordem = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) {
+        k64[i] = misturar((uint64_t) i);
+        k32[i] = (uint32_t) i * 2654435761u;   /* permutação de 32 bits */
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long) k64[i]);
+        memcpy(ks[i].c, buf, 16);
+        ordem[i] = i;
+    }
+    srand(12345);
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int) (((long long) rand() * RAND_MAX + rand()) % (i + 1));
+        int x = ordem[i]; ordem[i] = ordem[j]; ordem[j] = x;
+    }
+
+    FILE* f = fopen("resultados_mapa.csv", "w");
+    fprintf(f, "especializacao,arvore,operacao,ns_por_op,ops_por_op\n");
+    printf("n=%d ordem_b=%d\n", n, t);
+    printf("%-12s %-5s %-8s %10s %10s\n", "esp", "arv", "op", "ns", "ops");
+
+    medir_mapa_u32_avl(f, "u32_v8", "avl", t, k32, ordem, n);
+    medir_mapa_u32_rb(f, "u32_v8", "rb", t, k32, ordem, n);
+    medir_mapa_u32_b(f, "u32_v8", "b", t, k32, ordem, n);
+    medir_mapa_u64_avl(f, "u64_v8", "avl", t, k64, ordem, n);
+    medir_mapa_u64_rb(f, "u64_v8", "rb", t, k64, ordem, n);
+    medir_mapa_u64_b(f, "u64_v8", "b", t, k64, ordem, n);
+    medir_mapa_u64v16_avl(f, "u64_v16", "avl", t, k64, ordem, n);
+    medir_mapa_u64v16_rb(f, "u64_v16", "rb", t, k64, ordem, n);
+    medir_mapa_u64v16_b(f, "u64_v16", "b", t, k64, ordem, n);
+    medir_mapa_s16_avl(f, "s16_v8", "avl", t, ks, ordem, n);
+    medir_mapa_s16_rb(f, "s16_v8", "rb", t, ks, ordem, n);
+    medir_mapa_s16_b(f, "s16_v8", "b", t, ks, ordem, n);
+
+    fclose(f);
+    free(k64);
+    free(k32);
+    free(ks);
+    free(ordem);
+    printf("\nArquivo gerado:\n - resultados_mapa.csv\n");
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+    Benchmark de estatísticas de ordem (avl/rb_rank, _select, _contar_intervalo).
+    n chaves aleatórias em [0, n) (com repetições). Para cada árvore:
+      - insercao:  custo das n inserções e, à parte, das atualizações de tamanho
+      - rank / select / contar_intervalo: q consultas aleatórias (O(log n))
+      - percorrer: a mesma contagem de rank feita hoje, em ordem pela árvore
+        inteira (*_percorrer), em q/10000 consultas (O(n))
+    Para cada linha: tempo e custo instrumentado por operação, e atualizações
+    de tamanho por operação.
+    Sem -DAVL_TAMANHO=1 -DRB_TAMANHO=1 mede as consultas sem o aumento (O(n)).
+
+    Compile:
+    gcc bench_ordem.c AVL_mod.c RubroNegra_mod.c -O2 -pthread -DAVL_TAMANHO=1 -DRB_TAMANHO=1 -o bench_ordem
+
+    Uso:
+    ./bench_ordem [n] [consultas]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+long avl_rank(Arvore1*, int);
+int avl_select(Arvore1*, long, int*);
+long avl_contar_intervalo(Arvore1*, int, int);
+long avl_percorrer(Arvore1*, void (*)(int, int, void*), void*);
+void avl_remover_tudo(Arvore1*);
+long avl_get_insercao_and_reset();
+long avl_get_tamanho_and_reset();
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+long rb_rank(ArvoreRB*, int);
+int rb_select(ArvoreRB*, long, int*);
+long rb_contar_intervalo(ArvoreRB*, int, int);
+long rb_percorrer(ArvoreRB*, void (*)(int, int, void*), void*);
+void rb_remover_tudo(ArvoreRB*);
+long rb_get_insercao_and_reset();
+long rb_get_tamanho_and_reset();
+
+/* uma árvore vista pelo benchmark */
+typedef struct {
+    const char* nome;
+    void* (*criar)(void);
+    void (*inserir)(void*, int);
+    long (*rank)(void*, int);
+    int (*select)(void*, long, int*);
+    long (*contar)(void*, int, int);
+    long (*percorrer)(void*, void (*)(int, int, void*), void*);
+    void (*destruir)(void*);
+    long (*ops)(void);
+    long (*ops_tamanho)(void);
+} Alvo;
+
+static void* criar_avl(void) { return avl_criar(); }
+static void ins_avl(void* a, int k) { avl_inserir(a, k); }
+static long rank_avl(void* a, int k) { return avl_rank(a, k); }
+static int select_avl(void* a, long k, int* v) { return avl_select(a, k, v); }
+static long contar_avl(void* a, int lo, int hi) { return avl_contar_intervalo(a, lo, hi); }
+static long percorrer_avl(void* a, void (*cb)(int, int, void*), void* c) { return avl_percorrer(a, cb, c); }
+static void destruir_avl(void* a) { avl_remover_tudo(a); free(a); }
+
+static void* criar_rb(void) { return rb_criar(); }
+static void ins_rb(void* a, int k) { rb_inserir(a, k); }
+static long rank_rb(void* a, int k) { return rb_rank(a, k); }
+static int select_rb(void* a, long k, int* v) { return rb_select(a, k, v); }
+static long contar_rb(void* a, int lo, int hi) { return rb_contar_intervalo(a, lo, hi); }
+static long percorrer_rb(void* a, void (*cb)(int, int, void*), void* c) { return rb_percorrer(a, cb, c); }
+static void destruir_rb(void* a) { rb_remover_tudo(a); free(a); }
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void linha(FILE* f, const char* arvore, const char* operacao, double ns, double ops, double tam) {
+    printf("%-5s %-17s %12.1f %12.1f %10.2f\n", arvore, operacao, ns, ops, tam);
+    fprintf(f, "%s,%s,%.2f,%.2f,%.3f\n", arvore, operacao, ns, ops, tam);
+}
+
+typedef struct {
+    int chave;
+    long menores;
+} ContaRank;
+
+static void contar_menores(int valor, int quantidade, void* ctx) {
+    ContaRank* c = (ContaRank*) ctx;
+    if (valor < c->chave) c->menores += quantidade;
+}
+
+static volatile long sorvedouro;
+
+static void medir(FILE* f, const Alvo* a, const int* chaves, int n, const int* consultas, int q) {
+    void* t = a->criar();
+    a->ops(); a->ops_tamanho();
+    double t0 = agora();
+    for (int i = 0; i < n; i++) a->inserir(t, chaves[i]);
+    double ns = (agora() - t0) * 1e9 / n;
+    long tam = a->ops_tamanho();
+    linha(f, a->nome, "insercao", ns, (double) a->ops() / n, (double) tam / n);
+
+    long s = 0;
+    t0 = agora();
+    for (int i = 0; i < q; i++) s += a->rank(t, consultas[i]);
+    ns = (agora() - t0) * 1e9 / q;
+    linha(f, a->nome, "rank", ns, (double) a->ops() / q, (double) a->ops_tamanho() / q);
+
+    t0 = agora();
+    for (int i = 0; i < q; i++) {
+        int v = 0;
+        s += a->select(t, consultas[i], &v) ? v : 0;
+    }
+    ns = (agora() - t0) * 1e9 / q;
+    linha(f, a->nome, "select", ns, (double) a->ops() / q, (double) a->ops_tamanho() / q);
+
+    t0 = agora();
+    for (int i = 0; i < q; i++) s += a->contar(t, consultas[i], consultas[i] + n / 100);
+    ns = (agora() - t0) * 1e9 / q;
+    linha(f, a->nome, "contar_intervalo", ns, (double) a->ops() / q, (double) a->ops_tamanho() / q);
+
+    /* *_percorrer não é instrumentado: o custo é o número de nós visitados */
+    int qp = q / 10000 > 0 ? q / 10000 : 1;
+    long visitados = 0;
+    t0 = agora();
+    for (int i = 0; i < qp; i++) {
+        ContaRank c = { consultas[i], 0 };
+        visitados += a->percorrer(t, contar_menores, &c);
+        s += c.menores;
+    }
+    ns = (agora() - t0) * 1e9 / qp;
+    linha(f, a->nome, "percorrer", ns, (double) visitados / qp, 0);
+
+    sorvedouro = s;
+    a->destruir(t);
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int q = 1000000;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) q = atoi(argv[2]);
+    if (n < 1) n = 1;
+    if (q < 1) q = 1;
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) chaves[i] = rand() % n;
+    int* consultas = malloc(sizeof(int) * q);
+    for (int i = 0; i < q; i++) consultas[i] = rand() % n;
+
+    Alvo alvos[] = {
+        { "avl", criar_avl, ins_avl, rank_avl, select_avl, contar_avl, percorrer_avl, destruir_avl,
+          avl_get_insercao_and_reset, avl_get_tamanho_and_reset },
+        { "rb", criar_rb, ins_rb, rank_rb, select_rb, contar_rb, percorrer_rb, destruir_rb,
+          rb_get_insercao_and_reset, rb_get_tamanho_and_reset },
+    };
+
+    FILE* f = fopen("resultados_ordem.csv", "w");
+    fprintf(f, "arvore,operacao,ns_por_op,ops_por_op,tamanho_por_op\n");
+    printf("n=%d consultas=%d\n", n, q);
+    printf("%-5s %-17s %12s %12s %10s\n", "arv", "operacao", "ns", "ops", "tamanho");
+    for (int i = 0; i < 2; i++) medir(f, &alvos[i], chaves, n, consultas, q);
+
+    fclose(f);
+    free(chaves);
+    free(consultas);
+    printf("\nArquivo gerado:\n - resultados_ordem.csv\n");
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+    Benchmark da remoção preguiçosa da B-tree (b_definir_remocao_preguicosa).
+    Para cada ordem t em 1, 2, 3, 4, 8 e 16: carrega n chaves aleatórias
+    (b_carregar_paralelo, ocupação 0.7) e remove uma fração delas em ordem
+    aleatória, nos modos:
+      - normal:        b_remover_chave de sempre (redistribui/funde na descida)
+      - preg_<limiar>: remoção preguiçosa, reorganizando quando a ocupação
+                       estimada cai abaixo do limiar (0.2, 0.35, 0.5)
+    Para cada linha: tempo por remoção (com as reorganizações), custo
+    instrumentado da remoção, redistribuições/fusões, nós deixados abaixo do
+    mínimo e custo das reorganizações (tudo por remoção), ocupação final e
+    visitas por busca depois das remoções.
+
+    Compile:
+    gcc bench_preguicosa.c B_mod.c -O2 -pthread -o bench_preguicosa
+
+    Uso:
+    ./bench_preguicosa [n] [percentual_removido]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct ArvoreB ArvoreB;
+ArvoreB* b_carregar_paralelo(int, const int*, int, int, double);
+int b_remover_chave(ArvoreB*, int);
+int b_buscar_chave(ArvoreB*, int);
+void b_remover_tudo(ArvoreB*);
+double b_ocupacao(ArvoreB*);
+void b_definir_remocao_preguicosa(ArvoreB*, double);
+long b_get_insercao_and_reset();
+long b_get_remocao_and_reset();
+long b_get_rebalanceamento_and_reset();
+long b_get_adiados_and_reset();
+long b_get_reorganizacao_and_reset();
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int aleatorio(int limite) {
+    return (int) (((long long) rand() * RAND_MAX + rand()) % limite);
+}
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int pct = 50;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) pct = atoi(argv[2]);
+    if (n < 1) n = 1;
+    if (pct < 1) pct = 1;
+    if (pct > 100) pct = 100;
+    int r = (int) ((long long) n * pct / 100);
+    if (r < 1) r = 1;
+    int q = n < 100000 ? n : 100000;
+
+    const int ordens[] = { 1, 2, 3, 4, 8, 16 };
+    const double limiares[] = { 0, 0.2, 0.35, 0.5 };
+    int* chaves = malloc(sizeof(int) * n);
+    int* consultas = malloc(sizeof(int) * q);
+    srand(12345);
+    for (int i = 0; i < n; i++) chaves[i] = rand();
+    for (int i = n - 1; i > 0; i--) {
+        int j = aleatorio(i + 1);
+        int x = chaves[i]; chaves[i] = chaves[j]; chaves[j] = x;
+    }
+    for (int i = 0; i < q; i++) consultas[i] = (i & 1) ? rand() : chaves[aleatorio(n)];
+
+    FILE* f = fopen("resultados_preguicosa.csv", "w");
+    fprintf(f, "t,modo,ns_por_remocao,ops_por_remocao,rebalanceamentos,adiados,reorganizacao,"
+               "total_por_remocao,ocupacao_final,visitas_busca\n");
+    printf("n=%d removidas=%d (%d%%)\n", n, r, pct);
+    printf("%3s %-10s %9s %8s %7s %7s %8s %8s %6s %7s\n", "t", "modo", "ns", "ops", "rebal",
+           "adiad", "reorg", "total", "ocup", "v busca");
+
+    for (size_t o = 0; o < sizeof(ordens) / sizeof(ordens[0]); o++) {
+        int t = ordens[o];
+        for (size_t l = 0; l < sizeof(limiares) / sizeof(limiares[0]); l++) {
+            char modo[32];
+            if (limiares[l] > 0) snprintf(modo, sizeof(modo), "preg_%.2f", limiares[l]);
+            else snprintf(modo, sizeof(modo), "normal");
+
+            ArvoreB* b = b_carregar_paralelo(t, chaves, n, 1, 0.7);
+            b_definir_remocao_preguicosa(b, limiares[l]);
+            b_get_remocao_and_reset();
+            b_get_rebalanceamento_and_reset();
+            b_get_adiados_and_reset();
+            b_get_reorganizacao_and_reset();
+
+            double t0 = agora();
+            for (int i = 0; i < r; i++) b_remover_chave(b, chaves[i]);
+            double ns = (agora() - t0) * 1e9 / r;
+            double ops = (double) b_get_remocao_and_reset() / r;
+            double rebal = (double) b_get_rebalanceamento_and_reset() / r;
+            double adiados = (double) b_get_adiados_and_reset() / r;
+            double reorg = (double) b_get_reorganizacao_and_reset() / r;
+
+            b_get_insercao_and_reset();
+            for (int i = 0; i < q; i++) b_buscar_chave(b, consultas[i]);
+            double v_busca = (double) b_get_insercao_and_reset() / q;
+            double ocup = b_ocupacao(b);
+
+            printf("%3d %-10s %9.1f %8.1f %7.3f %7.3f %8.1f %8.1f %6.3f %7.1f\n", t, modo, ns, ops,
+                   rebal, adiados, reorg, ops + reorg, ocup, v_busca);
+            fprintf(f, "%d,%s,%.2f,%.2f,%.4f,%.4f,%.2f,%.2f,%.4f,%.2f\n", t, modo, ns, ops,
+                    rebal, adiados, reorg, ops + reorg, ocup, v_busca);
+
+            b_remover_tudo(b);
+            free(b);
+        }
+    }
+
+    fclose(f);
+    free(chaves);
+    free(consultas);
+    printf("\nArquivo gerado:\n - resultados_preguicosa.csv\n");
+    return 0;
+}
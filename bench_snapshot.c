@@ -0,0 +1,149 @@
+/*
+    Benchmark de snapshots da B-tree persistente (BPersistente_mod.c).
+    A cada rodada um leitor percorre uma versão fixa da árvore enquanto o
+    escritor continua com W escritas. Compara:
+      - cow:  bp_snapshot() O(1) + leitor em paralelo com as escritas
+      - dump: cópia completa das chaves para um vetor (backup atual), com as
+              escritas esperando o fim da cópia
+    Tempo medido: do início do snapshot/dump até o fim das W escritas (quanto o
+    escritor espera). Também o custo instrumentado por escrita com e sem snapshot
+    vivo, com as cópias de nós compartilhados (COPY) à parte.
+
+    Compile:
+    gcc bench_snapshot.c BPersistente_mod.c -O2 -pthread -o bench_snapshot
+
+    Uso:
+    ./bench_snapshot [n_inicial] [rodadas]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+typedef struct ArvoreBP ArvoreBP;
+typedef struct SnapshotBP SnapshotBP;
+ArvoreBP* bp_criar(int);
+void bp_inserir(ArvoreBP*, int);
+int bp_remover_chave(ArvoreBP*, int);
+void bp_destruir(ArvoreBP*);
+SnapshotBP* bp_snapshot(ArvoreBP*);
+long bp_snap_percorrer(SnapshotBP*, void (*)(int, void*), void*);
+void bp_snap_liberar(SnapshotBP*);
+long bp_get_copia();
+long bp_get_insercao_and_reset();
+long bp_get_remocao_and_reset();
+
+#define ORDEM 16
+#define W_MAX 100000   /* escritas por rodada: 10, 100, ..., W_MAX */
+
+typedef struct {
+    int* v;
+    long n;
+    int ordenado;
+} Dump;
+
+typedef struct {
+    SnapshotBP* s;
+    Dump d;
+} Leitura;
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void copiar_chave(int k, void* ctx) {
+    Dump* d = (Dump*) ctx;
+    if (d->n > 0 && d->v[d->n - 1] > k) d->ordenado = 0;
+    d->v[d->n++] = k;
+}
+
+static void* leitor(void* arg) {
+    Leitura* l = (Leitura*) arg;
+    bp_snap_percorrer(l->s, copiar_chave, &l->d);
+    return NULL;
+}
+
+/* W/2 inserções e W/2 remoções; acumula custo instrumentado e cópias */
+static void escrever(ArvoreBP* a, int w, int universo, unsigned* s, long* ops, long* copias) {
+    for (int i = 0; i < w / 2; i++) bp_inserir(a, (int)(rand_r(s) % universo) + 1);
+    *copias += bp_get_copia();
+    *ops += bp_get_insercao_and_reset();
+    for (int i = 0; i < w / 2; i++) bp_remover_chave(a, (int)(rand_r(s) % universo) + 1);
+    *copias += bp_get_copia();
+    *ops += bp_get_remocao_and_reset();
+}
+
+int main(int argc, char **argv)
+{
+    int n = 200000;
+    int rodadas = 20;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) rodadas = atoi(argv[2]);
+    if (n < 1) n = 1;
+    if (rodadas < 1) rodadas = 1;
+    int universo = 4 * n;
+
+    FILE* f = fopen("resultados_snapshot.csv", "w");
+    fprintf(f, "escritas,cow_ms,dump_ms,cow_copias,dump_copias,ops_escrita_base,ops_escrita_cow\n");
+    printf("n=%d ordem=%d rodadas=%d\n", n, ORDEM, rodadas);
+    printf("%9s %10s %10s %12s %12s %10s %10s\n",
+           "escritas", "cow ms", "dump ms", "cow copias", "dump copias", "ops/esc", "ops/esc cow");
+
+    /* a árvore cresce no máximo W/2 chaves por rodada (3 fases) */
+    int* vetor = malloc(sizeof(int) * ((size_t) n + (size_t)(2 * rodadas + 1) * (W_MAX / 2)));
+    for (int w = 10; w <= W_MAX; w *= 10) {
+        ArvoreBP* a = bp_criar(ORDEM);
+        unsigned s = 12345u;
+        for (int i = 0; i < n; i++) bp_inserir(a, (int)(rand_r(&s) % universo) + 1);
+        bp_get_insercao_and_reset();
+
+        /* custo base por escrita, sem snapshot vivo */
+        long base_ops = 0, base_copias = 0;
+        escrever(a, w, universo, &s, &base_ops, &base_copias);
+
+        /* cow: leitor percorre a versão fixa enquanto as escritas seguem */
+        long cow_ops = 0, cow_copias = 0;
+        double cow_ms = 0;
+        for (int r = 0; r < rodadas; r++) {
+            double t0 = agora();
+            Leitura l = { bp_snapshot(a), { vetor, 0, 1 } };
+            pthread_t th;
+            pthread_create(&th, NULL, leitor, &l);
+            escrever(a, w, universo, &s, &cow_ops, &cow_copias);
+            cow_ms += (agora() - t0) * 1000.0 / rodadas;
+            pthread_join(th, NULL);
+            if (!l.d.ordenado) printf("AVISO: snapshot inconsistente\n");
+            bp_snap_liberar(l.s);
+        }
+
+        /* dump: cópia completa antes de liberar as escritas */
+        long dump_copias = 0, dump_ops = 0, dump_cop_esc = 0;
+        double t0 = agora();
+        for (int r = 0; r < rodadas; r++) {
+            SnapshotBP* snap = bp_snapshot(a);
+            Dump d = { vetor, 0, 1 };
+            dump_copias += bp_snap_percorrer(snap, copiar_chave, &d);
+            bp_snap_liberar(snap);
+            escrever(a, w, universo, &s, &dump_ops, &dump_cop_esc);
+        }
+        double dump_ms = (agora() - t0) * 1000.0 / rodadas;
+
+        int esc = (w / 2) * 2;
+        printf("%9d %10.3f %10.3f %12.1f %12.1f %10.1f %10.1f\n", esc, cow_ms, dump_ms,
+               (double) cow_copias / rodadas, (double) dump_copias / rodadas,
+               (double) base_ops / esc, (double) cow_ops / ((double) esc * rodadas));
+        fprintf(f, "%d,%.4f,%.4f,%.1f,%.1f,%.2f,%.2f\n", esc, cow_ms, dump_ms,
+                (double) cow_copias / rodadas, (double) dump_copias / rodadas,
+                (double) base_ops / esc, (double) cow_ops / ((double) esc * rodadas));
+        bp_destruir(a);
+    }
+
+    free(vetor);
+    fclose(f);
+    printf("\nArquivo gerado:\n - resultados_snapshot.csv\n");
+    return 0;
+}
@@ -0,0 +1,257 @@
+/*
+    Benchmark de acessos concentrados: árvores auto-ajustáveis (Splay_mod.c,
+    Treap_mod.c) contra o balanceamento estrito da AVL e da rubro-negra.
+    As n chaves 0..n-1 são inseridas em ordem aleatória; depois roda uma
+    sequência de operações cujas chaves seguem:
+      - uniforme: todas as chaves com a mesma probabilidade
+      - zipf:     a chave de posto r (1..n) sai com probabilidade ~ 1/r^s; os postos
+                  são espalhados pelas chaves por uma permutação, então as chaves
+                  quentes não ficam juntas
+    Em duas cargas:
+      - busca: só *_buscar (chaves presentes)
+      - misto: 90% buscas, 10% atualizações (remove e reinsere a mesma chave)
+    Alvos: avl, rb, splay, treap (prioridade fixa) e treap_adapt (prioridade
+    reforçada a cada busca). A mesma sequência vale para todos; antes da medida
+    roda um aquecimento de 1/10 das operações com a mesma distribuição, para a
+    splay e a treap adaptativa chegarem ao regime.
+    Para cada combinação: tempo e custo instrumentado por operação (soma dos
+    contadores; na splay e na treap adaptativa inclui a reestruturação feita pela
+    busca) e o custo relativo à AVL.
+
+    Compile:
+    gcc bench_zipf.c AVL_mod.c RubroNegra_mod.c Splay_mod.c Treap_mod.c -O2 -pthread -lm -o bench_zipf
+
+    Uso:
+    ./bench_zipf [n] [operacoes] [s]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+typedef struct arvore1 Arvore1;
+Arvore1* avl_criar();
+void avl_inserir(Arvore1*, int);
+int avl_remover_chave(Arvore1*, int);
+int avl_buscar(Arvore1*, int);
+void avl_remover_tudo(Arvore1*);
+long avl_get_insercao_and_reset();
+long avl_get_remocao_and_reset();
+
+typedef struct arvoreRB ArvoreRB;
+ArvoreRB* rb_criar();
+void rb_inserir(ArvoreRB*, int);
+int rb_remover_chave(ArvoreRB*, int);
+int rb_buscar(ArvoreRB*, int);
+void rb_remover_tudo(ArvoreRB*);
+long rb_get_insercao_and_reset();
+long rb_get_remocao_and_reset();
+
+typedef struct ArvoreSplay ArvoreSplay;
+ArvoreSplay* sp_criar();
+void sp_inserir(ArvoreSplay*, int);
+int sp_remover_chave(ArvoreSplay*, int);
+int sp_buscar(ArvoreSplay*, int);
+void sp_remover_tudo(ArvoreSplay*);
+long sp_get_insercao_and_reset();
+long sp_get_remocao_and_reset();
+
+typedef struct ArvoreTreap ArvoreTreap;
+ArvoreTreap* tp_criar();
+void tp_definir_adaptativo(ArvoreTreap*, int);
+void tp_inserir(ArvoreTreap*, int);
+int tp_remover_chave(ArvoreTreap*, int);
+int tp_buscar(ArvoreTreap*, int);
+void tp_remover_tudo(ArvoreTreap*);
+long tp_get_insercao_and_reset();
+long tp_get_remocao_and_reset();
+
+#define PCT_ATUALIZACAO 10   /* carga mista */
+
+/* uma árvore vista pelo benchmark */
+typedef struct {
+    const char* nome;
+    void* (*criar)(void);
+    void (*inserir)(void*, int);
+    int (*remover)(void*, int);
+    int (*buscar)(void*, int);
+    void (*destruir)(void*);
+    long (*ops_insercao)(void);
+    long (*ops_remocao)(void);
+} Alvo;
+
+static void* criar_avl(void) { return avl_criar(); }
+static void ins_avl(void* a, int k) { avl_inserir(a, k); }
+static int rem_avl(void* a, int k) { return avl_remover_chave(a, k); }
+static int bus_avl(void* a, int k) { return avl_buscar(a, k); }
+static void destruir_avl(void* a) { avl_remover_tudo(a); free(a); }
+static long ops_ins_avl(void) { return avl_get_insercao_and_reset(); }
+static long ops_rem_avl(void) { return avl_get_remocao_and_reset(); }
+
+static void* criar_rb(void) { return rb_criar(); }
+static void ins_rb(void* a, int k) { rb_inserir(a, k); }
+static int rem_rb(void* a, int k) { return rb_remover_chave(a, k); }
+static int bus_rb(void* a, int k) { return rb_buscar(a, k) != 0; }
+static void destruir_rb(void* a) { rb_remover_tudo(a); }
+static long ops_ins_rb(void) { return rb_get_insercao_and_reset(); }
+static long ops_rem_rb(void) { return rb_get_remocao_and_reset(); }
+
+static void* criar_sp(void) { return sp_criar(); }
+static void ins_sp(void* a, int k) { sp_inserir(a, k); }
+static int rem_sp(void* a, int k) { return sp_remover_chave(a, k); }
+static int bus_sp(void* a, int k) { return sp_buscar(a, k); }
+static void destruir_sp(void* a) { sp_remover_tudo(a); free(a); }
+static long ops_ins_sp(void) { return sp_get_insercao_and_reset(); }
+static long ops_rem_sp(void) { return sp_get_remocao_and_reset(); }
+
+static void* criar_tp(void) { return tp_criar(); }
+static void* criar_tp_adapt(void) { ArvoreTreap* a = tp_criar(); tp_definir_adaptativo(a, 1); return a; }
+static void ins_tp(void* a, int k) { tp_inserir(a, k); }
+static int rem_tp(void* a, int k) { return tp_remover_chave(a, k); }
+static int bus_tp(void* a, int k) { return tp_buscar(a, k); }
+static void destruir_tp(void* a) { tp_remover_tudo(a); free(a); }
+static long ops_ins_tp(void) { return tp_get_insercao_and_reset(); }
+static long ops_rem_tp(void) { return tp_get_remocao_and_reset(); }
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void embaralhar(int* v, int n) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1), tmp = v[i];
+        v[i] = v[j]; v[j] = tmp;
+    }
+}
+
+static double uniforme01() {
+    return rand() / (RAND_MAX + 1.0);
+}
+
+/* sorteia m chaves: uniforme, ou Zipf(s) pelos postos com busca binária na
+   distribuição acumulada; posto r vira a chave perm[r] */
+static void gerar_sequencia(int* seq, int m, int n, double s, const int* perm) {
+    if (s <= 0) {
+        for (int i = 0; i < m; i++) seq[i] = (int) (uniforme01() * n);
+        return;
+    }
+    double* acum = malloc(sizeof(double) * n);
+    double soma = 0;
+    for (int r = 0; r < n; r++) {
+        soma += 1.0 / pow(r + 1, s);
+        acum[r] = soma;
+    }
+    for (int i = 0; i < m; i++) {
+        double u = uniforme01() * soma;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int meio = (lo + hi) / 2;
+            if (acum[meio] <= u) lo = meio + 1;
+            else hi = meio;
+        }
+        seq[i] = perm[lo];
+    }
+    free(acum);
+}
+
+/* roda seq[ini..fim) sobre a árvore; atualizar[i] != 0 = remove e reinsere */
+static long executar(Alvo* x, void* arv, const int* seq, const char* atualizar, int ini, int fim) {
+    long achadas = 0;
+    for (int i = ini; i < fim; i++) {
+        if (atualizar && atualizar[i]) {
+            x->remover(arv, seq[i]);
+            x->inserir(arv, seq[i]);
+            achadas++;
+        } else {
+            achadas += x->buscar(arv, seq[i]);
+        }
+    }
+    return achadas;
+}
+
+int main(int argc, char **argv)
+{
+    int n = 100000;
+    int m = 1000000;
+    double s = 0.99;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) m = atoi(argv[2]);
+    if (argc > 3) s = atof(argv[3]);
+    if (n < 1) n = 1;
+    if (m < 10) m = 10;
+
+    Alvo alvos[] = {
+        { "avl",         criar_avl,      ins_avl, rem_avl, bus_avl, destruir_avl, ops_ins_avl, ops_rem_avl },
+        { "rb",          criar_rb,       ins_rb,  rem_rb,  bus_rb,  destruir_rb,  ops_ins_rb,  ops_rem_rb },
+        { "splay",       criar_sp,       ins_sp,  rem_sp,  bus_sp,  destruir_sp,  ops_ins_sp,  ops_rem_sp },
+        { "treap",       criar_tp,       ins_tp,  rem_tp,  bus_tp,  destruir_tp,  ops_ins_tp,  ops_rem_tp },
+        { "treap_adapt", criar_tp_adapt, ins_tp,  rem_tp,  bus_tp,  destruir_tp,  ops_ins_tp,  ops_rem_tp },
+    };
+    int n_alvos = (int) (sizeof(alvos) / sizeof(alvos[0]));
+
+    srand(12345);
+    int* chaves = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) chaves[i] = i;
+    embaralhar(chaves, n);
+    int* perm = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) perm[i] = i;
+    embaralhar(perm, n);
+
+    /* aquecimento + medida na mesma sequência */
+    int aquec = m / 10;
+    int total = aquec + m;
+    int* seq[2];
+    seq[0] = malloc(sizeof(int) * total);
+    seq[1] = malloc(sizeof(int) * total);
+    gerar_sequencia(seq[0], total, n, 0, perm);
+    gerar_sequencia(seq[1], total, n, s, perm);
+    char* atualizar = malloc(total);
+    for (int i = 0; i < total; i++) atualizar[i] = rand() % 100 < PCT_ATUALIZACAO;
+    const char* distribuicoes[2] = { "uniforme", "zipf" };
+    const char* cargas[2] = { "busca", "misto" };
+
+    FILE* f = fopen("resultados_zipf.csv", "w");
+    fprintf(f, "arvore,distribuicao,carga,ns_por_op,ops_por_op,relativo_avl\n");
+    printf("n=%d operacoes=%d s=%.2f atualizacao=%d%%\n", n, m, s, PCT_ATUALIZACAO);
+    printf("%-12s %-9s %-6s %10s %10s %8s\n", "arv", "dist", "carga", "ns/op", "ops/op", "vs avl");
+
+    for (int d = 0; d < 2; d++) {
+        for (int c = 0; c < 2; c++) {
+            double base = 0;
+            for (int a = 0; a < n_alvos; a++) {
+                Alvo* x = &alvos[a];
+                void* arv = x->criar();
+                for (int i = 0; i < n; i++) x->inserir(arv, chaves[i]);
+                const char* atu = c ? atualizar : NULL;
+                executar(x, arv, seq[d], atu, 0, aquec);
+                x->ops_insercao();
+                x->ops_remocao();
+
+                double t0 = agora();
+                long achadas = executar(x, arv, seq[d], atu, aquec, total);
+                double seg = agora() - t0;
+                double ops = (double) (x->ops_insercao() + x->ops_remocao()) / m;
+                if (achadas != m) printf("AVISO: %s achou %ld de %d\n", x->nome, achadas, m);
+                if (a == 0) base = ops;
+
+                double ns = seg * 1e9 / m, rel = ops / base;
+                printf("%-12s %-9s %-6s %10.1f %10.2f %8.2f\n", x->nome, distribuicoes[d], cargas[c], ns, ops, rel);
+                fprintf(f, "%s,%s,%s,%.2f,%.3f,%.3f\n", x->nome, distribuicoes[d], cargas[c], ns, ops, rel);
+                x->destruir(arv);
+            }
+        }
+    }
+
+    fclose(f);
+    free(chaves);
+    free(perm);
+    free(seq[0]);
+    free(seq[1]);
+    free(atualizar);
+    printf("\nArquivo gerado:\n - resultados_zipf.csv\n");
+    return 0;
+}
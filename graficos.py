@@ -1,3 +1,4 @@
+import os
 import pandas as pd
 import matplotlib.pyplot as plt
 
@@ -8,17 +9,33 @@ import matplotlib.pyplot as plt
 insercao = pd.read_csv("resultados_insercao_acumulado.csv")
 remocao  = pd.read_csv("resultados_remocao_acumulado.csv")
 
+# colunas do CSV -> rótulo da legenda (colunas ausentes são ignoradas)
+SERIES = [
+    ("avl",  "AVL"),
+    ("wavl", "WAVL (rank-balanced)"),
+    ("rb",   "Rubro-Negra"),
+    ("rbtd", "Rubro-Negra (top-down)"),
+    ("b1",   "B-tree (ord. 1)"),
+    ("b5",   "B-tree (ord. 5)"),
+    ("b10",  "B-tree (ord.10)"),
+    ("be5",  "Bε-tree (ord. 5)"),
+    ("ls",   "Skip list"),
+    ("sp",   "Splay"),
+    ("tp",   "Treap"),
+]
+
+def plotar_series(df):
+    for coluna, rotulo in SERIES:
+        if coluna in df.columns:
+            plt.plot(df["tamanho"], df[coluna], label=rotulo, linewidth=2)
+
 # ===========================================================
 #   GRÁFICO 1 — Inserção (escala linear)
 # ===========================================================
 
 plt.figure(figsize=(12,6))
 
-plt.plot(insercao["tamanho"], insercao["avl"],  label="AVL", linewidth=2)
-plt.plot(insercao["tamanho"], insercao["rb"],   label="Rubro-Negra", linewidth=2)
-plt.plot(insercao["tamanho"], insercao["b1"],   label="B-tree (ord. 1)", linewidth=2)
-plt.plot(insercao["tamanho"], insercao["b5"],   label="B-tree (ord. 5)", linewidth=2)
-plt.plot(insercao["tamanho"], insercao["b10"],  label="B-tree (ord.10)", linewidth=2)
+plotar_series(insercao)
 
 plt.title("Custo ACUMULADO de Inserção por Estrutura")
 plt.xlabel("Tamanho n")
@@ -35,11 +52,7 @@ plt.show()
 
 plt.figure(figsize=(12,6))
 
-plt.plot(insercao["tamanho"], insercao["avl"],  label="AVL", linewidth=2)
-plt.plot(insercao["tamanho"], insercao["rb"],   label="Rubro-Negra", linewidth=2)
-plt.plot(insercao["tamanho"], insercao["b1"],   label="B-tree (ord. 1)", linewidth=2)
-plt.plot(insercao["tamanho"], insercao["b5"],   label="B-tree (ord. 5)", linewidth=2)
-plt.plot(insercao["tamanho"], insercao["b10"],  label="B-tree (ord.10)", linewidth=2)
+plotar_series(insercao)
 
 plt.title("Custo ACUMULADO de Inserção (Escala Log)")
 plt.xlabel("Tamanho n")
@@ -57,11 +70,7 @@ plt.show()
 
 plt.figure(figsize=(12,6))
 
-plt.plot(remocao["tamanho"], remocao["avl"],  label="AVL", linewidth=2)
-plt.plot(remocao["tamanho"], remocao["rb"],   label="Rubro-Negra", linewidth=2)
-plt.plot(remocao["tamanho"], remocao["b1"],   label="B-tree (ord. 1)", linewidth=2)
-plt.plot(remocao["tamanho"], remocao["b5"],   label="B-tree (ord. 5)", linewidth=2)
-plt.plot(remocao["tamanho"], remocao["b10"],  label="B-tree (ord.10)", linewidth=2)
+plotar_series(remocao)
 
 plt.title("Custo ACUMULADO de Remoção (Esvaziamento)")
 plt.xlabel("Tamanho n")
@@ -78,11 +87,7 @@ plt.show()
 
 plt.figure(figsize=(12,6))
 
-plt.plot(remocao["tamanho"], remocao["avl"],  label="AVL", linewidth=2)
-plt.plot(remocao["tamanho"], remocao["rb"],   label="Rubro-Negra", linewidth=2)
-plt.plot(remocao["tamanho"], remocao["b1"],   label="B-tree (ord. 1)", linewidth=2)
-plt.plot(remocao["tamanho"], remocao["b5"],   label="B-tree (ord. 5)", linewidth=2)
-plt.plot(remocao["tamanho"], remocao["b10"],  label="B-tree (ord.10)", linewidth=2)
+plotar_series(remocao)
 
 plt.title("Custo ACUMULADO de Remoção (Escala Log)")
 plt.xlabel("Tamanho n")
@@ -93,3 +98,28 @@ plt.legend()
 plt.tight_layout()
 plt.savefig("grafico_remocao_acumulado_log.png", dpi=300)
 plt.show()
+
+# ===========================================================
+#   GRÁFICO 5 — Custo por operação (./experimento --curvas)
+# ===========================================================
+
+if os.path.exists("resultados_curvas.csv"):
+    curvas = pd.read_csv("resultados_curvas.csv")
+    fig, eixos = plt.subplots(2, 1, figsize=(12,9), sharex=True)
+    for eixo, operacao in zip(eixos, ["insercao", "remocao"]):
+        for coluna, rotulo in SERIES:
+            c = curvas[(curvas["operacao"] == operacao) & (curvas["estrutura"] == coluna)]
+            if c.empty:
+                continue
+            linha, = eixo.plot(c["tamanho"], c["maximo"], linewidth=0.6, alpha=0.5)
+            eixo.plot(c["tamanho"], c["amortizado"], color=linha.get_color(), linewidth=2, label=rotulo)
+        eixo.set_title("Custo por " + ("inserção" if operacao == "insercao" else "remoção") +
+                       " (fino: pior caso no tamanho; grosso: amortizado)")
+        eixo.set_ylabel("Operações")
+        eixo.set_yscale("log")
+        eixo.grid(True)
+        eixo.legend()
+    eixos[1].set_xlabel("Tamanho da árvore antes da operação")
+    plt.tight_layout()
+    plt.savefig("grafico_curvas_por_operacao.png", dpi=300)
+    plt.show()
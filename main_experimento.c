@@ -1,12 +1,20 @@
 /*
     Compile:
-    gcc main_experimento.c AVL_mod.c RubroNegra_mod.c B_mod.c -O2 -o experimento
+    gcc main_experimento.c AVL_mod.c WAVL_mod.c RubroNegra_mod.c RubroNegraTD_mod.c B_mod.c BEpsilon_mod.c ListaSaltos_mod.c Splay_mod.c Treap_mod.c -O2 -pthread -lm -o experimento
+
+    Uso:
+    ./experimento [--debug] [--repeticoes R] [--semente S] [--tempo] [--aquecimento W] [--atipicos K]
+    ./experimento --comparar base.csv novo.csv [--limiar pct]
+    ./experimento --curvas curvas.bin [--repeticoes R] [--semente S]
+    ./experimento --agregar curvas.bin
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <math.h>
+#include <stdint.h>
 
 /* --------------------------------------------------
    DEBUG via linha de comando (--debug)
@@ -21,6 +29,9 @@ static int DEBUG_FLAG = 0;
 #define REPETICOES 10
 #define N_MAX 10000
 #define SAMPLE_STEP 200
+#define SEMENTE 12345       // repetição r usa SEMENTE + r*7919 (--semente muda a base)
+#define ALFA 0.05           // nível dos intervalos de confiança e de --comparar
+#define ATIPICOS_TEMPO 1.5  // cercas de Tukey padrão no --tempo (k * IQR além dos quartis)
 
 /* AVL */
 typedef struct arvore1 Arvore1;
@@ -28,27 +39,85 @@ Arvore1* avl_criar();
 void avl_inserir(Arvore1*, int);
 int avl_remover_chave(Arvore1*, int);
 void avl_remover_tudo(Arvore1*);
+int avl_altura(Arvore1*);
 long avl_get_insercao_and_reset();
 long avl_get_remocao_and_reset();
 
+/* WAVL */
+typedef struct arvoreWAVL ArvoreWAVL;
+ArvoreWAVL* wavl_criar();
+void wavl_inserir(ArvoreWAVL*, int);
+int wavl_remover_chave(ArvoreWAVL*, int);
+void wavl_remover_tudo(ArvoreWAVL*);
+long wavl_get_insercao_and_reset();
+long wavl_get_remocao_and_reset();
+
 /* RB */
 typedef struct arvoreRB ArvoreRB;
 ArvoreRB* rb_criar();
 void rb_inserir(ArvoreRB*, int);
 int rb_remover_chave(ArvoreRB*, int);
 void rb_remover_tudo(ArvoreRB*);
+int rb_altura_preta(ArvoreRB*);
 long rb_get_insercao_and_reset();
 long rb_get_remocao_and_reset();
 
+/* RB top-down */
+typedef struct arvoreRBTD ArvoreRBTD;
+ArvoreRBTD* rbtd_criar();
+void rbtd_inserir(ArvoreRBTD*, int);
+int rbtd_remover_chave(ArvoreRBTD*, int);
+void rbtd_remover_tudo(ArvoreRBTD*);
+long rbtd_get_insercao_and_reset();
+long rbtd_get_remocao_and_reset();
+
 /* B-tree */
 typedef struct ArvoreB ArvoreB;
 ArvoreB* b_criar(int);
 void b_inserir(ArvoreB*, int);
 int b_remover_chave(ArvoreB*, int);
 void b_remover_tudo(ArvoreB*);
+int b_altura(ArvoreB*);
 long b_get_insercao_and_reset();
 long b_get_remocao_and_reset();
 
+/* B^epsilon-tree */
+typedef struct ArvoreBE ArvoreBE;
+ArvoreBE* be_criar(int);
+void be_inserir(ArvoreBE*, int);
+int be_remover_chave(ArvoreBE*, int);
+void be_remover_tudo(ArvoreBE*);
+long be_get_insercao_and_reset();
+long be_get_remocao_and_reset();
+
+/* Skip list */
+typedef struct ListaSaltos ListaSaltos;
+ListaSaltos* ls_criar();
+void ls_inserir(ListaSaltos*, int);
+int ls_remover_chave(ListaSaltos*, int);
+void ls_remover_tudo(ListaSaltos*);
+int ls_nivel(ListaSaltos*);
+long ls_get_insercao_and_reset();
+long ls_get_remocao_and_reset();
+
+/* Splay (descendente) */
+typedef struct ArvoreSplay ArvoreSplay;
+ArvoreSplay* sp_criar();
+void sp_inserir(ArvoreSplay*, int);
+int sp_remover_chave(ArvoreSplay*, int);
+void sp_remover_tudo(ArvoreSplay*);
+long sp_get_insercao_and_reset();
+long sp_get_remocao_and_reset();
+
+/* Treap */
+typedef struct ArvoreTreap ArvoreTreap;
+ArvoreTreap* tp_criar();
+void tp_inserir(ArvoreTreap*, int);
+int tp_remover_chave(ArvoreTreap*, int);
+void tp_remover_tudo(ArvoreTreap*);
+long tp_get_insercao_and_reset();
+long tp_get_remocao_and_reset();
+
 
 void gerar_chaves_unicas(int *arr, int n)
 {
@@ -59,259 +128,636 @@ void gerar_chaves_unicas(int *arr, int n)
     }
 }
 
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* --------------------------------------------------
+   Estruturas medidas: uma tabela de operações por árvore
+   -------------------------------------------------- */
+typedef struct {
+    const char* nome;     // coluna dos CSVs
+    int ordem;            // B / Bε (ignorada nas outras)
+    void* (*criar)(int);
+    void (*inserir)(void*, int);
+    int (*remover)(void*, int);
+    void (*remover_tudo)(void*);
+    long (*get_insercao)();
+    long (*get_remocao)();
+    int (*altura)(void*); // --curvas (NULL: sem altura barata)
+} Estrutura;
+
+#define ADAPTAR(P, T, CRIAR) \
+    static void* P##_novo(int ordem) { (void) ordem; return CRIAR; } \
+    static void P##_ins(void* a, int k) { P##_inserir((T*) a, k); } \
+    static int P##_rem(void* a, int k) { return P##_remover_chave((T*) a, k); } \
+    static void P##_tudo(void* a) { P##_remover_tudo((T*) a); }
+
+ADAPTAR(avl, Arvore1, avl_criar())
+ADAPTAR(wavl, ArvoreWAVL, wavl_criar())
+ADAPTAR(rb, ArvoreRB, rb_criar())
+ADAPTAR(rbtd, ArvoreRBTD, rbtd_criar())
+ADAPTAR(b, ArvoreB, b_criar(ordem))
+ADAPTAR(be, ArvoreBE, be_criar(ordem))
+ADAPTAR(ls, ListaSaltos, ls_criar())
+ADAPTAR(sp, ArvoreSplay, sp_criar())
+ADAPTAR(tp, ArvoreTreap, tp_criar())
+
+static int avl_alt(void* a) { return avl_altura((Arvore1*) a); }
+static int rb_alt(void* a) { return rb_altura_preta((ArvoreRB*) a); }   // altura preta
+static int b_alt(void* a) { return b_altura((ArvoreB*) a); }
+static int ls_alt(void* a) { return ls_nivel((ListaSaltos*) a); }   // níveis em uso
+
+#define ESTRUTURA(nome, P, ordem, altura) \
+    { nome, ordem, P##_novo, P##_ins, P##_rem, P##_tudo, P##_get_insercao_and_reset, P##_get_remocao_and_reset, altura }
+
+static const Estrutura ESTRUTURAS[] = {
+    ESTRUTURA("avl", avl, 0, avl_alt),
+    ESTRUTURA("wavl", wavl, 0, NULL),
+    ESTRUTURA("rb", rb, 0, rb_alt),
+    ESTRUTURA("rbtd", rbtd, 0, NULL),
+    ESTRUTURA("b1", b, 1, b_alt),
+    ESTRUTURA("b5", b, 5, b_alt),
+    ESTRUTURA("b10", b, 10, b_alt),
+    ESTRUTURA("be5", be, 5, NULL),
+    ESTRUTURA("ls", ls, 0, ls_alt),
+    ESTRUTURA("sp", sp, 0, NULL),
+    ESTRUTURA("tp", tp, 0, NULL),
+};
+#define N_ESTRUTURAS ((int) (sizeof(ESTRUTURAS) / sizeof(ESTRUTURAS[0])))
 
 int SAMPLES;
-long *avl_ins_acc, *rb_ins_acc, *b1_ins_acc, *b5_ins_acc, *b10_ins_acc;
-long *avl_rem_acc, *rb_rem_acc, *b1_rem_acc, *b5_rem_acc, *b10_rem_acc;
+static int MODO_TEMPO = 0;   // --tempo: ns de relógio em vez dos contadores
 
+/* amostras[(e * (SAMPLES + 2) + idx) * repeticoes + rep] */
+static double *amostras_ins, *amostras_rem;
 
-int main(int argc, char **argv)
+/* Para cada tamanho múltiplo de SAMPLE_STEP: custo das SAMPLE_STEP inserções
+   desde a amostra anterior e da remoção das n chaves; depois a árvore é
+   reconstruída com as mesmas n chaves (fora da medição). */
+static void medir_estrutura(const Estrutura* e, int ei, const int* chaves, int rep, int repeticoes, int registrar)
 {
-    
-    if (argc > 1 && strcmp(argv[1], "--debug") == 0) {
-        DEBUG_FLAG = 1;
-        printf("DEBUG ATIVADO\n");
-    }
-
-    srand(12345);
-    SAMPLES = (N_MAX + SAMPLE_STEP - 1) / SAMPLE_STEP;
-
-    /* Alocar acumuladores */
-    avl_ins_acc = calloc(SAMPLES+2, sizeof(long));
-    rb_ins_acc  = calloc(SAMPLES+2, sizeof(long));
-    b1_ins_acc  = calloc(SAMPLES+2, sizeof(long));
-    b5_ins_acc  = calloc(SAMPLES+2, sizeof(long));
-    b10_ins_acc = calloc(SAMPLES+2, sizeof(long));
-
-    avl_rem_acc = calloc(SAMPLES+2, sizeof(long));
-    rb_rem_acc  = calloc(SAMPLES+2, sizeof(long));
-    b1_rem_acc  = calloc(SAMPLES+2, sizeof(long));
-    b5_rem_acc  = calloc(SAMPLES+2, sizeof(long));
-    b10_rem_acc = calloc(SAMPLES+2, sizeof(long));
-
-    int *chaves = malloc(sizeof(int) * N_MAX);
+    void* a = e->criar(e->ordem);
+    double t0 = agora();
+    for (int n = 1; n <= N_MAX; n++)
+    {
+        e->inserir(a, chaves[n-1]);
 
-    /* Repete experimento */
-    for (int rep = 0; rep < REPETICOES; rep++) {
+        /* Não resetamos! Custo é acumulado. */
+        if (n % SAMPLE_STEP == 0) {
 
-        printf("Repeticao %d/%d\n", rep+1, REPETICOES);
-        srand((unsigned)time(NULL) + rep*7919);
-        gerar_chaves_unicas(chaves, N_MAX);
+            int idx = n / SAMPLE_STEP;
+            long pos = ((long) ei * (SAMPLES + 2) + idx) * repeticoes + rep;
 
-        
-        Arvore1* avl = avl_criar();
-        long avl_ins_total = 0;
-        long avl_rem_total = 0;
+            /* obtém custo acumulado e zera */
+            double ins = MODO_TEMPO ? (agora() - t0) * 1e9 : 0;
+            long ins_ops = e->get_insercao();
+            if (!MODO_TEMPO) ins = (double) ins_ops;
 
-        for (int n = 1; n <= N_MAX; n++)
-        {
-            avl_inserir(avl, chaves[n-1]);
+            /* Remover n elementos */
+            t0 = agora();
+            for (int k = 0; k < n; k++) {
+                DBG_PRINT("[%s][REM] %d\n", e->nome, chaves[k]);
+                e->remover(a, chaves[k]);
+            }
+            double rem = MODO_TEMPO ? (agora() - t0) * 1e9 : 0;
+            long rem_ops = e->get_remocao();
+            if (!MODO_TEMPO) rem = (double) rem_ops;
 
-            /* Não resetamos! Custo é acumulado. */
-            if (n % SAMPLE_STEP == 0) {
+            if (registrar) {
+                amostras_ins[pos] = ins;
+                amostras_rem[pos] = rem;
+            }
 
-                int idx = n / SAMPLE_STEP;
+            /* Reconstruir a árvore */
+            e->remover_tudo(a);
+            free(a);
+            a = e->criar(e->ordem);
 
-                /* obtém custo acumulado e zera */
-                long ins_ops = avl_get_insercao_and_reset();
-                avl_ins_acc[idx] += ins_ops;
+            for (int k = 0; k < n; k++)
+                e->inserir(a, chaves[k]);
 
-                /* Remover n elementos */
-                for (int k = 0; k < n; k++) {
-                    DBG_PRINT("[AVL][REM] %d\n", chaves[k]);
-                    avl_remover_chave(avl, chaves[k]);
-                }
+            e->get_insercao();
+            t0 = agora();
+        }
+    }
+    e->remover_tudo(a);
+    e->get_remocao();
+    free(a);
+}
 
-                long rem_ops = avl_get_remocao_and_reset();
-                avl_rem_acc[idx] += rem_ops;
+/* --------------------------------------------------
+   Estatística: t de Student (intervalos e teste de Welch)
+   -------------------------------------------------- */
 
-                /* Reconstruir a árvore */
-                avl_remover_tudo(avl);
-                free(avl);
-                avl = avl_criar();
+/* fração contínua da beta incompleta regularizada (Numerical Recipes, betacf) */
+static double beta_cf(double a, double b, double x) {
+    double qab = a + b, qap = a + 1, qam = a - 1;
+    double c = 1, d = 1 - qab * x / qap;
+    if (fabs(d) < 1e-300) d = 1e-300;
+    d = 1 / d;
+    double h = d;
+    for (int m = 1; m <= 300; m++) {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+        d = 1 + aa * d; if (fabs(d) < 1e-300) d = 1e-300;
+        c = 1 + aa / c; if (fabs(c) < 1e-300) c = 1e-300;
+        d = 1 / d;
+        h *= d * c;
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+        d = 1 + aa * d; if (fabs(d) < 1e-300) d = 1e-300;
+        c = 1 + aa / c; if (fabs(c) < 1e-300) c = 1e-300;
+        d = 1 / d;
+        double del = d * c;
+        h *= del;
+        if (fabs(del - 1) < 1e-12) break;
+    }
+    return h;
+}
 
-                for (int k = 0; k < n; k++)
-                    avl_inserir(avl, chaves[k]);
+static double beta_inc(double a, double b, double x) {
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    double bt = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1 - x));
+    if (x < (a + 1) / (a + b + 2)) return bt * beta_cf(a, b, x) / a;
+    return 1 - bt * beta_cf(b, a, 1 - x) / b;
+}
 
-                avl_get_insercao_and_reset(); 
-            }
-        }
-        avl_remover_tudo(avl);
-        avl_get_remocao_and_reset();
-        free(avl);
+/* P(|T| >= t) com gl graus de liberdade */
+static double t_p_bilateral(double t, double gl) {
+    return beta_inc(gl / 2, 0.5, gl / (gl + t * t));
+}
 
-        
-        ArvoreRB* rb = rb_criar();
-        for (int n = 1; n <= N_MAX; n++)
-        {
-            rb_inserir(rb, chaves[n-1]);
+/* t com P(|T| >= t) = p (bisseção) */
+static double t_critico(double p, double gl) {
+    double lo = 0, hi = 1e4;
+    for (int i = 0; i < 200; i++) {
+        double m = (lo + hi) / 2;
+        if (t_p_bilateral(m, gl) > p) lo = m; else hi = m;
+    }
+    return (lo + hi) / 2;
+}
 
-            if (n % SAMPLE_STEP == 0) {
+static int comparar_double(const void* a, const void* b) {
+    double x = *(const double*) a, y = *(const double*) b;
+    return (x > y) - (x < y);
+}
 
-                int idx = n / SAMPLE_STEP;
+typedef struct {
+    int n, descartadas;
+    double media, mediana, desvio, ic_inf, ic_sup, minimo, maximo;
+} Resumo;
 
-                long ins_ops = rb_get_insercao_and_reset();
-                rb_ins_acc[idx] += ins_ops;
+static double quantil(const double* o, int n, double p) {
+    double x = p * (n - 1);
+    int i = (int) x;
+    return i + 1 < n ? o[i] + (x - i) * (o[i + 1] - o[i]) : o[n - 1];
+}
 
-                for (int k = 0; k < n; k++) {
-                    DBG_PRINT("[RB][REM] %d\n", chaves[k]);
-                    rb_remover_chave(rb, chaves[k]);
-                }
+/* Resumo das n amostras; com k > 0 (e ao menos 4 amostras) descarta as
+   atípicas, fora de [Q1 - k*IQR, Q3 + k*IQR], antes de calcular. */
+static Resumo resumir(const double* v, int n, double k) {
+    Resumo r;
+    double* o = malloc(sizeof(double) * n);
+    memcpy(o, v, sizeof(double) * n);
+    qsort(o, n, sizeof(double), comparar_double);
+    r.descartadas = 0;
+    if (k > 0 && n >= 4) {
+        double q1 = quantil(o, n, 0.25), q3 = quantil(o, n, 0.75);
+        double lo = q1 - k * (q3 - q1), hi = q3 + k * (q3 - q1);
+        int m = 0;
+        for (int i = 0; i < n; i++)
+            if (o[i] >= lo && o[i] <= hi) o[m++] = o[i];
+        r.descartadas = n - m;
+        n = m;
+    }
+    double soma = 0;
+    for (int i = 0; i < n; i++) soma += o[i];
+    r.n = n;
+    r.media = soma / n;
+    double q = 0;
+    for (int i = 0; i < n; i++) q += (o[i] - r.media) * (o[i] - r.media);
+    r.desvio = n > 1 ? sqrt(q / (n - 1)) : 0;
+    r.mediana = n % 2 ? o[n / 2] : (o[n / 2 - 1] + o[n / 2]) / 2;
+    double meia = n > 1 ? t_critico(ALFA, n - 1) * r.desvio / sqrt(n) : 0;
+    r.ic_inf = r.media - meia;
+    r.ic_sup = r.media + meia;
+    r.minimo = o[0];
+    r.maximo = o[n - 1];
+    free(o);
+    return r;
+}
 
-                long rem_ops = rb_get_remocao_and_reset();
-                rb_rem_acc[idx] += rem_ops;
+/* --------------------------------------------------
+   --comparar base.csv novo.csv: teste t de Welch por linha
+   (operacao, estrutura, tamanho), com correção de Holm para os vários
+   testes; retorna 1 se houver regressão significativa
+   -------------------------------------------------- */
+typedef struct {
+    char operacao[16], estrutura[16];
+    int tamanho;
+    Resumo r;
+} LinhaEstat;
+
+static LinhaEstat* ler_estatisticas(const char* caminho, int* total) {
+    FILE* f = fopen(caminho, "r");
+    if (!f) {
+        fprintf(stderr, "nao abriu %s\n", caminho);
+        return NULL;
+    }
+    char linha[512];
+    int cap = 256, n = 0;
+    LinhaEstat* v = malloc(sizeof(LinhaEstat) * cap);
+    if (!fgets(linha, sizeof(linha), f)) linha[0] = 0;   // cabeçalho
+    while (fgets(linha, sizeof(linha), f)) {
+        LinhaEstat x;
+        if (sscanf(linha, "%15[^,],%15[^,],%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf", x.operacao, x.estrutura,
+                   &x.tamanho, &x.r.n, &x.r.descartadas, &x.r.media, &x.r.mediana, &x.r.desvio, &x.r.ic_inf, &x.r.ic_sup,
+                   &x.r.minimo, &x.r.maximo) != 12) continue;
+        if (n == cap) v = realloc(v, sizeof(LinhaEstat) * (cap *= 2));
+        v[n++] = x;
+    }
+    fclose(f);
+    *total = n;
+    return v;
+}
 
-                rb_remover_tudo(rb);
-                free(rb);
-                rb = rb_criar();
+typedef struct {
+    const LinhaEstat *base, *novo;
+    double variacao, t, gl, p;
+    int significativo;
+} Teste;
 
-                for (int k = 0; k < n; k++)
-                    rb_inserir(rb, chaves[k]);
+static int comparar_p(const void* a, const void* b) {
+    double x = (*(Teste* const*) a)->p, y = (*(Teste* const*) b)->p;
+    return (x > y) - (x < y);
+}
 
-                rb_get_insercao_and_reset();
+static int comparar_arquivos(const char* base, const char* novo, double limiar) {
+    int nb, nn;
+    LinhaEstat* vb = ler_estatisticas(base, &nb);
+    LinhaEstat* vn = ler_estatisticas(novo, &nn);
+    if (!vb || !vn) return 2;
+
+    Teste* testes = malloc(sizeof(Teste) * (nn > 0 ? nn : 1));
+    int nt = 0;
+    for (int i = 0; i < nn; i++)
+        for (int j = 0; j < nb; j++) {
+            const LinhaEstat *x = &vb[j], *y = &vn[i];
+            if (x->tamanho != y->tamanho || strcmp(x->operacao, y->operacao) || strcmp(x->estrutura, y->estrutura))
+                continue;
+            Teste* t = &testes[nt++];
+            t->base = x;
+            t->novo = y;
+            t->variacao = x->r.media != 0 ? 100.0 * (y->r.media - x->r.media) / x->r.media : 0;
+            double vx = x->r.desvio * x->r.desvio / x->r.n, vy = y->r.desvio * y->r.desvio / y->r.n;
+            if (vx + vy > 0 && x->r.n > 1 && y->r.n > 1) {
+                t->t = (y->r.media - x->r.media) / sqrt(vx + vy);
+                t->gl = (vx + vy) * (vx + vy) /
+                        (vx * vx / (x->r.n - 1) + vy * vy / (y->r.n - 1));
+                t->p = t_p_bilateral(t->t, t->gl);
+            } else {
+                /* sem variação (contadores com as mesmas sementes): qualquer diferença é real */
+                t->t = 0;
+                t->gl = 0;
+                t->p = y->r.media != x->r.media ? 0 : 1;
             }
+            break;
         }
-        rb_remover_tudo(rb);
-        rb_get_remocao_and_reset();
-        free(rb);
-
-        
-        ArvoreB* b1 = b_criar(1);
-        for (int n = 1; n <= N_MAX; n++)
-        {
-            b_inserir(b1, chaves[n-1]);
-
-            if (n % SAMPLE_STEP == 0) {
-
-                int idx = n / SAMPLE_STEP;
 
-                long ins_ops = b_get_insercao_and_reset();
-                b1_ins_acc[idx] += ins_ops;
+    /* Holm: o k-ésimo menor p é comparado com ALFA / (nt - k) */
+    Teste** ordem = malloc(sizeof(Teste*) * (nt > 0 ? nt : 1));
+    for (int i = 0; i < nt; i++) ordem[i] = &testes[i];
+    qsort(ordem, nt, sizeof(Teste*), comparar_p);
+    int rejeitando = 1;
+    for (int k = 0; k < nt; k++) {
+        if (rejeitando && ordem[k]->p > ALFA / (nt - k)) rejeitando = 0;
+        ordem[k]->significativo = rejeitando;
+    }
 
-                for (int k = 0; k < n; k++)
-                    b_remover_chave(b1, chaves[k]);
+    FILE* f = fopen("resultados_comparacao.csv", "w");
+    fprintf(f, "operacao,estrutura,tamanho,media_base,media_novo,variacao_pct,t,gl,p,veredito\n");
+    int regressoes = 0, melhoras = 0;
+    for (int i = 0; i < nt; i++) {
+        Teste* t = &testes[i];
+        const char* veredito = "igual";
+        if (t->significativo && fabs(t->variacao) >= limiar) {
+            if (t->novo->r.media > t->base->r.media) { veredito = "REGRESSAO"; regressoes++; }
+            else { veredito = "melhora"; melhoras++; }
+        }
+        fprintf(f, "%s,%s,%d,%.2f,%.2f,%.3f,%.3f,%.1f,%.3g,%s\n", t->novo->operacao, t->novo->estrutura,
+                t->novo->tamanho, t->base->r.media, t->novo->r.media, t->variacao, t->t, t->gl, t->p, veredito);
+        if (strcmp(veredito, "igual"))
+            printf("%-9s %-8s %-5s n=%-6d %12.2f -> %12.2f (%+7.2f%%, p=%.3g)\n", veredito, t->novo->operacao,
+                   t->novo->estrutura, t->novo->tamanho, t->base->r.media, t->novo->r.media, t->variacao, t->p);
+    }
+    fclose(f);
+    printf("\n%d linhas comparadas: %d regressoes, %d melhoras (alfa %.2f com Holm, limiar %.2f%%)\n",
+           nt, regressoes, melhoras, ALFA, limiar);
+    printf("\nArquivo gerado:\n - resultados_comparacao.csv\n");
+    free(ordem);
+    free(testes);
+    free(vb);
+    free(vn);
+    return regressoes > 0;
+}
 
-                long rem_ops = b_get_remocao_and_reset();
-                b1_rem_acc[idx] += rem_ops;
+/* --------------------------------------------------
+   --curvas arquivo.bin: custo de cada inserção e remoção isolada
+   Por repetição e estrutura: insere as N_MAX chaves uma a uma e depois
+   remove todas numa outra ordem aleatória, lendo o contador depois de
+   cada operação. Cada operação vira um registro binário de 12 bytes
+   (tamanho antes da operação, custo, altura depois dela), juntado num
+   buffer de CURVA_BUFFER registros que vai para o arquivo quando enche.
+   --agregar lê o arquivo e gera as curvas média, pior caso e amortizada
+   por tamanho, e os eventos de mudança de altura (divisão da raiz da
+   B-tree, aumento da altura da AVL, da altura preta da rubro-negra).
+   -------------------------------------------------- */
+#define CURVA_MAGICA 0x56525543u   // "CURV"
+#define CURVA_VERSAO 1
+#define CURVA_BUFFER 65536
+#define CURVA_NOME 8
+
+typedef struct {
+    uint32_t magica, versao;
+    uint32_t n_max, estruturas, repeticoes, semente;
+    char nomes[16][CURVA_NOME];
+} CabecalhoCurva;
+
+typedef struct {
+    uint32_t tamanho;     // chaves na árvore antes da operação
+    uint32_t custo;       // soma dos contadores da operação
+    uint8_t estrutura;
+    uint8_t operacao;     // 0 inserção, 1 remoção
+    int8_t altura;        // depois da operação (-1: estrutura sem altura)
+    uint8_t repeticao;
+} RegistroCurva;
+
+static RegistroCurva curva_buffer[CURVA_BUFFER];
+static int curva_usados = 0;
+static FILE* curva_arquivo = NULL;
+
+static void curva_despejar() {
+    if (curva_usados > 0) fwrite(curva_buffer, sizeof(RegistroCurva), curva_usados, curva_arquivo);
+    curva_usados = 0;
+}
 
-                b_remover_tudo(b1);
-                free(b1);
-                b1 = b_criar(1);
+static inline void curva_registrar(int e, int op, int rep, long tamanho, long custo, int altura) {
+    RegistroCurva* r = &curva_buffer[curva_usados];
+    r->tamanho = (uint32_t) tamanho;
+    r->custo = custo > UINT32_MAX ? UINT32_MAX : (uint32_t) custo;
+    r->estrutura = (uint8_t) e;
+    r->operacao = (uint8_t) op;
+    r->altura = (int8_t) (altura > 127 ? 127 : altura);
+    r->repeticao = (uint8_t) rep;
+    if (++curva_usados == CURVA_BUFFER) curva_despejar();
+}
 
-                for (int k = 0; k < n; k++)
-                    b_inserir(b1, chaves[k]);
+static int gravar_curvas(const char* caminho, int repeticoes, unsigned semente) {
+    curva_arquivo = fopen(caminho, "wb");
+    if (!curva_arquivo) {
+        fprintf(stderr, "nao abriu %s\n", caminho);
+        return 2;
+    }
+    CabecalhoCurva c;
+    memset(&c, 0, sizeof(c));
+    c.magica = CURVA_MAGICA;
+    c.versao = CURVA_VERSAO;
+    c.n_max = N_MAX;
+    c.estruturas = N_ESTRUTURAS;
+    c.repeticoes = repeticoes;
+    c.semente = semente;
+    for (int e = 0; e < N_ESTRUTURAS; e++) strncpy(c.nomes[e], ESTRUTURAS[e].nome, CURVA_NOME - 1);
+    fwrite(&c, sizeof(c), 1, curva_arquivo);
 
-                b_get_insercao_and_reset();
+    int *chaves = malloc(sizeof(int) * N_MAX);
+    int *ordem = malloc(sizeof(int) * N_MAX);
+    for (int r = 0; r < repeticoes; r++) {
+        printf("Repeticao %d/%d\n", r + 1, repeticoes);
+        srand(semente + (unsigned) r * 7919);
+        gerar_chaves_unicas(chaves, N_MAX);
+        gerar_chaves_unicas(ordem, N_MAX);   // ordem das remoções (as chaves são 1..N_MAX)
+
+        for (int e = 0; e < N_ESTRUTURAS; e++) {
+            const Estrutura* x = &ESTRUTURAS[e];
+            void* a = x->criar(x->ordem);
+            x->get_insercao();
+            x->get_remocao();
+            for (int n = 0; n < N_MAX; n++) {
+                x->inserir(a, chaves[n]);
+                long custo = x->get_insercao();
+                curva_registrar(e, 0, r, n, custo, x->altura ? x->altura(a) : -1);
+            }
+            for (int n = N_MAX; n > 0; n--) {
+                x->remover(a, ordem[N_MAX - n]);
+                long custo = x->get_remocao();
+                curva_registrar(e, 1, r, n, custo, x->altura ? x->altura(a) : -1);
             }
+            x->remover_tudo(a);
+            x->get_remocao();
+            free(a);
         }
-        b_remover_tudo(b1);
-        b_get_remocao_and_reset();
-        free(b1);
-
-       
-        ArvoreB* b5 = b_criar(5);
-        for (int n = 1; n <= N_MAX; n++)
-        {
-            b_inserir(b5, chaves[n-1]);
-
-            if (n % SAMPLE_STEP == 0) {
-
-                int idx = n / SAMPLE_STEP;
-
-                long ins_ops = b_get_insercao_and_reset();
-                b5_ins_acc[idx] += ins_ops;
-
-                for (int k = 0; k < n; k++)
-                    b_remover_chave(b5, chaves[k]);
-
-                long rem_ops = b_get_remocao_and_reset();
-                b5_rem_acc[idx] += rem_ops;
-
-                b_remover_tudo(b5);
-                free(b5);
-                b5 = b_criar(5);
-
-                for (int k = 0; k < n; k++)
-                    b_inserir(b5, chaves[k]);
+    }
+    curva_despejar();
+    fclose(curva_arquivo);
+    free(chaves);
+    free(ordem);
+    printf("\n%ld registros de %zu bytes\n", 2L * N_MAX * N_ESTRUTURAS * repeticoes, sizeof(RegistroCurva));
+    return 0;
+}
 
-                b_get_insercao_and_reset();
+/* soma, pior caso e altura (máxima) por (estrutura, operação, tamanho) */
+typedef struct {
+    double soma;
+    uint32_t maximo, vezes;
+    int altura;
+} PontoCurva;
+
+static int agregar_curvas(const char* caminho) {
+    FILE* f = fopen(caminho, "rb");
+    CabecalhoCurva c;
+    if (!f || fread(&c, sizeof(c), 1, f) != 1 || c.magica != CURVA_MAGICA || c.versao != CURVA_VERSAO ||
+        c.estruturas > 16) {
+        fprintf(stderr, "%s: arquivo de curvas invalido\n", caminho);
+        if (f) fclose(f);
+        return 2;
+    }
+    long pontos = (long) c.estruturas * 2 * (c.n_max + 1);
+    PontoCurva* p = calloc(pontos, sizeof(PontoCurva));
+    for (long i = 0; i < pontos; i++) p[i].altura = -1;
+    int ultima[16] = { 0 };   // altura depois da operação anterior da mesma estrutura
+
+    FILE* f_ev = fopen("resultados_curvas_eventos.csv", "w");
+    fprintf(f_ev, "operacao,estrutura,repeticao,tamanho,altura_antes,altura_depois,custo\n");
+    RegistroCurva* buf = malloc(sizeof(RegistroCurva) * CURVA_BUFFER);
+    long lidos = 0;
+    size_t k;
+    while ((k = fread(buf, sizeof(RegistroCurva), CURVA_BUFFER, f)) > 0) {
+        for (size_t i = 0; i < k; i++) {
+            const RegistroCurva* r = &buf[i];
+            if (r->estrutura >= c.estruturas || r->operacao > 1 || r->tamanho > c.n_max) continue;
+            PontoCurva* q = &p[((long) r->estrutura * 2 + r->operacao) * (c.n_max + 1) + r->tamanho];
+            q->soma += r->custo;
+            if (r->custo > q->maximo) q->maximo = r->custo;
+            q->vezes++;
+            if (r->altura > q->altura) q->altura = r->altura;
+
+            if (r->operacao == 0 && r->tamanho == 0) ultima[r->estrutura] = 0;   // árvore nova
+            if (r->altura >= 0 && r->altura != ultima[r->estrutura])
+                fprintf(f_ev, "%s,%s,%d,%u,%d,%d,%u\n", r->operacao ? "remocao" : "insercao",
+                        c.nomes[r->estrutura], r->repeticao, r->tamanho, ultima[r->estrutura], r->altura, r->custo);
+            ultima[r->estrutura] = r->altura;
+        }
+        lidos += k;
+    }
+    fclose(f);
+    fclose(f_ev);
+    free(buf);
+
+    /* amortizado: média por operação em todos os tamanhos <= este (construir
+       a árvore até aqui / esvaziar uma árvore deste tamanho) */
+    FILE* f_cv = fopen("resultados_curvas.csv", "w");
+    fprintf(f_cv, "operacao,estrutura,tamanho,vezes,media,maximo,amortizado,altura\n");
+    for (uint32_t e = 0; e < c.estruturas; e++)
+        for (int op = 0; op < 2; op++) {
+            double acumulado = 0;
+            long vezes = 0;
+            for (uint32_t n = 0; n <= c.n_max; n++) {
+                const PontoCurva* q = &p[((long) e * 2 + op) * (c.n_max + 1) + n];
+                if (q->vezes == 0) continue;
+                acumulado += q->soma;
+                vezes += q->vezes;
+                fprintf(f_cv, "%s,%s,%u,%u,%.2f,%u,%.3f,%d\n", op ? "remocao" : "insercao", c.nomes[e], n,
+                        q->vezes, q->soma / q->vezes, q->maximo, acumulado / vezes, q->altura);
             }
         }
-        b_remover_tudo(b5);
-        b_get_remocao_and_reset();
-        free(b5);
-
-        ArvoreB* b10 = b_criar(10);
-        for (int n = 1; n <= N_MAX; n++)
-        {
-            b_inserir(b10, chaves[n-1]);
+    fclose(f_cv);
+    free(p);
 
-            if (n % SAMPLE_STEP == 0) {
+    printf("%ld registros lidos (n_max=%u, %u estruturas, %u repeticoes, semente %u)\n", lidos, c.n_max,
+           c.estruturas, c.repeticoes, c.semente);
+    printf("\nArquivos gerados:\n");
+    printf(" - resultados_curvas.csv\n");
+    printf(" - resultados_curvas_eventos.csv\n");
+    return 0;
+}
 
-                int idx = n / SAMPLE_STEP;
 
-                long ins_ops = b_get_insercao_and_reset();
-                b10_ins_acc[idx] += ins_ops;
+int main(int argc, char **argv)
+{
+    int repeticoes = REPETICOES;
+    int aquecimento = 0;
+    unsigned semente = SEMENTE;
+    double atipicos = -1;
+    const char* curvas = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--debug") == 0) {
+            DEBUG_FLAG = 1;
+            printf("DEBUG ATIVADO\n");
+        } else if (strcmp(argv[i], "--tempo") == 0) MODO_TEMPO = 1;
+        else if (strcmp(argv[i], "--repeticoes") == 0 && i + 1 < argc) repeticoes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--aquecimento") == 0 && i + 1 < argc) aquecimento = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) semente = (unsigned) strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--atipicos") == 0 && i + 1 < argc) atipicos = atof(argv[++i]);
+        else if (strcmp(argv[i], "--curvas") == 0 && i + 1 < argc) curvas = argv[++i];
+        else if (strcmp(argv[i], "--agregar") == 0 && i + 1 < argc) return agregar_curvas(argv[i + 1]);
+        else if (strcmp(argv[i], "--comparar") == 0 && i + 2 < argc) {
+            double limiar = 0;
+            for (int j = i + 3; j + 1 < argc; j++)
+                if (strcmp(argv[j], "--limiar") == 0) limiar = atof(argv[j + 1]);
+            return comparar_arquivos(argv[i + 1], argv[i + 2], limiar);
+        }
+    }
+    if (repeticoes < 1) repeticoes = 1;
+    if (curvas) {
+        if (repeticoes > 255) repeticoes = 255;   // repetição cabe num byte do registro
+        int rc = gravar_curvas(curvas, repeticoes, semente);
+        return rc ? rc : agregar_curvas(curvas);
+    }
+    if (aquecimento < 0) aquecimento = 0;
+    if (!MODO_TEMPO && aquecimento > 0) {
+        printf("Aquecimento ignorado: os contadores não dependem de cache nem de frequência (use --tempo)\n");
+        aquecimento = 0;
+    }
+    /* contadores variam com as chaves, não com ruído: por padrão nada é descartado */
+    if (atipicos < 0) atipicos = MODO_TEMPO ? ATIPICOS_TEMPO : 0;
 
-                for (int k = 0; k < n; k++)
-                    b_remover_chave(b10, chaves[k]);
+    SAMPLES = (N_MAX + SAMPLE_STEP - 1) / SAMPLE_STEP;
 
-                long rem_ops = b_get_remocao_and_reset();
-                b10_rem_acc[idx] += rem_ops;
+    /* Alocar amostras */
+    long total = (long) N_ESTRUTURAS * (SAMPLES + 2) * repeticoes;
+    amostras_ins = calloc(total, sizeof(double));
+    amostras_rem = calloc(total, sizeof(double));
 
-                b_remover_tudo(b10);
-                free(b10);
-                b10 = b_criar(10);
+    int *chaves = malloc(sizeof(int) * N_MAX);
 
-                for (int k = 0; k < n; k++)
-                    b_inserir(b10, chaves[k]);
+    /* Repete experimento (as de aquecimento rodam antes e são descartadas) */
+    for (int r = -aquecimento; r < repeticoes; r++) {
 
-                b_get_insercao_and_reset();
-            }
-        }
-        b_remover_tudo(b10);
-        b_get_remocao_and_reset();
-        free(b10);
+        if (r < 0) printf("Aquecimento %d/%d\n", r + aquecimento + 1, aquecimento);
+        else printf("Repeticao %d/%d\n", r + 1, repeticoes);
+        srand(semente + (unsigned) (r < 0 ? r + aquecimento : r) * 7919);
+        gerar_chaves_unicas(chaves, N_MAX);
 
-    } 
+        for (int e = 0; e < N_ESTRUTURAS; e++)
+            medir_estrutura(&ESTRUTURAS[e], e, chaves, r < 0 ? 0 : r, repeticoes, r >= 0);
+    }
 
 
     FILE* f_ins = fopen("resultados_insercao_acumulado.csv","w");
     FILE* f_rem = fopen("resultados_remocao_acumulado.csv","w");
-
-    fprintf(f_ins, "tamanho,avl,rb,b1,b5,b10\n");
-    fprintf(f_rem, "tamanho,avl,rb,b1,b5,b10\n");
+    FILE* f_est = fopen("resultados_estatisticas.csv","w");
+    FILE* f_am = fopen("resultados_amostras.csv","w");
+
+    fprintf(f_ins, "tamanho");
+    fprintf(f_rem, "tamanho");
+    for (int e = 0; e < N_ESTRUTURAS; e++) {
+        fprintf(f_ins, ",%s", ESTRUTURAS[e].nome);
+        fprintf(f_rem, ",%s", ESTRUTURAS[e].nome);
+    }
+    fprintf(f_ins, "\n");
+    fprintf(f_rem, "\n");
+    fprintf(f_est, "operacao,estrutura,tamanho,n,descartadas,media,mediana,desvio,ic95_inf,ic95_sup,minimo,maximo\n");
+    fprintf(f_am, "operacao,estrutura,tamanho,repeticao,valor\n");
 
     for (int s = SAMPLE_STEP; s <= N_MAX; s += SAMPLE_STEP)
     {
         int idx = s / SAMPLE_STEP;
+        fprintf(f_ins, "%d", s);
+        fprintf(f_rem, "%d", s);
+
+        for (int e = 0; e < N_ESTRUTURAS; e++)
+            for (int op = 0; op < 2; op++) {
+                const double* v = (op ? amostras_rem : amostras_ins) + ((long) e * (SAMPLES + 2) + idx) * repeticoes;
+                const char* nome_op = op ? "remocao" : "insercao";
+                Resumo r = resumir(v, repeticoes, atipicos);
+                fprintf(op ? f_rem : f_ins, ",%.2f", r.media);
+                fprintf(f_est, "%s,%s,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", nome_op, ESTRUTURAS[e].nome,
+                        s, r.n, r.descartadas, r.media, r.mediana, r.desvio, r.ic_inf, r.ic_sup, r.minimo, r.maximo);
+                for (int k = 0; k < repeticoes; k++)
+                    fprintf(f_am, "%s,%s,%d,%d,%.1f\n", nome_op, ESTRUTURAS[e].nome, s, k, v[k]);
+            }
 
-        fprintf(f_ins,"%d,%ld,%ld,%ld,%ld,%ld\n",
-            s,
-            avl_ins_acc[idx] / REPETICOES,
-            rb_ins_acc[idx]  / REPETICOES,
-            b1_ins_acc[idx]  / REPETICOES,
-            b5_ins_acc[idx]  / REPETICOES,
-            b10_ins_acc[idx] / REPETICOES
-        );
-
-        fprintf(f_rem,"%d,%ld,%ld,%ld,%ld,%ld\n",
-            s,
-            avl_rem_acc[idx] / REPETICOES,
-            rb_rem_acc[idx]  / REPETICOES,
-            b1_rem_acc[idx]  / REPETICOES,
-            b5_rem_acc[idx]  / REPETICOES,
-            b10_rem_acc[idx] / REPETICOES
-        );
+        fprintf(f_ins, "\n");
+        fprintf(f_rem, "\n");
     }
 
     fclose(f_ins);
     fclose(f_rem);
+    fclose(f_est);
+    fclose(f_am);
 
     printf("\nArquivos gerados:\n");
     printf(" - resultados_insercao_acumulado.csv\n");
     printf(" - resultados_remocao_acumulado.csv\n");
+    printf(" - resultados_estatisticas.csv\n");
+    printf(" - resultados_amostras.csv\n");
 
+    free(amostras_ins);
+    free(amostras_rem);
     free(chaves);
     return 0;
 }